@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_BENCHMARKS_BENCHMARK_H
+#define BLOCKFACTORY_BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace blockfactory {
+    namespace benchmark {
+        class State;
+        struct Registrar;
+
+        /// The body of a benchmark
+        using Function = std::function<void(State&)>;
+
+        /// A registered benchmark
+        struct Definition
+        {
+            std::string name;
+            Function function;
+        };
+
+        /**
+         * @brief Get all the benchmarks registered with BF_BENCHMARK
+         *
+         * @return The benchmarks, in registration order.
+         */
+        std::vector<Definition>& registry();
+
+        /**
+         * @brief Prevent the compiler from optimizing away the computation of a value
+         *
+         * @param value The value.
+         */
+        template <typename T>
+        inline void doNotOptimize(const T& value);
+    } // namespace benchmark
+} // namespace blockfactory
+
+/**
+ * @brief Iteration state of a benchmark
+ *
+ * The body of the benchmark executes the measured code in a loop:
+ *
+ * @code{.cpp}
+ * BF_BENCHMARK("Signal/get")
+ * {
+ *     // Setup, not measured
+ *     while (state.keepRunning()) {
+ *         // Measured code
+ *     }
+ * }
+ * @endcode
+ *
+ * The runner chooses the number of iterations so that every measurement lasts long enough.
+ */
+class blockfactory::benchmark::State
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t m_iterations;
+    uint64_t m_remaining;
+    bool m_started = false;
+    Clock::time_point m_start;
+    Clock::time_point m_stop;
+
+public:
+    explicit State(const uint64_t iterations)
+        : m_iterations(iterations)
+        , m_remaining(iterations)
+    {}
+
+    /**
+     * @brief Check if another iteration should be executed
+     *
+     * The first call starts the timer and the last call stops it.
+     *
+     * @return True if the loop should continue, false otherwise.
+     */
+    inline bool keepRunning()
+    {
+        if (!m_started) {
+            m_started = true;
+            m_start = Clock::now();
+        }
+
+        if (m_remaining == 0) {
+            m_stop = Clock::now();
+            return false;
+        }
+
+        --m_remaining;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of iterations of the measurement
+     *
+     * @return The number of iterations.
+     */
+    uint64_t getIterations() const { return m_iterations; }
+
+    /**
+     * @brief Get the duration of the measured loop
+     *
+     * @return The duration in nanoseconds.
+     */
+    double getElapsedNanoseconds() const
+    {
+        return std::chrono::duration<double, std::nano>(m_stop - m_start).count();
+    }
+};
+
+/// Object whose construction registers a benchmark
+struct blockfactory::benchmark::Registrar
+{
+    Registrar(const std::string& name, const Function& function)
+    {
+        registry().push_back({name, function});
+    }
+};
+
+template <typename T>
+inline void blockfactory::benchmark::doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+#define BF_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BF_BENCHMARK_CONCAT(a, b) BF_BENCHMARK_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Define and register a benchmark
+ *
+ * The body has access to a blockfactory::benchmark::State object called `state`.
+ *
+ * @param name The name of the benchmark, e.g. "Signal/get/CONTIGUOUS".
+ */
+#define BF_BENCHMARK(name)                                                           \
+    static void BF_BENCHMARK_CONCAT(bfBenchmark, __LINE__)(                          \
+        blockfactory::benchmark::State & state);                                     \
+    static const blockfactory::benchmark::Registrar BF_BENCHMARK_CONCAT(bfRegistrar, \
+                                                                        __LINE__)(   \
+        name, &BF_BENCHMARK_CONCAT(bfBenchmark, __LINE__));                          \
+    static void BF_BENCHMARK_CONCAT(bfBenchmark, __LINE__)(blockfactory::benchmark::State & state)
+
+#endif // BLOCKFACTORY_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/FactorySingleton.h"
+
+#include <string>
+
+using namespace blockfactory::benchmark;
+using blockfactory::core::ClassFactorySingleton;
+
+namespace {
+    const ClassFactorySingleton::ClassFactoryData NullBlockData = {"BenchmarkPlugin", "NullBlock"};
+
+    ClassFactorySingleton& getFactorySingleton()
+    {
+        // The search path is extended only once, otherwise every measurement would make the
+        // lookup of the library slower
+        static ClassFactorySingleton& factorySingleton = []() -> ClassFactorySingleton& {
+            auto& instance = ClassFactorySingleton::getInstance();
+            instance.extendPluginSearchPath(BENCHMARK_PLUGIN_PATH);
+            return instance;
+        }();
+        return factorySingleton;
+    }
+} // namespace
+
+// Load and unload the plugin library at every iteration
+BF_BENCHMARK("ClassFactorySingleton/getClassFactory/cold")
+{
+    auto& factorySingleton = getFactorySingleton();
+
+    while (state.keepRunning()) {
+        auto factory = factorySingleton.getClassFactory(NullBlockData);
+        doNotOptimize(factory);
+        factory.reset();
+        factorySingleton.destroyFactory(NullBlockData);
+    }
+}
+
+// The plugin is kept loaded by another user of the factory
+BF_BENCHMARK("ClassFactorySingleton/getClassFactory/warm")
+{
+    auto& factorySingleton = getFactorySingleton();
+    auto owner = factorySingleton.getClassFactory(NullBlockData);
+
+    while (state.keepRunning()) {
+        auto factory = factorySingleton.getClassFactory(NullBlockData);
+        doNotOptimize(factory);
+    }
+
+    owner.reset();
+    factorySingleton.destroyFactory(NullBlockData);
+}
+
+BF_BENCHMARK("ClassFactorySingleton/createBlock")
+{
+    auto& factorySingleton = getFactorySingleton();
+    auto factory = factorySingleton.getClassFactory(NullBlockData);
+
+    while (state.keepRunning()) {
+        blockfactory::core::Block* block = factory->create();
+        doNotOptimize(block);
+        factory->destroy(block);
+    }
+
+    factory.reset();
+    factorySingleton.destroyFactory(NullBlockData);
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/Kernels.h"
+#include "BlockFactory/Core/Span.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace blockfactory::benchmark;
+using blockfactory::core::Kernels;
+using blockfactory::core::Span;
+
+// The kernels are benchmarked with every instruction set supported by the processor, so that
+// the implementations can be compared with the scalar one
+
+namespace {
+    const size_t Width = 1024;
+
+    template <typename T>
+    struct Fixture
+    {
+        std::vector<T> a = std::vector<T>(Width, static_cast<T>(1));
+        std::vector<T> b = std::vector<T>(Width, static_cast<T>(2));
+        std::vector<T> y = std::vector<T>(Width, static_cast<T>(0));
+
+        Span<const T> getA() const { return {a.data(), a.size()}; }
+        Span<const T> getB() const { return {b.data(), b.size()}; }
+        Span<T> getY() { return {y.data(), y.size()}; }
+    };
+
+    template <typename T>
+    void add(State& state)
+    {
+        Fixture<T> fixture;
+
+        while (state.keepRunning()) {
+            Kernels::add(fixture.getA(), fixture.getB(), fixture.getY());
+            doNotOptimize(fixture.y);
+        }
+    }
+
+    template <typename T>
+    void axpy(State& state)
+    {
+        Fixture<T> fixture;
+
+        while (state.keepRunning()) {
+            Kernels::axpy(static_cast<T>(0), fixture.getA(), fixture.getY());
+            doNotOptimize(fixture.y);
+        }
+    }
+
+    template <typename T>
+    void dot(State& state)
+    {
+        const Fixture<T> fixture;
+
+        while (state.keepRunning()) {
+            double result = 0;
+            Kernels::dot(fixture.getA(), fixture.getB(), result);
+            doNotOptimize(result);
+        }
+    }
+
+    template <typename T>
+    void registerKernels(const std::string& type, const Kernels::InstructionSet instructionSet)
+    {
+        const std::string suffix =
+            "/" + type + "/" + Kernels::getInstructionSetName(instructionSet);
+
+        // Select the instruction set only while running the benchmark
+        const auto wrap = [instructionSet](void (*benchmark)(State&)) {
+            return [instructionSet, benchmark](State& state) {
+                const auto defaultInstructionSet = Kernels::getInstructionSet();
+                Kernels::setInstructionSet(instructionSet);
+                benchmark(state);
+                Kernels::setInstructionSet(defaultInstructionSet);
+            };
+        };
+
+        registry().push_back({"Kernels/add" + suffix, wrap(&add<T>)});
+        registry().push_back({"Kernels/axpy" + suffix, wrap(&axpy<T>)});
+        registry().push_back({"Kernels/dot" + suffix, wrap(&dot<T>)});
+    }
+
+    bool registerAll()
+    {
+        for (const auto instructionSet : {Kernels::InstructionSet::Scalar,
+                                          Kernels::InstructionSet::SSE2,
+                                          Kernels::InstructionSet::AVX2,
+                                          Kernels::InstructionSet::AVX512}) {
+            if (!Kernels::isSupported(instructionSet)) {
+                continue;
+            }
+            registerKernels<double>("double", instructionSet);
+            registerKernels<float>("float", instructionSet);
+            registerKernels<int16_t>("int16", instructionSet);
+        }
+        return true;
+    }
+
+    const bool registered = registerAll();
+} // namespace
+
+// Product of 128x128 matrices stored column major, compared with the naive triple loop
+
+namespace {
+    const size_t MatrixSize = 128;
+} // namespace
+
+BF_BENCHMARK("Kernels/gemm/double/128")
+{
+    const std::vector<double> a(MatrixSize * MatrixSize, 1.0);
+    std::vector<double> c(MatrixSize * MatrixSize, 0.0);
+    const blockfactory::core::MatrixView<const double> view(a.data(), MatrixSize, MatrixSize);
+
+    while (state.keepRunning()) {
+        Kernels::gemm(1.0, view, view, 0.0, {c.data(), MatrixSize, MatrixSize});
+        doNotOptimize(c);
+    }
+}
+
+BF_BENCHMARK("Kernels/gemm/double/128/naive")
+{
+    const std::vector<double> a(MatrixSize * MatrixSize, 1.0);
+    std::vector<double> c(MatrixSize * MatrixSize, 0.0);
+
+    while (state.keepRunning()) {
+        for (size_t col = 0; col < MatrixSize; ++col) {
+            for (size_t row = 0; row < MatrixSize; ++row) {
+                double sum = 0;
+                for (size_t k = 0; k < MatrixSize; ++k) {
+                    sum += a[row + k * MatrixSize] * a[k + col * MatrixSize];
+                }
+                c[row + col * MatrixSize] = sum;
+            }
+        }
+        doNotOptimize(c);
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/Log.h"
+
+#include <string>
+
+using namespace blockfactory::benchmark;
+using blockfactory::core::Log;
+
+// The messages are stored until they are cleared, hence every iteration also clears them
+BF_BENCHMARK("Log/error")
+{
+    while (state.keepRunning()) {
+        bfError << "Failed to read the parameter " << 42;
+        Log::getSingleton().clear();
+    }
+}
+
+// Serialization of ten messages
+BF_BENCHMARK("Log/getErrors")
+{
+    Log::getSingleton().clear();
+    for (unsigned i = 0; i < 10; ++i) {
+        bfError << "Failed to read the parameter " << i;
+    }
+
+    while (state.keepRunning()) {
+        const std::string errors = Log::getSingleton().getErrors();
+        doNotOptimize(errors);
+    }
+
+    Log::getSingleton().clear();
+}
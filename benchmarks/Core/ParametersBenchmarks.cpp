@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/Parameter.h"
+#include "BlockFactory/Core/Parameters.h"
+
+#include <string>
+#include <vector>
+
+using namespace blockfactory::benchmark;
+using namespace blockfactory::core;
+
+namespace {
+    // A set of parameters similar to the one of a block with a few options
+    Parameters createParameters()
+    {
+        Parameters parameters;
+        parameters.storeParameter(42, ParameterMetadata(ParameterType::INT, 0, 1, 1, "int"));
+        parameters.storeParameter(true, ParameterMetadata(ParameterType::BOOL, 1, 1, 1, "bool"));
+        parameters.storeParameter(3.14,
+                                  ParameterMetadata(ParameterType::DOUBLE, 2, 1, 1, "double"));
+        parameters.storeParameter(std::string("robot"),
+                                  ParameterMetadata(ParameterType::STRING, 3, 1, 1, "string"));
+        parameters.storeParameter(std::vector<double>(16, 1.0),
+                                  ParameterMetadata(ParameterType::DOUBLE, 4, 1, 16, "vector"));
+        return parameters;
+    }
+
+    template <typename T>
+    void getParameter(State& state, const std::string& name)
+    {
+        const Parameters parameters = createParameters();
+        T value;
+
+        while (state.keepRunning()) {
+            parameters.getParameter(name, value);
+            doNotOptimize(value);
+        }
+    }
+} // namespace
+
+BF_BENCHMARK("Parameters/getParameter/int")
+{
+    getParameter<int>(state, "int");
+}
+
+BF_BENCHMARK("Parameters/getParameter/bool")
+{
+    getParameter<bool>(state, "bool");
+}
+
+BF_BENCHMARK("Parameters/getParameter/double")
+{
+    getParameter<double>(state, "double");
+}
+
+BF_BENCHMARK("Parameters/getParameter/string")
+{
+    getParameter<std::string>(state, "string");
+}
+
+BF_BENCHMARK("Parameters/getParameter/vector<double>")
+{
+    getParameter<std::vector<double>>(state, "vector");
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/PoolAllocator.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <cstddef>
+#include <vector>
+
+using namespace blockfactory::benchmark;
+using blockfactory::core::Signal;
+
+// Signal is instantiated only for double, which is the type used by both the Simulink engine
+// and the generated code. The other types of Port::DataType cannot be benchmarked.
+
+namespace {
+    const size_t Width = 64;
+
+    // The buffers must outlive the signals that point to them
+    struct Fixture
+    {
+        std::vector<double> data;
+        const void* pointer;
+        Signal signal;
+
+        explicit Fixture(const Signal::DataFormat format)
+            : data(Width, 1.0)
+            , pointer(data.data())
+            , signal(format, blockfactory::core::Port::DataType::DOUBLE)
+        {
+            switch (format) {
+                case Signal::DataFormat::NONCONTIGUOUS:
+                    signal.initializeBufferFromNonContiguous(&pointer, Width);
+                    break;
+                case Signal::DataFormat::CONTIGUOUS:
+                    signal.initializeBufferFromContiguous(data.data(), Width);
+                    break;
+                case Signal::DataFormat::CONTIGUOUS_ZEROCOPY:
+                    signal.initializeBufferFromContiguousZeroCopy(data.data(), Width);
+                    break;
+            }
+        }
+    };
+
+    void get(State& state, const Signal::DataFormat format)
+    {
+        const Fixture fixture(format);
+        const Signal& signal = fixture.signal;
+
+        while (state.keepRunning()) {
+            double sum = 0;
+            for (size_t i = 0; i < Width; ++i) {
+                sum += signal.get<double>(i);
+            }
+            doNotOptimize(sum);
+        }
+    }
+
+    void set(State& state, const Signal::DataFormat format)
+    {
+        Fixture fixture(format);
+
+        while (state.keepRunning()) {
+            for (size_t i = 0; i < Width; ++i) {
+                fixture.signal.set(i, static_cast<double>(i));
+            }
+            doNotOptimize(fixture.signal);
+        }
+    }
+
+    void setBuffer(State& state, const Signal::DataFormat format)
+    {
+        Fixture fixture(format);
+        const std::vector<double> input(Width, 2.0);
+
+        while (state.keepRunning()) {
+            fixture.signal.setBuffer(input.data(), Width);
+            doNotOptimize(fixture.signal);
+        }
+    }
+
+    void getBuffer(State& state, const Signal::DataFormat format)
+    {
+        const Fixture fixture(format);
+
+        while (state.keepRunning()) {
+            doNotOptimize(fixture.signal.getBuffer<double>());
+        }
+    }
+} // namespace
+
+// The Simulink engine creates a signal for every port at every step
+BF_BENCHMARK("Signal/initialize/double/NONCONTIGUOUS")
+{
+    const std::vector<double> data(Width, 1.0);
+    const void* const pointer = data.data();
+
+    while (state.keepRunning()) {
+        Signal signal(Signal::DataFormat::NONCONTIGUOUS);
+        signal.initializeBufferFromNonContiguous(&pointer, Width);
+        doNotOptimize(signal);
+    }
+}
+
+// Blocks keeping the history of their inputs copy a signal at every step
+BF_BENCHMARK("Signal/copy/double/CONTIGUOUS/heap")
+{
+    const Fixture fixture(Signal::DataFormat::CONTIGUOUS);
+
+    while (state.keepRunning()) {
+        Signal copy(fixture.signal);
+        doNotOptimize(copy);
+    }
+}
+
+BF_BENCHMARK("Signal/copy/double/CONTIGUOUS/pool")
+{
+    const std::vector<double> data(Width, 1.0);
+    Signal signal(Signal::DataFormat::CONTIGUOUS,
+                  blockfactory::core::Port::DataType::DOUBLE,
+                  &blockfactory::core::PoolAllocator::getThreadLocal());
+    signal.initializeBufferFromContiguous(data.data(), Width);
+
+    while (state.keepRunning()) {
+        Signal copy(signal);
+        doNotOptimize(copy);
+    }
+}
+
+BF_BENCHMARK("Signal/initialize/double/CONTIGUOUS_ZEROCOPY")
+{
+    std::vector<double> data(Width, 1.0);
+
+    while (state.keepRunning()) {
+        Signal signal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+        signal.initializeBufferFromContiguousZeroCopy(data.data(), Width);
+        doNotOptimize(signal);
+    }
+}
+
+// Every iteration accesses all the 64 elements of the signal
+
+BF_BENCHMARK("Signal/get/double/NONCONTIGUOUS")
+{
+    get(state, Signal::DataFormat::NONCONTIGUOUS);
+}
+
+BF_BENCHMARK("Signal/get/double/CONTIGUOUS")
+{
+    get(state, Signal::DataFormat::CONTIGUOUS);
+}
+
+BF_BENCHMARK("Signal/get/double/CONTIGUOUS_ZEROCOPY")
+{
+    get(state, Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+}
+
+BF_BENCHMARK("Signal/set/double/NONCONTIGUOUS")
+{
+    set(state, Signal::DataFormat::NONCONTIGUOUS);
+}
+
+BF_BENCHMARK("Signal/set/double/CONTIGUOUS")
+{
+    set(state, Signal::DataFormat::CONTIGUOUS);
+}
+
+BF_BENCHMARK("Signal/set/double/CONTIGUOUS_ZEROCOPY")
+{
+    set(state, Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+}
+
+BF_BENCHMARK("Signal/setBuffer/double/CONTIGUOUS")
+{
+    setBuffer(state, Signal::DataFormat::CONTIGUOUS);
+}
+
+BF_BENCHMARK("Signal/setBuffer/double/CONTIGUOUS_ZEROCOPY")
+{
+    setBuffer(state, Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+}
+
+BF_BENCHMARK("Signal/getBuffer/double/CONTIGUOUS")
+{
+    getBuffer(state, Signal::DataFormat::CONTIGUOUS);
+}
+
+BF_BENCHMARK("Signal/getBuffer/double/CONTIGUOUS_ZEROCOPY")
+{
+    getBuffer(state, Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+}
+
+// Elementwise sum of two signals, as in the output of a math block. The accessors are inlined in
+// the loops. The loop over the buffers is vectorized, while the bounds check of get() keeps the
+// other loop scalar.
+
+BF_BENCHMARK("Signal/add/get")
+{
+    const Fixture a(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    const Fixture b(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    Fixture y(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+
+    while (state.keepRunning()) {
+        double* output = y.signal.getBuffer<double>();
+        for (size_t i = 0; i < Width; ++i) {
+            output[i] = a.signal.get<double>(i) + b.signal.get<double>(i);
+        }
+        doNotOptimize(output);
+    }
+}
+
+BF_BENCHMARK("Signal/add/getBuffer")
+{
+    const Fixture a(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    const Fixture b(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    Fixture y(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+
+    while (state.keepRunning()) {
+        const double* inputA = a.signal.getBuffer<double>();
+        const double* inputB = b.signal.getBuffer<double>();
+        double* output = y.signal.getBuffer<double>();
+        for (size_t i = 0; i < Width; ++i) {
+            output[i] = inputA[i] + inputB[i];
+        }
+        doNotOptimize(output);
+    }
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "NullBlock.h"
+
+#include <sharedlibpp/SharedLibraryClassApi.h>
+
+bool benchmark::NullBlock::output(const blockfactory::core::BlockInformation* /*blockInfo*/)
+{
+    return true;
+}
+
+// Add the NullBlock class to the plugin factory
+SHLIBPP_DEFINE_SHARED_SUBCLASS(NullBlock, benchmark::NullBlock, blockfactory::core::Block);
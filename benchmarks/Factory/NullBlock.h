@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_BENCHMARKS_NULLBLOCK_H
+#define BLOCKFACTORY_BENCHMARKS_NULLBLOCK_H
+
+#include <BlockFactory/Core/Block.h>
+
+namespace benchmark {
+    class NullBlock;
+}
+
+/// Block that does nothing, used to measure the cost of the plugin factory
+class benchmark::NullBlock : public blockfactory::core::Block
+{
+public:
+    NullBlock() = default;
+    ~NullBlock() override = default;
+
+    bool output(const blockfactory::core::BlockInformation* blockInfo) override;
+};
+
+#endif // BLOCKFACTORY_BENCHMARKS_NULLBLOCK_H
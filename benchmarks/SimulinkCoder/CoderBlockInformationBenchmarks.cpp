@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <array>
+#include <cstddef>
+
+using namespace blockfactory;
+using namespace blockfactory::benchmark;
+
+namespace {
+    const size_t NumberOfPorts = 4;
+    const int Width = 16;
+
+    // A block with a few vector ports, as configured by the generated code
+    struct Fixture
+    {
+        std::array<std::array<double, Width>, NumberOfPorts> inputs = {};
+        std::array<std::array<double, Width>, NumberOfPorts> outputs = {};
+        coder::CoderBlockInformation blockInfo;
+
+        Fixture()
+        {
+            blockInfo.setUniqueBlockName("model/Block");
+
+            for (size_t i = 0; i < NumberOfPorts; ++i) {
+                blockInfo.setInputPort({i, {1, Width}, core::Port::DataType::DOUBLE},
+                                       inputs[i].data());
+                blockInfo.setOutputPort({i, {1, Width}, core::Port::DataType::DOUBLE},
+                                        outputs[i].data());
+            }
+        }
+    };
+} // namespace
+
+BF_BENCHMARK("CoderBlockInformation/getInputPortSignal")
+{
+    const Fixture fixture;
+
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < NumberOfPorts; ++i) {
+            auto signal = fixture.blockInfo.getInputPortSignal(i);
+            doNotOptimize(signal);
+        }
+    }
+}
+
+BF_BENCHMARK("CoderBlockInformation/getOutputPortSignal")
+{
+    const Fixture fixture;
+
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < NumberOfPorts; ++i) {
+            auto signal = fixture.blockInfo.getOutputPortSignal(i);
+            doNotOptimize(signal);
+        }
+    }
+}
+
+BF_BENCHMARK("CoderBlockInformation/getInputPortWidth")
+{
+    const Fixture fixture;
+
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < NumberOfPorts; ++i) {
+            auto width = fixture.blockInfo.getInputPortWidth(i);
+            doNotOptimize(width);
+        }
+    }
+}
+
+BF_BENCHMARK("CoderBlockInformation/getOutputPortInfo")
+{
+    const Fixture fixture;
+
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < NumberOfPorts; ++i) {
+            auto info = fixture.blockInfo.getOutputPortInfo(i);
+            doNotOptimize(info);
+        }
+    }
+}
+
+// The access of a block to its inputs at every step of the generated code
+BF_BENCHMARK("CoderBlockInformation/readInputs")
+{
+    const Fixture fixture;
+
+    while (state.keepRunning()) {
+        double sum = 0;
+        for (size_t i = 0; i < NumberOfPorts; ++i) {
+            const auto signal = fixture.blockInfo.getInputPortSignal(i);
+            for (size_t j = 0; j < signal->getWidth(); ++j) {
+                sum += signal->get<double>(j);
+            }
+        }
+        doNotOptimize(sum);
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/ElementwiseKernel.h"
+#include "BlockFactory/Core/Kernels.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/ElementwiseFusion.h"
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::benchmark;
+
+namespace {
+    const size_t NumberOfBlocks = 4;
+    const int Width = 1 << 16;
+
+    // Block that scales its input with an elementwise kernel
+    class ScaleBlock : public core::Block
+    {
+    public:
+        bool output(const core::BlockInformation* blockInfo) override
+        {
+            const auto u = blockInfo->getInputPortSignal(0);
+            auto y = blockInfo->getOutputPortSignal(0);
+            return core::Kernels::scale(*u, 1.0001, *y);
+        }
+
+        bool getElementwiseKernel(core::ElementwiseKernel& kernel) override
+        {
+            kernel.operation = core::ElementwiseKernel::Operation::SCALE;
+            kernel.alpha = 1.0001;
+            return true;
+        }
+    };
+
+    // A chain of wide elementwise blocks: in -> B0 -> B1 -> ... -> out
+    struct Fixture
+    {
+        coder::ModelGraph graph;
+        coder::SignalMemoryPlanner planner;
+        std::vector<ScaleBlock> blocks{NumberOfBlocks};
+        std::vector<core::Block*> blockPtrs;
+        std::vector<std::unique_ptr<coder::CoderBlockInformation>> blockInfos;
+        std::vector<const core::BlockInformation*> blockInfoPtrs;
+        coder::ElementwiseFusion fusion;
+
+        Fixture()
+        {
+            const core::Port::Info port{0, {Width}, core::Port::DataType::DOUBLE};
+            for (size_t i = 0; i < NumberOfBlocks; ++i) {
+                graph.addBlock("B" + std::to_string(i), {port}, {port});
+                if (i > 0) {
+                    graph.connect({i - 1, 0}, {i, 0});
+                }
+            }
+
+            planner.setBufferReuse(false);
+            planner.plan(graph);
+
+            for (size_t i = 0; i < NumberOfBlocks; ++i) {
+                blockPtrs.push_back(&blocks[i]);
+                blockInfos.emplace_back(new coder::CoderBlockInformation);
+                planner.configureBlockInformation(i, *blockInfos.back());
+                blockInfoPtrs.push_back(blockInfos.back().get());
+            }
+
+            fusion.configure(graph, blockPtrs);
+            fusion.bind(blockInfoPtrs);
+        }
+    };
+} // namespace
+
+BF_BENCHMARK("ElementwiseFusion/chain/4x65536/separate")
+{
+    Fixture fixture;
+
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < NumberOfBlocks; ++i) {
+            bool ok = fixture.blocks[i].output(fixture.blockInfoPtrs[i]);
+            doNotOptimize(ok);
+        }
+    }
+}
+
+BF_BENCHMARK("ElementwiseFusion/chain/4x65536/fused")
+{
+    Fixture fixture;
+
+    while (state.keepRunning()) {
+        bool ok = fixture.fusion.output(NumberOfBlocks - 1);
+        doNotOptimize(ok);
+    }
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace blockfactory::benchmark;
+
+std::vector<Definition>& blockfactory::benchmark::registry()
+{
+    static std::vector<Definition> benchmarks;
+    return benchmarks;
+}
+
+namespace {
+    struct Options
+    {
+        std::string filter;
+        std::string format = "text";
+        std::string output;
+        double minTime = 0.1;
+        unsigned repetitions = 5;
+    };
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        // Nanoseconds per iteration of every repetition, sorted
+        std::vector<double> times;
+
+        double median() const { return times[times.size() / 2]; }
+    };
+
+    double measure(const Function& function, const uint64_t iterations)
+    {
+        State state(iterations);
+        function(state);
+        return state.getElapsedNanoseconds();
+    }
+
+    Result run(const Definition& benchmark, const Options& options)
+    {
+        const double minTime = options.minTime * 1e9;
+
+        // Increase the iterations until a measurement lasts at least the minimum time
+        uint64_t iterations = 1;
+        while (true) {
+            const double elapsed = measure(benchmark.function, iterations);
+            if (elapsed >= minTime || iterations >= 1000000000) {
+                break;
+            }
+
+            const double predicted =
+                minTime * 1.4 / std::max(elapsed, 1.0) * static_cast<double>(iterations);
+            iterations = std::min<uint64_t>(std::max<uint64_t>(static_cast<uint64_t>(predicted),
+                                                               iterations + 1),
+                                            iterations * 10);
+        }
+
+        Result result{benchmark.name, iterations, {}};
+        for (unsigned i = 0; i < options.repetitions; ++i) {
+            result.times.push_back(measure(benchmark.function, iterations)
+                                   / static_cast<double>(iterations));
+        }
+        std::sort(result.times.begin(), result.times.end());
+        return result;
+    }
+
+    std::string escape(const std::string& string)
+    {
+        std::string escaped;
+        for (const char c : string) {
+            if (c == '"' || c == '\\') {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
+
+    // The format is compatible with the JSON output of Google Benchmark, so that the results
+    // can be compared with its tools
+    void writeJson(std::ostream& stream, const std::vector<Result>& results)
+    {
+        char date[64];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        stream << "{\n  \"context\": {\n"
+               << "    \"date\": \"" << date << "\",\n"
+               << "    \"library\": \"BlockFactory\",\n"
+               << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "\n  },\n"
+               << "  \"benchmarks\": [";
+
+        stream << std::setprecision(6);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << escape(result.name)
+                   << "\", \"run_type\": \"iteration\", \"iterations\": " << result.iterations
+                   << ", \"repetitions\": " << result.times.size()
+                   << ", \"real_time\": " << result.median()
+                   << ", \"min_time\": " << result.times.front()
+                   << ", \"max_time\": " << result.times.back() << ", \"time_unit\": \"ns\"}";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    void writeCsv(std::ostream& stream, const std::vector<Result>& results)
+    {
+        stream << "name,iterations,median_ns,min_ns,max_ns\n";
+        for (const auto& result : results) {
+            stream << '"' << result.name << "\"," << result.iterations << ',' << result.median()
+                   << ',' << result.times.front() << ',' << result.times.back() << '\n';
+        }
+    }
+
+    void writeText(std::ostream& stream, const Result& result)
+    {
+        stream << std::left << std::setw(56) << result.name << std::right << std::setw(12)
+               << result.iterations << std::fixed << std::setprecision(2) << std::setw(14)
+               << result.median() << " ns" << std::setw(14) << result.times.front() << " ns"
+               << std::endl;
+    }
+
+    void printUsage(const char* program)
+    {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --filter <text>       Run only the benchmarks whose name contains text\n"
+                  << "  --format <format>     Output format: text (default), json, csv\n"
+                  << "  --output <file>       Write the results to a file instead of stdout\n"
+                  << "  --min-time <seconds>  Minimum duration of a measurement (0.1)\n"
+                  << "  --repetitions <n>     Number of measurements of every benchmark (5)\n"
+                  << "  --list                List the benchmarks\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--format" && hasValue) {
+            options.format = argv[++i];
+        }
+        else if (arg == "--output" && hasValue) {
+            options.output = argv[++i];
+        }
+        else if (arg == "--min-time" && hasValue) {
+            options.minTime = std::atof(argv[++i]);
+        }
+        else if (arg == "--repetitions" && hasValue) {
+            options.repetitions = static_cast<unsigned>(std::max(std::atoi(argv[++i]), 1));
+        }
+        else if (arg == "--list") {
+            list = true;
+        }
+        else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (options.format != "text" && options.format != "json" && options.format != "csv") {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Failed to open " << options.output << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& stream = options.output.empty() ? std::cout : file;
+
+    std::vector<Result> results;
+    for (const auto& benchmark : registry()) {
+        if (benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        if (list) {
+            stream << benchmark.name << std::endl;
+            continue;
+        }
+
+        results.push_back(run(benchmark, options));
+
+        // Print the progress while running
+        if (options.format == "text") {
+            writeText(stream, results.back());
+        }
+        else if (!options.output.empty()) {
+            writeText(std::cout, results.back());
+        }
+    }
+
+    if (options.format == "json") {
+        writeJson(stream, results);
+    }
+    else if (options.format == "csv") {
+        writeCsv(stream, results);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -9,6 +9,8 @@
 #ifndef MXPP_MXARRAY_H
 #define MXPP_MXARRAY_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -16,6 +18,8 @@
 
 namespace mxpp {
     class MxArray;
+    template <typename T>
+    struct MxSpan;
     using MxArrayPtr = std::shared_ptr<MxArray>;
     using MxCell = std::vector<MxArrayPtr>;
     using MxStructKey = std::string;
@@ -25,6 +29,24 @@ namespace mxpp {
 struct mxArray_tag;
 using mxArray = struct mxArray_tag;
 
+/**
+ * @brief Read-only view of the data of a numeric mxArray
+ *
+ * The view does not own the data, and it is valid as long as the viewed `mxArray` is alive and not
+ * modified. Elements are stored in column-major order.
+ */
+template <typename T>
+struct mxpp::MxSpan
+{
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](const size_t index) const { return data[index]; }
+    bool empty() const { return size == 0; }
+};
+
 /**
  * @brief Slim wrapper of mxArray
  *
@@ -78,10 +100,21 @@ public:
     // Cell
     bool asMxCell(MxCell& cell);
 
+    // Lazy access to composite data types. The returned pointers are owned by the wrapped
+    // mxArray, and they are nullptr if the element or the field do not exist.
+    size_t getNumberOfElements() const;
+    const mxArray* getCellElement(const size_t index) const;
+    const mxArray* getField(const std::string& fieldName) const;
+
     // Vector
     // TODO: valarray? And matrices?
     bool asVectorDouble(std::vector<double>& vec);
 
+    // Views without copies. Supported types: double, float, bool (logical), and the fixed-width
+    // integers. The class of the mxArray must match the type of the view.
+    template <typename T>
+    bool asSpan(MxSpan<T>& span) const;
+
     // TODO: Matrix
 };
 
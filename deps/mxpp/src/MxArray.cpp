@@ -9,10 +9,70 @@
 #include "mxpp/MxArray.h"
 
 #include <cassert>
+#include <cstdint>
 #include <matrix.h>
 
 using namespace mxpp;
 
+// The mxClassID that stores elements of type T
+template <typename T>
+static mxClassID classIdOf();
+template <>
+mxClassID classIdOf<double>()
+{
+    return mxDOUBLE_CLASS;
+}
+template <>
+mxClassID classIdOf<float>()
+{
+    return mxSINGLE_CLASS;
+}
+template <>
+mxClassID classIdOf<bool>()
+{
+    return mxLOGICAL_CLASS;
+}
+template <>
+mxClassID classIdOf<int8_t>()
+{
+    return mxINT8_CLASS;
+}
+template <>
+mxClassID classIdOf<uint8_t>()
+{
+    return mxUINT8_CLASS;
+}
+template <>
+mxClassID classIdOf<int16_t>()
+{
+    return mxINT16_CLASS;
+}
+template <>
+mxClassID classIdOf<uint16_t>()
+{
+    return mxUINT16_CLASS;
+}
+template <>
+mxClassID classIdOf<int32_t>()
+{
+    return mxINT32_CLASS;
+}
+template <>
+mxClassID classIdOf<uint32_t>()
+{
+    return mxUINT32_CLASS;
+}
+template <>
+mxClassID classIdOf<int64_t>()
+{
+    return mxINT64_CLASS;
+}
+template <>
+mxClassID classIdOf<uint64_t>()
+{
+    return mxUINT64_CLASS;
+}
+
 class MxArray::Impl
 {
 public:
@@ -242,39 +302,83 @@ bool MxArray::asMxCell(MxCell& cell)
     return true;
 }
 
+size_t MxArray::getNumberOfElements() const
+{
+    return pImpl->md.nElem;
+}
+
+const mxArray* MxArray::getCellElement(const size_t index) const
+{
+    if (!pImpl->mx || pImpl->md.id != mxCELL_CLASS || index >= pImpl->md.nElem) {
+        return nullptr;
+    }
+
+    return mxGetCell(pImpl->mx, index);
+}
+
+const mxArray* MxArray::getField(const std::string& fieldName) const
+{
+    if (!pImpl->mx || pImpl->md.id != mxSTRUCT_CLASS) {
+        return nullptr;
+    }
+
+    // TODO multidimensional struct
+    return mxGetField(pImpl->mx, 0, fieldName.c_str());
+}
+
 // MATRIX
 // ======
 
 // VECTOR
 // ======
 
-// TODO:
-// Test with other types (uint8) https://it.mathworks.com/help/matlab/apiref/mxgetdata.html
-// (Description)
 bool MxArray::asVectorDouble(std::vector<double>& vec)
 {
-    if (!pImpl->mx) {
+    if (pImpl->md.rows > 1 && pImpl->md.cols > 1) {
         return false;
     }
-    if (!mxIsDouble(pImpl->mx)) {
+
+    MxSpan<double> span;
+    if (!asSpan(span)) {
         return false;
     }
 
-    if (pImpl->md.rows > 1 && pImpl->md.cols > 1) {
+    vec.assign(span.begin(), span.end());
+    return true;
+}
+
+// VIEWS
+// =====
+
+template <typename T>
+bool MxArray::asSpan(MxSpan<T>& span) const
+{
+    if (!pImpl->mx) {
         return false;
     }
-
-    // TODO add method for complex vectors (and move the check into md)
-    if (mxIsComplex(pImpl->mx)) {
+    if (pImpl->md.id != classIdOf<T>()) {
         return false;
     }
 
-    double* buffer = mxGetPr(pImpl->mx);
-    if (!buffer) {
+    // TODO add views for complex arrays
+    if (mxIsComplex(pImpl->mx)) {
         return false;
     }
 
-    vec.reserve(pImpl->md.rows * pImpl->md.cols);
-    vec.assign(buffer, buffer + pImpl->md.rows * pImpl->md.cols);
-    return true;
+    // mxLogical is bool in C++, and the other classes store the matching fixed-width type
+    span.data = static_cast<const T*>(mxGetData(pImpl->mx));
+    span.size = pImpl->md.nElem;
+    return span.data || span.size == 0;
 }
+
+template bool MxArray::asSpan<double>(MxSpan<double>& span) const;
+template bool MxArray::asSpan<float>(MxSpan<float>& span) const;
+template bool MxArray::asSpan<bool>(MxSpan<bool>& span) const;
+template bool MxArray::asSpan<int8_t>(MxSpan<int8_t>& span) const;
+template bool MxArray::asSpan<uint8_t>(MxSpan<uint8_t>& span) const;
+template bool MxArray::asSpan<int16_t>(MxSpan<int16_t>& span) const;
+template bool MxArray::asSpan<uint16_t>(MxSpan<uint16_t>& span) const;
+template bool MxArray::asSpan<int32_t>(MxSpan<int32_t>& span) const;
+template bool MxArray::asSpan<uint32_t>(MxSpan<uint32_t>& span) const;
+template bool MxArray::asSpan<int64_t>(MxSpan<int64_t>& span) const;
+template bool MxArray::asSpan<uint64_t>(MxSpan<uint64_t>& span) const;
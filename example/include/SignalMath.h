@@ -42,6 +42,7 @@ public:
     bool configureSizeAndPorts(blockfactory::core::BlockInformation* blockInfo) override;
     bool initialize(blockfactory::core::BlockInformation* blockInfo) override;
     bool output(const blockfactory::core::BlockInformation* blockInfo) override;
+    bool getElementwiseKernel(blockfactory::core::ElementwiseKernel& kernel) override;
     bool terminate(const blockfactory::core::BlockInformation* blockInfo) override;
 };
 
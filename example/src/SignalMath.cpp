@@ -1,5 +1,7 @@
 #include "SignalMath.h"
 
+#include <BlockFactory/Core/ElementwiseKernel.h>
+#include <BlockFactory/Core/Kernels.h>
 #include <BlockFactory/Core/Log.h>
 #include <BlockFactory/Core/Parameter.h>
 #include <BlockFactory/Core/Signal.h>
@@ -151,22 +153,39 @@ bool SignalMath::output(const blockfactory::core::BlockInformation* blockInfo)
         return false;
     }
 
-    // Perform the given operation
-    for (size_t i = 0; i < output->getWidth(); ++i) {
-        switch (m_operation) {
-            case Operation::ADDITION:
-                output->set(i, input1->get<double>(i) + input2->get<double>(i));
-                break;
-            case Operation::SUBTRACTION:
-                output->set(i, input1->get<double>(i) - input2->get<double>(i));
-                break;
-            case Operation::MULTIPLICATION:
-                output->set(i, input1->get<double>(i) * input2->get<double>(i));
-                break;
-        }
+    // Perform the given operation. The kernels process the whole signals with the vector
+    // instructions supported by the processor.
+    switch (m_operation) {
+        case Operation::ADDITION:
+            return blockfactory::core::Kernels::add(*input1, *input2, *output);
+        case Operation::SUBTRACTION:
+            return blockfactory::core::Kernels::subtract(*input1, *input2, *output);
+        case Operation::MULTIPLICATION:
+            return blockfactory::core::Kernels::multiply(*input1, *input2, *output);
     }
 
-    return true;
+    return false;
+}
+
+bool SignalMath::getElementwiseKernel(blockfactory::core::ElementwiseKernel& kernel)
+{
+    using Kernel = blockfactory::core::ElementwiseKernel;
+
+    // The output is the elementwise operation of the two inputs, hence chains of SignalMath
+    // blocks can be fused by the runners
+    switch (m_operation) {
+        case Operation::ADDITION:
+            kernel.operation = Kernel::Operation::ADDITION;
+            return true;
+        case Operation::SUBTRACTION:
+            kernel.operation = Kernel::Operation::SUBTRACTION;
+            return true;
+        case Operation::MULTIPLICATION:
+            kernel.operation = Kernel::Operation::MULTIPLICATION;
+            return true;
+    }
+
+    return false;
 }
 
 bool SignalMath::terminate(const blockfactory::core::BlockInformation* /*blockInfo*/)
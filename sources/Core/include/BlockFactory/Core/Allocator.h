@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_ALLOCATOR_H
+#define BLOCKFACTORY_CORE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blockfactory {
+    namespace core {
+        class Allocator;
+        class ArenaAllocator;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Interface of the sources of memory of the buffers owned by core::Signal
+ *
+ * The buffers of the DataFormat::CONTIGUOUS and DataFormat::NONCONTIGUOUS signals are allocated
+ * through this interface. The returned memory is aligned at least to the requested alignment,
+ * which allows the use of aligned vector loads and avoids false sharing between buffers accessed
+ * by different threads.
+ *
+ * Unless another allocator is passed to the core::Signal constructor, signals use the allocator
+ * returned by core::Allocator::getDefault, which allocates from the heap.
+ *
+ * @note The allocator must outlive all the signals using it.
+ * @see core::ArenaAllocator
+ */
+class blockfactory::core::Allocator
+{
+public:
+    /// Alignment of the buffers owned by signals, which matches the size of a cache line
+    static constexpr size_t DefaultAlignment = 64;
+
+    virtual ~Allocator() = default;
+
+    /**
+     * @brief Allocate a memory area
+     *
+     * @param bytes The size of the area.
+     * @param alignment The alignment of the area. It must be a power of two.
+     * @return The pointer to the area if the allocation succeeded, `nullptr` otherwise.
+     */
+    virtual void* allocate(const size_t bytes, const size_t alignment) = 0;
+
+    /**
+     * @brief Release a memory area
+     *
+     * @param ptr The pointer returned by core::Allocator::allocate. It can be `nullptr`.
+     * @param bytes The size passed to core::Allocator::allocate.
+     * @param alignment The alignment passed to core::Allocator::allocate.
+     */
+    virtual void deallocate(void* ptr, const size_t bytes, const size_t alignment) = 0;
+
+    /**
+     * @brief Get the allocator used by default by the signals
+     *
+     * The default allocator is thread safe and allocates aligned memory from the heap.
+     *
+     * @return The default allocator.
+     */
+    static Allocator& getDefault();
+
+    /**
+     * @brief Check if a pointer is aligned
+     *
+     * @param ptr The pointer to check.
+     * @param alignment The alignment. It must be a power of two.
+     * @return True if the address is a multiple of the alignment, false otherwise.
+     */
+    static bool isAligned(const void* ptr, const size_t alignment)
+    {
+        return (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) == 0;
+    }
+};
+
+/**
+ * @brief Allocator that serves the requests from a preallocated memory area
+ *
+ * The arena allocates its memory area at construction and then serves the requests by advancing
+ * a pointer, without calling the heap. Memory is released only by ArenaAllocator::reset, hence
+ * the arena fits signals with the same lifetime, e.g. the signals created by a block during its
+ * initialization. The requests that do not fit in the area are forwarded to the upstream
+ * allocator.
+ *
+ * @code{.cpp}
+ * ArenaAllocator arena(64 * 1024);
+ * Signal signal(Signal::DataFormat::CONTIGUOUS, Port::DataType::DOUBLE, &arena);
+ * @endcode
+ *
+ * @note The arena is not thread safe.
+ */
+class blockfactory::core::ArenaAllocator final : public blockfactory::core::Allocator
+{
+private:
+    Allocator& m_upstream;
+    char* m_begin = nullptr;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+
+public:
+    /**
+     * @brief Create an arena
+     *
+     * @param capacity The size in bytes of the memory area of the arena.
+     * @param upstream The allocator of the memory area and of the requests that do not fit in it.
+     */
+    explicit ArenaAllocator(const size_t capacity,
+                            Allocator& upstream = Allocator::getDefault());
+    ~ArenaAllocator() override;
+
+    ArenaAllocator(const ArenaAllocator& other) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator& other) = delete;
+
+    void* allocate(const size_t bytes, const size_t alignment) override;
+    void deallocate(void* ptr, const size_t bytes, const size_t alignment) override;
+
+    /**
+     * @brief Release all the memory served from the arena
+     *
+     * @warning The buffers allocated from the arena must not be used after this call.
+     */
+    void reset();
+
+    /// Get the size in bytes of the memory area of the arena
+    size_t getCapacity() const { return m_capacity; }
+
+    /// Get the number of bytes of the memory area already served, including the padding
+    size_t getUsedBytes() const { return m_used; }
+
+    /// Check if a pointer was served from the memory area of the arena
+    bool owns(const void* ptr) const;
+};
+
+#endif // BLOCKFACTORY_CORE_ALLOCATOR_H
@@ -11,6 +11,7 @@
 
 #include "BlockFactory/Core/Parameters.h"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@ namespace blockfactory {
     namespace core {
         class Block;
         class BlockInformation;
+        class ElementwiseKernel;
     } // namespace core
 } // namespace blockfactory
 
@@ -147,11 +149,33 @@ public:
      */
     virtual unsigned numberOfContinuousStates();
 
+    /**
+     * @brief Sample time of a block
+     *
+     * The block is executed every `period` seconds starting from `offset` seconds.
+     */
+    struct SampleTime
+    {
+        double period;
+        double offset;
+    };
+
+    /**
+     * @brief Period of blocks that inherit their sample time
+     *
+     * Blocks with this period are executed with the rate of the signals connected to their
+     * inputs.
+     */
+    static constexpr double InheritedSampleTime = -1;
+
     /**
      * @brief Update the internal discrete state
      *
      * i.e. `x[i+1] = f(x[i])`
      *
+     * The state should be stored in the signal returned by
+     * core::BlockInformation::getDiscreteStateSignal, which is updated in place.
+     *
      * @param blockInfo The pointer to a BlockInformation object.
      * @return True for success, false otherwise.
      */
@@ -160,6 +184,11 @@ public:
     /**
      * @brief Update the internal continuous state
      *
+     * Implement this method writing the derivative of the state returned by
+     * core::BlockInformation::getContinuousStateSignal in the signal returned by
+     * core::BlockInformation::getContinuousStateDerivativeSignal. The state is then integrated by
+     * the solver.
+     *
      * @param blockInfo The pointer to a BlockInformation object.
      * @return True for success, false otherwise.
      */
@@ -291,6 +320,89 @@ public:
      * @return True for success, false otherwise.
      */
     virtual bool output(const BlockInformation* blockInfo) = 0;
+
+    // Methods added after the first release. They are appended after the original methods to
+    // preserve the order of the existing entries of the virtual table.
+
+    /**
+     * @brief Returns the sample time of the block
+     *
+     * The base implementation returns an inherited sample time, i.e. the block is executed at the
+     * rate of its inputs. Implement this method if the block should run at a specific rate, e.g.
+     * planning algorithms that are much slower than the control loop using their output.
+     *
+     * This method is called after core::Block::configureSizeAndPorts, whose base implementation
+     * parses the parameters, hence the sample time can be computed from the block parameters.
+     *
+     * @return The sample time of the block.
+     * @see core::Block::InheritedSampleTime
+     */
+    virtual SampleTime sampleTime();
+
+    /**
+     * @brief Returns if the block implements core::Block::outputBatched
+     *
+     * The base implementation returns false.
+     *
+     * @return True if the block supports the batched execution, false otherwise.
+     * @see core::Block::outputBatched
+     */
+    virtual bool supportsBatchedOutput();
+
+    /**
+     * @brief Compute the output of many instances of the block at once
+     *
+     * In the batched execution, a single block object computes the output of batchSize instances
+     * that share the same parameters and differ only in their signals, e.g. the runs of a Monte
+     * Carlo campaign. The signals of all the instances are stored in structure-of-arrays layout:
+     * a port of width W has width batchSize * W, and the element e of the instance i is stored at
+     * the index e * batchSize + i. The loops over the instances access contiguous memory and can
+     * be vectorized.
+     *
+     * Blocks implementing this method must return true from core::Block::supportsBatchedOutput.
+     * The other blocks are executed calling core::Block::output once per instance. The base
+     * implementation fails.
+     *
+     * @param blockInfo The pointer to a BlockInformation object with the batched ports.
+     * @param batchSize The number of instances.
+     * @return True for success, false otherwise.
+     * @see coder::BatchRunner
+     */
+    virtual bool outputBatched(const BlockInformation* blockInfo, const size_t batchSize);
+
+    /**
+     * @brief Returns if the output of the block depends only on its inputs and parameters
+     *
+     * The output of pure blocks is a function of the current inputs and of the parameters, without
+     * internal states nor side effects. When none of the inputs and of the tunable parameters
+     * changed since the previous step, the engines skip core::Block::output and keep the outputs
+     * computed in the previous step. The inputs are compared with a copy stored by
+     * core::InputChangeDetector. The code generated by Simulink Coder skips the output only of
+     * pure blocks without tunable parameters.
+     *
+     * The base implementation returns false.
+     *
+     * @return True if the block is pure, false otherwise.
+     * @note Blocks with discrete or continuous states, or that read data from devices or from the
+     *       network, are not pure.
+     */
+    virtual bool isPure();
+
+    /**
+     * @brief Describe the output of the block as an elementwise kernel
+     *
+     * Blocks with a single output port that is an elementwise function of their input ports can
+     * describe it with a core::ElementwiseKernel. The runners can then fuse chains of these
+     * blocks in a single loop over the data, without calling core::Block::output. The kernel is
+     * read after core::Block::initialize.
+     *
+     * The base implementation returns false.
+     *
+     * @param[out] kernel The kernel computed by the block.
+     * @return True if the output of the block is described by the kernel, false otherwise.
+     * @see coder::ElementwiseFusion
+     */
+    virtual bool getElementwiseKernel(ElementwiseKernel& kernel);
 };
 
 #endif // BLOCKFACTORY_CORE_BLOCK_H
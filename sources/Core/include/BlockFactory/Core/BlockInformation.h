@@ -201,6 +201,55 @@ public:
      *         otherwise.
      */
     virtual OutputSignalPtr getOutputPortSignal(const Port::Index idx) const = 0;
+
+    // ============
+    // BLOCK STATES
+    // ============
+
+    /**
+     * @brief Get the continuous state of the block
+     *
+     * The signal has core::Block::numberOfContinuousStates elements and it can be written by
+     * core::Block::initializeInitialConditions for setting the initial state. During the
+     * execution, the state is owned by the solver and blocks should only read it.
+     *
+     * The base implementation fails, implementations of this interface that support continuous
+     * states must override it.
+     *
+     * @return The pointer to the state signal for success, a `nullptr` otherwise.
+     * @see core::Block::stateDerivative
+     */
+    virtual OutputSignalPtr getContinuousStateSignal() const;
+
+    /**
+     * @brief Get the derivative of the continuous state of the block
+     *
+     * core::Block::stateDerivative writes in this signal the derivative of the state returned
+     * by core::BlockInformation::getContinuousStateSignal. The signal has the same width of the
+     * state.
+     *
+     * The base implementation fails, implementations of this interface that support continuous
+     * states must override it.
+     *
+     * @return The pointer to the derivative signal for success, a `nullptr` otherwise.
+     */
+    virtual OutputSignalPtr getContinuousStateDerivativeSignal() const;
+
+    /**
+     * @brief Get the discrete state of the block
+     *
+     * The signal has core::Block::numberOfDiscreteStates elements. It is written by
+     * core::Block::initializeInitialConditions with the initial state and by
+     * core::Block::updateDiscreteState at every step. Storing the state in this signal instead of
+     * in members of the block allows the backend to keep the states of all the blocks close in
+     * memory and to save and restore them.
+     *
+     * The base implementation fails, implementations of this interface that support discrete
+     * states must override it.
+     *
+     * @return The pointer to the state signal for success, a `nullptr` otherwise.
+     */
+    virtual OutputSignalPtr getDiscreteStateSignal() const;
 };
 
 #endif // BLOCKFACTORY_CORE_BLOCKINFORMATION_H
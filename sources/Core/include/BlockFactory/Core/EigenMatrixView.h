@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_EIGENMATRIXVIEW_H
+#define BLOCKFACTORY_CORE_EIGENMATRIXVIEW_H
+
+#include "BlockFactory/Core/MatrixView.h"
+
+#include <Eigen/Core>
+
+#include <type_traits>
+
+// This header is optional: BlockFactory does not depend on Eigen, and only the blocks that
+// include it have to find it.
+
+namespace blockfactory {
+    namespace core {
+        /**
+         * @brief Eigen map with the strides of a core::MatrixView
+         *
+         * The map is read-only if `T` is a const type.
+         */
+        template <typename T>
+        using EigenMatrixMap = Eigen::Map<
+            typename std::conditional<
+                std::is_const<T>::value,
+                const Eigen::Matrix<typename std::remove_const<T>::type,
+                                    Eigen::Dynamic,
+                                    Eigen::Dynamic,
+                                    Eigen::ColMajor>,
+                Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>>::type,
+            Eigen::Unaligned,
+            Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+        /**
+         * @brief Map a core::MatrixView to an Eigen matrix without copying data
+         *
+         * @code{.cpp}
+         * auto input = MatrixView<const double>::fromSignal(*inputSignal, size);
+         * auto output = MatrixView<double>::fromSignal(*outputSignal, size);
+         * toEigen(output) = toEigen(input).transpose() * toEigen(input);
+         * @endcode
+         *
+         * @param view The view.
+         * @return The Eigen map over the buffer of the view.
+         */
+        template <typename T>
+        EigenMatrixMap<T> toEigen(const MatrixView<T>& view)
+        {
+            // The outer stride of a column major map is the distance between columns
+            return EigenMatrixMap<T>(
+                view.data(),
+                static_cast<Eigen::Index>(view.rows()),
+                static_cast<Eigen::Index>(view.cols()),
+                Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
+                    static_cast<Eigen::Index>(view.colStride()),
+                    static_cast<Eigen::Index>(view.rowStride())));
+        }
+    } // namespace core
+} // namespace blockfactory
+
+#endif // BLOCKFACTORY_CORE_EIGENMATRIXVIEW_H
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_ELEMENTWISEKERNEL_H
+#define BLOCKFACTORY_CORE_ELEMENTWISEKERNEL_H
+
+#include "BlockFactory/Core/Span.h"
+
+#include <cstddef>
+
+namespace blockfactory {
+    namespace core {
+        class ElementwiseKernel;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Description of the elementwise operation computed by a block
+ *
+ * Blocks whose single output is an elementwise function of their inputs can describe it with this
+ * class through core::Block::getElementwiseKernel. The runners can then fuse chains of such blocks
+ * into a single pass over the data, without storing the intermediate signals (see
+ * coder::ElementwiseFusion).
+ *
+ * The inputs of the operation are the input ports of the block, in the order of their indices.
+ * All the ports must be of type core::Port::DataType::DOUBLE and have the same number of elements.
+ *
+ * @see core::Kernels
+ */
+class blockfactory::core::ElementwiseKernel
+{
+public:
+    /// The supported operations
+    enum class Operation
+    {
+        /// `y = u0 + u1`
+        ADDITION,
+        /// `y = u0 - u1`
+        SUBTRACTION,
+        /// `y = u0 * u1`
+        MULTIPLICATION,
+        /// `y = alpha * u0`
+        SCALE,
+        /// `y = min(max(u0, lower), upper)`
+        CLAMP,
+    };
+
+    Operation operation = Operation::ADDITION;
+    double alpha = 1.0;
+    double lower = 0.0;
+    double upper = 0.0;
+
+    /**
+     * @brief Get the number of inputs of an operation
+     *
+     * @param operation The operation.
+     * @return The number of input ports of the blocks computing the operation.
+     */
+    static size_t getNumberOfInputs(const Operation operation);
+
+    /**
+     * @brief Apply the operation to a range of elements
+     *
+     * The output can alias the inputs, as long as they start at the same address.
+     *
+     * @param u0 The first input.
+     * @param u1 The second input. It is ignored by the operations with one input.
+     * @param[out] y The output.
+     * @return True for success, false if the lengths do not match.
+     */
+    bool apply(Span<const double> u0, Span<const double> u1, Span<double> y) const;
+};
+
+#endif // BLOCKFACTORY_CORE_ELEMENTWISEKERNEL_H
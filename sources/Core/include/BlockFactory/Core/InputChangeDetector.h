@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_INPUTCHANGEDETECTOR_H
+#define BLOCKFACTORY_CORE_INPUTCHANGEDETECTOR_H
+
+#include <cstddef>
+#include <vector>
+
+namespace blockfactory {
+    namespace core {
+        class BlockInformation;
+        class InputChangeDetector;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Detect if the input signals of a block changed since the previous step
+ *
+ * The engines use this class to skip core::Block::output of the blocks that return true from
+ * core::Block::isPure. The detector stores a copy of the input signals and, at every step,
+ * compares it with their current content.
+ *
+ * The inputs are compared bitwise. Most input signals are zero-copy views of the memory of the
+ * engine, hence neither the signals nor the blocks can track when they are written. Comparing
+ * the content costs a read of the inputs, and unlike hashes it never misses a change.
+ *
+ * @code{.cpp}
+ * // In the output callback of the engine
+ * if (!block->isPure() || detector.update(blockInfo, numberOfInputPorts)) {
+ *     block->output(blockInfo);
+ * }
+ * @endcode
+ *
+ * @note The copy is allocated at the first step and reallocated only if the size of the inputs
+ *       changes.
+ */
+class blockfactory::core::InputChangeDetector
+{
+private:
+    std::vector<unsigned char> m_snapshot;
+    std::vector<size_t> m_offsets;
+    bool m_valid = false;
+    size_t m_numberOfChanges = 0;
+    size_t m_numberOfSkips = 0;
+
+public:
+    InputChangeDetector() = default;
+    ~InputChangeDetector() = default;
+
+    /**
+     * @brief Compare the input signals with the previous step and store them
+     *
+     * @param blockInfo The BlockInformation object of the block.
+     * @param numberOfInputPorts The number of input ports of the block.
+     * @return True if any input changed, if this is the first step after the construction or
+     *         InputChangeDetector::invalidate, or if an input signal is not valid. False if the
+     *         output of the block can be skipped.
+     */
+    bool update(const BlockInformation* blockInfo, const size_t numberOfInputPorts);
+
+    /**
+     * @brief Force the next call of InputChangeDetector::update to return true
+     *
+     * Call this method when the tunable parameters of the block change.
+     */
+    void invalidate() { m_valid = false; }
+
+    /// Get the number of steps in which the inputs changed
+    size_t getNumberOfChanges() const { return m_numberOfChanges; }
+
+    /// Get the number of steps in which the inputs did not change
+    size_t getNumberOfSkips() const { return m_numberOfSkips; }
+};
+
+#endif // BLOCKFACTORY_CORE_INPUTCHANGEDETECTOR_H
@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_KERNELS_H
+#define BLOCKFACTORY_CORE_KERNELS_H
+
+#include "BlockFactory/Core/MatrixView.h"
+#include "BlockFactory/Core/Span.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace blockfactory {
+    namespace core {
+        class Kernels;
+        class Signal;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Class that provides vectorized elementwise operations on signals
+ *
+ * The kernels operate either on core::Signal objects or on core::Span views of their buffers,
+ * and they replace the scalar loops that blocks would write in their core::Block::output:
+ *
+ * @code{.cpp}
+ * InputSignalPtr input1 = blockInfo->getInputPortSignal(0);
+ * InputSignalPtr input2 = blockInfo->getInputPortSignal(1);
+ * OutputSignalPtr output = blockInfo->getOutputPortSignal(0);
+ *
+ * return Kernels::add(*input1, *input2, *output);
+ * @endcode
+ *
+ * All the numeric types of core::Port::DataType are supported. Input and output buffers must
+ * have the same length, and the output can be one of the inputs. Partially overlapping buffers
+ * are not supported.
+ *
+ * On x86 Linux systems the implementation is selected at runtime among SSE2, AVX2 and AVX-512,
+ * depending on the instruction sets supported by the processor. The other systems use a
+ * portable scalar implementation. The `BLOCKFACTORY_KERNELS` environment variable
+ * (`scalar`, `sse2`, `avx2`, `avx512`) can be used to select a different implementation.
+ *
+ * The matrix kernels (core::Kernels::gemv, core::Kernels::gemm) operate on core::MatrixView
+ * objects of `double` or `float` elements, and they are built on top of the vectorized kernels.
+ *
+ * @note Reductions (core::Kernels::dot, core::Kernels::norm) of floating point signals may differ
+ *       in the last bits between implementations, since they sum the elements in different order.
+ */
+class blockfactory::core::Kernels
+{
+public:
+    /// The instruction sets used by the implementations of the kernels
+    enum class InstructionSet
+    {
+        Scalar = 0,
+        SSE2,
+        AVX2,
+        AVX512,
+    };
+
+    /**
+     * @brief Get the instruction set used by the kernels
+     *
+     * @return The selected instruction set.
+     */
+    static InstructionSet getInstructionSet();
+
+    /**
+     * @brief Select the instruction set used by the kernels
+     *
+     * This is meant for testing and benchmarking the different implementations.
+     *
+     * @param instructionSet The instruction set.
+     * @return True if the instruction set is supported and was selected, false otherwise.
+     */
+    static bool setInstructionSet(const InstructionSet instructionSet);
+
+    /**
+     * @brief Check if an instruction set is supported by the processor and by the library
+     *
+     * @param instructionSet The instruction set.
+     * @return True if the kernels can use the instruction set, false otherwise.
+     */
+    static bool isSupported(const InstructionSet instructionSet);
+
+    /**
+     * @brief Get the name of an instruction set
+     *
+     * @param instructionSet The instruction set.
+     * @return The lowercase name of the instruction set, e.g. `avx2`.
+     */
+    static std::string getInstructionSetName(const InstructionSet instructionSet);
+
+    /**
+     * @brief Compute the elementwise sum `y = a + b`
+     *
+     * @param a The first input.
+     * @param b The second input.
+     * @param[out] y The output.
+     * @return True for success, false if the lengths do not match.
+     */
+    template <typename T>
+    static bool add(Span<const T> a, Span<const T> b, Span<T> y);
+
+    /**
+     * @brief Compute the elementwise difference `y = a - b`
+     *
+     * @copydetails core::Kernels::add
+     */
+    template <typename T>
+    static bool subtract(Span<const T> a, Span<const T> b, Span<T> y);
+
+    /**
+     * @brief Compute the elementwise product `y = a * b`
+     *
+     * @copydetails core::Kernels::add
+     */
+    template <typename T>
+    static bool multiply(Span<const T> a, Span<const T> b, Span<T> y);
+
+    /**
+     * @brief Compute the scaled signal `y = alpha * x`
+     *
+     * @param x The input.
+     * @param alpha The scale factor.
+     * @param[out] y The output.
+     * @return True for success, false if the lengths do not match.
+     */
+    template <typename T>
+    static bool scale(Span<const T> x, const T alpha, Span<T> y);
+
+    /**
+     * @brief Accumulate the scaled signal `y = alpha * x + y`
+     *
+     * @param alpha The scale factor.
+     * @param x The input.
+     * @param[in,out] y The accumulated output.
+     * @return True for success, false if the lengths do not match.
+     */
+    template <typename T>
+    static bool axpy(const T alpha, Span<const T> x, Span<T> y);
+
+    /**
+     * @brief Limit the elements of a signal to an interval
+     *
+     * @param x The input.
+     * @param lower The lower limit.
+     * @param upper The upper limit.
+     * @param[out] y The output.
+     * @return True for success, false if the lengths do not match or `lower > upper`.
+     */
+    template <typename T>
+    static bool clamp(Span<const T> x, const T lower, const T upper, Span<T> y);
+
+    /**
+     * @brief Compute the dot product of two signals
+     *
+     * The products of integer signals are accumulated in double precision.
+     *
+     * @param a The first input.
+     * @param b The second input.
+     * @param[out] result The dot product.
+     * @return True for success, false if the lengths do not match.
+     */
+    template <typename T>
+    static bool dot(Span<const T> a, Span<const T> b, double& result);
+
+    /**
+     * @brief Compute the Euclidean norm of a signal
+     *
+     * @param x The input.
+     * @param[out] result The norm.
+     * @return True for success, false otherwise.
+     */
+    template <typename T>
+    static bool norm(Span<const T> x, double& result);
+
+    // Signal interface
+    // ================
+
+    // The signals must have the same numeric data type. The scalar arguments are converted to it:
+    // the methods fail if a scale factor cannot be represented by the type, e.g. if it is
+    // fractional for an integer type. The limits of clamp are rounded towards the inside of the
+    // interval and saturated to the range of the type, which does not change the result.
+
+    /// @copydoc core::Kernels::add
+    static bool add(const Signal& a, const Signal& b, Signal& y);
+    /// @copydoc core::Kernels::subtract
+    static bool subtract(const Signal& a, const Signal& b, Signal& y);
+    /// @copydoc core::Kernels::multiply
+    static bool multiply(const Signal& a, const Signal& b, Signal& y);
+    /// @copydoc core::Kernels::scale
+    static bool scale(const Signal& x, const double alpha, Signal& y);
+    /// @copydoc core::Kernels::axpy
+    static bool axpy(const double alpha, const Signal& x, Signal& y);
+    /// @copydoc core::Kernels::clamp
+    static bool clamp(const Signal& x, const double lower, const double upper, Signal& y);
+    /// @copydoc core::Kernels::dot
+    static bool dot(const Signal& a, const Signal& b, double& result);
+    /// @copydoc core::Kernels::norm
+    static bool norm(const Signal& x, double& result);
+
+    // Matrix interface
+    // ================
+
+    /**
+     * @brief Compute the matrix-vector product `y = alpha * A * x + beta * y`
+     *
+     * Matrices with contiguous columns or rows use the vectorized kernels, the other strides use
+     * a scalar loop. If `beta` is zero, the initial values of `y` are not read.
+     *
+     * @param alpha The scale factor of the product.
+     * @param a The matrix.
+     * @param x The vector, whose length is the number of columns of the matrix.
+     * @param beta The scale factor of the output.
+     * @param[in,out] y The output, whose length is the number of rows of the matrix.
+     * @return True for success, false if the sizes do not match.
+     */
+    template <typename T>
+    static bool
+    gemv(const T alpha, MatrixView<const T> a, Span<const T> x, const T beta, Span<T> y);
+
+    /**
+     * @brief Compute the matrix-matrix product `C = alpha * A * B + beta * C`
+     *
+     * The product is computed in blocks of `A` that fit in the cache. Matrices with contiguous
+     * columns use the vectorized kernels, and row major matrices are handled as the transposed
+     * product. If `beta` is zero, the initial values of `C` are not read.
+     *
+     * @param alpha The scale factor of the product.
+     * @param a The left matrix.
+     * @param b The right matrix.
+     * @param beta The scale factor of the output.
+     * @param[in,out] c The output. It must not overlap the inputs.
+     * @return True for success, false if the sizes do not match.
+     */
+    template <typename T>
+    static bool gemm(const T alpha,
+                     MatrixView<const T> a,
+                     MatrixView<const T> b,
+                     const T beta,
+                     MatrixView<T> c);
+};
+
+// Explicit declaration of templates for all the supported types
+// =============================================================
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#define BF_KERNELS_EXTERN_TEMPLATES(T)                                                      \
+    extern template bool Kernels::add<T>(Span<const T>, Span<const T>, Span<T>);           \
+    extern template bool Kernels::subtract<T>(Span<const T>, Span<const T>, Span<T>);      \
+    extern template bool Kernels::multiply<T>(Span<const T>, Span<const T>, Span<T>);      \
+    extern template bool Kernels::scale<T>(Span<const T>, const T, Span<T>);               \
+    extern template bool Kernels::axpy<T>(const T, Span<const T>, Span<T>);                \
+    extern template bool Kernels::clamp<T>(Span<const T>, const T, const T, Span<T>);      \
+    extern template bool Kernels::dot<T>(Span<const T>, Span<const T>, double&);           \
+    extern template bool Kernels::norm<T>(Span<const T>, double&);
+
+namespace blockfactory {
+    namespace core {
+        BF_KERNELS_EXTERN_TEMPLATES(double)
+        BF_KERNELS_EXTERN_TEMPLATES(float)
+        BF_KERNELS_EXTERN_TEMPLATES(int8_t)
+        BF_KERNELS_EXTERN_TEMPLATES(uint8_t)
+        BF_KERNELS_EXTERN_TEMPLATES(int16_t)
+        BF_KERNELS_EXTERN_TEMPLATES(uint16_t)
+        BF_KERNELS_EXTERN_TEMPLATES(int32_t)
+        BF_KERNELS_EXTERN_TEMPLATES(uint32_t)
+    } // namespace core
+} // namespace blockfactory
+
+#define BF_KERNELS_EXTERN_MATRIX_TEMPLATES(T)                                               \
+    extern template bool Kernels::gemv<T>(                                                 \
+        const T, MatrixView<const T>, Span<const T>, const T, Span<T>);                    \
+    extern template bool Kernels::gemm<T>(                                                 \
+        const T, MatrixView<const T>, MatrixView<const T>, const T, MatrixView<T>);
+
+namespace blockfactory {
+    namespace core {
+        BF_KERNELS_EXTERN_MATRIX_TEMPLATES(double)
+        BF_KERNELS_EXTERN_MATRIX_TEMPLATES(float)
+    } // namespace core
+} // namespace blockfactory
+
+#undef BF_KERNELS_EXTERN_TEMPLATES
+#undef BF_KERNELS_EXTERN_MATRIX_TEMPLATES
+#endif
+
+#endif // BLOCKFACTORY_CORE_KERNELS_H
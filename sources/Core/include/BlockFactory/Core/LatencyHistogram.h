@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_LATENCYHISTOGRAM_H
+#define BLOCKFACTORY_CORE_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace blockfactory {
+    namespace core {
+        class LatencyHistogram;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Class that collects the distribution of durations
+ *
+ * The histogram stores the number of samples falling in logarithmic buckets. Every power of two
+ * is split into LatencyHistogram::SubBuckets linear buckets, so that the relative error of the
+ * statistics computed from the buckets is lower than 1 / LatencyHistogram::SubBuckets. Values
+ * lower than LatencyHistogram::SubBuckets are stored exactly.
+ *
+ * Samples are added with atomic operations and without locks. A single thread can record samples
+ * while other threads read the statistics, for instance a real-time loop and a monitoring thread.
+ * The statistics read concurrently with LatencyHistogram::record are not a consistent snapshot,
+ * but every counter is always valid.
+ *
+ * @note Values are unitless. The classes using this histogram usually record nanoseconds.
+ */
+class blockfactory::core::LatencyHistogram
+{
+public:
+    /// Number of linear buckets every power of two is split into
+    static const size_t SubBuckets = 8;
+    /// Total number of buckets, covering the entire range of 64 bits values
+    static const size_t NumberOfBuckets = (64 - 2) * SubBuckets;
+
+private:
+    std::array<std::atomic<uint64_t>, NumberOfBuckets> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max;
+
+public:
+    LatencyHistogram();
+    ~LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram& other) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram& other) = delete;
+
+    /**
+     * @brief Add a sample to the histogram
+     *
+     * @param value The value of the sample.
+     */
+    inline void record(const uint64_t value);
+
+    /**
+     * @brief Remove all the samples from the histogram
+     *
+     * @note Samples recorded concurrently with this method could be partially removed.
+     */
+    void reset();
+
+    /**
+     * @brief Add the samples of another histogram
+     *
+     * @param other The histogram whose samples are added. It can be modified concurrently.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Get the number of recorded samples
+     *
+     * @return The number of samples.
+     */
+    uint64_t getCount() const;
+
+    /**
+     * @brief Get the minimum recorded value
+     *
+     * @return The minimum value, or 0 if the histogram is empty.
+     */
+    uint64_t getMin() const;
+
+    /**
+     * @brief Get the maximum recorded value
+     *
+     * @return The maximum value, or 0 if the histogram is empty.
+     */
+    uint64_t getMax() const;
+
+    /**
+     * @brief Get the mean of the recorded values
+     *
+     * @return The mean value, or 0 if the histogram is empty.
+     */
+    double getMean() const;
+
+    /**
+     * @brief Get a percentile of the recorded values
+     *
+     * @param percentile The percentile, in the [0, 100] range.
+     * @return The upper bound of the bucket containing the percentile, clamped to the maximum
+     *         recorded value. It returns 0 if the histogram is empty.
+     */
+    uint64_t getPercentile(const double percentile) const;
+
+    /**
+     * @brief Get the number of samples stored in a bucket
+     *
+     * @param bucket The index of the bucket.
+     * @return The number of samples, or 0 if the bucket does not exist.
+     */
+    uint64_t getBucketCount(const size_t bucket) const;
+
+    /**
+     * @brief Get the index of the bucket that stores a value
+     *
+     * @param value The value.
+     * @return The index of the bucket.
+     */
+    static inline size_t getBucketIndex(const uint64_t value);
+
+    /**
+     * @brief Get the lowest value stored in a bucket
+     *
+     * @param bucket The index of the bucket.
+     * @return The lowest value of the bucket.
+     */
+    static uint64_t getBucketLowerBound(const size_t bucket);
+
+    /**
+     * @brief Get the highest value stored in a bucket
+     *
+     * @param bucket The index of the bucket.
+     * @return The highest value of the bucket.
+     */
+    static uint64_t getBucketUpperBound(const size_t bucket);
+};
+
+inline size_t blockfactory::core::LatencyHistogram::getBucketIndex(const uint64_t value)
+{
+    if (value < SubBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    // Position of the most significant bit. SubBuckets is 2^3, hence msb >= 3.
+#if defined(__GNUC__) || defined(__clang__)
+    const size_t msb = static_cast<size_t>(63 - __builtin_clzll(value));
+#else
+    size_t msb = 0;
+    for (uint64_t v = value >> 1; v; v >>= 1) {
+        ++msb;
+    }
+#endif
+
+    // The three bits following the msb select the linear sub bucket
+    const size_t sub = static_cast<size_t>(value >> (msb - 3)) & (SubBuckets - 1);
+    return (msb - 2) * SubBuckets + sub;
+}
+
+inline void blockfactory::core::LatencyHistogram::record(const uint64_t value)
+{
+    m_buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (value < current
+           && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+
+    current = m_max.load(std::memory_order_relaxed);
+    while (value > current
+           && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+
+    // The count is updated last, so that readers never see samples without their value
+    m_count.fetch_add(1, std::memory_order_release);
+}
+
+#endif // BLOCKFACTORY_CORE_LATENCYHISTOGRAM_H
@@ -10,6 +10,7 @@
 #define BLOCKFACTORY_CORE_LOG_H
 
 #include <memory>
+#include <ostream>
 #include <sstream>
 #include <string>
 
@@ -41,6 +42,10 @@ namespace blockfactory {
  * @brief Class for handling log messages
  *
  * Errors and Warnings are currently supported.
+ *
+ * Messages can be logged concurrently from different threads, e.g. by blocks executed by
+ * coder::ParallelScheduler. Every message is composed in its own core::Log::Stream and it is
+ * stored in the log only when the statement that writes it is complete.
  */
 class blockfactory::core::Log
 {
@@ -57,6 +62,8 @@ public:
         DEBUG
     };
 
+    class Stream;
+
 private:
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     class impl;
@@ -65,7 +72,7 @@ private:
 
 public:
     Log();
-    ~Log() = default;
+    ~Log();
 
     /**
      * @brief Get the Log singleton
@@ -77,18 +84,21 @@ public:
     static blockfactory::core::Log& getSingleton();
 
     /**
-     * @brief Get the stringstream object for adding log messages
+     * @brief Get the stream object for adding a log message
+     *
+     * The message is stored in the log when the returned object is destroyed, i.e. at the end of
+     * the statement that uses the bfError and bfWarning macros.
      *
      * @param type The log type.
      * @param file The file from which this method is called (preprocessor directive).
      * @param line The line from which this method is called (preprocessor directive).
      * @param function The function from which this method is called (preprocessor directive).
-     * @return The stringstream object matching the log type.
+     * @return The stream object of the new message.
      */
-    std::stringstream& getLogStringStream(const Type& type,
-                                          const std::string& file,
-                                          const unsigned& line,
-                                          const std::string& function);
+    Stream getLogStringStream(const Type& type,
+                              const std::string& file,
+                              const unsigned& line,
+                              const std::string& function);
 
     /**
      * @brief Get the stored error messages.
@@ -118,4 +128,36 @@ public:
     void clear();
 };
 
+/**
+ * @brief Stream that composes a single log message
+ *
+ * The message is written in a buffer owned by the object, and it is stored in the log by the
+ * destructor. This class is not meant to be used directly, use the bfError and bfWarning macros.
+ */
+class blockfactory::core::Log::Stream
+{
+private:
+    Log* m_log;
+    Type m_type;
+    std::stringstream m_stream;
+
+public:
+    Stream(Log& log, const Type type);
+    Stream(Stream&& other);
+    ~Stream();
+
+    Stream(const Stream& other) = delete;
+    Stream& operator=(const Stream& other) = delete;
+    Stream& operator=(Stream&& other) = delete;
+
+    template <typename T>
+    Stream& operator<<(const T& value)
+    {
+        m_stream << value;
+        return *this;
+    }
+
+    Stream& operator<<(std::ostream& (*manipulator)(std::ostream&));
+};
+
 #endif // BLOCKFACTORY_CORE_LOG_H
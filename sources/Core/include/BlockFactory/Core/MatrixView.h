@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_MATRIXVIEW_H
+#define BLOCKFACTORY_CORE_MATRIXVIEW_H
+
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace blockfactory {
+    namespace core {
+        template <typename T>
+        class MatrixView;
+
+        /// The order of the elements of a matrix stored in a contiguous buffer
+        enum class MatrixLayout
+        {
+            /// Columns are contiguous, as in Simulink and in the generated code
+            ColumnMajor,
+            /// Rows are contiguous
+            RowMajor,
+        };
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Non-owning 2D view of a buffer with explicit strides
+ *
+ * The element `(row, col)` is stored at `data()[row * rowStride() + col * colStride()]`. Column
+ * major and row major contiguous buffers are special cases, and transposed views or blocks of
+ * other views are obtained without copying data.
+ *
+ * The view is meant to be created every step from the signals of the ports and to be passed by
+ * value:
+ *
+ * @code{.cpp}
+ * const auto size = blockInfo->getInputPortMatrixSize(0);
+ * InputSignalPtr input = blockInfo->getInputPortSignal(0);
+ * auto matrix = MatrixView<const double>::fromSignal(*input, size);
+ * @endcode
+ *
+ * @tparam T The type of the elements. Use a const type for read-only views.
+ * @see core::Kernels::gemv, core::Kernels::gemm
+ */
+template <typename T>
+class blockfactory::core::MatrixView
+{
+private:
+    T* m_data = nullptr;
+    size_t m_rows = 0;
+    size_t m_cols = 0;
+    size_t m_rowStride = 1;
+    size_t m_colStride = 0;
+
+    using Element = typename std::remove_const<T>::type;
+    using SignalType =
+        typename std::conditional<std::is_const<T>::value, const Signal, Signal>::type;
+
+public:
+    MatrixView() = default;
+
+    /**
+     * @brief Create a view over a contiguous buffer
+     *
+     * @param data The pointer to the first element.
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param layout The order of the elements in the buffer.
+     */
+    MatrixView(T* data,
+               const size_t rows,
+               const size_t cols,
+               const MatrixLayout layout = MatrixLayout::ColumnMajor)
+        : m_data(data)
+        , m_rows(rows)
+        , m_cols(cols)
+        , m_rowStride(layout == MatrixLayout::ColumnMajor ? 1 : cols)
+        , m_colStride(layout == MatrixLayout::ColumnMajor ? rows : 1)
+    {}
+
+    /**
+     * @brief Create a view with explicit strides
+     *
+     * @param data The pointer to the first element.
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param rowStride The distance in elements between two consecutive rows.
+     * @param colStride The distance in elements between two consecutive columns.
+     */
+    MatrixView(T* data,
+               const size_t rows,
+               const size_t cols,
+               const size_t rowStride,
+               const size_t colStride)
+        : m_data(data)
+        , m_rows(rows)
+        , m_cols(cols)
+        , m_rowStride(rowStride)
+        , m_colStride(colStride)
+    {}
+
+    /**
+     * @brief Create a read-only view from a mutable one
+     *
+     * @param other The view over elements of type `U`, convertible to `T`.
+     */
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    MatrixView(const MatrixView<U>& other)
+        : m_data(other.data())
+        , m_rows(other.rows())
+        , m_cols(other.cols())
+        , m_rowStride(other.rowStride())
+        , m_colStride(other.colStride())
+    {}
+
+    /**
+     * @brief Create a view over the buffer of a signal
+     *
+     * The signal must be contiguous and its width must match the size of the matrix.
+     *
+     * @param signal The signal. Its data type must match `T`.
+     * @param size The size of the matrix, e.g. from core::BlockInformation::getInputPortMatrixSize.
+     * @param layout The order of the elements in the signal.
+     * @return The view, or an empty view if the signal does not match the size.
+     */
+    static MatrixView fromSignal(SignalType& signal,
+                                 const Port::Size::Matrix& size,
+                                 const MatrixLayout layout = MatrixLayout::ColumnMajor)
+    {
+        const size_t rows = static_cast<size_t>(size.rows);
+        const size_t cols = static_cast<size_t>(size.cols);
+
+        if (size.rows < 0 || size.cols < 0 || signal.getWidth() != rows * cols) {
+            bfError << "The width of the signal does not match the size of the matrix.";
+            return {};
+        }
+
+        T* data = signal.template getBuffer<Element>();
+        if (!data) {
+            return {};
+        }
+
+        return {data, rows, cols, layout};
+    }
+
+    T* data() const { return m_data; }
+    size_t rows() const { return m_rows; }
+    size_t cols() const { return m_cols; }
+    size_t rowStride() const { return m_rowStride; }
+    size_t colStride() const { return m_colStride; }
+    size_t size() const { return m_rows * m_cols; }
+    bool empty() const { return size() == 0; }
+
+    /// Check if the columns are contiguous in memory
+    bool hasContiguousColumns() const { return m_rowStride == 1; }
+
+    /// Check if the rows are contiguous in memory
+    bool hasContiguousRows() const { return m_colStride == 1; }
+
+    T& operator()(const size_t row, const size_t col) const
+    {
+        return m_data[row * m_rowStride + col * m_colStride];
+    }
+
+    /**
+     * @brief Get the transposed view of the same buffer
+     *
+     * @return The view with swapped rows and columns.
+     */
+    MatrixView transpose() const { return {m_data, m_cols, m_rows, m_colStride, m_rowStride}; }
+
+    /**
+     * @brief Get the view of a block of the matrix
+     *
+     * @param row The first row of the block.
+     * @param col The first column of the block.
+     * @param rows The number of rows of the block.
+     * @param cols The number of columns of the block.
+     * @return The view of the block, which has the same strides of this view.
+     */
+    MatrixView block(const size_t row, const size_t col, const size_t rows, const size_t cols) const
+    {
+        return {&(*this)(row, col), rows, cols, m_rowStride, m_colStride};
+    }
+};
+
+#endif // BLOCKFACTORY_CORE_MATRIXVIEW_H
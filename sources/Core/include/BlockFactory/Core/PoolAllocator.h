@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_POOLALLOCATOR_H
+#define BLOCKFACTORY_CORE_POOLALLOCATOR_H
+
+#include "BlockFactory/Core/Allocator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace blockfactory {
+    namespace core {
+        class PoolAllocator;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Allocator that recycles the released memory in size classes
+ *
+ * The requests are rounded up to the next power of two between PoolAllocator::MinBlockSize and
+ * PoolAllocator::MaxBlockSize bytes. Every size class keeps a list of the released blocks, which
+ * serves the next requests of the same class without calling the heap. The requests larger than
+ * PoolAllocator::MaxBlockSize bytes, or with an alignment greater than
+ * Allocator::DefaultAlignment, are forwarded to the upstream allocator.
+ *
+ * The pool fits the signals that are created and destroyed at every step, for instance the copies
+ * of the inputs stored by a block to keep their history:
+ *
+ * @code{.cpp}
+ * PoolAllocator& pool = PoolAllocator::getThreadLocal();
+ * Signal history(Signal::DataFormat::CONTIGUOUS, Port::DataType::DOUBLE, &pool);
+ * @endcode
+ *
+ * The pool is not thread safe and does not lock. Use a pool per thread, e.g. the one returned by
+ * PoolAllocator::getThreadLocal, so that threads do not contend for memory.
+ *
+ * @warning The signals allocated from a pool must be destroyed by the thread that uses the pool,
+ *          and before the pool itself.
+ */
+class blockfactory::core::PoolAllocator final : public blockfactory::core::Allocator
+{
+public:
+    /// Size in bytes of the smallest size class
+    static constexpr size_t MinBlockSize = Allocator::DefaultAlignment;
+    /// Size in bytes of the largest size class
+    static constexpr size_t MaxBlockSize = 64 * 1024;
+    /// Number of size classes
+    static constexpr size_t NumberOfClasses = 11;
+
+    /// Counters of the operations of the pool
+    struct Statistics
+    {
+        /// Number of calls to PoolAllocator::allocate
+        uint64_t allocations = 0;
+        /// Number of calls to PoolAllocator::deallocate
+        uint64_t deallocations = 0;
+        /// Number of allocations served by recycled blocks
+        uint64_t hits = 0;
+        /// Number of allocations forwarded to the upstream allocator
+        uint64_t misses = 0;
+        /// Bytes currently allocated by the users of the pool, rounded to the size classes
+        size_t bytesInUse = 0;
+        /// Maximum value of Statistics::bytesInUse
+        size_t peakBytesInUse = 0;
+        /// Bytes of the released blocks kept by the pool
+        size_t bytesCached = 0;
+    };
+
+    /**
+     * @brief Function called at every allocation forwarded to the upstream allocator
+     *
+     * The argument is the size in bytes requested to the upstream allocator. Misses after the
+     * initialization usually mean that the pool was not reserved with enough blocks.
+     */
+    using MissCallback = std::function<void(size_t)>;
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    Allocator& m_upstream;
+    std::array<Block*, NumberOfClasses> m_freeLists = {};
+    Statistics m_statistics;
+    MissCallback m_missCallback;
+
+    static size_t getSizeClass(const size_t bytes);
+    static size_t getBlockSize(const size_t sizeClass);
+    bool isPooled(const size_t bytes, const size_t alignment) const;
+
+public:
+    /**
+     * @brief Create an empty pool
+     *
+     * @param upstream The allocator of the blocks of the pool and of the requests that cannot be
+     *        pooled.
+     */
+    explicit PoolAllocator(Allocator& upstream = Allocator::getDefault());
+    ~PoolAllocator() override;
+
+    PoolAllocator(const PoolAllocator& other) = delete;
+    PoolAllocator& operator=(const PoolAllocator& other) = delete;
+
+    void* allocate(const size_t bytes, const size_t alignment) override;
+    void deallocate(void* ptr, const size_t bytes, const size_t alignment) override;
+
+    /**
+     * @brief Get the pool of the calling thread
+     *
+     * The pool is created at the first call from every thread and destroyed when the thread exits.
+     *
+     * @return The pool of the calling thread.
+     */
+    static PoolAllocator& getThreadLocal();
+
+    /**
+     * @brief Fill the pool with released blocks
+     *
+     * Reserving the blocks during the initialization avoids calls to the heap during the
+     * simulation.
+     *
+     * @param bytes The size of the requests the blocks should serve.
+     * @param count The number of blocks to add.
+     * @return True if all the blocks were allocated, false otherwise.
+     */
+    bool reserve(const size_t bytes, const size_t count);
+
+    /**
+     * @brief Return the released blocks to the upstream allocator
+     *
+     * The memory still in use is not affected.
+     */
+    void trim();
+
+    /// Get the counters of the pool
+    const Statistics& getStatistics() const { return m_statistics; }
+
+    /// Reset the counters of the pool, except the counters of the bytes in use and cached
+    void resetStatistics();
+
+    /**
+     * @brief Set the function called at every allocation forwarded to the upstream allocator
+     *
+     * @param callback The function. Pass an empty function to remove the callback.
+     */
+    void setMissCallback(MissCallback callback);
+};
+
+#endif // BLOCKFACTORY_CORE_POOLALLOCATOR_H
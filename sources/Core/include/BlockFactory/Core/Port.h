@@ -24,7 +24,9 @@ namespace blockfactory {
  * Ports are virtual entities associated to blocks, and they provide the interface between a block
  * and a signal, carrying the required information.
  *
- * @note Currently only 1D and 2D ports are supported.
+ * @note Ports can have any number of dimensions. Vectors and matrices have dedicated accessors in
+ *       core::BlockInformation, while N-D ports are described by Port::Info::dimension and their
+ *       signals can be accessed with core::TensorView.
  * @note This class is just a placeholder of information. It might become a concrete class in the
  *       future.
  *
@@ -38,8 +40,8 @@ public:
     /// The 0-based index of a port
     using Index = size_t;
 
-    /// Specifies the dimensions of a port. Only 1D and 2D ports (and hence signals) are currently
-    /// supported
+    /// Specifies the dimensions of a port. The elements of signals with more than one dimension are
+    /// stored in column-major order, as in Simulink
     using Dimensions = std::vector<int>;
 
     /// @brief Identifier of a port with dynamic size
@@ -48,6 +50,9 @@ public:
     /// happen before the signal-size propagation by the engine.
     static const int DynamicSize = -1;
 
+    /// Identifier of an output port that is not computed in place
+    static const int NotInPlace = -1;
+
     /**
      * @brief Defines allowed port data types
      *
@@ -88,6 +93,29 @@ public:
         /// connected.
         /// @see Port::DataType
         DataType dataType;
+
+        /// @brief The number of consecutive samples carried by the signal of a port
+        ///
+        /// With a frame size greater than one, the signal of the port stores a frame of
+        /// samples, each one described by Port::Info::dimension, and the block processes the
+        /// whole frame in a single call. Frames are supported only by vector ports. They are
+        /// stored as a `frameSize x width` column-major matrix as in Simulink, i.e. the samples
+        /// of every element are contiguous. The element `i` of the sample `k` is at the index
+        /// `k + i * frameSize` of the signal.
+        int frameSize = 1;
+
+        /// @brief The index of the input port whose buffer can be shared by an output port
+        ///
+        /// Blocks such as gains and saturations can compute an output port in place, writing it
+        /// in the buffer of one of their input ports. The block must read every element of the
+        /// input before writing the same element of the output, and must not read the input
+        /// after writing the output. The input must not be read outside core::Block::output,
+        /// e.g. by core::Block::updateDiscreteState or core::Block::stateDerivative, hence the
+        /// Simulink engine never shares the buffers of blocks with states. The two ports must
+        /// have the same data type and number of elements. This is a hint: the engines can
+        /// still allocate a dedicated buffer, and the value is ignored for input ports. The
+        /// default Port::NotInPlace disables the sharing, and other negative values are invalid.
+        int inPlaceInput = NotInPlace;
     };
 
     /**
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_PROFILER_H
+#define BLOCKFACTORY_CORE_PROFILER_H
+
+#include "BlockFactory/Core/LatencyHistogram.h"
+#include "BlockFactory/Core/Tracer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace blockfactory {
+    namespace core {
+        class Block;
+        class BlockInformation;
+        class Profiler;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Class that measures the execution time of the blocks
+ *
+ * The profiler records how many times the callbacks of every block are called and the
+ * distribution of their execution times. It is used by the Simulink S-Function and by the code
+ * generated by Simulink Coder, which call the blocks through core::Profiler::call:
+ *
+ * @code{.cpp}
+ * ok = Profiler::call(block, blockInfo, Profiler::Callback::Output, &Block::output);
+ * @endcode
+ *
+ * The profiler is disabled by default, and when both the profiler and the core::Tracer are
+ * disabled it costs two relaxed atomic loads per call. It can be enabled with
+ * core::Profiler::setEnabled, or setting the `BLOCKFACTORY_PROFILE` environment variable before
+ * loading the library. If the variable is set, the report is written at the exit of the process
+ * to the file it contains, or to the standard error if its value is `1` or `stderr`.
+ *
+ * Samples are stored in core::LatencyHistogram objects owned by the thread that executes the
+ * block, hence blocks executed concurrently by different threads do not share any counter. The
+ * statistics of the threads are merged when they are read. When a block is terminated, the
+ * records of all the threads are merged with the statistics of the released blocks with the same
+ * name and released, so that a new block allocated at the same address starts from new records.
+ *
+ * Blocks are identified by their unique name (core::Block::getUniqueName).
+ *
+ * If the core::Tracer is enabled, the callbacks also record begin and end events named after
+ * the block, with the name of the callback as category.
+ */
+class blockfactory::core::Profiler
+{
+public:
+    /// The profiled callbacks of core::Block
+    enum class Callback
+    {
+        Initialize = 0,
+        Output,
+        UpdateDiscreteState,
+        StateDerivative,
+        Terminate,
+    };
+
+    /// The number of elements of core::Profiler::Callback
+    static const size_t NumberOfCallbacks = 5;
+
+    /**
+     * @brief Measure the execution time of a scope
+     *
+     * The time elapsed between the construction and the destruction of the object is recorded
+     * only if the profiler was enabled at construction.
+     */
+    class Scope
+    {
+    private:
+        const Block* m_block = nullptr;
+        LatencyHistogram* m_histogram = nullptr;
+        Callback m_callback;
+        bool m_trace = false;
+        uint32_t m_traceName = 0;
+        uint32_t m_traceCategory = 0;
+        std::chrono::steady_clock::time_point m_start;
+
+    public:
+        inline Scope(const Block* block, const BlockInformation* blockInfo, Callback callback);
+        inline ~Scope();
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+    };
+
+private:
+    static std::atomic<bool> m_enabled;
+
+    struct Entry
+    {
+        LatencyHistogram* histogram;
+        uint32_t traceName;
+        uint32_t traceCategory;
+    };
+
+    static Entry getEntry(const Block* block,
+                          const BlockInformation* blockInfo,
+                          const Callback callback);
+    static void releaseBlock(const Block* block);
+
+public:
+    /**
+     * @brief Check if the profiler is enabled
+     *
+     * @return True if the profiler records samples, false otherwise.
+     */
+    static inline bool isEnabled();
+
+    /**
+     * @brief Enable or disable the profiler
+     *
+     * @param enabled True to record samples, false otherwise.
+     */
+    static void setEnabled(const bool enabled);
+
+    /**
+     * @brief Call a callback of a block measuring its execution time
+     *
+     * @param block The block.
+     * @param blockInfo The pointer to a BlockInformation object.
+     * @param callback The profiled callback.
+     * @param method The method of core::Block to call, e.g. `&Block::output`.
+     * @return The value returned by the method.
+     */
+    template <typename Method, typename Info>
+    static bool call(Block* block, Info* blockInfo, const Callback callback, Method method);
+
+    /**
+     * @brief Get the name of a callback
+     *
+     * @param callback The callback.
+     * @return The name of the callback.
+     */
+    static std::string getCallbackName(const Callback callback);
+
+    /**
+     * @brief Get the number of calls of a block callback
+     *
+     * @param blockName The unique name of the block.
+     * @param callback The callback.
+     * @return The number of recorded calls of all the threads.
+     */
+    static uint64_t getCallCount(const std::string& blockName, const Callback callback);
+
+    /**
+     * @brief Get the execution times of a block callback
+     *
+     * @param blockName The unique name of the block.
+     * @param callback The callback.
+     * @param[out] histogram The histogram, in nanoseconds, where the samples of all the threads
+     *             are added.
+     * @return True if the block was profiled, false otherwise.
+     */
+    static bool getExecutionTimes(const std::string& blockName,
+                                  const Callback callback,
+                                  LatencyHistogram& histogram);
+
+    /**
+     * @brief Write a table with the statistics of all the profiled blocks
+     *
+     * The rows are sorted by decreasing total execution time.
+     *
+     * @param stream The output stream.
+     */
+    static void report(std::ostream& stream);
+
+    /**
+     * @brief Remove all the recorded samples
+     */
+    static void reset();
+};
+
+inline bool blockfactory::core::Profiler::isEnabled()
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+inline blockfactory::core::Profiler::Scope::Scope(const Block* block,
+                                                  const BlockInformation* blockInfo,
+                                                  Callback callback)
+    : m_callback(callback)
+{
+    const bool profile = isEnabled();
+    m_trace = Tracer::isEnabled();
+
+    if (!profile && !m_trace) {
+        return;
+    }
+
+    m_block = block;
+    const Entry entry = getEntry(block, blockInfo, callback);
+
+    if (m_trace) {
+        m_traceName = entry.traceName;
+        m_traceCategory = entry.traceCategory;
+        Tracer::record(m_traceName, m_traceCategory, Tracer::Phase::Begin);
+    }
+
+    if (profile) {
+        m_histogram = entry.histogram;
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+inline blockfactory::core::Profiler::Scope::~Scope()
+{
+    if (!m_block) {
+        return;
+    }
+
+    if (m_histogram) {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_histogram->record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    if (m_trace) {
+        Tracer::record(m_traceName, m_traceCategory, Tracer::Phase::End);
+    }
+
+    // The address of a terminated block can be reused by a new block
+    if (m_callback == Callback::Terminate) {
+        releaseBlock(m_block);
+    }
+}
+
+template <typename Method, typename Info>
+bool blockfactory::core::Profiler::call(Block* block,
+                                        Info* blockInfo,
+                                        const Callback callback,
+                                        Method method)
+{
+    const Scope scope(block, blockInfo, callback);
+    return (block->*method)(blockInfo);
+}
+
+#endif // BLOCKFACTORY_CORE_PROFILER_H
@@ -9,8 +9,12 @@
 #ifndef BLOCKFACTORY_CORE_SIGNAL_H
 #define BLOCKFACTORY_CORE_SIGNAL_H
 
+#include "BlockFactory/Core/Allocator.h"
 #include "BlockFactory/Core/Port.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace blockfactory {
@@ -83,8 +87,25 @@ public:
         CONTIGUOUS_ZEROCOPY = 2
     };
 
+    /**
+     * @brief Create a signal whose buffers are allocated from core::Allocator::getDefault
+     *
+     * @param dataFormat The format of the signal.
+     * @param dataType The type of the elements of the signal.
+     */
     Signal(const DataFormat& dataFormat = DataFormat::CONTIGUOUS_ZEROCOPY,
            const Port::DataType& dataType = Port::DataType::DOUBLE);
+
+    /**
+     * @brief Create a signal with a custom allocator
+     *
+     * @param dataFormat The format of the signal.
+     * @param dataType The type of the elements of the signal.
+     * @param allocator The allocator of the buffers owned by the signal. If `nullptr`, the
+     *        buffers are allocated from core::Allocator::getDefault. Copies of the signal use
+     *        the same allocator.
+     */
+    Signal(const DataFormat& dataFormat, const Port::DataType& dataType, Allocator* allocator);
     ~Signal();
 
     Signal(const Signal& other);
@@ -188,7 +209,7 @@ public:
      * @see core::Signal::setBuffer
      */
     template <typename T>
-    T* getBuffer();
+    inline T* getBuffer();
 
     /**
      * @brief Get the pointer to the buffer storing signal's data
@@ -196,7 +217,7 @@ public:
      * Documented in core::Signal::getBuffer
      */
     template <typename T>
-    const T* getBuffer() const;
+    inline const T* getBuffer() const;
 
     /**
      * @brief Get a single element of the signal
@@ -212,7 +233,7 @@ public:
      * @todo Switch to std::optional as soon as we switch to C++17
      */
     template <typename T>
-    T get(const size_t i) const;
+    inline T get(const size_t i) const;
 
     /**
      * @brief Set the value of a sigle element of the buffer
@@ -240,7 +261,26 @@ public:
      * @return True if the buffer was set sucessfully, false otherwise.
      */
     template <typename T>
-    bool setBuffer(const T* data, const size_t length);
+    inline bool setBuffer(const T* data, const size_t length);
+
+    /**
+     * @brief Check if the buffer of the signal is aligned
+     *
+     * The buffers owned by DataFormat::CONTIGUOUS and DataFormat::NONCONTIGUOUS signals are
+     * always aligned to core::Allocator::DefaultAlignment bytes. The alignment of
+     * DataFormat::CONTIGUOUS_ZEROCOPY signals depends on the memory of the engine.
+     *
+     * @param alignment The alignment in bytes. It must be a power of two.
+     * @return True if the signal is valid and its buffer is aligned, false otherwise.
+     */
+    inline bool isAligned(const size_t alignment) const;
+
+    /**
+     * @brief Get the allocator of the buffers owned by the signal
+     *
+     * @return The allocator of the signal.
+     */
+    Allocator& getAllocator() const;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 private:
@@ -248,21 +288,112 @@ private:
     const Port::DataType m_portDataType;
     const DataFormat m_dataFormat;
     void* m_bufferPtr = nullptr;
+    Allocator* m_allocator = nullptr;
 
     template <typename T>
-    T* getBufferImpl() const;
+    inline T* getBufferImpl() const;
+    template <typename T>
+    bool setBufferImpl(const T* data, const size_t length);
+
+    // The port data type of the buffer elements of type T
+    static constexpr Port::DataType getDataType(const double*) { return Port::DataType::DOUBLE; }
+    static constexpr Port::DataType getDataType(const float*) { return Port::DataType::SINGLE; }
+    static constexpr Port::DataType getDataType(const int8_t*) { return Port::DataType::INT8; }
+    static constexpr Port::DataType getDataType(const uint8_t*) { return Port::DataType::UINT8; }
+    static constexpr Port::DataType getDataType(const int16_t*) { return Port::DataType::INT16; }
+    static constexpr Port::DataType getDataType(const uint16_t*) { return Port::DataType::UINT16; }
+    static constexpr Port::DataType getDataType(const int32_t*) { return Port::DataType::INT32; }
+    static constexpr Port::DataType getDataType(const uint32_t*) { return Port::DataType::UINT32; }
+    static constexpr Port::DataType getDataType(const bool*) { return Port::DataType::BOOLEAN; }
+
+    // The errors are reported out of line, so that the accessors can be inlined
+    static void reportError(const char* message);
 
     void deleteBuffer();
     void allocateBuffer(const void* const bufferInput, void*& bufferOutput, size_t length);
 #endif
 };
 
+// Template definitions
+// ====================
+
+// The accessors are defined in the header so that they can be inlined in the loops of the blocks.
+// Only the error handling is implemented in the library.
+
+template <typename T>
+inline T* blockfactory::core::Signal::getBufferImpl() const
+{
+    // Check the returned matches the same type of the portType.
+    // If this is not met, applying pointer arithmetics on the returned
+    // pointer would show unknown behaviour.
+    if (!m_bufferPtr || m_portDataType != getDataType(static_cast<const T*>(nullptr))) {
+        reportError(m_bufferPtr
+                        ? "Trying to get the buffer using a type different than its DataType"
+                        : "The pointer to data is null. The signal was not configured properly.");
+        return nullptr;
+    }
+
+    // Cast pointer and return it
+    return static_cast<T*>(m_bufferPtr);
+}
+
+template <typename T>
+inline T* blockfactory::core::Signal::getBuffer()
+{
+    return getBufferImpl<T>();
+}
+
+template <typename T>
+inline const T* blockfactory::core::Signal::getBuffer() const
+{
+    return getBufferImpl<T>();
+}
+
+template <typename T>
+inline T blockfactory::core::Signal::get(const size_t i) const
+{
+    const T* buffer = getBuffer<T>();
+
+    if (!buffer) {
+        reportError("The buffer inside the signal has not been initialized properly.");
+        return {};
+    }
+
+    if (i >= m_width) {
+        reportError("Trying to access an element that exceeds signal width.");
+        return {};
+    }
+
+    return buffer[i];
+}
+
+template <typename T>
+inline bool blockfactory::core::Signal::setBuffer(const T* data, const size_t length)
+{
+    // If the width does not change, the data is copied in the existing buffer
+    if (length == m_width && m_bufferPtr && m_dataFormat != DataFormat::NONCONTIGUOUS
+        && m_portDataType == getDataType(data)) {
+        std::copy(data, data + length, static_cast<T*>(m_bufferPtr));
+        return true;
+    }
+
+    return setBufferImpl(data, length);
+}
+
+inline bool blockfactory::core::Signal::isAligned(const size_t alignment) const
+{
+    return isValid() && Allocator::isAligned(m_bufferPtr, alignment);
+}
+
 // Explicit declaration of templates for all the supported types
 // =============================================================
 
 // TODO: for the time being, only DOUBLE is allowed. The toolbox has an almost complete support to
 //       many other data types, but they need to be tested.
 
+// The explicit instantiations are still part of the library, so that the binaries compiled with
+// the previous versions of this header find their symbols.
+
 namespace blockfactory {
     namespace core {
         // DataType::DOUBLE
@@ -270,6 +401,8 @@ namespace blockfactory {
         extern template const double* Signal::getBuffer<double>() const;
         extern template double Signal::get<double>(const size_t i) const;
         extern template bool Signal::setBuffer<double>(const double* data, const size_t length);
+        extern template bool Signal::setBufferImpl<double>(const double* data,
+                                                           const size_t length);
     } // namespace core
 } // namespace blockfactory
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_SIGNALHISTORY_H
+#define BLOCKFACTORY_CORE_SIGNALHISTORY_H
+
+#include "BlockFactory/Core/Allocator.h"
+#include "BlockFactory/Core/MatrixView.h"
+#include "BlockFactory/Core/Span.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace blockfactory {
+    namespace core {
+        class Signal;
+        class SignalHistory;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Ring buffer storing the past samples of a signal
+ *
+ * The history is the delay line of filters and estimators. It stores the last
+ * SignalHistory::getCapacity samples of a signal with a fixed width, and gives access to the
+ * samples and to windows of consecutive samples without copying them.
+ *
+ * The capacity is rounded up to a power of two, so that the samples are indexed with a mask.
+ * The first `maxWindow - 1` slots of the buffer are mirrored after its end, hence every window
+ * of up to `maxWindow` samples is contiguous in memory. Pushing a sample copies it with a single
+ * `memcpy`, and with a second one only when it is written in one of the mirrored slots.
+ *
+ * @code{.cpp}
+ * // In Block::initialize
+ * m_history.reset(new SignalHistory(width, 8));
+ * // In Block::output
+ * m_history->push(*blockInfo->getInputPortSignal(0));
+ * const MatrixView<const double> window = m_history->window(4);
+ * @endcode
+ *
+ * @note The buffer is allocated at construction, and no method allocates afterwards.
+ */
+class blockfactory::core::SignalHistory
+{
+private:
+    Allocator& m_allocator;
+    double* m_buffer = nullptr;
+    size_t m_width = 0;
+    size_t m_capacity = 0;
+    size_t m_maxWindow = 0;
+    size_t m_head = 0;
+    size_t m_size = 0;
+
+    size_t getNumberOfSlots() const { return m_capacity + m_maxWindow - 1; }
+
+public:
+    /**
+     * @brief Create an empty history
+     *
+     * @param width The number of elements of every sample.
+     * @param capacity The number of past samples to store. It is rounded up to a power of two.
+     * @param maxWindow The maximum number of samples of the windows. It is limited to the
+     *        capacity, which is also its default value. Smaller values reduce the mirrored slots.
+     * @param allocator The allocator of the buffer. If `nullptr`, the buffer is allocated from
+     *        core::Allocator::getDefault.
+     */
+    SignalHistory(const size_t width,
+                  const size_t capacity,
+                  const size_t maxWindow = 0,
+                  Allocator* allocator = nullptr);
+    ~SignalHistory();
+
+    SignalHistory(const SignalHistory& other) = delete;
+    SignalHistory& operator=(const SignalHistory& other) = delete;
+
+    /// Check if the buffer of the history was allocated
+    bool isValid() const { return m_buffer != nullptr; }
+
+    /// Get the number of elements of every sample
+    size_t getWidth() const { return m_width; }
+
+    /// Get the maximum number of samples stored in the history
+    size_t getCapacity() const { return m_capacity; }
+
+    /// Get the maximum number of samples of the windows
+    size_t getMaxWindow() const { return m_maxWindow; }
+
+    /// Get the number of samples stored in the history
+    size_t size() const { return m_size; }
+
+    /// Check if the history has no samples
+    bool empty() const { return m_size == 0; }
+
+    /// Remove all the samples
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Add a sample to the history
+     *
+     * When the history is full, the oldest sample is overwritten.
+     *
+     * @param sample The pointer to the SignalHistory::getWidth elements of the sample.
+     */
+    void push(const double* sample)
+    {
+        assert(isValid());
+        const size_t bytes = m_width * sizeof(double);
+        double* slot = m_buffer + m_head * m_width;
+
+        std::memcpy(slot, sample, bytes);
+        if (m_head + 1 < m_maxWindow) {
+            std::memcpy(slot + m_capacity * m_width, sample, bytes);
+        }
+
+        m_head = (m_head + 1) & (m_capacity - 1);
+        m_size += m_size < m_capacity ? 1 : 0;
+    }
+
+    /**
+     * @brief Add the current sample of a signal to the history
+     *
+     * @param signal The signal. Its width must match the width of the history.
+     * @return True for success, false if the signal is not valid or its width does not match.
+     */
+    bool push(const Signal& signal);
+
+    /**
+     * @brief Get a past sample
+     *
+     * @param age The age of the sample, 0 for the last pushed sample. It must be lower than
+     *        SignalHistory::size.
+     * @return The view of the elements of the sample.
+     */
+    Span<const double> sample(const size_t age) const
+    {
+        assert(age < m_size);
+        const size_t slot = (m_head - 1 - age) & (m_capacity - 1);
+        return {m_buffer + slot * m_width, m_width};
+    }
+
+    /**
+     * @brief Get the window of the last samples
+     *
+     * The samples are the columns of the returned matrix, ordered from the oldest to the last
+     * pushed one. The columns are contiguous, hence the view can be passed directly to the
+     * matrix kernels, e.g. to compute a FIR filter as a matrix-vector product with
+     * core::Kernels::gemv.
+     *
+     * @param length The number of samples of the window.
+     * @return The `width x length` view of the window, or an empty view if the history stores
+     *         less samples or the length exceeds the maximum window.
+     */
+    MatrixView<const double> window(const size_t length) const
+    {
+        if (length == 0 || length > m_size || length > m_maxWindow) {
+            return {};
+        }
+
+        const size_t slot = (m_head - length) & (m_capacity - 1);
+        return {m_buffer + slot * m_width, m_width, length};
+    }
+};
+
+#endif // BLOCKFACTORY_CORE_SIGNALHISTORY_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_SPAN_H
+#define BLOCKFACTORY_CORE_SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+
+namespace blockfactory {
+    namespace core {
+        template <typename T>
+        class Span;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Non-owning view of a contiguous sequence of elements
+ *
+ * This class is a minimal replacement of C++20 `std::span`. It stores only the pointer to the
+ * first element and the number of elements, and it is meant to be passed by value. The memory
+ * must outlive the span.
+ *
+ * @tparam T The type of the elements. Use a const type for read-only views.
+ */
+template <typename T>
+class blockfactory::core::Span
+{
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    using element_type = T;
+    using iterator = T*;
+
+    Span() = default;
+
+    /**
+     * @brief Create a span over a buffer
+     *
+     * @param data The pointer to the first element.
+     * @param size The number of elements.
+     */
+    Span(T* data, const size_t size)
+        : m_data(data)
+        , m_size(size)
+    {}
+
+    /**
+     * @brief Create a span over a C array
+     *
+     * @param array The array.
+     */
+    template <size_t N>
+    Span(T (&array)[N])
+        : m_data(array)
+        , m_size(N)
+    {}
+
+    /**
+     * @brief Create a read-only span from a mutable one
+     *
+     * @param other The span over elements of type `U`, convertible to `T`.
+     */
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    Span(const Span<U>& other)
+        : m_data(other.data())
+        , m_size(other.size())
+    {}
+
+    T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    T& operator[](const size_t index) const { return m_data[index]; }
+
+    iterator begin() const { return m_data; }
+    iterator end() const { return m_data + m_size; }
+};
+
+#endif // BLOCKFACTORY_CORE_SPAN_H
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_TENSORVIEW_H
+#define BLOCKFACTORY_CORE_TENSORVIEW_H
+
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/MatrixView.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+namespace blockfactory {
+    namespace core {
+        template <typename T>
+        class TensorView;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Non-owning N-D view of a buffer with explicit strides
+ *
+ * The view generalizes core::MatrixView to signals with any number of dimensions, e.g. images or
+ * point clouds. The element at `(i0, i1, ..., iN)` is stored at
+ * `data()[i0 * stride(0) + i1 * stride(1) + ... + iN * stride(N)]`. The dimensions and the strides
+ * are stored in the view, hence creating, slicing and permuting views never allocates.
+ *
+ * @code{.cpp}
+ * const Port::Info info = blockInfo->getInputPortInfo(0);
+ * InputSignalPtr input = blockInfo->getInputPortSignal(0);
+ * auto image = TensorView<const double>::fromSignal(*input, info.dimension);
+ * const double red = image(row, col, 0);
+ * @endcode
+ *
+ * @tparam T The type of the elements. Use a const type for read-only views.
+ */
+template <typename T>
+class blockfactory::core::TensorView
+{
+public:
+    /// The maximum number of dimensions of a view
+    static constexpr size_t MaxRank = 8;
+
+private:
+    T* m_data = nullptr;
+    size_t m_rank = 0;
+    std::array<size_t, MaxRank> m_dims = {};
+    std::array<size_t, MaxRank> m_strides = {};
+
+    using Element = typename std::remove_const<T>::type;
+    using SignalType =
+        typename std::conditional<std::is_const<T>::value, const Signal, Signal>::type;
+
+    template <typename Iterator>
+    void initialize(Iterator begin, Iterator end, const MatrixLayout layout)
+    {
+        const size_t rank = static_cast<size_t>(end - begin);
+        if (rank > MaxRank) {
+            bfError << "Views with more than " << MaxRank << " dimensions are not supported.";
+            m_data = nullptr;
+            return;
+        }
+
+        m_rank = rank;
+        for (size_t axis = 0; axis < rank; ++axis) {
+            m_dims[axis] = static_cast<size_t>(begin[axis]);
+        }
+
+        // The first dimension is the fastest in column major order, the last in row major order
+        size_t stride = 1;
+        for (size_t i = 0; i < rank; ++i) {
+            const size_t axis = layout == MatrixLayout::ColumnMajor ? i : rank - 1 - i;
+            m_strides[axis] = stride;
+            stride *= m_dims[axis];
+        }
+    }
+
+    template <typename... Indices>
+    size_t offset(const size_t axis, const size_t index, const Indices... indices) const
+    {
+        return index * m_strides[axis] + offset(axis + 1, static_cast<size_t>(indices)...);
+    }
+
+    size_t offset(const size_t /*axis*/) const { return 0; }
+
+public:
+    TensorView() = default;
+
+    /**
+     * @brief Create a view over a contiguous buffer
+     *
+     * @param data The pointer to the first element.
+     * @param dims The dimensions.
+     * @param layout The order of the elements in the buffer. Column major is the order of
+     *        Simulink.
+     */
+    TensorView(T* data,
+               std::initializer_list<size_t> dims,
+               const MatrixLayout layout = MatrixLayout::ColumnMajor)
+        : m_data(data)
+    {
+        initialize(dims.begin(), dims.end(), layout);
+    }
+
+    /**
+     * @brief Create a view with explicit strides
+     *
+     * @param data The pointer to the first element.
+     * @param dims The dimensions.
+     * @param strides The distance in elements between consecutive indices of every dimension.
+     */
+    TensorView(T* data, std::initializer_list<size_t> dims, std::initializer_list<size_t> strides)
+        : m_data(data)
+    {
+        if (dims.size() != strides.size()) {
+            bfError << "The number of strides does not match the number of dimensions.";
+            m_data = nullptr;
+            return;
+        }
+
+        initialize(dims.begin(), dims.end(), MatrixLayout::ColumnMajor);
+        for (size_t axis = 0; axis < m_rank; ++axis) {
+            m_strides[axis] = strides.begin()[axis];
+        }
+    }
+
+    /**
+     * @brief Create a read-only view from a mutable one
+     *
+     * @param other The view over elements of type `U`, convertible to `T`.
+     */
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    TensorView(const TensorView<U>& other)
+        : m_data(other.data())
+        , m_rank(other.rank())
+    {
+        for (size_t axis = 0; axis < m_rank; ++axis) {
+            m_dims[axis] = other.dim(axis);
+            m_strides[axis] = other.stride(axis);
+        }
+    }
+
+    /**
+     * @brief Create a view over the buffer of a signal
+     *
+     * The signal must be contiguous and its width must match the number of elements.
+     *
+     * @param signal The signal. Its data type must match `T`.
+     * @param dims The dimensions of the port, e.g. from core::BlockInformation::getInputPortInfo.
+     * @param layout The order of the elements in the signal.
+     * @return The view, or an empty view if the signal does not match the dimensions.
+     */
+    static TensorView fromSignal(SignalType& signal,
+                                 const Port::Dimensions& dims,
+                                 const MatrixLayout layout = MatrixLayout::ColumnMajor)
+    {
+        size_t numberOfElements = 1;
+        for (const int dim : dims) {
+            if (dim < 0) {
+                bfError << "Views of dynamically sized signals are not supported.";
+                return {};
+            }
+            numberOfElements *= static_cast<size_t>(dim);
+        }
+
+        if (signal.getWidth() != numberOfElements) {
+            bfError << "The width of the signal does not match the dimensions of the port.";
+            return {};
+        }
+
+        TensorView view;
+        view.m_data = signal.template getBuffer<Element>();
+        view.initialize(dims.begin(), dims.end(), layout);
+        return view.m_data ? view : TensorView();
+    }
+
+    T* data() const { return m_data; }
+    size_t rank() const { return m_rank; }
+    size_t dim(const size_t axis) const { return m_dims[axis]; }
+    size_t stride(const size_t axis) const { return m_strides[axis]; }
+    bool empty() const { return size() == 0; }
+
+    /// Get the number of elements of the view
+    size_t size() const
+    {
+        if (!m_data || m_rank == 0) {
+            return 0;
+        }
+
+        size_t size = 1;
+        for (size_t axis = 0; axis < m_rank; ++axis) {
+            size *= m_dims[axis];
+        }
+        return size;
+    }
+
+    /**
+     * @brief Access an element
+     *
+     * @param indices The index of every dimension.
+     * @return The reference to the element.
+     */
+    template <typename... Indices>
+    T& operator()(const Indices... indices) const
+    {
+        assert(sizeof...(Indices) == m_rank);
+        return m_data[offset(0, static_cast<size_t>(indices)...)];
+    }
+
+    /**
+     * @brief Get the view with one dimension less, fixing the index of a dimension
+     *
+     * For example, `image.slice(2, 0)` is the first channel of a `rows x cols x channels` image.
+     *
+     * @param axis The dimension to fix.
+     * @param index The index of the dimension.
+     * @return The view of the slice.
+     */
+    TensorView slice(const size_t axis, const size_t index) const
+    {
+        assert(axis < m_rank && index < m_dims[axis]);
+
+        TensorView view;
+        view.m_data = m_data + index * m_strides[axis];
+        for (size_t i = 0; i < m_rank; ++i) {
+            if (i != axis) {
+                view.m_dims[view.m_rank] = m_dims[i];
+                view.m_strides[view.m_rank] = m_strides[i];
+                ++view.m_rank;
+            }
+        }
+        return view;
+    }
+
+    /**
+     * @brief Get the view with reordered dimensions
+     *
+     * @param axes The dimensions of this view in the new order, e.g. `{1, 0}` transposes a matrix.
+     * @return The permuted view, or an empty view if the axes are not a permutation.
+     */
+    TensorView permute(std::initializer_list<size_t> axes) const
+    {
+        if (axes.size() != m_rank) {
+            bfError << "The number of axes does not match the number of dimensions.";
+            return {};
+        }
+
+        TensorView view;
+        view.m_data = m_data;
+        view.m_rank = m_rank;
+
+        std::array<bool, MaxRank> used = {};
+        for (size_t i = 0; i < m_rank; ++i) {
+            const size_t axis = axes.begin()[i];
+            if (axis >= m_rank || used[axis]) {
+                bfError << "The axes are not a permutation of the dimensions.";
+                return {};
+            }
+            used[axis] = true;
+            view.m_dims[i] = m_dims[axis];
+            view.m_strides[i] = m_strides[axis];
+        }
+        return view;
+    }
+
+    /**
+     * @brief Get the matrix view of a view with two dimensions
+     *
+     * @return The matrix view, or an empty view if the view has a different number of dimensions.
+     */
+    MatrixView<T> matrix() const
+    {
+        if (m_rank != 2) {
+            bfError << "Only views with two dimensions can be converted to matrices.";
+            return {};
+        }
+        return {m_data, m_dims[0], m_dims[1], m_strides[0], m_strides[1]};
+    }
+};
+
+template <typename T>
+constexpr size_t blockfactory::core::TensorView<T>::MaxRank;
+
+#endif // BLOCKFACTORY_CORE_TENSORVIEW_H
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CORE_TRACER_H
+#define BLOCKFACTORY_CORE_TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace blockfactory {
+    namespace core {
+        class Tracer;
+    } // namespace core
+} // namespace blockfactory
+
+/**
+ * @brief Class that records the timeline of the execution
+ *
+ * The tracer stores begin and end events in a buffer allocated by core::Tracer::start. Recording
+ * an event takes a timestamp and a few atomic operations, and never allocates memory or takes
+ * locks. When the buffer is full the new events are dropped and counted.
+ *
+ * The core::Profiler records an event for every callback of every block, and
+ * coder::GeneratedCodeWrapper for every step of the model. The buffer can be exported in the
+ * Chrome trace JSON format, which can be opened with `chrome://tracing` or with the Perfetto UI
+ * (https://ui.perfetto.dev) to inspect the timeline of every thread.
+ *
+ * The tracer is disabled by default. It can be enabled with core::Tracer::start, or setting the
+ * `BLOCKFACTORY_TRACE` environment variable to the path of the JSON file before loading the
+ * library. In this case the trace is written by core::Tracer::flush, which is called by
+ * coder::GeneratedCodeWrapper::terminate and at the exit of the process.
+ *
+ * @note Events are identified by a name and a category, interned with
+ *       core::Tracer::registerName.
+ * @note Events can be read and exported while other threads are recording. Events that are still
+ *       being written are skipped. core::Tracer::start waits for the threads that are writing an
+ *       event before replacing the buffer, and events recorded after core::Tracer::stop are
+ *       dropped.
+ */
+class blockfactory::core::Tracer
+{
+public:
+    /// Default number of events stored in the buffer
+    static const size_t DefaultCapacity = 1 << 20;
+
+    /// The type of the events
+    enum class Phase : uint8_t
+    {
+        Begin = 0,
+        End,
+    };
+
+    /// A recorded event
+    struct Event
+    {
+        /// Nanoseconds since core::Tracer::start
+        uint64_t timestamp;
+        /// The name registered with core::Tracer::registerName
+        uint32_t name;
+        /// The category registered with core::Tracer::registerName
+        uint32_t category;
+        /// The index of the thread in order of recording
+        uint32_t thread;
+        Phase phase;
+    };
+
+    /**
+     * @brief Record the begin and end events of a scope
+     *
+     * The events are recorded only if the tracer was enabled at construction.
+     */
+    class Scope
+    {
+    private:
+        uint32_t m_name;
+        uint32_t m_category;
+        bool m_active;
+
+    public:
+        inline Scope(const uint32_t name, const uint32_t category);
+        inline ~Scope();
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+    };
+
+private:
+    static std::atomic<bool> m_enabled;
+
+public:
+    /**
+     * @brief Check if the tracer is enabled
+     *
+     * @return True if the tracer records events, false otherwise.
+     */
+    static inline bool isEnabled();
+
+    /**
+     * @brief Allocate the buffer and start recording
+     *
+     * The events previously recorded are removed.
+     *
+     * @param capacity The maximum number of events.
+     * @return True for success, false if the tracer is already enabled or the capacity is 0.
+     */
+    static bool start(const size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Stop recording
+     *
+     * The recorded events are kept until the next core::Tracer::start.
+     */
+    static void stop();
+
+    /**
+     * @brief Get the identifier of a name or a category
+     *
+     * Registering the same string twice returns the same identifier. This method takes a lock,
+     * and it should be called during the initialization.
+     *
+     * @param name The string.
+     * @return The identifier of the string.
+     */
+    static uint32_t registerName(const std::string& name);
+
+    /**
+     * @brief Get the string of a registered identifier
+     *
+     * @param id The identifier returned by core::Tracer::registerName.
+     * @return The string, or an empty string if the identifier does not exist.
+     */
+    static std::string getName(const uint32_t id);
+
+    /**
+     * @brief Record an event of the calling thread
+     *
+     * @param name The identifier of the name of the event.
+     * @param category The identifier of the category of the event.
+     * @param phase The type of the event.
+     */
+    static void record(const uint32_t name, const uint32_t category, const Phase phase);
+
+    /**
+     * @brief Get the number of recorded events
+     *
+     * The count includes the events that other threads are still writing, which are not returned
+     * by core::Tracer::getEvent.
+     *
+     * @return The number of slots of the buffer reserved by the recorded events.
+     */
+    static size_t getNumberOfEvents();
+
+    /**
+     * @brief Get the number of events dropped because the buffer was full
+     *
+     * @return The number of dropped events.
+     */
+    static uint64_t getNumberOfDroppedEvents();
+
+    /**
+     * @brief Get a recorded event
+     *
+     * @param index The index of the event, in recording order.
+     * @param[out] event The event.
+     * @return True for success, false if the event does not exist or is still being written.
+     */
+    static bool getEvent(const size_t index, Event& event);
+
+    /**
+     * @brief Export the recorded events in the Chrome trace JSON format
+     *
+     * @param stream The output stream.
+     */
+    static void writeChromeTrace(std::ostream& stream);
+
+    /**
+     * @brief Export the recorded events in the Chrome trace JSON format
+     *
+     * @param path The path of the file.
+     * @return True for success, false otherwise.
+     */
+    static bool writeChromeTrace(const std::string& path);
+
+    /**
+     * @brief Write the trace to the file specified by the `BLOCKFACTORY_TRACE` variable
+     *
+     * @return True for success or if the variable is not set, false otherwise.
+     */
+    static bool flush();
+};
+
+inline bool blockfactory::core::Tracer::isEnabled()
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+inline blockfactory::core::Tracer::Scope::Scope(const uint32_t name, const uint32_t category)
+    : m_name(name)
+    , m_category(category)
+    , m_active(isEnabled())
+{
+    if (m_active) {
+        record(m_name, m_category, Phase::Begin);
+    }
+}
+
+inline blockfactory::core::Tracer::Scope::~Scope()
+{
+    if (m_active) {
+        record(m_name, m_category, Phase::End);
+    }
+}
+
+#endif // BLOCKFACTORY_CORE_TRACER_H
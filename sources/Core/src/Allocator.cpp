@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+using namespace blockfactory::core;
+
+constexpr size_t Allocator::DefaultAlignment;
+
+namespace {
+    class HeapAllocator final : public Allocator
+    {
+    public:
+        void* allocate(const size_t bytes, const size_t alignment) override
+        {
+            // The alignment of posix_memalign must also be a multiple of sizeof(void*)
+            const size_t actualAlignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+            const size_t actualBytes = bytes > 0 ? bytes : 1;
+#if defined(_WIN32)
+            return _aligned_malloc(actualBytes, actualAlignment);
+#else
+            void* ptr = nullptr;
+            if (posix_memalign(&ptr, actualAlignment, actualBytes) != 0) {
+                return nullptr;
+            }
+            return ptr;
+#endif
+        }
+
+        void deallocate(void* ptr, const size_t /*bytes*/, const size_t /*alignment*/) override
+        {
+#if defined(_WIN32)
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+    };
+} // namespace
+
+Allocator& Allocator::getDefault()
+{
+    static HeapAllocator allocator;
+    return allocator;
+}
+
+// ===============
+// ARENA ALLOCATOR
+// ===============
+
+ArenaAllocator::ArenaAllocator(const size_t capacity, Allocator& upstream)
+    : m_upstream(upstream)
+{
+    m_begin = static_cast<char*>(m_upstream.allocate(capacity, DefaultAlignment));
+    m_capacity = m_begin ? capacity : 0;
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    m_upstream.deallocate(m_begin, m_capacity, DefaultAlignment);
+}
+
+void* ArenaAllocator::allocate(const size_t bytes, const size_t alignment)
+{
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(m_begin);
+    const uintptr_t current = begin + m_used;
+    const uintptr_t aligned = (current + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    const size_t padding = static_cast<size_t>(aligned - current);
+
+    if (!m_begin || padding + bytes > m_capacity - m_used) {
+        return m_upstream.allocate(bytes, alignment);
+    }
+
+    m_used += padding + bytes;
+    return m_begin + (aligned - begin);
+}
+
+void ArenaAllocator::deallocate(void* ptr, const size_t bytes, const size_t alignment)
+{
+    // The memory of the arena is released only by reset
+    if (ptr && !owns(ptr)) {
+        m_upstream.deallocate(ptr, bytes, alignment);
+    }
+}
+
+void ArenaAllocator::reset()
+{
+    m_used = 0;
+}
+
+bool ArenaAllocator::owns(const void* ptr) const
+{
+    // Pointers to different arrays cannot be compared with the built-in operators
+    const std::less_equal<const void*> lessEqual;
+    return m_begin && lessEqual(m_begin, ptr) && !lessEqual(m_begin + m_capacity, ptr);
+}
@@ -15,6 +15,8 @@
 
 using namespace blockfactory::core;
 
+constexpr double Block::InheritedSampleTime;
+
 std::string Block::getUniqueName(const BlockInformation* blockInfo) const
 {
     std::string blockUniqueName;
@@ -78,6 +80,11 @@ unsigned Block::numberOfContinuousStates()
     return 0;
 }
 
+Block::SampleTime Block::sampleTime()
+{
+    return {Block::InheritedSampleTime, 0.0};
+}
+
 bool Block::updateDiscreteState(const BlockInformation* /*blockInfo*/)
 {
     return true;
@@ -98,6 +105,27 @@ bool Block::terminate(const BlockInformation* /*blockInfo*/)
     return true;
 }
 
+bool Block::isPure()
+{
+    return false;
+}
+
+bool Block::getElementwiseKernel(ElementwiseKernel& /*kernel*/)
+{
+    return false;
+}
+
+bool Block::supportsBatchedOutput()
+{
+    return false;
+}
+
+bool Block::outputBatched(const BlockInformation* /*blockInfo*/, const size_t /*batchSize*/)
+{
+    bfError << "The block does not implement the batched output.";
+    return false;
+}
+
 bool Block::getParameters(blockfactory::core::Parameters& params) const
 {
     params = m_parameters;
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Log.h"
+
+#include <ostream>
+
+using namespace blockfactory::core;
+
+OutputSignalPtr BlockInformation::getContinuousStateSignal() const
+{
+    bfError << "This BlockInformation implementation does not support continuous states.";
+    return {};
+}
+
+OutputSignalPtr BlockInformation::getContinuousStateDerivativeSignal() const
+{
+    bfError << "This BlockInformation implementation does not support continuous states.";
+    return {};
+}
+
+OutputSignalPtr BlockInformation::getDiscreteStateSignal() const
+{
+    bfError << "This BlockInformation implementation does not support discrete states.";
+    return {};
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/ElementwiseKernel.h"
+#include "BlockFactory/Core/Kernels.h"
+
+using namespace blockfactory::core;
+
+size_t ElementwiseKernel::getNumberOfInputs(const Operation operation)
+{
+    switch (operation) {
+        case Operation::ADDITION:
+        case Operation::SUBTRACTION:
+        case Operation::MULTIPLICATION:
+            return 2;
+        case Operation::SCALE:
+        case Operation::CLAMP:
+            return 1;
+    }
+    return 0;
+}
+
+bool ElementwiseKernel::apply(Span<const double> u0, Span<const double> u1, Span<double> y) const
+{
+    switch (operation) {
+        case Operation::ADDITION:
+            return Kernels::add(u0, u1, y);
+        case Operation::SUBTRACTION:
+            return Kernels::subtract(u0, u1, y);
+        case Operation::MULTIPLICATION:
+            return Kernels::multiply(u0, u1, y);
+        case Operation::SCALE:
+            return Kernels::scale(u0, alpha, y);
+        case Operation::CLAMP:
+            return Kernels::clamp(u0, lower, upper, y);
+    }
+    return false;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/InputChangeDetector.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace blockfactory::core;
+
+namespace {
+    template <typename T>
+    const void* getData(const Signal& signal, size_t& bytes)
+    {
+        bytes = signal.getWidth() * sizeof(T);
+        return signal.getBuffer<T>();
+    }
+
+    const void* getData(const Signal& signal, size_t& bytes)
+    {
+        switch (signal.getPortDataType()) {
+            case Port::DataType::DOUBLE:
+                return getData<double>(signal, bytes);
+            case Port::DataType::SINGLE:
+                return getData<float>(signal, bytes);
+            case Port::DataType::INT8:
+                return getData<int8_t>(signal, bytes);
+            case Port::DataType::UINT8:
+                return getData<uint8_t>(signal, bytes);
+            case Port::DataType::INT16:
+                return getData<int16_t>(signal, bytes);
+            case Port::DataType::UINT16:
+                return getData<uint16_t>(signal, bytes);
+            case Port::DataType::INT32:
+                return getData<int32_t>(signal, bytes);
+            case Port::DataType::UINT32:
+                return getData<uint32_t>(signal, bytes);
+            case Port::DataType::BOOLEAN:
+                return getData<bool>(signal, bytes);
+        }
+        return nullptr;
+    }
+} // namespace
+
+bool InputChangeDetector::update(const BlockInformation* blockInfo,
+                                 const size_t numberOfInputPorts)
+{
+    bool changed = !m_valid;
+
+    // Keep the layout of the copy if the number and the size of the inputs did not change
+    if (m_offsets.size() != numberOfInputPorts + 1) {
+        m_offsets.assign(numberOfInputPorts + 1, 0);
+        changed = true;
+    }
+
+    for (size_t port = 0; port < numberOfInputPorts; ++port) {
+        const auto signal = blockInfo->getInputPortSignal(port);
+
+        size_t bytes = 0;
+        const void* data = signal ? getData(*signal, bytes) : nullptr;
+
+        if (!data) {
+            // The content of the signal cannot be compared, hence the output is always computed
+            m_valid = false;
+            ++m_numberOfChanges;
+            return true;
+        }
+
+        const size_t offset = m_offsets[port];
+        if (m_offsets[port + 1] != offset + bytes) {
+            m_offsets[port + 1] = offset + bytes;
+            if (m_snapshot.size() < offset + bytes) {
+                m_snapshot.resize(offset + bytes);
+            }
+            changed = true;
+        }
+
+        unsigned char* previous = m_snapshot.data() + offset;
+        if (changed || std::memcmp(previous, data, bytes) != 0) {
+            std::memcpy(previous, data, bytes);
+            changed = true;
+        }
+    }
+
+    m_valid = true;
+
+    if (changed) {
+        ++m_numberOfChanges;
+    }
+    else {
+        ++m_numberOfSkips;
+    }
+
+    return changed;
+}
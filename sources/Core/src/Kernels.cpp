@@ -0,0 +1,867 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Kernels.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+#define BF_KERNELS_X86
+#endif
+
+#if defined(__GNUC__)
+#define BF_KERNELS_VECTORS
+#define BF_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define BF_ALWAYS_INLINE inline
+#endif
+
+// The vectors are passed only between inlined functions, hence their calling convention does not
+// matter
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+using namespace blockfactory::core;
+
+namespace {
+    // Vector of elements of type T with a size of Bytes. The size 0 is the scalar type.
+    template <typename T, size_t Bytes>
+    struct Vector
+    {
+#if defined(BF_KERNELS_VECTORS)
+        typedef T Type __attribute__((vector_size(Bytes)));
+#endif
+    };
+
+    template <typename T>
+    struct Vector<T, 0>
+    {
+        using Type = T;
+    };
+
+    // Operations applied both to vectors and to scalars
+
+    struct Add
+    {
+        template <typename V>
+        BF_ALWAYS_INLINE V operator()(const V& a, const V& b) const
+        {
+            return static_cast<V>(a + b);
+        }
+    };
+
+    struct Subtract
+    {
+        template <typename V>
+        BF_ALWAYS_INLINE V operator()(const V& a, const V& b) const
+        {
+            return static_cast<V>(a - b);
+        }
+    };
+
+    struct Multiply
+    {
+        template <typename V>
+        BF_ALWAYS_INLINE V operator()(const V& a, const V& b) const
+        {
+            return static_cast<V>(a * b);
+        }
+    };
+
+    // Loops over buffers of type T processed with vectors of the given size. The elements that do
+    // not fill a vector are processed one by one.
+    template <typename T, size_t Bytes>
+    struct Loops
+    {
+        using V = typename Vector<T, Bytes>::Type;
+        static constexpr size_t Width = sizeof(V) / sizeof(T);
+
+        static BF_ALWAYS_INLINE V load(const T* data)
+        {
+            V vector;
+            std::memcpy(&vector, data, sizeof(V));
+            return vector;
+        }
+
+        static BF_ALWAYS_INLINE void store(T* data, const V& vector)
+        {
+            std::memcpy(data, &vector, sizeof(V));
+        }
+
+        static BF_ALWAYS_INLINE V broadcast(const T value) { return static_cast<V>(V{} + value); }
+
+        template <typename Operation>
+        static BF_ALWAYS_INLINE void
+        binary(const T* a, const T* b, T* y, const size_t n, const Operation operation)
+        {
+            size_t i = 0;
+            for (; i + Width <= n; i += Width) {
+                store(y + i, operation(load(a + i), load(b + i)));
+            }
+            for (; i < n; ++i) {
+                y[i] = operation(a[i], b[i]);
+            }
+        }
+
+        static BF_ALWAYS_INLINE void scale(const T* x, const T alpha, T* y, const size_t n)
+        {
+            const V alphaVector = broadcast(alpha);
+            size_t i = 0;
+            for (; i + Width <= n; i += Width) {
+                store(y + i, static_cast<V>(alphaVector * load(x + i)));
+            }
+            for (; i < n; ++i) {
+                y[i] = static_cast<T>(alpha * x[i]);
+            }
+        }
+
+        static BF_ALWAYS_INLINE void axpy(const T alpha, const T* x, T* y, const size_t n)
+        {
+            const V alphaVector = broadcast(alpha);
+            size_t i = 0;
+            for (; i + Width <= n; i += Width) {
+                store(y + i, static_cast<V>(alphaVector * load(x + i) + load(y + i)));
+            }
+            for (; i < n; ++i) {
+                y[i] = static_cast<T>(alpha * x[i] + y[i]);
+            }
+        }
+
+        static BF_ALWAYS_INLINE void
+        clamp(const T* x, const T lower, const T upper, T* y, const size_t n)
+        {
+            const V lowerVector = broadcast(lower);
+            const V upperVector = broadcast(upper);
+            size_t i = 0;
+            for (; i + Width <= n; i += Width) {
+                V value = load(x + i);
+                value = value < lowerVector ? lowerVector : value;
+                value = value > upperVector ? upperVector : value;
+                store(y + i, value);
+            }
+            for (; i < n; ++i) {
+                y[i] = x[i] < lower ? lower : (x[i] > upper ? upper : x[i]);
+            }
+        }
+
+        static BF_ALWAYS_INLINE double dot(const T* a, const T* b, const size_t n)
+        {
+            double result = 0;
+            size_t i = 0;
+
+            // The products of integers would overflow the elements of the vectors
+            if (std::is_floating_point<T>::value) {
+                V sum = V{};
+                for (; i + Width <= n; i += Width) {
+                    sum += load(a + i) * load(b + i);
+                }
+
+                T lanes[Width];
+                std::memcpy(lanes, &sum, sizeof(V));
+                for (const T lane : lanes) {
+                    result += static_cast<double>(lane);
+                }
+            }
+
+            for (; i < n; ++i) {
+                result += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+            }
+            return result;
+        }
+    };
+
+    // The implementations of the kernels for an instruction set
+
+#define BF_KERNELS_IMPLEMENTATION(NAME, ATTRIBUTES, BYTES)                                      \
+    struct NAME                                                                                \
+    {                                                                                          \
+        template <typename T>                                                                  \
+        ATTRIBUTES static void add(const T* a, const T* b, T* y, const size_t n)               \
+        {                                                                                      \
+            Loops<T, BYTES>::binary(a, b, y, n, Add());                                        \
+        }                                                                                      \
+        template <typename T>                                                                  \
+        ATTRIBUTES static void subtract(const T* a, const T* b, T* y, const size_t n)          \
+        {                                                                                      \
+            Loops<T, BYTES>::binary(a, b, y, n, Subtract());                                   \
+        }                                                                                      \
+        template <typename T>                                                                  \
+        ATTRIBUTES static void multiply(const T* a, const T* b, T* y, const size_t n)          \
+        {                                                                                      \
+            Loops<T, BYTES>::binary(a, b, y, n, Multiply());                                   \
+        }                                                                                      \
+        template <typename T>                                                                  \
+        ATTRIBUTES static void scale(const T* x, const T alpha, T* y, const size_t n)          \
+        {                                                                                      \
+            Loops<T, BYTES>::scale(x, alpha, y, n);                                            \
+        }                                                                                      \
+        template <typename T>                                                                  \
+        ATTRIBUTES static void axpy(const T alpha, const T* x, T* y, const size_t n)           \
+        {                                                                                      \
+            Loops<T, BYTES>::axpy(alpha, x, y, n);                                             \
+        }                                                                                      \
+        template <typename T>                                                                  \
+        ATTRIBUTES static void                                                                 \
+        clamp(const T* x, const T lower, const T upper, T* y, const size_t n)                  \
+        {                                                                                      \
+            Loops<T, BYTES>::clamp(x, lower, upper, y, n);                                     \
+        }                                                                                      \
+        template <typename T>                                                                  \
+        ATTRIBUTES static double dot(const T* a, const T* b, const size_t n)                   \
+        {                                                                                      \
+            return Loops<T, BYTES>::dot(a, b, n);                                              \
+        }                                                                                      \
+    };
+
+    BF_KERNELS_IMPLEMENTATION(ScalarKernels, , 0)
+#if defined(BF_KERNELS_X86)
+    BF_KERNELS_IMPLEMENTATION(SSE2Kernels, __attribute__((target("sse2"))), 16)
+    BF_KERNELS_IMPLEMENTATION(AVX2Kernels, __attribute__((target("avx2"))), 32)
+    BF_KERNELS_IMPLEMENTATION(AVX512Kernels,
+                              __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))),
+                              64)
+#endif
+
+#undef BF_KERNELS_IMPLEMENTATION
+
+    // The kernels of an instruction set for the type T
+    template <typename T>
+    struct Table
+    {
+        void (*add)(const T*, const T*, T*, const size_t);
+        void (*subtract)(const T*, const T*, T*, const size_t);
+        void (*multiply)(const T*, const T*, T*, const size_t);
+        void (*scale)(const T*, const T, T*, const size_t);
+        void (*axpy)(const T, const T*, T*, const size_t);
+        void (*clamp)(const T*, const T, const T, T*, const size_t);
+        double (*dot)(const T*, const T*, const size_t);
+    };
+
+    template <typename Implementation, typename T>
+    Table<T> createTable()
+    {
+        return {&Implementation::template add<T>,
+                &Implementation::template subtract<T>,
+                &Implementation::template multiply<T>,
+                &Implementation::template scale<T>,
+                &Implementation::template axpy<T>,
+                &Implementation::template clamp<T>,
+                &Implementation::template dot<T>};
+    }
+
+    const Kernels::InstructionSet InstructionSets[] = {Kernels::InstructionSet::Scalar,
+                                                       Kernels::InstructionSet::SSE2,
+                                                       Kernels::InstructionSet::AVX2,
+                                                       Kernels::InstructionSet::AVX512};
+
+    // Select the most recent instruction set, unless it is specified by the environment
+    Kernels::InstructionSet getDefaultInstructionSet()
+    {
+        const char* value = std::getenv("BLOCKFACTORY_KERNELS");
+
+        if (value) {
+            for (const auto instructionSet : InstructionSets) {
+                if (Kernels::getInstructionSetName(instructionSet) == value
+                    && Kernels::isSupported(instructionSet)) {
+                    return instructionSet;
+                }
+            }
+            std::cerr << "BLOCKFACTORY_KERNELS: the instruction set " << value
+                      << " is not supported" << std::endl;
+        }
+
+        auto selected = Kernels::InstructionSet::Scalar;
+        for (const auto instructionSet : InstructionSets) {
+            if (Kernels::isSupported(instructionSet)) {
+                selected = instructionSet;
+            }
+        }
+        return selected;
+    }
+
+    std::atomic<Kernels::InstructionSet>& selectedInstructionSet()
+    {
+        static std::atomic<Kernels::InstructionSet> instructionSet{getDefaultInstructionSet()};
+        return instructionSet;
+    }
+
+    template <typename T>
+    const Table<T>& getTable()
+    {
+        static const Table<T> scalar = createTable<ScalarKernels, T>();
+#if defined(BF_KERNELS_X86)
+        static const Table<T> sse2 = createTable<SSE2Kernels, T>();
+        static const Table<T> avx2 = createTable<AVX2Kernels, T>();
+        static const Table<T> avx512 = createTable<AVX512Kernels, T>();
+
+        switch (selectedInstructionSet().load(std::memory_order_relaxed)) {
+            case Kernels::InstructionSet::Scalar:
+                return scalar;
+            case Kernels::InstructionSet::SSE2:
+                return sse2;
+            case Kernels::InstructionSet::AVX2:
+                return avx2;
+            case Kernels::InstructionSet::AVX512:
+                return avx512;
+        }
+#endif
+        return scalar;
+    }
+
+    bool checkLengths(const size_t input, const size_t output)
+    {
+        if (input != output) {
+            bfError << "The length of the input (" << input << ") does not match the length of "
+                    << "the output (" << output << ").";
+            return false;
+        }
+        return true;
+    }
+
+    bool checkSignals(const Signal& input, const Signal& output)
+    {
+        if (!input.isValid() || !output.isValid()) {
+            bfError << "The signals are not valid.";
+            return false;
+        }
+
+        if (input.getPortDataType() != output.getPortDataType()) {
+            bfError << "The signals have different data types.";
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    Span<const T> getSpan(const Signal& signal)
+    {
+        return {signal.getBuffer<T>(), signal.getWidth()};
+    }
+
+    template <typename T>
+    Span<T> getSpan(Signal& signal)
+    {
+        return {signal.getBuffer<T>(), signal.getWidth()};
+    }
+
+    // Call the function with a null pointer to the type of the elements of the signals
+    template <typename Function>
+    bool dispatch(const Port::DataType dataType, const Function& function)
+    {
+        switch (dataType) {
+            case Port::DataType::DOUBLE:
+                return function(static_cast<double*>(nullptr));
+            case Port::DataType::SINGLE:
+                return function(static_cast<float*>(nullptr));
+            case Port::DataType::INT8:
+                return function(static_cast<int8_t*>(nullptr));
+            case Port::DataType::UINT8:
+                return function(static_cast<uint8_t*>(nullptr));
+            case Port::DataType::INT16:
+                return function(static_cast<int16_t*>(nullptr));
+            case Port::DataType::UINT16:
+                return function(static_cast<uint16_t*>(nullptr));
+            case Port::DataType::INT32:
+                return function(static_cast<int32_t*>(nullptr));
+            case Port::DataType::UINT32:
+                return function(static_cast<uint32_t*>(nullptr));
+            case Port::DataType::BOOLEAN:
+                break;
+        }
+
+        bfError << "The kernels support only signals with a numeric data type.";
+        return false;
+    }
+
+    // Convert a scale factor to the type of the signals. The conversion of a value that the type
+    // cannot represent would truncate it or, out of the range of the type, be undefined.
+    template <typename T>
+    bool convertFactor(const double alpha, T& result)
+    {
+        const double lowest = static_cast<double>(std::numeric_limits<T>::lowest());
+        const double max = static_cast<double>(std::numeric_limits<T>::max());
+        const bool inRange = alpha >= lowest && alpha <= max;
+
+        const bool representable = std::is_floating_point<T>::value
+                                       ? inRange || std::isinf(alpha) || std::isnan(alpha)
+                                       : inRange && alpha == std::trunc(alpha);
+        if (!representable) {
+            bfError << "The scale factor " << alpha << " cannot be represented by the data type "
+                    << "of the signals.";
+            return false;
+        }
+
+        result = static_cast<T>(alpha);
+        return true;
+    }
+
+    // Convert a limit of clamp to the type of the signals. The limits of integer types are rounded
+    // towards the inside of the interval, and all the limits are saturated to the range of the
+    // type. The clamped values do not change.
+    template <typename T>
+    T convertLimit(const double limit, const bool isLower)
+    {
+        if (std::is_floating_point<T>::value && std::isinf(limit)) {
+            return static_cast<T>(limit);
+        }
+
+        const double lowest = static_cast<double>(std::numeric_limits<T>::lowest());
+        const double max = static_cast<double>(std::numeric_limits<T>::max());
+
+        double value = limit;
+        if (!std::is_floating_point<T>::value) {
+            value = isLower ? std::ceil(limit) : std::floor(limit);
+        }
+        return static_cast<T>(std::min(std::max(value, lowest), max));
+    }
+
+    // Size of the blocks of the matrices processed by gemv and gemm. A block of BlockRows x
+    // BlockDepth elements of the left matrix fits in the L2 cache, and its columns in L1.
+    const size_t BlockRows = 128;
+    const size_t BlockDepth = 64;
+
+    // Compute y = beta * y without reading y if beta is zero
+    template <typename T>
+    void scaleOutput(const T beta, T* y, const size_t n, const Table<T>& table)
+    {
+        if (beta == T(0)) {
+            std::fill(y, y + n, T(0));
+        }
+        else if (beta != T(1)) {
+            table.scale(y, beta, y, n);
+        }
+    }
+} // namespace
+
+// INSTRUCTION SETS
+// ================
+
+Kernels::InstructionSet Kernels::getInstructionSet()
+{
+    return selectedInstructionSet().load(std::memory_order_relaxed);
+}
+
+bool Kernels::setInstructionSet(const InstructionSet instructionSet)
+{
+    if (!isSupported(instructionSet)) {
+        bfError << "The instruction set " << getInstructionSetName(instructionSet)
+                << " is not supported.";
+        return false;
+    }
+
+    selectedInstructionSet().store(instructionSet, std::memory_order_relaxed);
+    return true;
+}
+
+bool Kernels::isSupported(const InstructionSet instructionSet)
+{
+#if defined(BF_KERNELS_X86)
+    __builtin_cpu_init();
+#endif
+
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return true;
+#if defined(BF_KERNELS_X86)
+        case InstructionSet::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case InstructionSet::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case InstructionSet::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+                   && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+#endif
+        default:
+            return false;
+    }
+}
+
+std::string Kernels::getInstructionSetName(const InstructionSet instructionSet)
+{
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return "scalar";
+        case InstructionSet::SSE2:
+            return "sse2";
+        case InstructionSet::AVX2:
+            return "avx2";
+        case InstructionSet::AVX512:
+            return "avx512";
+    }
+    return {};
+}
+
+// SPAN KERNELS
+// ============
+
+template <typename T>
+bool Kernels::add(Span<const T> a, Span<const T> b, Span<T> y)
+{
+    if (!checkLengths(a.size(), y.size()) || !checkLengths(b.size(), y.size())) {
+        return false;
+    }
+
+    getTable<T>().add(a.data(), b.data(), y.data(), y.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::subtract(Span<const T> a, Span<const T> b, Span<T> y)
+{
+    if (!checkLengths(a.size(), y.size()) || !checkLengths(b.size(), y.size())) {
+        return false;
+    }
+
+    getTable<T>().subtract(a.data(), b.data(), y.data(), y.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::multiply(Span<const T> a, Span<const T> b, Span<T> y)
+{
+    if (!checkLengths(a.size(), y.size()) || !checkLengths(b.size(), y.size())) {
+        return false;
+    }
+
+    getTable<T>().multiply(a.data(), b.data(), y.data(), y.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::scale(Span<const T> x, const T alpha, Span<T> y)
+{
+    if (!checkLengths(x.size(), y.size())) {
+        return false;
+    }
+
+    getTable<T>().scale(x.data(), alpha, y.data(), y.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::axpy(const T alpha, Span<const T> x, Span<T> y)
+{
+    if (!checkLengths(x.size(), y.size())) {
+        return false;
+    }
+
+    getTable<T>().axpy(alpha, x.data(), y.data(), y.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::clamp(Span<const T> x, const T lower, const T upper, Span<T> y)
+{
+    if (!checkLengths(x.size(), y.size())) {
+        return false;
+    }
+
+    if (lower > upper) {
+        bfError << "The lower limit is greater than the upper limit.";
+        return false;
+    }
+
+    getTable<T>().clamp(x.data(), lower, upper, y.data(), y.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::dot(Span<const T> a, Span<const T> b, double& result)
+{
+    if (!checkLengths(a.size(), b.size())) {
+        return false;
+    }
+
+    result = getTable<T>().dot(a.data(), b.data(), a.size());
+    return true;
+}
+
+template <typename T>
+bool Kernels::norm(Span<const T> x, double& result)
+{
+    result = std::sqrt(getTable<T>().dot(x.data(), x.data(), x.size()));
+    return true;
+}
+
+// SIGNAL KERNELS
+// ==============
+
+bool Kernels::add(const Signal& a, const Signal& b, Signal& y)
+{
+    if (!checkSignals(a, y) || !checkSignals(b, y)) {
+        return false;
+    }
+
+    return dispatch(y.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        return add<T>(getSpan<T>(a), getSpan<T>(b), getSpan<T>(y));
+    });
+}
+
+bool Kernels::subtract(const Signal& a, const Signal& b, Signal& y)
+{
+    if (!checkSignals(a, y) || !checkSignals(b, y)) {
+        return false;
+    }
+
+    return dispatch(y.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        return subtract<T>(getSpan<T>(a), getSpan<T>(b), getSpan<T>(y));
+    });
+}
+
+bool Kernels::multiply(const Signal& a, const Signal& b, Signal& y)
+{
+    if (!checkSignals(a, y) || !checkSignals(b, y)) {
+        return false;
+    }
+
+    return dispatch(y.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        return multiply<T>(getSpan<T>(a), getSpan<T>(b), getSpan<T>(y));
+    });
+}
+
+bool Kernels::scale(const Signal& x, const double alpha, Signal& y)
+{
+    if (!checkSignals(x, y)) {
+        return false;
+    }
+
+    return dispatch(y.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        T factor;
+        return convertFactor(alpha, factor) && scale<T>(getSpan<T>(x), factor, getSpan<T>(y));
+    });
+}
+
+bool Kernels::axpy(const double alpha, const Signal& x, Signal& y)
+{
+    if (!checkSignals(x, y)) {
+        return false;
+    }
+
+    return dispatch(y.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        T factor;
+        return convertFactor(alpha, factor) && axpy<T>(factor, getSpan<T>(x), getSpan<T>(y));
+    });
+}
+
+bool Kernels::clamp(const Signal& x, const double lower, const double upper, Signal& y)
+{
+    if (!checkSignals(x, y)) {
+        return false;
+    }
+
+    if (std::isnan(lower) || std::isnan(upper) || lower > upper) {
+        bfError << "The lower limit " << lower << " must not be greater than the upper limit "
+                << upper << ".";
+        return false;
+    }
+
+    return dispatch(y.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        const T lowerLimit = convertLimit<T>(lower, /*isLower=*/true);
+        const T upperLimit = convertLimit<T>(upper, /*isLower=*/false);
+
+        if (lowerLimit > upperLimit) {
+            bfError << "The interval [" << lower << ", " << upper << "] does not contain any "
+                    << "value of the data type of the signals.";
+            return false;
+        }
+        return clamp<T>(getSpan<T>(x), lowerLimit, upperLimit, getSpan<T>(y));
+    });
+}
+
+bool Kernels::dot(const Signal& a, const Signal& b, double& result)
+{
+    if (!checkSignals(a, b)) {
+        return false;
+    }
+
+    return dispatch(a.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        return dot<T>(getSpan<T>(a), getSpan<T>(b), result);
+    });
+}
+
+bool Kernels::norm(const Signal& x, double& result)
+{
+    if (!x.isValid()) {
+        bfError << "The signal is not valid.";
+        return false;
+    }
+
+    return dispatch(x.getPortDataType(), [&](auto* type) {
+        using T = typename std::remove_pointer<decltype(type)>::type;
+        return norm<T>(getSpan<T>(x), result);
+    });
+}
+
+// MATRIX KERNELS
+// ==============
+
+template <typename T>
+bool Kernels::gemv(const T alpha, MatrixView<const T> a, Span<const T> x, const T beta, Span<T> y)
+{
+    if (a.cols() != x.size() || a.rows() != y.size()) {
+        bfError << "The size of the matrix (" << a.rows() << "x" << a.cols()
+                << ") does not match the lengths of the vectors (" << x.size() << ", "
+                << y.size() << ").";
+        return false;
+    }
+
+    const Table<T>& table = getTable<T>();
+
+    // Every element of y is the dot product of a row with x
+    if (a.hasContiguousRows() && !a.empty()) {
+        for (size_t row = 0; row < a.rows(); ++row) {
+            const T product = static_cast<T>(table.dot(&a(row, 0), x.data(), x.size()));
+            y[row] = beta == T(0) ? alpha * product : alpha * product + beta * y[row];
+        }
+        return true;
+    }
+
+    scaleOutput(beta, y.data(), y.size(), table);
+
+    // Accumulate the columns scaled by the elements of x. The blocks of y stay in the cache while
+    // all the columns are accumulated.
+    if (a.hasContiguousColumns()) {
+        for (size_t row = 0; row < a.rows(); row += BlockRows) {
+            const size_t rows = std::min(BlockRows, a.rows() - row);
+            for (size_t col = 0; col < a.cols(); ++col) {
+                table.axpy(alpha * x[col], &a(row, col), &y[row], rows);
+            }
+        }
+        return true;
+    }
+
+    for (size_t row = 0; row < a.rows(); ++row) {
+        T product = 0;
+        for (size_t col = 0; col < a.cols(); ++col) {
+            product += a(row, col) * x[col];
+        }
+        y[row] += alpha * product;
+    }
+    return true;
+}
+
+template <typename T>
+bool Kernels::gemm(const T alpha,
+                   MatrixView<const T> a,
+                   MatrixView<const T> b,
+                   const T beta,
+                   MatrixView<T> c)
+{
+    if (a.rows() != c.rows() || b.cols() != c.cols() || a.cols() != b.rows()) {
+        bfError << "The sizes of the matrices (" << a.rows() << "x" << a.cols() << ", "
+                << b.rows() << "x" << b.cols() << ", " << c.rows() << "x" << c.cols()
+                << ") do not match.";
+        return false;
+    }
+
+    // The row major product is computed as the column major product C' = B' * A'
+    if (!c.hasContiguousColumns() && c.hasContiguousRows()) {
+        return gemm(alpha, b.transpose(), a.transpose(), beta, c.transpose());
+    }
+
+    const Table<T>& table = getTable<T>();
+
+    for (size_t col = 0; col < c.cols(); ++col) {
+        if (c.hasContiguousColumns()) {
+            scaleOutput(beta, &c(0, col), c.rows(), table);
+            continue;
+        }
+        for (size_t row = 0; row < c.rows(); ++row) {
+            c(row, col) = beta == T(0) ? T(0) : beta * c(row, col);
+        }
+    }
+
+    const size_t depth = a.cols();
+    const bool vectorized = a.hasContiguousColumns() && c.hasContiguousColumns();
+
+    // Every block of A is used for all the columns of C before moving to the next one
+    for (size_t k0 = 0; k0 < depth; k0 += BlockDepth) {
+        const size_t blockDepth = std::min(BlockDepth, depth - k0);
+
+        for (size_t i0 = 0; i0 < c.rows(); i0 += BlockRows) {
+            const size_t blockRows = std::min(BlockRows, c.rows() - i0);
+
+            for (size_t col = 0; col < c.cols(); ++col) {
+                for (size_t k = k0; k < k0 + blockDepth; ++k) {
+                    const T factor = alpha * b(k, col);
+
+                    if (vectorized) {
+                        table.axpy(factor, &a(i0, k), &c(i0, col), blockRows);
+                        continue;
+                    }
+                    for (size_t row = i0; row < i0 + blockRows; ++row) {
+                        c(row, col) += factor * a(row, k);
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Explicit template instantiations
+// ================================
+
+#define BF_KERNELS_TEMPLATES(T)                                                             \
+    template bool Kernels::add<T>(Span<const T>, Span<const T>, Span<T>);                  \
+    template bool Kernels::subtract<T>(Span<const T>, Span<const T>, Span<T>);             \
+    template bool Kernels::multiply<T>(Span<const T>, Span<const T>, Span<T>);             \
+    template bool Kernels::scale<T>(Span<const T>, const T, Span<T>);                      \
+    template bool Kernels::axpy<T>(const T, Span<const T>, Span<T>);                       \
+    template bool Kernels::clamp<T>(Span<const T>, const T, const T, Span<T>);             \
+    template bool Kernels::dot<T>(Span<const T>, Span<const T>, double&);                  \
+    template bool Kernels::norm<T>(Span<const T>, double&);
+
+namespace blockfactory {
+    namespace core {
+        BF_KERNELS_TEMPLATES(double)
+        BF_KERNELS_TEMPLATES(float)
+        BF_KERNELS_TEMPLATES(int8_t)
+        BF_KERNELS_TEMPLATES(uint8_t)
+        BF_KERNELS_TEMPLATES(int16_t)
+        BF_KERNELS_TEMPLATES(uint16_t)
+        BF_KERNELS_TEMPLATES(int32_t)
+        BF_KERNELS_TEMPLATES(uint32_t)
+
+        template bool Kernels::gemv<double>(
+            const double, MatrixView<const double>, Span<const double>, const double, Span<double>);
+        template bool Kernels::gemv<float>(
+            const float, MatrixView<const float>, Span<const float>, const float, Span<float>);
+        template bool Kernels::gemm<double>(const double,
+                                            MatrixView<const double>,
+                                            MatrixView<const double>,
+                                            const double,
+                                            MatrixView<double>);
+        template bool Kernels::gemm<float>(const float,
+                                           MatrixView<const float>,
+                                           MatrixView<const float>,
+                                           const float,
+                                           MatrixView<float>);
+    } // namespace core
+} // namespace blockfactory
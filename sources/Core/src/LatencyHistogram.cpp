@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace blockfactory::core;
+
+const size_t LatencyHistogram::SubBuckets;
+const size_t LatencyHistogram::NumberOfBuckets;
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::reset()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_release);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    const uint64_t count = other.getCount();
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < NumberOfBuckets; ++i) {
+        m_buckets[i].fetch_add(other.m_buckets[i].load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+    }
+    m_sum.fetch_add(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    const uint64_t otherMin = other.m_min.load(std::memory_order_relaxed);
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (otherMin < current
+           && !m_min.compare_exchange_weak(current, otherMin, std::memory_order_relaxed)) {
+    }
+
+    const uint64_t otherMax = other.m_max.load(std::memory_order_relaxed);
+    current = m_max.load(std::memory_order_relaxed);
+    while (otherMax > current
+           && !m_max.compare_exchange_weak(current, otherMax, std::memory_order_relaxed)) {
+    }
+
+    m_count.fetch_add(count, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return m_count.load(std::memory_order_acquire);
+}
+
+uint64_t LatencyHistogram::getMin() const
+{
+    if (getCount() == 0) {
+        return 0;
+    }
+    return m_min.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax() const
+{
+    if (getCount() == 0) {
+        return 0;
+    }
+    return m_max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean() const
+{
+    const uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+    return static_cast<double>(m_sum.load(std::memory_order_relaxed))
+           / static_cast<double>(count);
+}
+
+uint64_t LatencyHistogram::getPercentile(const double percentile) const
+{
+    // Sum the buckets instead of using the count, since samples could be added concurrently
+    uint64_t total = 0;
+    std::array<uint64_t, NumberOfBuckets> counts;
+    for (size_t i = 0; i < NumberOfBuckets; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    const uint64_t rank = std::max<uint64_t>(
+        static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total))), 1);
+
+    uint64_t cumulative = 0;
+    size_t bucket = 0;
+    for (; bucket < NumberOfBuckets; ++bucket) {
+        cumulative += counts[bucket];
+        if (cumulative >= rank) {
+            break;
+        }
+    }
+
+    return std::min(getBucketUpperBound(bucket), m_max.load(std::memory_order_relaxed));
+}
+
+uint64_t LatencyHistogram::getBucketCount(const size_t bucket) const
+{
+    if (bucket >= NumberOfBuckets) {
+        return 0;
+    }
+    return m_buckets[bucket].load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getBucketLowerBound(const size_t bucket)
+{
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+
+    const size_t msb = bucket / SubBuckets + 2;
+    const uint64_t sub = bucket % SubBuckets;
+    return (SubBuckets + sub) << (msb - 3);
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(const size_t bucket)
+{
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+
+    if (bucket >= NumberOfBuckets - 1) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    return getBucketLowerBound(bucket + 1) - 1;
+}
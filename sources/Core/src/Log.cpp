@@ -8,7 +8,8 @@
 
 #include "BlockFactory/Core/Log.h"
 
-#include <cassert>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 using namespace blockfactory::core;
@@ -16,74 +17,51 @@ using namespace blockfactory::core;
 class Log::impl
 {
 public:
-    std::vector<std::unique_ptr<std::stringstream>> errorsSStream;
-    std::vector<std::unique_ptr<std::stringstream>> warningsSStream;
+    std::vector<std::string> errors;
+    std::vector<std::string> warnings;
+
+    // Blocks might be executed concurrently (e.g. by coder::ParallelScheduler). Messages are
+    // composed by Log::Stream without locking, and the mutex protects only the stored messages.
+    mutable std::mutex mutex;
 
     const Verbosity verbosity = BF_LOG_VERBOSITY;
 
-    static std::string
-    serializeVectorStringStream(const std::vector<std::unique_ptr<std::stringstream>>& ss);
+    static std::string serializeMessages(const std::vector<std::string>& messages);
 };
 
 Log::Log()
     : pImpl(std::make_unique<Log::impl>())
 {}
 
+Log::~Log() = default;
+
 Log& Log::getSingleton()
 {
     static Log logInstance;
     return logInstance;
 }
 
-std::stringstream& Log::getLogStringStream(const Log::Type& type,
-                                           const std::string& file,
-                                           const unsigned& line,
-                                           const std::string& function)
+Log::Stream Log::getLogStringStream(const Log::Type& type,
+                                    const std::string& file,
+                                    const unsigned& line,
+                                    const std::string& function)
 {
-    switch (pImpl->verbosity) {
-        case Log::Verbosity::RELEASE:
-            switch (type) {
-                case Log::Type::ERROR:
-                    pImpl->errorsSStream.emplace_back(new std::stringstream);
-                    return *pImpl->errorsSStream.back();
-                case Log::Type::WARNING:
-                    pImpl->warningsSStream.emplace_back(new std::stringstream);
-                    return *pImpl->warningsSStream.back();
-            }
-            break;
-        case Log::Verbosity::DEBUG:
-            switch (type) {
-                case Log::Type::ERROR: {
-                    pImpl->errorsSStream.emplace_back(new std::stringstream);
-                    auto& ss = *pImpl->errorsSStream.back();
-                    ss << std::endl
-                       << file << "@" << function << ":" << std::to_string(line) << std::endl;
-                    return ss;
-                }
-                case Log::Type::WARNING: {
-                    pImpl->warningsSStream.emplace_back(new std::stringstream);
-                    auto& ss = *pImpl->warningsSStream.back();
-                    ss << std::endl
-                       << file << "@" << function << ":" << std::to_string(line) << std::endl;
-                    return ss;
-                }
-            }
-            break;
+    Stream stream(*this, type);
+
+    if (pImpl->verbosity == Log::Verbosity::DEBUG) {
+        stream << std::endl
+               << file << "@" << function << ":" << std::to_string(line) << std::endl;
     }
 
-    // This should never happen. It is here to avoid compiler warnings.
-    assert(false);
-    std::stringstream* dummy = nullptr;
-    return *dummy;
+    return stream;
 }
 
-std::string
-Log::impl::serializeVectorStringStream(const std::vector<std::unique_ptr<std::stringstream>>& ss)
+std::string Log::impl::serializeMessages(const std::vector<std::string>& messages)
 {
     std::stringstream output;
 
-    for (const auto& ss_elem : ss) {
-        output << ss_elem->str() << std::endl;
+    for (const auto& message : messages) {
+        output << message << std::endl;
     }
 
     return output.str();
@@ -91,22 +69,26 @@ Log::impl::serializeVectorStringStream(const std::vector<std::unique_ptr<std::st
 
 std::string Log::getErrors() const
 {
-    return impl::serializeVectorStringStream(pImpl->errorsSStream);
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return impl::serializeMessages(pImpl->errors);
 }
 
 std::string Log::getWarnings() const
 {
-    return impl::serializeVectorStringStream(pImpl->warningsSStream);
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return impl::serializeMessages(pImpl->warnings);
 }
 
 void Log::clearWarnings()
 {
-    pImpl->warningsSStream.clear();
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->warnings.clear();
 }
 
 void Log::clearErrors()
 {
-    pImpl->errorsSStream.clear();
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->errors.clear();
 }
 
 void Log::clear()
@@ -114,3 +96,42 @@ void Log::clear()
     clearErrors();
     clearWarnings();
 }
+
+Log::Stream::Stream(Log& log, const Type type)
+    : m_log(&log)
+    , m_type(type)
+{}
+
+Log::Stream::Stream(Stream&& other)
+    : m_log(other.m_log)
+    , m_type(other.m_type)
+    , m_stream(std::move(other.m_stream))
+{
+    // Only the last owner of the message stores it
+    other.m_log = nullptr;
+}
+
+Log::Stream::~Stream()
+{
+    if (!m_log) {
+        return;
+    }
+
+    std::string message = m_stream.str();
+
+    std::lock_guard<std::mutex> lock(m_log->pImpl->mutex);
+    switch (m_type) {
+        case Log::Type::ERROR:
+            m_log->pImpl->errors.push_back(std::move(message));
+            break;
+        case Log::Type::WARNING:
+            m_log->pImpl->warnings.push_back(std::move(message));
+            break;
+    }
+}
+
+Log::Stream& Log::Stream::operator<<(std::ostream& (*manipulator)(std::ostream&))
+{
+    m_stream << manipulator;
+    return *this;
+}
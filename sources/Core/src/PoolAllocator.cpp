@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/PoolAllocator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+using namespace blockfactory::core;
+
+constexpr size_t PoolAllocator::MinBlockSize;
+constexpr size_t PoolAllocator::MaxBlockSize;
+constexpr size_t PoolAllocator::NumberOfClasses;
+
+static_assert(PoolAllocator::MinBlockSize << (PoolAllocator::NumberOfClasses - 1)
+                  == PoolAllocator::MaxBlockSize,
+              "The size classes must cover all the sizes up to MaxBlockSize");
+
+PoolAllocator::PoolAllocator(Allocator& upstream)
+    : m_upstream(upstream)
+{}
+
+PoolAllocator::~PoolAllocator()
+{
+    trim();
+}
+
+size_t PoolAllocator::getSizeClass(const size_t bytes)
+{
+    size_t sizeClass = 0;
+    while (getBlockSize(sizeClass) < bytes) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+size_t PoolAllocator::getBlockSize(const size_t sizeClass)
+{
+    return MinBlockSize << sizeClass;
+}
+
+bool PoolAllocator::isPooled(const size_t bytes, const size_t alignment) const
+{
+    return bytes <= MaxBlockSize && alignment <= DefaultAlignment;
+}
+
+void* PoolAllocator::allocate(const size_t bytes, const size_t alignment)
+{
+    ++m_statistics.allocations;
+
+    size_t size = bytes;
+    size_t upstreamAlignment = alignment;
+
+    if (isPooled(bytes, alignment)) {
+        const size_t sizeClass = getSizeClass(bytes);
+        size = getBlockSize(sizeClass);
+        upstreamAlignment = DefaultAlignment;
+
+        // Recycle a released block
+        if (Block* block = m_freeLists[sizeClass]) {
+            m_freeLists[sizeClass] = block->next;
+            ++m_statistics.hits;
+            m_statistics.bytesCached -= size;
+            m_statistics.bytesInUse += size;
+            m_statistics.peakBytesInUse =
+                std::max(m_statistics.peakBytesInUse, m_statistics.bytesInUse);
+            return block;
+        }
+    }
+
+    ++m_statistics.misses;
+    if (m_missCallback) {
+        m_missCallback(size);
+    }
+
+    void* ptr = m_upstream.allocate(size, upstreamAlignment);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    m_statistics.bytesInUse += size;
+    m_statistics.peakBytesInUse = std::max(m_statistics.peakBytesInUse, m_statistics.bytesInUse);
+    return ptr;
+}
+
+void PoolAllocator::deallocate(void* ptr, const size_t bytes, const size_t alignment)
+{
+    if (!ptr) {
+        return;
+    }
+
+    ++m_statistics.deallocations;
+
+    if (!isPooled(bytes, alignment)) {
+        m_statistics.bytesInUse -= bytes;
+        m_upstream.deallocate(ptr, bytes, alignment);
+        return;
+    }
+
+    // Keep the block in the list of its size class
+    const size_t sizeClass = getSizeClass(bytes);
+    Block* block = static_cast<Block*>(ptr);
+    block->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block;
+
+    m_statistics.bytesInUse -= getBlockSize(sizeClass);
+    m_statistics.bytesCached += getBlockSize(sizeClass);
+}
+
+PoolAllocator& PoolAllocator::getThreadLocal()
+{
+    static thread_local PoolAllocator pool;
+    return pool;
+}
+
+bool PoolAllocator::reserve(const size_t bytes, const size_t count)
+{
+    if (!isPooled(bytes, DefaultAlignment)) {
+        return false;
+    }
+
+    const size_t sizeClass = getSizeClass(bytes);
+    const size_t size = getBlockSize(sizeClass);
+
+    for (size_t i = 0; i < count; ++i) {
+        Block* block = static_cast<Block*>(m_upstream.allocate(size, DefaultAlignment));
+        if (!block) {
+            return false;
+        }
+        block->next = m_freeLists[sizeClass];
+        m_freeLists[sizeClass] = block;
+        m_statistics.bytesCached += size;
+    }
+
+    return true;
+}
+
+void PoolAllocator::trim()
+{
+    for (size_t sizeClass = 0; sizeClass < NumberOfClasses; ++sizeClass) {
+        const size_t size = getBlockSize(sizeClass);
+        while (Block* block = m_freeLists[sizeClass]) {
+            m_freeLists[sizeClass] = block->next;
+            m_upstream.deallocate(block, size, DefaultAlignment);
+            m_statistics.bytesCached -= size;
+        }
+    }
+}
+
+void PoolAllocator::resetStatistics()
+{
+    m_statistics.allocations = 0;
+    m_statistics.deallocations = 0;
+    m_statistics.hits = 0;
+    m_statistics.misses = 0;
+    m_statistics.peakBytesInUse = m_statistics.bytesInUse;
+}
+
+void PoolAllocator::setMissCallback(MissCallback callback)
+{
+    m_missCallback = std::move(callback);
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Profiler.h"
+#include "BlockFactory/Core/Block.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace blockfactory::core;
+
+const size_t Profiler::NumberOfCallbacks;
+
+namespace {
+    using Histograms = std::array<LatencyHistogram, Profiler::NumberOfCallbacks>;
+
+    // The samples of a block recorded by a single thread
+    struct Record
+    {
+        std::string blockName;
+        uint32_t traceName;
+        Histograms histograms;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        // The records of the blocks that are alive, one for every thread executing the block
+        std::unordered_map<const Block*, std::vector<std::unique_ptr<Record>>> records;
+        // The merged statistics of the released blocks, indexed by name
+        std::map<std::string, Histograms> releasedBlocks;
+        // Incremented at every release, it invalidates the records cached by the threads
+        std::atomic<uint64_t> generation{0};
+    };
+
+    // The registry is never destroyed, so that it can be accessed by the report written at exit
+    Registry& registry()
+    {
+        static auto* registry = new Registry;
+        return *registry;
+    }
+
+    // The records of the blocks executed by the current thread
+    struct ThreadRecords
+    {
+        uint64_t generation = 0;
+        std::unordered_map<const Block*, Record*> records;
+    };
+
+    ThreadRecords& threadRecords()
+    {
+        thread_local ThreadRecords records;
+        return records;
+    }
+
+    // Call a function for the statistics of every block, both alive and released. The registry
+    // must be locked.
+    template <typename Function>
+    void forEachHistograms(Registry& registry, const Function& function)
+    {
+        for (auto& block : registry.records) {
+            for (auto& record : block.second) {
+                function(record->blockName, record->histograms);
+            }
+        }
+        for (auto& block : registry.releasedBlocks) {
+            function(block.first, block.second);
+        }
+    }
+
+    std::string getEnvironment()
+    {
+        const char* value = std::getenv("BLOCKFACTORY_PROFILE");
+        return value ? std::string(value) : std::string();
+    }
+
+    // Write the report at exit if the profiler was enabled by the environment
+    class ExitReport
+    {
+    public:
+        ~ExitReport()
+        {
+            const std::string destination = getEnvironment();
+
+            if (destination.empty()) {
+                return;
+            }
+
+            if (destination == "1" || destination == "stderr") {
+                Profiler::report(std::cerr);
+                return;
+            }
+
+            std::ofstream file(destination);
+            if (!file) {
+                std::cerr << "Failed to open the profiler report " << destination << std::endl;
+                return;
+            }
+            Profiler::report(file);
+        }
+    } exitReport;
+} // namespace
+
+std::atomic<bool> Profiler::m_enabled{!getEnvironment().empty()};
+
+Profiler::Entry Profiler::getEntry(const Block* block,
+                                   const BlockInformation* blockInfo,
+                                   const Callback callback)
+{
+    // The names of the callbacks used as categories of the trace events
+    static const std::array<uint32_t, NumberOfCallbacks> traceCategories = []() {
+        std::array<uint32_t, NumberOfCallbacks> categories;
+        for (size_t i = 0; i < NumberOfCallbacks; ++i) {
+            categories[i] = Tracer::registerName(getCallbackName(static_cast<Callback>(i)));
+        }
+        return categories;
+    }();
+
+    auto& thread = threadRecords();
+
+    // A block released by any thread might have been replaced by a new block with the same address
+    const uint64_t generation = registry().generation.load(std::memory_order_acquire);
+    if (thread.generation != generation) {
+        thread.records.clear();
+        thread.generation = generation;
+    }
+
+    auto it = thread.records.find(block);
+
+    if (it == thread.records.end()) {
+        auto record = std::unique_ptr<Record>(new Record);
+        record->blockName = blockInfo ? block->getUniqueName(blockInfo) : std::string();
+
+        if (record->blockName.empty()) {
+            std::ostringstream address;
+            address << static_cast<const void*>(block);
+            record->blockName = address.str();
+        }
+        record->traceName = Tracer::registerName(record->blockName);
+
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        auto& blockRecords = registry().records[block];
+        blockRecords.push_back(std::move(record));
+        it = thread.records.emplace(block, blockRecords.back().get()).first;
+    }
+
+    const auto index = static_cast<size_t>(callback);
+    return {&it->second->histograms[index], it->second->traceName, traceCategories[index]};
+}
+
+void Profiler::releaseBlock(const Block* block)
+{
+    threadRecords().records.erase(block);
+
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    auto it = registry().records.find(block);
+
+    if (it == registry().records.end()) {
+        return;
+    }
+
+    // Keep the statistics for the report, and release the records of all the threads
+    for (const auto& record : it->second) {
+        auto& histograms = registry().releasedBlocks[record->blockName];
+        for (size_t i = 0; i < NumberOfCallbacks; ++i) {
+            histograms[i].merge(record->histograms[i]);
+        }
+    }
+
+    registry().records.erase(it);
+    registry().generation.fetch_add(1, std::memory_order_release);
+}
+
+void Profiler::setEnabled(const bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::string Profiler::getCallbackName(const Callback callback)
+{
+    switch (callback) {
+        case Callback::Initialize:
+            return "initialize";
+        case Callback::Output:
+            return "output";
+        case Callback::UpdateDiscreteState:
+            return "updateDiscreteState";
+        case Callback::StateDerivative:
+            return "stateDerivative";
+        case Callback::Terminate:
+            return "terminate";
+    }
+    return {};
+}
+
+uint64_t Profiler::getCallCount(const std::string& blockName, const Callback callback)
+{
+    LatencyHistogram histogram;
+    getExecutionTimes(blockName, callback, histogram);
+    return histogram.getCount();
+}
+
+bool Profiler::getExecutionTimes(const std::string& blockName,
+                                 const Callback callback,
+                                 LatencyHistogram& histogram)
+{
+    bool found = false;
+
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    forEachHistograms(registry(), [&](const std::string& name, const Histograms& histograms) {
+        if (name == blockName) {
+            histogram.merge(histograms[static_cast<size_t>(callback)]);
+            found = true;
+        }
+    });
+
+    return found;
+}
+
+void Profiler::report(std::ostream& stream)
+{
+    // Merge the records of the same block
+    std::map<std::string, Histograms> blocks;
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        forEachHistograms(registry(), [&](const std::string& name, const Histograms& histograms) {
+            for (size_t i = 0; i < NumberOfCallbacks; ++i) {
+                blocks[name][i].merge(histograms[i]);
+            }
+        });
+    }
+
+    struct Row
+    {
+        std::string block;
+        std::string callback;
+        const LatencyHistogram* histogram;
+        double total;
+    };
+
+    std::vector<Row> rows;
+    for (const auto& block : blocks) {
+        for (size_t i = 0; i < NumberOfCallbacks; ++i) {
+            const auto& histogram = block.second[i];
+            if (histogram.getCount() > 0) {
+                rows.push_back({block.first,
+                                getCallbackName(static_cast<Callback>(i)),
+                                &histogram,
+                                histogram.getMean() * static_cast<double>(histogram.getCount())});
+            }
+        }
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        return a.total > b.total;
+    });
+
+    size_t nameWidth = 5;
+    for (const auto& row : rows) {
+        nameWidth = std::max(nameWidth, row.block.size());
+    }
+
+    const auto us = [](const double ns) { return ns / 1e3; };
+
+    stream << std::left << std::setw(static_cast<int>(nameWidth)) << "Block"
+           << "  " << std::setw(19) << "Callback" << std::right << std::setw(10) << "Calls"
+           << std::setw(14) << "Total [ms]" << std::setw(12) << "Mean [us]" << std::setw(12)
+           << "p50 [us]" << std::setw(12) << "p99 [us]" << std::setw(12) << "Max [us]"
+           << std::endl;
+
+    stream << std::fixed << std::setprecision(3);
+    for (const auto& row : rows) {
+        const auto& histogram = *row.histogram;
+        stream << std::left << std::setw(static_cast<int>(nameWidth)) << row.block << "  "
+               << std::setw(19) << row.callback << std::right << std::setw(10)
+               << histogram.getCount() << std::setw(14) << row.total / 1e6 << std::setw(12)
+               << us(histogram.getMean()) << std::setw(12)
+               << us(static_cast<double>(histogram.getPercentile(50))) << std::setw(12)
+               << us(static_cast<double>(histogram.getPercentile(99))) << std::setw(12)
+               << us(static_cast<double>(histogram.getMax())) << std::endl;
+    }
+}
+
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().releasedBlocks.clear();
+    forEachHistograms(registry(), [](const std::string& /*name*/, Histograms& histograms) {
+        for (auto& histogram : histograms) {
+            histogram.reset();
+        }
+    });
+}
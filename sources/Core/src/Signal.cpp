@@ -12,9 +12,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <ostream>
-#include <typeinfo>
 
 using namespace blockfactory::core;
 
@@ -29,7 +27,12 @@ void Signal::allocateBuffer(const void* const bufferInput, void*& bufferOutput,
     switch (m_portDataType) {
         case Port::DataType::DOUBLE: {
             // Allocate the array
-            bufferOutput = static_cast<void*>(new double[length]);
+            bufferOutput =
+                m_allocator->allocate(length * sizeof(double), Allocator::DefaultAlignment);
+            if (!bufferOutput) {
+                bfError << "Failed to allocate the buffer of the signal.";
+                return;
+            }
             // Cast to double
             const double* const bufferInputDouble = static_cast<const double*>(bufferInput);
             double* bufferOutputDouble = static_cast<double*>(bufferOutput);
@@ -52,7 +55,8 @@ void Signal::deleteBuffer()
 
     switch (m_portDataType) {
         case Port::DataType::DOUBLE:
-            delete[] static_cast<double*>(m_bufferPtr);
+            m_allocator->deallocate(
+                m_bufferPtr, m_width * sizeof(double), Allocator::DefaultAlignment);
             m_bufferPtr = nullptr;
             return;
         default:
@@ -75,25 +79,41 @@ Signal::Signal(const Signal& other)
     : m_width(other.m_width)
     , m_portDataType(other.m_portDataType)
     , m_dataFormat(other.m_dataFormat)
-    , m_bufferPtr(other.m_bufferPtr)
+    , m_allocator(other.m_allocator)
 {
-    if (m_bufferPtr) {
+    if (other.m_bufferPtr) {
         switch (m_dataFormat) {
             case DataFormat::CONTIGUOUS_ZEROCOPY:
-                // We just need the buffer pointer, which has been already copied
+                // We just need the buffer pointer
+                m_bufferPtr = other.m_bufferPtr;
                 break;
             case DataFormat::NONCONTIGUOUS:
-            case DataFormat::CONTIGUOUS:
-                // Copy the allocated data
-                allocateBuffer(other.m_bufferPtr, m_bufferPtr, other.m_width);
+            case DataFormat::CONTIGUOUS: {
+                // Copy the allocated data. The buffer of the other signal must never be shared,
+                // otherwise it would be released twice.
+                void* buffer = nullptr;
+                allocateBuffer(other.m_bufferPtr, buffer, other.m_width);
+                m_bufferPtr = buffer;
                 break;
+            }
         }
     }
+
+    if (!m_bufferPtr) {
+        m_width = 0;
+    }
 }
 
 Signal::Signal(const DataFormat& dataFormat, const Port::DataType& dataType)
+    : Signal(dataFormat, dataType, nullptr)
+{}
+
+Signal::Signal(const DataFormat& dataFormat,
+               const Port::DataType& dataType,
+               Allocator* allocator)
     : m_portDataType(dataType)
     , m_dataFormat(dataFormat)
+    , m_allocator(allocator ? allocator : &Allocator::getDefault())
 {}
 
 Signal::Signal(Signal&& other)
@@ -101,6 +121,7 @@ Signal::Signal(Signal&& other)
     , m_portDataType(other.m_portDataType)
     , m_dataFormat(other.m_dataFormat)
     , m_bufferPtr(other.m_bufferPtr)
+    , m_allocator(other.m_allocator)
 {
     other.m_width = 0;
     other.m_bufferPtr = nullptr;
@@ -151,12 +172,20 @@ bool Signal::initializeBufferFromContiguous(const void* buffer, size_t len)
         return false;
     }
 
+    // Release the data of a previous initialization
+    deleteBuffer();
+
     // Store the length
     m_width = len;
 
     // Copy data from the external contiguous buffer to the internal buffer
     allocateBuffer(buffer, m_bufferPtr, m_width);
 
+    if (!m_bufferPtr) {
+        m_width = 0;
+        return false;
+    }
+
     return true;
 }
 
@@ -178,12 +207,20 @@ bool Signal::initializeBufferFromNonContiguous(const void* const* bufferPtrs, si
         return false;
     }
 
+    // Release the data of a previous initialization
+    deleteBuffer();
+
     // Store the length
     m_width = len;
 
     if (m_portDataType == Port::DataType::DOUBLE) {
         // Allocate a new vector to store data from the non-contiguous signal
-        m_bufferPtr = static_cast<void*>(new double[m_width]);
+        m_bufferPtr = m_allocator->allocate(m_width * sizeof(double), Allocator::DefaultAlignment);
+        if (!m_bufferPtr) {
+            bfError << "Failed to allocate the buffer of the signal.";
+            m_width = 0;
+            return false;
+        }
         double* bufferPtrDouble = static_cast<double*>(m_bufferPtr);
 
         // Copy data from MATLAB's memory to the Signal object
@@ -195,6 +232,11 @@ bool Signal::initializeBufferFromNonContiguous(const void* const* bufferPtrs, si
     return true;
 }
 
+Allocator& Signal::getAllocator() const
+{
+    return *m_allocator;
+}
+
 bool Signal::isValid() const
 {
     return m_bufferPtr && (m_width > 0);
@@ -215,6 +257,11 @@ Signal::DataFormat Signal::getDataFormat() const
     return m_dataFormat;
 }
 
+void Signal::reportError(const char* message)
+{
+    bfError << message;
+}
+
 bool Signal::set(const size_t index, const double data)
 {
     if (m_width <= index) {
@@ -256,6 +303,7 @@ namespace blockfactory {
         template double Signal::get<double>(const size_t i) const;
         template bool Signal::setBuffer<double>(const double* data, const size_t length);
         template double* Signal::getBufferImpl() const;
+        template bool Signal::setBufferImpl<double>(const double* data, const size_t length);
     } // namespace core
 } // namespace blockfactory
 
@@ -263,68 +311,7 @@ namespace blockfactory {
 // ===================
 
 template <typename T>
-T Signal::get(const size_t i) const
-{
-    const T* buffer = getBuffer<T>();
-
-    if (!buffer) {
-        bfError << "The buffer inside the signal has not been initialized properly.";
-        return {};
-    }
-
-    if (i >= m_width) {
-        bfError << "Trying to access an element that exceeds signal width.";
-        return {};
-    }
-
-    return buffer[i];
-}
-
-template <typename T>
-T* Signal::getBufferImpl() const
-{
-    const std::map<Port::DataType, size_t> mapDataTypeToHash = {
-        {Port::DataType::DOUBLE, typeid(double).hash_code()},
-        {Port::DataType::SINGLE, typeid(float).hash_code()},
-        {Port::DataType::INT8, typeid(int8_t).hash_code()},
-        {Port::DataType::UINT8, typeid(uint8_t).hash_code()},
-        {Port::DataType::INT16, typeid(int16_t).hash_code()},
-        {Port::DataType::UINT16, typeid(uint16_t).hash_code()},
-        {Port::DataType::INT32, typeid(int32_t).hash_code()},
-        {Port::DataType::UINT32, typeid(uint32_t).hash_code()},
-        {Port::DataType::BOOLEAN, typeid(bool).hash_code()}};
-
-    if (!m_bufferPtr) {
-        bfError << "The pointer to data is null. The signal was not configured properly.";
-        return nullptr;
-    }
-
-    // Check the returned matches the same type of the portType.
-    // If this is not met, applying pointer arithmetics on the returned
-    // pointer would show unknown behaviour.
-    if (typeid(T).hash_code() != mapDataTypeToHash.at(m_portDataType)) {
-        bfError << "Trying to get the buffer using a type different than its DataType";
-        return nullptr;
-    }
-
-    // Cast pointer and return it
-    return static_cast<T*>(m_bufferPtr);
-}
-
-template <typename T>
-T* Signal::getBuffer()
-{
-    return getBufferImpl<T>();
-}
-
-template <typename T>
-const T* Signal::getBuffer() const
-{
-    return getBufferImpl<T>();
-}
-
-template <typename T>
-bool Signal::setBuffer(const T* data, const size_t length)
+bool Signal::setBufferImpl(const T* data, const size_t length)
 {
     // Non contiguous signals follow the Simulink convention of being read-only.
     // They are used only for input signals.
@@ -350,12 +337,17 @@ bool Signal::setBuffer(const T* data, const size_t length)
         case DataFormat::CONTIGUOUS:
             // Delete the current array
             if (m_bufferPtr) {
-                delete getBuffer<T>();
+                m_allocator->deallocate(
+                    m_bufferPtr, m_width * sizeof(T), Allocator::DefaultAlignment);
                 m_bufferPtr = nullptr;
                 m_width = 0;
             }
             // Allocate a new empty array
-            m_bufferPtr = static_cast<void*>(new T[length]);
+            m_bufferPtr = m_allocator->allocate(length * sizeof(T), Allocator::DefaultAlignment);
+            if (!m_bufferPtr) {
+                bfError << "Failed to allocate the buffer of the signal.";
+                return false;
+            }
             m_width = length;
             // Fill it with new data
             std::copy(data, data + length, getBuffer<T>());
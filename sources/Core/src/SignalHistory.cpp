@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/SignalHistory.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <algorithm>
+#include <cstddef>
+
+using namespace blockfactory::core;
+
+SignalHistory::SignalHistory(const size_t width,
+                             const size_t capacity,
+                             const size_t maxWindow,
+                             Allocator* allocator)
+    : m_allocator(allocator ? *allocator : Allocator::getDefault())
+    , m_width(width)
+{
+    if (width == 0 || capacity == 0) {
+        bfError << "The width and the capacity of a signal history must be positive.";
+        return;
+    }
+
+    // Round the capacity to a power of two, so that the slots are indexed with a mask
+    m_capacity = 1;
+    while (m_capacity < capacity) {
+        m_capacity <<= 1;
+    }
+
+    m_maxWindow = maxWindow == 0 ? m_capacity : std::min(maxWindow, m_capacity);
+
+    m_buffer = static_cast<double*>(m_allocator.allocate(
+        getNumberOfSlots() * m_width * sizeof(double), Allocator::DefaultAlignment));
+
+    if (!m_buffer) {
+        bfError << "Failed to allocate the buffer of the signal history.";
+        return;
+    }
+
+    std::fill(m_buffer, m_buffer + getNumberOfSlots() * m_width, 0.0);
+}
+
+SignalHistory::~SignalHistory()
+{
+    if (m_buffer) {
+        m_allocator.deallocate(
+            m_buffer, getNumberOfSlots() * m_width * sizeof(double), Allocator::DefaultAlignment);
+    }
+}
+
+bool SignalHistory::push(const Signal& signal)
+{
+    const double* buffer = signal.getBuffer<double>();
+
+    if (!buffer || !isValid()) {
+        bfError << "The signal or the history are not valid.";
+        return false;
+    }
+
+    if (signal.getWidth() != m_width) {
+        bfError << "The width of the signal (" << signal.getWidth()
+                << ") does not match the width of the history (" << m_width << ").";
+        return false;
+    }
+
+    push(buffer);
+    return true;
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Tracer.h"
+#include "BlockFactory/Core/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace blockfactory::core;
+
+const size_t Tracer::DefaultCapacity;
+
+namespace {
+    // An element of the buffer. The session is written after the event, and an event can be read
+    // only if its session matches the current one.
+    struct Slot
+    {
+        Tracer::Event event;
+        std::atomic<uint32_t> session{0};
+    };
+
+    struct State
+    {
+        std::unique_ptr<Slot[]> slots;
+        size_t capacity = 0;
+        // Incremented by every start, so that the events of previous sessions are not read
+        uint32_t session = 0;
+        std::atomic<size_t> next{0};
+        std::atomic<uint64_t> dropped{0};
+        // The number of threads executing core::Tracer::record
+        std::atomic<uint32_t> recorders{0};
+        std::atomic<uint32_t> numberOfThreads{0};
+        std::chrono::steady_clock::time_point origin;
+
+        std::mutex namesMutex;
+        std::vector<std::string> names;
+        std::unordered_map<std::string, uint32_t> ids;
+    };
+
+    // The state is never destroyed, so that it can be accessed by the trace written at exit
+    State& state()
+    {
+        static auto* state = new State;
+        return *state;
+    }
+
+    uint32_t threadIndex()
+    {
+        thread_local const uint32_t index = state().numberOfThreads.fetch_add(1);
+        return index;
+    }
+
+    std::string getEnvironment()
+    {
+        const char* value = std::getenv("BLOCKFACTORY_TRACE");
+        return value ? std::string(value) : std::string();
+    }
+
+    bool startFromEnvironment()
+    {
+        if (getEnvironment().empty()) {
+            return false;
+        }
+
+        auto& s = state();
+        s.slots.reset(new Slot[Tracer::DefaultCapacity]);
+        s.capacity = Tracer::DefaultCapacity;
+        s.session = 1;
+        s.origin = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    // Get a slot whose event was completely written in the current session
+    const Slot* getCommittedSlot(const size_t index)
+    {
+        const auto& s = state();
+        if (index >= std::min(s.next.load(std::memory_order_acquire), s.capacity)) {
+            return nullptr;
+        }
+
+        const Slot& slot = s.slots[index];
+        return slot.session.load(std::memory_order_acquire) == s.session ? &slot : nullptr;
+    }
+
+    void writeJsonString(std::ostream& stream, const std::string& string)
+    {
+        stream << '"';
+        for (const char c : string) {
+            switch (c) {
+                case '"':
+                    stream << "\\\"";
+                    break;
+                case '\\':
+                    stream << "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        stream << escaped;
+                    }
+                    else {
+                        stream << c;
+                    }
+            }
+        }
+        stream << '"';
+    }
+
+    class ExitTrace
+    {
+    public:
+        ~ExitTrace() { Tracer::flush(); }
+    } exitTrace;
+} // namespace
+
+std::atomic<bool> Tracer::m_enabled{startFromEnvironment()};
+
+bool Tracer::start(const size_t capacity)
+{
+    if (isEnabled()) {
+        bfError << "The tracer is already enabled.";
+        return false;
+    }
+
+    if (capacity == 0) {
+        bfError << "The capacity of the tracer must be positive.";
+        return false;
+    }
+
+    auto& s = state();
+
+    // Threads that checked isEnabled before the previous stop might still be writing an event
+    while (s.recorders.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+
+    if (capacity != s.capacity) {
+        s.slots.reset(new Slot[capacity]);
+        s.capacity = capacity;
+    }
+
+    s.session++;
+    s.next = 0;
+    s.dropped = 0;
+    s.origin = std::chrono::steady_clock::now();
+
+    m_enabled.store(true, std::memory_order_seq_cst);
+    return true;
+}
+
+void Tracer::stop()
+{
+    m_enabled.store(false, std::memory_order_seq_cst);
+}
+
+uint32_t Tracer::registerName(const std::string& name)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.namesMutex);
+
+    const auto it = s.ids.find(name);
+    if (it != s.ids.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<uint32_t>(s.names.size());
+    s.names.push_back(name);
+    s.ids.emplace(name, id);
+    return id;
+}
+
+std::string Tracer::getName(const uint32_t id)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.namesMutex);
+    return id < s.names.size() ? s.names[id] : std::string();
+}
+
+void Tracer::record(const uint32_t name, const uint32_t category, const Phase phase)
+{
+    auto& s = state();
+    const auto now = std::chrono::steady_clock::now();
+
+    // Announce the access to the buffer, and check again that the tracer was not stopped after
+    // the caller checked isEnabled. While recorders is not 0, start does not replace the buffer.
+    s.recorders.fetch_add(1, std::memory_order_seq_cst);
+
+    if (!m_enabled.load(std::memory_order_seq_cst)) {
+        s.recorders.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    const size_t index = s.next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= s.capacity) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        s.recorders.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    auto& slot = s.slots[index];
+    slot.event.timestamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - s.origin).count());
+    slot.event.name = name;
+    slot.event.category = category;
+    slot.event.thread = threadIndex();
+    slot.event.phase = phase;
+    slot.session.store(s.session, std::memory_order_release);
+
+    s.recorders.fetch_sub(1, std::memory_order_release);
+}
+
+size_t Tracer::getNumberOfEvents()
+{
+    const auto& s = state();
+    return std::min(s.next.load(std::memory_order_acquire), s.capacity);
+}
+
+uint64_t Tracer::getNumberOfDroppedEvents()
+{
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+bool Tracer::getEvent(const size_t index, Event& event)
+{
+    const Slot* slot = getCommittedSlot(index);
+
+    if (!slot) {
+        return false;
+    }
+
+    event = slot->event;
+    return true;
+}
+
+void Tracer::writeChromeTrace(std::ostream& stream)
+{
+    const size_t numberOfEvents = getNumberOfEvents();
+
+    // Copy the names to avoid taking the lock for every event
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(state().namesMutex);
+        names = state().names;
+    }
+
+    const auto name = [&names](const uint32_t id) {
+        return id < names.size() ? names[id] : std::string();
+    };
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    stream << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    for (size_t i = 0; i < numberOfEvents; ++i) {
+        // Skip the events that are still being written
+        const Slot* slot = getCommittedSlot(i);
+        if (!slot) {
+            continue;
+        }
+        const auto& event = slot->event;
+
+        stream << (first ? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        writeJsonString(stream, name(event.name));
+        stream << ",\"cat\":";
+        writeJsonString(stream, name(event.category));
+        stream << ",\"ph\":\"" << (event.phase == Phase::Begin ? 'B' : 'E') << "\""
+               << ",\"ts\":" << static_cast<double>(event.timestamp) / 1e3
+               << ",\"pid\":0,\"tid\":" << event.thread << "}";
+    }
+
+    stream << "\n]}\n";
+}
+
+bool Tracer::writeChromeTrace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file) {
+        bfError << "Failed to open the trace file " << path << ".";
+        return false;
+    }
+
+    writeChromeTrace(file);
+    return static_cast<bool>(file);
+}
+
+bool Tracer::flush()
+{
+    const std::string path = getEnvironment();
+
+    if (path.empty()) {
+        return true;
+    }
+
+    // The logger is not used since this method is called also at exit
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open the trace file " << path << std::endl;
+        return false;
+    }
+
+    writeChromeTrace(file);
+    return static_cast<bool>(file);
+}
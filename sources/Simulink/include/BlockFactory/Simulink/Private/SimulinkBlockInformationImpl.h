@@ -14,6 +14,7 @@
 
 #include <simstruc.h>
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,9 @@ public:
     std::string confBlockName;
     std::vector<core::ParameterMetadata> paramsMetadata;
 
+    // The input ports that can be overwritten by the output ports, indexed by output port
+    std::map<PortIndex, int> inPlaceInputs;
+
     DataType mapSimulinkToPortType(const DTypeId typeId) const;
     DTypeId mapPortTypeToSimulink(const DataType dataType) const;
 
@@ -79,6 +83,14 @@ public:
     bool setInputPortMatrixSize(const PortIndex idx, const MatrixSize& size);
     bool setOutputPortVectorSize(const PortIndex idx, const VectorSize& size);
     bool setOutputPortMatrixSize(const PortIndex idx, const MatrixSize& size);
+    bool setInputPortTensorSize(const PortIndex idx, const core::Port::Dimensions& dims);
+    bool setOutputPortTensorSize(const PortIndex idx, const core::Port::Dimensions& dims);
+    bool setInputPortFrameSize(const PortIndex idx,
+                               const int frameSize,
+                               const core::Port::Dimensions& dims);
+    bool setOutputPortFrameSize(const PortIndex idx,
+                                const int frameSize,
+                                const core::Port::Dimensions& dims);
     size_t getNrOfInputPortElements(const PortIndex idx) const;
     size_t getNrOfOutputPortElements(const PortIndex idx) const;
     PortInfo getInputPortInfo(const PortIndex idx) const;
@@ -96,6 +108,16 @@ public:
     getNonContiguousSignalRawPtrFromInputPort(const PortIndex idx) const;
     ContiguousOutputSignalRawPtr getSignalRawPtrFromOutputPort(const PortIndex idx) const;
 
+    // ==============
+    // STATES METHODS
+    // ==============
+
+    size_t getNrOfContinuousStates() const;
+    double* getContinuousStatesRawPtr() const;
+    double* getContinuousStateDerivativesRawPtr() const;
+    size_t getNrOfDiscreteStates() const;
+    double* getDiscreteStatesRawPtr() const;
+
     // =================
     // SCALAR PARAMETERS
     // =================
@@ -108,14 +130,15 @@ public:
     // CELL / STRUCT / VECTOR PARAMETERS
     // =================================
 
-    bool getCellAtIndex(const ParameterIndex idx, mxpp::MxCell& value) const;
-    bool getStructAtIndex(const ParameterIndex idx, mxpp::MxStruct& value) const;
+    bool getCellAtIndex(const ParameterIndex idx, std::vector<double>& value) const;
+    bool getCellAtIndex(const ParameterIndex idx, std::vector<std::string>& value) const;
     bool getVectorAtIndex(const ParameterIndex idx, std::vector<double>& value) const;
 
     // ===========================
     // FIELDS OF STRUCT PARAMETERS
     // ===========================
 
+    const mxArray* getFieldAtIndex(const ParameterIndex idx, const std::string& fieldName) const;
     bool getStringFieldAtIndex(const ParameterIndex idx,
                                const std::string& fieldName,
                                std::string& value) const;
@@ -127,7 +150,10 @@ public:
                                 bool& value) const;
     bool getCellFieldAtIndex(const ParameterIndex idx,
                              const std::string& fieldName,
-                             mxpp::MxCell& value) const;
+                             std::vector<double>& value) const;
+    bool getCellFieldAtIndex(const ParameterIndex idx,
+                             const std::string& fieldName,
+                             std::vector<std::string>& value) const;
     bool getVectorDoubleFieldAtIndex(const ParameterIndex idx,
                                      const std::string& fieldName,
                                      std::vector<double>& value) const;
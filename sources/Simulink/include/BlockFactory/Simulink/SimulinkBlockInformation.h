@@ -61,6 +61,9 @@ public:
     core::Port::Size::Matrix getOutputPortMatrixSize(const core::Port::Index idx) const override;
     core::InputSignalPtr getInputPortSignal(const core::Port::Index idx) const override;
     core::OutputSignalPtr getOutputPortSignal(const core::Port::Index idx) const override;
+    core::OutputSignalPtr getContinuousStateSignal() const override;
+    core::OutputSignalPtr getContinuousStateDerivativeSignal() const override;
+    core::OutputSignalPtr getDiscreteStateSignal() const override;
 };
 
 #endif /* BLOCKFACTORY_MEX_SIMULINKBLOCKINFORMATION_H */
@@ -11,9 +11,11 @@
 
 #include "BlockFactory/Core/Block.h"
 #include "BlockFactory/Core/FactorySingleton.h"
+#include "BlockFactory/Core/InputChangeDetector.h"
 #include "BlockFactory/Core/Log.h"
 #include "BlockFactory/Core/Parameter.h"
 #include "BlockFactory/Core/Parameters.h"
+#include "BlockFactory/Core/Profiler.h"
 #include "BlockFactory/Simulink/SimulinkBlockInformation.h"
 
 #include <matrix.h>
@@ -32,7 +34,8 @@
 #include <utility>
 #include <vector>
 
-static const size_t NumPWork = 2;
+// The PWork stores the Block, the BlockInformation, and the InputChangeDetector of pure blocks
+static const size_t NumPWork = 3;
 const bool ForwardLogsToStdErr = true;
 
 static void catchLogMessages(bool status, SimStruct* S);
@@ -53,6 +56,45 @@ static void mdlCheckParameters(SimStruct* S)
 }
 #endif /*MDL_CHECK_PARAMETERS*/
 
+// Function: MDL_PROCESS_PARAMETERS
+#define MDL_PROCESS_PARAMETERS
+#if defined(MDL_PROCESS_PARAMETERS) && defined(MATLAB_MEX_FILE)
+static void mdlProcessParameters(SimStruct* S)
+{
+    if (ssGetNumPWork(S) != NumPWork || !ssGetPWork(S)) {
+        return;
+    }
+
+    // The outputs of pure blocks must be computed again after a change of the tunable parameters
+    auto* detector = static_cast<blockfactory::core::InputChangeDetector*>(ssGetPWorkValue(S, 2));
+    if (detector) {
+        detector->invalidate();
+    }
+}
+#endif /*MDL_PROCESS_PARAMETERS*/
+
+// Check that the dimensions proposed by the signal propagation match the concrete dimensions of
+// an N-D port. The dimensions of vectors and matrices are checked by Simulink.
+static bool
+dimensionsAreCompatible(const int_T numDims, const int_T* dims, const DimsInfo_T* dimsInfo)
+{
+    if (numDims <= 2) {
+        return true;
+    }
+
+    if (dimsInfo->numDims != numDims) {
+        return false;
+    }
+
+    for (int_T i = 0; i < numDims; ++i) {
+        if (dims[i] != DYNAMICALLY_SIZED && dims[i] != dimsInfo->dims[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 #define MDL_SET_INPUT_PORT_DIMENSION_INFO
 static void mdlSetInputPortDimensionInfo(SimStruct* S, int_T port, const DimsInfo_T* dimsInfo)
 {
@@ -60,6 +102,14 @@ static void mdlSetInputPortDimensionInfo(SimStruct* S, int_T port, const DimsInf
     // the signal propagation) accept it
     if (ssGetInputPortWidth(S, port) == DYNAMICALLY_SIZED) {
         if (dimsInfo->width != DYNAMICALLY_SIZED) {
+            if (!dimensionsAreCompatible(ssGetInputPortNumDimensions(S, port),
+                                         ssGetInputPortDimensions(S, port),
+                                         dimsInfo)) {
+                bfError << "The proposed dimensions of the input port " << port
+                        << " do not match the dimensions of the block.";
+                catchLogMessages(false, S);
+                return;
+            }
             if (!ssSetInputPortDimensionInfo(S, port, dimsInfo)) {
                 bfError << "Failed to set proposed sizes.";
                 catchLogMessages(false, S);
@@ -76,6 +126,14 @@ static void mdlSetOutputPortDimensionInfo(SimStruct* S, int_T port, const DimsIn
     // the signal propagation) accept it
     if (ssGetOutputPortWidth(S, port) == DYNAMICALLY_SIZED) {
         if (dimsInfo->width != DYNAMICALLY_SIZED) {
+            if (!dimensionsAreCompatible(ssGetOutputPortNumDimensions(S, port),
+                                         ssGetOutputPortDimensions(S, port),
+                                         dimsInfo)) {
+                bfError << "The proposed dimensions of the output port " << port
+                        << " do not match the dimensions of the block.";
+                catchLogMessages(false, S);
+                return;
+            }
             if (!ssSetOutputPortDimensionInfo(S, port, dimsInfo)) {
                 bfError << "Failed to set proposed sizes.";
                 catchLogMessages(false, S);
@@ -85,6 +143,36 @@ static void mdlSetOutputPortDimensionInfo(SimStruct* S, int_T port, const DimsIn
     }
 }
 
+#define MDL_SET_INPUT_PORT_FRAME_DATA
+static void mdlSetInputPortFrameData(SimStruct* S, int_T port, Frame_T frameData)
+{
+    // Only the ports configured with a frame size accept frame-based signals, and they do not
+    // accept sample-based signals
+    const bool isFramePort = ssGetInputPortFrameData(S, port) == FRAME_YES;
+    if ((frameData == FRAME_YES) != isFramePort) {
+        bfError << "The input port " << port
+                << (isFramePort ? " requires frame-based signals."
+                                : " does not accept frame-based signals.");
+        catchLogMessages(false, S);
+        return;
+    }
+
+    ssSetInputPortFrameData(S, port, frameData);
+}
+
+// Number of elements of a port, or DynamicSize if any of its dimensions is not yet known
+static int numberOfPortElements(const blockfactory::core::Port::Dimensions& dims)
+{
+    int elements = 1;
+    for (const int dim : dims) {
+        if (dim == blockfactory::core::Port::DynamicSize) {
+            return blockfactory::core::Port::DynamicSize;
+        }
+        elements *= dim;
+    }
+    return elements;
+}
+
 // Function: mdlInitializeSizes ===============================================
 // Abstract:
 //    The sizes information is used by Simulink to determine the S-function
@@ -122,9 +210,10 @@ static void mdlInitializeSizes(SimStruct* S)
 
     // We cannot save data in PWork during the initializeSizes phase.
 
-    // Two PWorks:
+    // Three PWorks:
     // 0: pointer to a Block implementation
     // 1: pointer to a BlockInformation implementation
+    // 2: pointer to the InputChangeDetector of pure blocks (nullptr for the other blocks)
     ssSetNumPWork(S, NumPWork);
 
     // Setup the block parameters' properties
@@ -153,6 +242,9 @@ static void mdlInitializeSizes(SimStruct* S)
     }
 #endif
 
+    // Blocks can define ports with more than 2 dimensions
+    ssAllowSignalsWithMoreThan2D(S);
+
     blockfactory::mex::SimulinkBlockInformation blockInfo(S);
     bool ok = block->configureSizeAndPorts(&blockInfo);
     catchLogMessages(ok, S);
@@ -180,12 +272,70 @@ static void mdlInitializeSizes(SimStruct* S)
         ssSetOutputPortOptimOpts(S, i, SS_NOT_REUSABLE_AND_GLOBAL);
     }
 
+    // Outputs computed in place can share the buffer of their input. The outputs of pure blocks
+    // must keep their value between steps, hence they always have a dedicated buffer. Blocks with
+    // states read their inputs also in mdlUpdate and mdlDerivatives, after the output has been
+    // written, hence their buffers are never shared.
+    const bool canComputeInPlace = !block->isPure() && block->numberOfDiscreteStates() == 0
+                                   && block->numberOfContinuousStates() == 0;
+
+    for (int i = 0; i < ssGetNumOutputPorts(S); ++i) {
+        const auto outputInfo = blockInfo.getOutputPortInfo(i);
+        const int input = outputInfo.inPlaceInput;
+
+        if (input == blockfactory::core::Port::NotInPlace) {
+            continue;
+        }
+
+        if (input < 0 || input >= ssGetNumInputPorts(S)) {
+            bfError << "The output port " << i << " is computed in place on the input port "
+                    << input << ", that does not exist.";
+            catchLogMessages(false, S);
+            return;
+        }
+
+        const auto inputInfo = blockInfo.getInputPortInfo(input);
+        if (inputInfo.dataType != outputInfo.dataType) {
+            bfError << "The output port " << i << " is computed in place on the input port "
+                    << input << ", that has a different data type.";
+            catchLogMessages(false, S);
+            return;
+        }
+
+        // Sizes that are not yet known cannot be verified, and the buffers are not shared
+        const int inputElements = numberOfPortElements(inputInfo.dimension);
+        const int outputElements = numberOfPortElements(outputInfo.dimension);
+
+        if (inputElements != blockfactory::core::Port::DynamicSize
+            && outputElements != blockfactory::core::Port::DynamicSize
+            && inputElements != outputElements) {
+            bfError << "The output port " << i << " is computed in place on the input port "
+                    << input << ", that has a different number of elements.";
+            catchLogMessages(false, S);
+            return;
+        }
+
+        if (!canComputeInPlace || inputElements == blockfactory::core::Port::DynamicSize
+            || outputElements == blockfactory::core::Port::DynamicSize) {
+            continue;
+        }
+
+        ssSetInputPortOptimOpts(S, input, SS_REUSABLE_AND_LOCAL);
+        ssSetInputPortOverWritable(S, input, true);
+        ssSetOutputPortOptimOpts(S, i, SS_REUSABLE_AND_LOCAL);
+    }
+
     ssSetNumSampleTimes(S, 1);
 
+    // Store the sample time until mdlInitializeSampleTimes, so that the block does not need to be
+    // created and its parameters parsed again. It might depend on the parameters.
+    delete static_cast<blockfactory::core::Block::SampleTime*>(ssGetUserData(S));
+    ssSetUserData(S, new blockfactory::core::Block::SampleTime(block->sampleTime()));
+
     ssSetSimStateCompliance(S, USE_CUSTOM_SIM_STATE); //??
 
     ssSetNumDiscStates(S, block->numberOfDiscreteStates());
-    ssSetNumContStates(S, 0); // block->numberOfContinuousStates());
+    ssSetNumContStates(S, block->numberOfContinuousStates());
 
     uint_T options = SS_OPTION_WORKS_WITH_CODE_REUSE | SS_OPTION_EXCEPTION_FREE_CODE
                      | SS_OPTION_ALLOW_INPUT_SCALAR_EXPANSION | SS_OPTION_USE_TLC_WITH_ACCELERATOR
@@ -217,9 +367,43 @@ static void mdlInitializeSizes(SimStruct* S)
 //   specified in ssSetNumSampleTimes.
 static void mdlInitializeSampleTimes(SimStruct* S)
 {
-    ssSetSampleTime(S, 0, INHERITED_SAMPLE_TIME);
-    ssSetOffsetTime(S, 0, 0.0);
-    ssSetModelReferenceSampleTimeDefaultInheritance(S);
+    // The sample time was read in mdlInitializeSizes, where the block was already configured
+    std::unique_ptr<blockfactory::core::Block::SampleTime> storedSampleTime(
+        static_cast<blockfactory::core::Block::SampleTime*>(ssGetUserData(S)));
+    ssSetUserData(S, nullptr);
+
+    if (!storedSampleTime) {
+        bfError << "The sample time of the block was not computed in mdlInitializeSizes.";
+        catchLogMessages(false, S);
+        return;
+    }
+
+    const auto sampleTime = *storedSampleTime;
+
+    // Continuous states are integrated by the solver at its own rate
+    if (sampleTime.period == blockfactory::core::Block::InheritedSampleTime
+        && ssGetNumContStates(S) > 0) {
+        ssSetSampleTime(S, 0, CONTINUOUS_SAMPLE_TIME);
+        ssSetOffsetTime(S, 0, 0.0);
+        return;
+    }
+
+    if (sampleTime.period == blockfactory::core::Block::InheritedSampleTime) {
+        ssSetSampleTime(S, 0, INHERITED_SAMPLE_TIME);
+        ssSetOffsetTime(S, 0, 0.0);
+        ssSetModelReferenceSampleTimeDefaultInheritance(S);
+        return;
+    }
+
+    if (sampleTime.period <= 0 || sampleTime.offset < 0 || sampleTime.offset >= sampleTime.period) {
+        bfError << "The block returned an invalid sample time (period=" << sampleTime.period
+                << ", offset=" << sampleTime.offset << ").";
+        catchLogMessages(false, S);
+        return;
+    }
+
+    ssSetSampleTime(S, 0, sampleTime.period);
+    ssSetOffsetTime(S, 0, sampleTime.offset);
 }
 
 // Function: mdlStart =======================================================
@@ -247,6 +431,13 @@ static void mdlStart(SimStruct* S)
         new blockfactory::mex::SimulinkBlockInformation(S);
     ssSetPWorkValue(S, 1, blockInfo);
 
+    // Allocate the InputChangeDetector of pure blocks and store its pointer in the PWork
+    blockfactory::core::InputChangeDetector* detector = nullptr;
+    if (block && block->isPure()) {
+        detector = new blockfactory::core::InputChangeDetector();
+    }
+    ssSetPWorkValue(S, 2, detector);
+
     if (!block || !blockInfo) {
         bfError << "Failed to create objects before storing them in the PWork.";
         catchLogMessages(false, S);
@@ -258,7 +449,9 @@ static void mdlStart(SimStruct* S)
     factory->addRef();
 
     // Call the initialize() method
-    bool ok = block->initialize(blockInfo);
+    using blockfactory::core::Profiler;
+    bool ok = Profiler::call(
+        block, blockInfo, Profiler::Callback::Initialize, &blockfactory::core::Block::initialize);
     catchLogMessages(ok, S);
 }
 
@@ -286,7 +479,12 @@ static void mdlUpdate(SimStruct* S, int_T tid)
     }
 
     // Call the updateDiscreteState() method
-    bool ok = block->updateDiscreteState(blockInfo);
+    using blockfactory::core::Profiler;
+    bool ok = Profiler::call(
+        block,
+        blockInfo,
+        Profiler::Callback::UpdateDiscreteState,
+        &blockfactory::core::Block::updateDiscreteState);
     catchLogMessages(ok, S);
 }
 #endif
@@ -322,9 +520,34 @@ static void mdlInitializeConditions(SimStruct* S)
 
 #define MDL_DERIVATIVES
 #if defined(MDL_DERIVATIVES) && defined(MATLAB_MEX_FILE)
-static void mdlDerivatives(SimStruct* /*S*/)
+static void mdlDerivatives(SimStruct* S)
 {
-    /* Add mdlDerivatives code here */
+    if (ssGetNumPWork(S) != NumPWork) {
+        bfError << "PWork should contain " << NumPWork << " elements.";
+        catchLogMessages(false, S);
+        return;
+    }
+
+    // Get the Block object
+    auto* block = static_cast<blockfactory::core::Block*>(ssGetPWorkValue(S, 0));
+
+    // Get the SimulinkBlockInformation object
+    auto* blockInfo = static_cast<blockfactory::core::BlockInformation*>(ssGetPWorkValue(S, 1));
+
+    if (!block || !blockInfo) {
+        bfError << "Failed to get pointers from the PWork vector.";
+        catchLogMessages(false, S);
+        return;
+    }
+
+    // Call the stateDerivative() method
+    using blockfactory::core::Profiler;
+    bool ok = Profiler::call(
+        block,
+        blockInfo,
+        Profiler::Callback::StateDerivative,
+        &blockfactory::core::Block::stateDerivative);
+    catchLogMessages(ok, S);
 }
 #endif
 
@@ -353,8 +576,17 @@ static void mdlOutputs(SimStruct* S, int_T tid)
         return;
     }
 
+    // Skip the output() method of pure blocks if their inputs did not change. The output ports
+    // are not reusable, hence they keep the outputs of the previous step.
+    auto* detector = static_cast<blockfactory::core::InputChangeDetector*>(ssGetPWorkValue(S, 2));
+    if (detector && !detector->update(blockInfo, static_cast<size_t>(ssGetNumInputPorts(S)))) {
+        return;
+    }
+
     // Call the output() method
-    bool ok = block->output(blockInfo);
+    using blockfactory::core::Profiler;
+    bool ok = Profiler::call(
+        block, blockInfo, Profiler::Callback::Output, &blockfactory::core::Block::output);
     catchLogMessages(ok, S);
 }
 
@@ -392,7 +624,10 @@ static void mdlTerminate(SimStruct* S)
     // Note that it might not exist, e.g. when the initialization fails not all blocks
     // are created, but in any case the terminate method is called for all of them.
     if (factory && block) {
-        if (block->terminate(blockInfo)) {
+        using blockfactory::core::Profiler;
+        const bool ok = Profiler::call(
+            block, blockInfo, Profiler::Callback::Terminate, &blockfactory::core::Block::terminate);
+        if (ok) {
             // Delete the block using the factory
             factory->destroy(block);
             block = nullptr;
@@ -425,12 +660,14 @@ static void mdlTerminate(SimStruct* S)
         }
     }
 
-    // Delete the BlockInformation object from the PWork vector
+    // Delete the BlockInformation and the InputChangeDetector objects from the PWork vector
     delete blockInfo;
+    delete static_cast<blockfactory::core::InputChangeDetector*>(ssGetPWorkValue(S, 2));
 
     // Clean the PWork vector
     ssSetPWorkValue(S, 0, nullptr);
     ssSetPWorkValue(S, 1, nullptr);
+    ssSetPWorkValue(S, 2, nullptr);
 
     // Report warnings if any
     catchLogMessages(true, S);
@@ -746,6 +983,7 @@ bool writeParameterToRTW(const blockfactory::core::Parameter<std::string> param,
 
 bool writeRTW(SimStruct* S,
               const std::string& blockUniqueName,
+              const bool skipUnchangedInputs,
               const blockfactory::core::Parameters& params)
 {
     // RTW Parameters record metadata
@@ -767,7 +1005,7 @@ bool writeRTW(SimStruct* S,
 
     // Create the record
     ssWriteRTWParamSettings(S,
-                            4,
+                            5,
                             SSWRITE_VALUE_NUM,
                             "numberOfParameters",
                             static_cast<real_T>(numberOfParameters),
@@ -779,7 +1017,10 @@ bool writeRTW(SimStruct* S,
                             className.c_str(),
                             SSWRITE_VALUE_QSTR,
                             "libName",
-                            libName.c_str());
+                            libName.c_str(),
+                            SSWRITE_VALUE_NUM,
+                            "skipUnchangedInputs",
+                            static_cast<real_T>(skipUnchangedInputs));
 
     // RTW Parameters
     // ==============
@@ -843,8 +1084,15 @@ static void mdlRTW(SimStruct* S)
         std::string blockUniqueName;
         blockInfo->getUniqueName(blockUniqueName);
 
+        // The generated code has no step that changes the parameters and invalidates the
+        // InputChangeDetector, hence only pure blocks without tunable parameters skip their output
+        bool skipUnchangedInputs = block->isPure();
+        for (unsigned i = 0; i < block->numberOfParameters() && skipUnchangedInputs; ++i) {
+            skipUnchangedInputs = !block->parameterAtIndexIsTunable(i);
+        }
+
         // Use parameters metadata to populate the rtw file used by the coder
-        ok = writeRTW(S, blockUniqueName, params);
+        ok = writeRTW(S, blockUniqueName, skipUnchangedInputs, params);
         catchLogMessages(ok, S);
         if (!ok) {
             bfError << "Failed to write parameters to the RTW file during the code "
@@ -58,7 +58,12 @@ SimulinkBlockInformation::getInputPortWidth(const core::Port::Index idx) const
         return {};
     }
 
-    return portInfo.dimension[0];
+    // Frames have the width of all their samples
+    const int width = portInfo.dimension[0];
+    if (width == core::Port::DynamicSize || portInfo.frameSize == core::Port::DynamicSize) {
+        return core::Port::DynamicSize;
+    }
+    return portInfo.frameSize * width;
 }
 
 core::Port::Size::Vector
@@ -73,7 +78,12 @@ SimulinkBlockInformation::getOutputPortWidth(const core::Port::Index idx) const
         return {};
     }
 
-    return portInfo.dimension[0];
+    // Frames have the width of all their samples
+    const int width = portInfo.dimension[0];
+    if (width == core::Port::DynamicSize || portInfo.frameSize == core::Port::DynamicSize) {
+        return core::Port::DynamicSize;
+    }
+    return portInfo.frameSize * width;
 }
 
 core::InputSignalPtr SimulinkBlockInformation::getInputPortSignal(const core::Port::Index idx) const
@@ -211,11 +221,51 @@ SimulinkBlockInformation::getOutputPortSignal(const core::Port::Index idx) const
     return signal;
 }
 
+// Create a signal pointing to the state vectors owned by the Simulink engine
+static core::OutputSignalPtr createStateSignal(double* buffer, const size_t numberOfStates)
+{
+    if (!buffer || numberOfStates == 0) {
+        bfError << "The block has no states of the requested type.";
+        return {};
+    }
+
+    auto signal = std::make_shared<core::Signal>(core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY,
+                                                 core::Port::DataType::DOUBLE);
+
+    if (!signal->initializeBufferFromContiguousZeroCopy(buffer, numberOfStates)) {
+        bfError << "Failed to initialize the CONTIGUOUS_ZEROCOPY state signal.";
+        return {};
+    }
+
+    return signal;
+}
+
+core::OutputSignalPtr SimulinkBlockInformation::getContinuousStateSignal() const
+{
+    return createStateSignal(pImpl->getContinuousStatesRawPtr(), pImpl->getNrOfContinuousStates());
+}
+
+core::OutputSignalPtr SimulinkBlockInformation::getContinuousStateDerivativeSignal() const
+{
+    return createStateSignal(pImpl->getContinuousStateDerivativesRawPtr(),
+                             pImpl->getNrOfContinuousStates());
+}
+
+core::OutputSignalPtr SimulinkBlockInformation::getDiscreteStateSignal() const
+{
+    return createStateSignal(pImpl->getDiscreteStatesRawPtr(), pImpl->getNrOfDiscreteStates());
+}
+
 core::Port::Size::Matrix
 SimulinkBlockInformation::getInputPortMatrixSize(const core::Port::Index idx) const
 {
     core::Port::Info portInfo = getInputPortInfo(idx);
 
+    // Frames are frameSize x width matrices, as in Simulink
+    if (portInfo.frameSize > 1 && portInfo.dimension.size() == 1) {
+        return {portInfo.frameSize, portInfo.dimension[0]};
+    }
+
     if (portInfo.dimension.size() != 2) {
         bfError << "Input port at index " << idx
                 << "does not contain a matrix. Failed to get its size.";
@@ -231,6 +281,11 @@ SimulinkBlockInformation::getOutputPortMatrixSize(const core::Port::Index idx) c
 {
     core::Port::Info portInfo = getOutputPortInfo(idx);
 
+    // Frames are frameSize x width matrices, as in Simulink
+    if (portInfo.frameSize > 1 && portInfo.dimension.size() == 1) {
+        return {portInfo.frameSize, portInfo.dimension[0]};
+    }
+
     if (portInfo.dimension.size() != 2) {
         bfError << "Output port at index " << idx
                 << "does not contain a matrix. Failed to get its size.";
@@ -350,20 +405,11 @@ bool SimulinkBlockInformation::parseParameters(core::Parameters& parameters)
             case core::ParameterType::CELL_INT:
             case core::ParameterType::CELL_BOOL:
             case core::ParameterType::CELL_DOUBLE: {
-                mxpp::MxCell cell;
-                if (!pImpl->getCellAtIndex(paramMD.index, cell)) {
-                    bfError << "Failed to get cell parameter at index " << paramMD.index << ".";
-                    return false;
-                }
                 std::vector<double> paramVector;
-                for (auto element : cell) {
-                    double value;
-                    if (!element->asDouble(value)) {
-                        bfError << "Failed to parse an element of the cell at index "
-                                << paramMD.index << " as a double.";
-                        return false;
-                    }
-                    paramVector.push_back(value);
+                if (!pImpl->getCellAtIndex(paramMD.index, paramVector)) {
+                    bfError << "Failed to parse the cell parameter at index " << paramMD.index
+                            << " as a vector of doubles.";
+                    return false;
                 }
                 if (hasDynSizeColumns) {
                     if (!handleDynSizeColumns(paramMD.cols, static_cast<int>(paramVector.size()))) {
@@ -374,20 +420,11 @@ bool SimulinkBlockInformation::parseParameters(core::Parameters& parameters)
                 break;
             }
             case core::ParameterType::CELL_STRING: {
-                mxpp::MxCell cell;
-                if (!pImpl->getCellAtIndex(paramMD.index, cell)) {
-                    bfError << "Failed to get cell parameter at index " << paramMD.index << ".";
-                    return false;
-                }
                 std::vector<std::string> paramVector;
-                for (auto element : cell) {
-                    std::string value;
-                    if (!element->asString(value)) {
-                        bfError << "Failed to parse an element of the cell at index "
-                                << paramMD.index << " as a string.";
-                        return false;
-                    }
-                    paramVector.push_back(value);
+                if (!pImpl->getCellAtIndex(paramMD.index, paramVector)) {
+                    bfError << "Failed to parse the cell parameter at index " << paramMD.index
+                            << " as a vector of strings.";
+                    return false;
                 }
                 if (hasDynSizeColumns) {
                     if (!handleDynSizeColumns(paramMD.cols, static_cast<int>(paramVector.size()))) {
@@ -448,22 +485,13 @@ bool SimulinkBlockInformation::parseParameters(core::Parameters& parameters)
             case core::ParameterType::STRUCT_CELL_INT:
             case core::ParameterType::STRUCT_CELL_BOOL:
             case core::ParameterType::STRUCT_CELL_DOUBLE: {
-                mxpp::MxCell cell;
                 std::vector<double> paramVector;
-                if (!pImpl->getCellFieldAtIndex(paramMD.index, paramMD.name, cell)) {
-                    bfError << "Failed to get cell field " << paramMD.name
-                            << " from the struct at index " << paramMD.index << ".";
+                if (!pImpl->getCellFieldAtIndex(paramMD.index, paramMD.name, paramVector)) {
+                    bfError << "Failed to parse the cell field " << paramMD.name
+                            << " from the struct at index " << paramMD.index
+                            << " as a vector of doubles.";
                     return false;
                 }
-                for (auto element : cell) {
-                    double value;
-                    if (!element->asDouble(value)) {
-                        bfError << "Failed to parse an element of the cell field " << paramMD.name
-                                << " from the struct at index " << paramMD.index << " as a double.";
-                        return false;
-                    }
-                    paramVector.push_back(value);
-                }
                 if (hasDynSizeColumns) {
                     if (!handleDynSizeColumns(paramMD.cols, static_cast<int>(paramVector.size()))) {
                         return false;
@@ -473,22 +501,13 @@ bool SimulinkBlockInformation::parseParameters(core::Parameters& parameters)
                 break;
             }
             case core::ParameterType::STRUCT_CELL_STRING: {
-                mxpp::MxCell cell;
                 std::vector<std::string> paramVector;
-                if (!pImpl->getCellFieldAtIndex(paramMD.index, paramMD.name, cell)) {
-                    bfError << "Failed to get cell field " << paramMD.name
-                            << " from the struct at index " << paramMD.index << ".";
+                if (!pImpl->getCellFieldAtIndex(paramMD.index, paramMD.name, paramVector)) {
+                    bfError << "Failed to parse the cell field " << paramMD.name
+                            << " from the struct at index " << paramMD.index
+                            << " as a vector of strings.";
                     return false;
                 }
-                for (auto element : cell) {
-                    std::string value;
-                    if (!element->asString(value)) {
-                        bfError << "Failed to parse an element of the cell field " << paramMD.name
-                                << " from the struct at index " << paramMD.index << " as a string.";
-                        return false;
-                    }
-                    paramVector.push_back(value);
-                }
                 if (hasDynSizeColumns) {
                     if (!handleDynSizeColumns(paramMD.cols, static_cast<int>(paramVector.size()))) {
                         return false;
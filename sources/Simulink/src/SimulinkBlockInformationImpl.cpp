@@ -13,10 +13,37 @@
 
 #include <cassert>
 #include <simstruc.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace blockfactory;
 using namespace blockfactory::mex::impl;
 
+// Convert N-D port dimensions to the Simulink structure. The storage of the dimensions must
+// outlive the structure.
+static void fillDimsInfo(const core::Port::Dimensions& dims,
+                         std::vector<int_T>& storage,
+                         DimsInfo_T& dimsInfo)
+{
+    int_T width = 1;
+    storage.clear();
+
+    for (const int dim : dims) {
+        if (dim == core::Port::DynamicSize) {
+            storage.push_back(DYNAMICALLY_SIZED);
+            width = DYNAMICALLY_SIZED;
+            continue;
+        }
+        storage.push_back(dim);
+        width = width == DYNAMICALLY_SIZED ? width : width * dim;
+    }
+
+    dimsInfo.numDims = static_cast<int_T>(storage.size());
+    dimsInfo.dims = storage.data();
+    dimsInfo.width = width;
+}
+
 SimulinkBlockInformationImpl::SimulinkBlockInformationImpl(SimStruct* ss)
     : simstruct(ss)
 {}
@@ -96,13 +123,18 @@ DTypeId SimulinkBlockInformationImpl::mapPortTypeToSimulink(const DataType dataT
 
 bool SimulinkBlockInformationImpl::updateInputPortInfo(const PortInfo& portInfo)
 {
-    if (portInfo.dimension.size() > 2) {
-        bfError << "Only vector (1D) and matrix (2D) input ports are supported.";
-        return false;
-    }
-
     bool ok = false;
 
+    // Frames are configured as frameSize x width frame-based matrices
+    if (portInfo.frameSize != 1) {
+        if (!setInputPortFrameSize(portInfo.index, portInfo.frameSize, portInfo.dimension)
+            || !setInputPortType(portInfo.index, portInfo.dataType)) {
+            bfError << "Failed to configure input port with index " << portInfo.index << ".";
+            return false;
+        }
+        return true;
+    }
+
     switch (portInfo.dimension.size()) {
         // 1D Vector
         case 1: {
@@ -119,6 +151,13 @@ bool SimulinkBlockInformationImpl::updateInputPortInfo(const PortInfo& portInfo)
                  && setInputPortType(portInfo.index, portInfo.dataType);
             break;
         }
+            // N-D Tensor
+        default: {
+            ok = !portInfo.dimension.empty()
+                 && setInputPortTensorSize(portInfo.index, portInfo.dimension)
+                 && setInputPortType(portInfo.index, portInfo.dataType);
+            break;
+        }
     }
 
     if (!ok) {
@@ -131,12 +170,22 @@ bool SimulinkBlockInformationImpl::updateInputPortInfo(const PortInfo& portInfo)
 
 bool SimulinkBlockInformationImpl::updateOutputPortInfo(const PortInfo& portInfo)
 {
-    if (portInfo.dimension.size() > 2) {
-        bfError << "Only vector (1D) and matrix (2D) output ports are supported.";
-        return false;
+    bool ok = false;
+
+    // The sharing of the buffers is configured by the S-function after all the ports are set
+    if (portInfo.inPlaceInput != core::Port::NotInPlace) {
+        inPlaceInputs[portInfo.index] = portInfo.inPlaceInput;
     }
 
-    bool ok = false;
+    // Frames are configured as frameSize x width frame-based matrices
+    if (portInfo.frameSize != 1) {
+        if (!setOutputPortFrameSize(portInfo.index, portInfo.frameSize, portInfo.dimension)
+            || !setOutputPortType(portInfo.index, portInfo.dataType)) {
+            bfError << "Failed to configure output port with index " << portInfo.index << ".";
+            return false;
+        }
+        return true;
+    }
 
     switch (portInfo.dimension.size()) {
         // 1D Vector
@@ -154,6 +203,13 @@ bool SimulinkBlockInformationImpl::updateOutputPortInfo(const PortInfo& portInfo
                  && setOutputPortType(portInfo.index, portInfo.dataType);
             break;
         }
+            // N-D Tensor
+        default: {
+            ok = !portInfo.dimension.empty()
+                 && setOutputPortTensorSize(portInfo.index, portInfo.dimension)
+                 && setOutputPortType(portInfo.index, portInfo.dataType);
+            break;
+        }
     }
 
     if (!ok) {
@@ -239,11 +295,70 @@ bool SimulinkBlockInformationImpl::setOutputPortMatrixSize(const PortIndex idx,
     return ssSetOutputPortMatrixDimensions(simstruct, static_cast<int>(idx), size.rows, size.cols);
 }
 
+bool SimulinkBlockInformationImpl::setInputPortFrameSize(const PortIndex idx,
+                                                         const int frameSize,
+                                                         const core::Port::Dimensions& dims)
+{
+    // Refer to: https://it.mathworks.com/help/simulink/sfg/sssetinputportframedata.html
+    if (frameSize < 1 || dims.size() != 1) {
+        bfError << "Frames are supported only by vector ports.";
+        return false;
+    }
+
+    if (!setInputPortTensorSize(idx, {frameSize, dims.front()})) {
+        return false;
+    }
+
+    ssSetInputPortFrameData(simstruct, static_cast<int>(idx), FRAME_YES);
+    return true;
+}
+
+bool SimulinkBlockInformationImpl::setOutputPortFrameSize(const PortIndex idx,
+                                                          const int frameSize,
+                                                          const core::Port::Dimensions& dims)
+{
+    // Refer to: https://it.mathworks.com/help/simulink/sfg/sssetoutputportframedata.html
+    if (frameSize < 1 || dims.size() != 1) {
+        bfError << "Frames are supported only by vector ports.";
+        return false;
+    }
+
+    if (!setOutputPortTensorSize(idx, {frameSize, dims.front()})) {
+        return false;
+    }
+
+    ssSetOutputPortFrameData(simstruct, static_cast<int>(idx), FRAME_YES);
+    return true;
+}
+
+bool SimulinkBlockInformationImpl::setInputPortTensorSize(const PortIndex idx,
+                                                          const core::Port::Dimensions& dims)
+{
+    // Refer to: https://it.mathworks.com/help/simulink/sfg/sssetinputportdimensioninfo.html
+    std::vector<int_T> simulinkDims;
+    DECL_AND_INIT_DIMSINFO(dimsInfo);
+    fillDimsInfo(dims, simulinkDims, dimsInfo);
+
+    return ssSetInputPortDimensionInfo(simstruct, static_cast<int>(idx), &dimsInfo);
+}
+
+bool SimulinkBlockInformationImpl::setOutputPortTensorSize(const PortIndex idx,
+                                                           const core::Port::Dimensions& dims)
+{
+    // Refer to: https://it.mathworks.com/help/simulink/sfg/sssetoutputportdimensioninfo.html
+    std::vector<int_T> simulinkDims;
+    DECL_AND_INIT_DIMSINFO(dimsInfo);
+    fillDimsInfo(dims, simulinkDims, dimsInfo);
+
+    return ssSetOutputPortDimensionInfo(simstruct, static_cast<int>(idx), &dimsInfo);
+}
+
 size_t SimulinkBlockInformationImpl::getNrOfInputPortElements(const PortIndex idx) const
 {
     PortInfo portInfo = getInputPortInfo(idx);
 
-    size_t nrOfElements = 1;
+    // Frames store all their samples in the same signal
+    size_t nrOfElements = static_cast<size_t>(portInfo.frameSize);
     for (int dim : portInfo.dimension) {
         dim == core::Port::DynamicSize ? dim = 0 : true;
         nrOfElements *= dim;
@@ -256,7 +371,8 @@ size_t SimulinkBlockInformationImpl::getNrOfOutputPortElements(const PortIndex i
 {
     PortInfo portInfo = getOutputPortInfo(idx);
 
-    size_t nrOfElements = 1;
+    // Frames store all their samples in the same signal
+    size_t nrOfElements = static_cast<size_t>(portInfo.frameSize);
     for (int dim : portInfo.dimension) {
         dim == core::Port::DynamicSize ? dim = 0 : true;
         nrOfElements *= dim;
@@ -286,12 +402,30 @@ SimulinkBlockInformationImpl::getInputPortInfo(const PortIndex idx) const
             portDimension = {dims[0], dims[1]};
             break;
         }
-        default:
-            bfError << "Unsupported number of port dimensions for port at index " << idx;
-            assert(false);
+        default: {
+            const int_T numDims = ssGetInputPortNumDimensions(simstruct, idx);
+            const int_T* dims = ssGetInputPortDimensions(simstruct, idx);
+            if (numDims < 1 || !dims) {
+                bfError << "Unsupported number of port dimensions for port at index " << idx;
+                assert(false);
+                break;
+            }
+            for (int_T i = 0; i < numDims; ++i) {
+                portDimension.push_back(dims[i] == DYNAMICALLY_SIZED ? core::Port::DynamicSize
+                                                                     : dims[i]);
+            }
+            break;
+        }
     }
 
-    return {idx, portDimension, dt};
+    // Frames are frameSize x width matrices. The dimension of the port is that of a sample.
+    int frameSize = 1;
+    if (ssGetInputPortFrameData(simstruct, idx) == FRAME_YES && portDimension.size() == 2) {
+        frameSize = portDimension[0];
+        portDimension = {portDimension[1]};
+    }
+
+    return {idx, portDimension, dt, frameSize};
 }
 
 SimulinkBlockInformationImpl::PortInfo
@@ -315,12 +449,35 @@ SimulinkBlockInformationImpl::getOutputPortInfo(const PortIndex idx) const
             portDimension = {dims[0], dims[1]};
             break;
         }
-        default:
-            bfError << "Unsupported number of port dimensions for port at index " << idx;
-            assert(false);
+        default: {
+            const int_T numDims = ssGetOutputPortNumDimensions(simstruct, idx);
+            const int_T* dims = ssGetOutputPortDimensions(simstruct, idx);
+            if (numDims < 1 || !dims) {
+                bfError << "Unsupported number of port dimensions for port at index " << idx;
+                assert(false);
+                break;
+            }
+            for (int_T i = 0; i < numDims; ++i) {
+                portDimension.push_back(dims[i] == DYNAMICALLY_SIZED ? core::Port::DynamicSize
+                                                                     : dims[i]);
+            }
+            break;
+        }
     }
 
-    return {idx, portDimension, dt};
+    // Frames are frameSize x width matrices. The dimension of the port is that of a sample.
+    int frameSize = 1;
+    if (ssGetOutputPortFrameData(simstruct, idx) == FRAME_YES && portDimension.size() == 2) {
+        frameSize = portDimension[0];
+        portDimension = {portDimension[1]};
+    }
+
+    const auto inPlaceInput = inPlaceInputs.find(idx);
+    if (inPlaceInput != inPlaceInputs.end()) {
+        return {idx, portDimension, dt, frameSize, inPlaceInput->second};
+    }
+
+    return {idx, portDimension, dt, frameSize};
 }
 
 bool SimulinkBlockInformationImpl::isInputPortDynamicallySized(const PortIndex idx) const
@@ -375,6 +532,35 @@ SimulinkBlockInformationImpl::getSignalRawPtrFromOutputPort(const PortIndex idx)
     return static_cast<int>(idx) >= ssGetNumOutputPorts(simstruct) ? nullptr : ptr;
 }
 
+// ==============
+// STATES METHODS
+// ==============
+
+size_t SimulinkBlockInformationImpl::getNrOfContinuousStates() const
+{
+    return static_cast<size_t>(ssGetNumContStates(simstruct));
+}
+
+double* SimulinkBlockInformationImpl::getContinuousStatesRawPtr() const
+{
+    return ssGetNumContStates(simstruct) > 0 ? ssGetContStates(simstruct) : nullptr;
+}
+
+double* SimulinkBlockInformationImpl::getContinuousStateDerivativesRawPtr() const
+{
+    return ssGetNumContStates(simstruct) > 0 ? ssGetdX(simstruct) : nullptr;
+}
+
+size_t SimulinkBlockInformationImpl::getNrOfDiscreteStates() const
+{
+    return static_cast<size_t>(ssGetNumDiscStates(simstruct));
+}
+
+double* SimulinkBlockInformationImpl::getDiscreteStatesRawPtr() const
+{
+    return ssGetNumDiscStates(simstruct) > 0 ? ssGetRealDiscStates(simstruct) : nullptr;
+}
+
 // =================
 // SCALAR PARAMETERS
 // =================
@@ -417,18 +603,54 @@ bool SimulinkBlockInformationImpl::getStringParameterAtIndex(const ParameterInde
 // CELL / STRUCT / VECTOR PARAMETERS
 // =================================
 
+// Parse the elements of a cell without allocating a wrapper for each of them up front
+template <typename T>
+static bool readCell(const mxArray* cell, std::vector<T>& value, bool (*read)(mxpp::MxArray&, T&))
+{
+    if (!cell || !mxIsCell(cell)) {
+        return false;
+    }
+
+    const mxpp::MxArray cellArray(cell);
+    value.clear();
+    value.reserve(cellArray.getNumberOfElements());
+
+    for (size_t i = 0; i < cellArray.getNumberOfElements(); ++i) {
+        const mxArray* element = cellArray.getCellElement(i);
+        if (!element) {
+            return false;
+        }
+        mxpp::MxArray elementArray(element);
+        T elementValue;
+        if (!read(elementArray, elementValue)) {
+            bfError << "Failed to parse the element " << i << " of the cell.";
+            return false;
+        }
+        value.push_back(std::move(elementValue));
+    }
+    return true;
+}
+
+static bool readDouble(mxpp::MxArray& array, double& value)
+{
+    return array.asDouble(value);
+}
+
+static bool readString(mxpp::MxArray& array, std::string& value)
+{
+    return array.asString(value);
+}
+
 bool SimulinkBlockInformationImpl::getCellAtIndex(const ParameterIndex idx,
-                                                  mxpp::MxCell& value) const
+                                                  std::vector<double>& value) const
 {
-    const mxArray* blockParam = ssGetSFcnParam(simstruct, idx);
-    return mxpp::MxArray(blockParam).asMxCell(value);
+    return readCell<double>(ssGetSFcnParam(simstruct, idx), value, readDouble);
 }
 
-bool SimulinkBlockInformationImpl::getStructAtIndex(const ParameterIndex idx,
-                                                    mxpp::MxStruct& value) const
+bool SimulinkBlockInformationImpl::getCellAtIndex(const ParameterIndex idx,
+                                                  std::vector<std::string>& value) const
 {
-    const mxArray* blockParam = ssGetSFcnParam(simstruct, idx);
-    return mxpp::MxArray(blockParam).asMxStruct(value);
+    return readCell<std::string>(ssGetSFcnParam(simstruct, idx), value, readString);
 }
 
 bool SimulinkBlockInformationImpl::getVectorAtIndex(const ParameterIndex idx,
@@ -442,97 +664,71 @@ bool SimulinkBlockInformationImpl::getVectorAtIndex(const ParameterIndex idx,
 // FIELDS OF STRUCT PARAMETERS
 // ===========================
 
-bool SimulinkBlockInformationImpl::getStringFieldAtIndex(const ParameterIndex idx,
-                                                         const std::string& fieldName,
-                                                         std::string& value) const
+const mxArray* SimulinkBlockInformationImpl::getFieldAtIndex(const ParameterIndex idx,
+                                                             const std::string& fieldName) const
 {
-    mxpp::MxStruct s;
+    const mxArray* blockParam = ssGetSFcnParam(simstruct, idx);
 
-    if (!getStructAtIndex(idx, s)) {
+    if (!blockParam || !mxIsStruct(blockParam)) {
         bfError << "Failed to get struct at index " << idx << ".";
-        return false;
+        return nullptr;
     }
 
-    if (s.find(fieldName) == s.end()) {
+    // Only the requested field is accessed, the other fields of the struct are not parsed
+    const mxArray* field = mxpp::MxArray(blockParam).getField(fieldName);
+
+    if (!field) {
         bfError << "Struct at index " << idx << " does not contain any " << fieldName << " field.";
-        return false;
+        return nullptr;
     }
 
-    return s.at(fieldName)->asString(value);
+    return field;
+}
+
+bool SimulinkBlockInformationImpl::getStringFieldAtIndex(const ParameterIndex idx,
+                                                         const std::string& fieldName,
+                                                         std::string& value) const
+{
+    const mxArray* field = getFieldAtIndex(idx, fieldName);
+    return field && mxpp::MxArray(field).asString(value);
 }
 
 bool SimulinkBlockInformationImpl::getScalarFieldAtIndex(const ParameterIndex idx,
                                                          const std::string& fieldName,
                                                          double& value) const
 {
-    mxpp::MxStruct s;
-
-    if (!getStructAtIndex(idx, s)) {
-        bfError << "Failed to get struct at index " << idx << ".";
-        return false;
-    }
-
-    if (s.find(fieldName) == s.end()) {
-        bfError << "Struct at index " << idx << " does not contain any " << fieldName << " field.";
-        return false;
-    }
-
-    return s.at(fieldName)->asDouble(value);
+    const mxArray* field = getFieldAtIndex(idx, fieldName);
+    return field && mxpp::MxArray(field).asDouble(value);
 }
 
 bool SimulinkBlockInformationImpl::getBooleanFieldAtIndex(const ParameterIndex idx,
                                                           const std::string& fieldName,
                                                           bool& value) const
 {
-    mxpp::MxStruct s;
-
-    if (!getStructAtIndex(idx, s)) {
-        bfError << "Failed to get struct at index " << idx << ".";
-        return false;
-    }
-
-    if (s.find(fieldName) == s.end()) {
-        bfError << "Struct at index " << idx << " does not contain any " << fieldName << " field.";
-        return false;
-    }
-
-    return s.at(fieldName)->asBool(value);
+    const mxArray* field = getFieldAtIndex(idx, fieldName);
+    return field && mxpp::MxArray(field).asBool(value);
 }
 
 bool SimulinkBlockInformationImpl::getCellFieldAtIndex(const ParameterIndex idx,
                                                        const std::string& fieldName,
-                                                       mxpp::MxCell& value) const
+                                                       std::vector<double>& value) const
 {
-    mxpp::MxStruct s;
-
-    if (!getStructAtIndex(idx, s)) {
-        bfError << "Failed to get struct at index " << idx << ".";
-        return false;
-    }
-
-    if (s.find(fieldName) == s.end()) {
-        bfError << "Struct at index " << idx << " does not contain any " << fieldName << " field.";
-        return false;
-    }
+    const mxArray* field = getFieldAtIndex(idx, fieldName);
+    return field && readCell<double>(field, value, readDouble);
+}
 
-    return s.at(fieldName)->asMxCell(value);
+bool SimulinkBlockInformationImpl::getCellFieldAtIndex(const ParameterIndex idx,
+                                                       const std::string& fieldName,
+                                                       std::vector<std::string>& value) const
+{
+    const mxArray* field = getFieldAtIndex(idx, fieldName);
+    return field && readCell<std::string>(field, value, readString);
 }
 
 bool SimulinkBlockInformationImpl::getVectorDoubleFieldAtIndex(const ParameterIndex idx,
                                                                const std::string& fieldName,
                                                                std::vector<double>& value) const
 {
-    mxpp::MxStruct s;
-
-    if (!getStructAtIndex(idx, s)) {
-        bfError << "Failed to get struct at index " << idx << ".";
-        return false;
-    }
-
-    if (s.find(fieldName) == s.end()) {
-        bfError << "Struct at index " << idx << " does not contain any " << fieldName << " field.";
-        return false;
-    }
-
-    return s.at(fieldName)->asVectorDouble(value);
+    const mxArray* field = getFieldAtIndex(idx, fieldName);
+    return field && mxpp::MxArray(field).asVectorDouble(value);
 }
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_BATCHRUNNER_H
+#define BLOCKFACTORY_CODER_BATCHRUNNER_H
+
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Parameters.h"
+#include "BlockFactory/Core/Port.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace blockfactory {
+    namespace core {
+        class Block;
+    } // namespace core
+    namespace coder {
+        class BatchRunner;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that executes many instances of a block sharing a single core::Block object
+ *
+ * This class is meant for campaigns that execute the same block many times with perturbed
+ * signals, e.g. Monte Carlo simulations. The signals of all the instances are stored in
+ * structure-of-arrays layout: a port of width W is stored in a buffer of batchSize * W elements,
+ * and the element e of the instance i is at index e * batchSize + i
+ * (see coder::BatchRunner::getIndex).
+ *
+ * Blocks that return true from core::Block::supportsBatchedOutput compute the output of all the
+ * instances with a single call of core::Block::outputBatched, which receives the batched buffers.
+ * For the other blocks, core::Block::output is called once per instance: the signals of the
+ * instance are gathered in scratch buffers before the call, and the outputs are scattered back to
+ * the batched buffers after it.
+ *
+ * @note All the instances share the parameters and the internal data of the core::Block object.
+ *       Perturbations must be carried by the input signals.
+ * Every instance has its own discrete and continuous states, stored in the same
+ * structure-of-arrays layout of the ports. The batched states are passed to
+ * core::Block::outputBatched, and the states of a single instance are gathered in scratch buffers
+ * for the other calls. The continuous states are integrated by the application, reading the
+ * derivatives computed by coder::BatchRunner::stateDerivative.
+ *
+ * @note Only ports of core::Port::DataType::DOUBLE are supported.
+ * @see core::Block::outputBatched
+ */
+class blockfactory::coder::BatchRunner
+{
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    BatchRunner();
+    ~BatchRunner();
+
+    BatchRunner(const BatchRunner& other) = delete;
+    BatchRunner& operator=(const BatchRunner& other) = delete;
+
+    /**
+     * @brief Allocate the batched buffers of the block
+     *
+     * @param block The block to execute. The runner does not take its ownership.
+     * @param inputPortsInfo The information of the input ports of a single instance.
+     * @param outputPortsInfo The information of the output ports of a single instance.
+     * @param batchSize The number of instances.
+     * @param parameters The parameters of the block, shared by all the instances.
+     * @param blockUniqueName The unique name of the block.
+     * @return True for success, false otherwise.
+     */
+    bool configure(core::Block* block,
+                   const core::InputPortsInfo& inputPortsInfo,
+                   const core::OutputPortsInfo& outputPortsInfo,
+                   const size_t batchSize,
+                   const core::Parameters& parameters = {},
+                   const std::string& blockUniqueName = {});
+
+    /**
+     * @brief Initialize the block
+     *
+     * The block is initialized once with the ports of a single instance. If the block has states,
+     * core::Block::initializeInitialConditions is then called for every instance, otherwise only
+     * once.
+     *
+     * @return True for success, false otherwise.
+     */
+    bool initialize();
+
+    /**
+     * @brief Compute the output of all the instances
+     *
+     * @return True for success, false otherwise.
+     */
+    bool output();
+
+    /**
+     * @brief Update the discrete states of all the instances
+     *
+     * @return True for success, false otherwise.
+     */
+    bool updateDiscreteState();
+
+    /**
+     * @brief Compute the derivatives of the continuous states of all the instances
+     *
+     * @return True for success, false otherwise.
+     */
+    bool stateDerivative();
+
+    /**
+     * @brief Terminate the block
+     *
+     * @return True for success, false otherwise.
+     */
+    bool terminate();
+
+    /**
+     * @brief Check if the block is executed with core::Block::outputBatched
+     *
+     * @return True if the block supports the batched execution, false if the runner falls back to
+     *         a loop over the instances.
+     */
+    bool isBatched() const;
+
+    /**
+     * @brief Get the number of instances
+     *
+     * @return The number of instances.
+     */
+    size_t getBatchSize() const;
+
+    /**
+     * @brief Get the index of an element of an instance in a batched buffer
+     *
+     * @param instance The index of the instance.
+     * @param element The index of the element in the port of a single instance.
+     * @return The index in the buffer.
+     */
+    size_t getIndex(const size_t instance, const size_t element) const;
+
+    /**
+     * @brief Get the batched buffer of an input port
+     *
+     * @param idx The index of the port.
+     * @return The buffer of the port, or nullptr if the port does not exist.
+     */
+    double* getInputPortBuffer(const core::Port::Index idx);
+
+    /**
+     * @brief Get the batched buffer of an output port
+     *
+     * @param idx The index of the port.
+     * @return The buffer of the port, or nullptr if the port does not exist.
+     */
+    const double* getOutputPortBuffer(const core::Port::Index idx) const;
+
+    /**
+     * @brief Get the batched buffer of the discrete states
+     *
+     * @return The buffer of the states, or nullptr if the block has no discrete states.
+     */
+    double* getDiscreteStateBuffer();
+
+    /**
+     * @brief Get the batched buffer of the continuous states
+     *
+     * @return The buffer of the states, or nullptr if the block has no continuous states.
+     */
+    double* getContinuousStateBuffer();
+
+    /**
+     * @brief Get the batched buffer of the derivatives of the continuous states
+     *
+     * @return The buffer of the derivatives, or nullptr if the block has no continuous states.
+     */
+    const double* getContinuousStateDerivativeBuffer() const;
+};
+
+#endif // BLOCKFACTORY_CODER_BATCHRUNNER_H
@@ -15,6 +15,7 @@
 #include "BlockFactory/Core/Port.h"
 #include "BlockFactory/Core/Signal.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -71,6 +72,13 @@ public:
     core::InputSignalPtr getInputPortSignal(const core::Port::Index idx) const override;
     core::OutputSignalPtr getOutputPortSignal(const core::Port::Index idx) const override;
 
+    // BLOCK STATES
+    // ============
+
+    core::OutputSignalPtr getContinuousStateSignal() const override;
+    core::OutputSignalPtr getContinuousStateDerivativeSignal() const override;
+    core::OutputSignalPtr getDiscreteStateSignal() const override;
+
     // METHODS OUTSIDE THE INTERFACE
     // =============================
 
@@ -78,6 +86,27 @@ public:
     bool storeRTWParameters(const core::Parameters& parameters);
     bool setInputPort(const core::Port::Info& portInfo, void* signalAddress);
     bool setOutputPort(const core::Port::Info& portInfo, void* signalAddress);
+    bool setContinuousStates(double* states, double* derivatives, const size_t numberOfStates);
+    bool setDiscreteStates(double* states, const size_t numberOfStates);
+
+    /**
+     * @brief Move the port signals stored in a memory region to another region
+     *
+     * All the existing objects of this class are searched for input and output ports whose
+     * signal is entirely contained in the region `[address, address + size)`. Their signals are
+     * replaced with signals pointing to the same offset in the region starting at `newAddress`.
+     * This allows blocks of generated code to read and write application memory in place of the
+     * buffers allocated by the model.
+     *
+     * @note Signals already retrieved by the blocks keep pointing to the old memory. The method
+     *       must not be called while the blocks are executing.
+     *
+     * @param address The beginning of the memory region to relocate.
+     * @param size The size in bytes of the memory region.
+     * @param newAddress The beginning of the new memory region, of the same size.
+     * @return The number of relocated port signals.
+     */
+    static size_t relocateSignals(const void* address, const size_t size, void* newAddress);
 };
 
 #endif // BLOCKFACTORY_CODER_CODERBLOCKINFORMATION_H
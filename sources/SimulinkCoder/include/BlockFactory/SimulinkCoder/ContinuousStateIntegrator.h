@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_CONTINUOUSSTATEINTEGRATOR_H
+#define BLOCKFACTORY_CODER_CONTINUOUSSTATEINTEGRATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace blockfactory {
+    namespace core {
+        class Block;
+    } // namespace core
+    namespace coder {
+        class CoderBlockInformation;
+        class ContinuousStateIntegrator;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that integrates the continuous states of blocks with a fixed-step solver
+ *
+ * Models generated by Simulink Coder integrate the continuous states with their own solver. This
+ * class provides the same functionality to applications that execute blocks directly through
+ * coder::CoderBlockInformation objects.
+ *
+ * The states and the state derivatives of all the registered blocks are stored in two contiguous
+ * vectors, and every block accesses its own slice through
+ * core::BlockInformation::getContinuousStateSignal and
+ * core::BlockInformation::getContinuousStateDerivativeSignal. The integration steps operate on
+ * the whole vectors with simple loops that the compiler can vectorize.
+ *
+ * A typical major step of the application is:
+ *
+ * 1. Compute the outputs of all the blocks with core::Block::output.
+ * 2. Advance the states with coder::ContinuousStateIntegrator::integrate.
+ *
+ * The initial states are set by core::Block::initializeInitialConditions, which must be called
+ * after coder::ContinuousStateIntegrator::configure.
+ */
+class blockfactory::coder::ContinuousStateIntegrator
+{
+public:
+    /// The available integration methods
+    enum class Method
+    {
+        /// First order explicit Euler method, one evaluation of the derivatives per step
+        ForwardEuler,
+        /// Classic fourth order Runge-Kutta method, four evaluations of the derivatives per step
+        RungeKutta4,
+    };
+
+    /// Function that updates the outputs of the model after the states changed
+    using MinorStep = std::function<bool()>;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    ContinuousStateIntegrator();
+    ~ContinuousStateIntegrator();
+
+    ContinuousStateIntegrator(const ContinuousStateIntegrator& other) = delete;
+    ContinuousStateIntegrator& operator=(const ContinuousStateIntegrator& other) = delete;
+
+    /**
+     * @brief Register a block with continuous states
+     *
+     * The number of states is read from core::Block::numberOfContinuousStates. Blocks without
+     * continuous states are ignored.
+     *
+     * @param block The block. The integrator does not take its ownership.
+     * @param blockInfo The object passed to the methods of the block.
+     * @return True for success, false otherwise.
+     */
+    bool addBlock(core::Block* block, CoderBlockInformation* blockInfo);
+
+    /**
+     * @brief Allocate the state vectors and store them in the registered blocks
+     *
+     * @param method The integration method.
+     * @return True for success, false otherwise.
+     */
+    bool configure(const Method method = Method::RungeKutta4);
+
+    /**
+     * @brief Advance the states of a step
+     *
+     * Methods with more than one stage evaluate the derivatives at intermediate states. If the
+     * derivatives depend on the inputs of the blocks, the outputs of the model must be updated
+     * before every evaluation but the first, which uses the outputs computed by the application in
+     * the major step.
+     *
+     * @param stepSize The integration step in seconds.
+     * @param minorStep The function that updates the outputs of the model at the intermediate
+     *                  states. If empty, the inputs are held constant during the step.
+     * @return True for success, false otherwise.
+     */
+    bool integrate(const double stepSize, const MinorStep& minorStep = {});
+
+    /**
+     * @brief Get the total number of continuous states
+     *
+     * @return The number of states of all the registered blocks.
+     */
+    size_t getNumberOfStates() const;
+
+    /**
+     * @brief Get the vector of the states of all the blocks
+     *
+     * @return The pointer to the states, or nullptr if the integrator is not configured.
+     */
+    double* getStates();
+
+    /**
+     * @brief Get the vector of the state derivatives of all the blocks
+     *
+     * @return The pointer to the derivatives, or nullptr if the integrator is not configured.
+     */
+    const double* getStateDerivatives() const;
+};
+
+#endif // BLOCKFACTORY_CODER_CONTINUOUSSTATEINTEGRATOR_H
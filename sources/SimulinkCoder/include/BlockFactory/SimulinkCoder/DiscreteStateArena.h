@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_DISCRETESTATEARENA_H
+#define BLOCKFACTORY_CODER_DISCRETESTATEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace blockfactory {
+    namespace core {
+        class Block;
+    } // namespace core
+    namespace coder {
+        class CoderBlockInformation;
+        class DiscreteStateArena;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that stores the discrete states of many blocks in a single buffer
+ *
+ * The arena allocates once the discrete states of all the registered blocks, and every block
+ * accesses its own slice through core::BlockInformation::getDiscreteStateSignal. The slices are
+ * aligned to coder::DiscreteStateArena::Alignment bytes, so that blocks executed by different
+ * threads never share a cache line.
+ *
+ * Since the whole state of the model is in one buffer, it can be saved and restored with a single
+ * copy, e.g. for resetting a simulation to a known condition or for branching many simulations
+ * from the same state.
+ *
+ * @note Blocks must store their states in the signal returned by
+ *       core::BlockInformation::getDiscreteStateSignal instead of in their own members.
+ */
+class blockfactory::coder::DiscreteStateArena
+{
+public:
+    /// Alignment in bytes of the states of every block
+    static const size_t Alignment = 64;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    DiscreteStateArena();
+    ~DiscreteStateArena();
+
+    DiscreteStateArena(const DiscreteStateArena& other) = delete;
+    DiscreteStateArena& operator=(const DiscreteStateArena& other) = delete;
+
+    /**
+     * @brief Register a block with discrete states
+     *
+     * The number of states is read from core::Block::numberOfDiscreteStates. Blocks without
+     * discrete states are ignored.
+     *
+     * @param block The block. The arena does not take its ownership.
+     * @param blockInfo The object passed to the methods of the block.
+     * @return True for success, false otherwise.
+     */
+    bool addBlock(core::Block* block, CoderBlockInformation* blockInfo);
+
+    /**
+     * @brief Allocate the arena and store the slices in the registered blocks
+     *
+     * The states are initialized to zero. Call core::Block::initializeInitialConditions after
+     * this method to set the initial states.
+     *
+     * @return True for success, false otherwise.
+     */
+    bool configure();
+
+    /**
+     * @brief Update the discrete states of all the registered blocks
+     *
+     * The blocks are updated calling core::Block::updateDiscreteState in registration order.
+     *
+     * @return True for success, false otherwise.
+     */
+    bool update();
+
+    /**
+     * @brief Get the total number of discrete states
+     *
+     * @return The number of states of all the registered blocks.
+     */
+    size_t getNumberOfStates() const;
+
+    /**
+     * @brief Get the size of the arena
+     *
+     * @return The size in bytes of the arena, including the alignment padding.
+     */
+    size_t getArenaSize() const;
+
+    /**
+     * @brief Save the states of all the blocks
+     *
+     * @param snapshot The buffer where the arena is copied. It is resized only if its capacity is
+     *                 not enough, hence it can be reused without allocations.
+     * @return True for success, false if the arena is not configured.
+     */
+    bool snapshot(std::vector<double>& snapshot) const;
+
+    /**
+     * @brief Restore the states of all the blocks
+     *
+     * @param snapshot A buffer filled by coder::DiscreteStateArena::snapshot.
+     * @return True for success, false if the snapshot does not match the arena.
+     */
+    bool restore(const std::vector<double>& snapshot);
+};
+
+#endif // BLOCKFACTORY_CODER_DISCRETESTATEARENA_H
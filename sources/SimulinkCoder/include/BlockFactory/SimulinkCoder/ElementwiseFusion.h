@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_ELEMENTWISEFUSION_H
+#define BLOCKFACTORY_CODER_ELEMENTWISEFUSION_H
+
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace blockfactory {
+    namespace core {
+        class Block;
+        class BlockInformation;
+    } // namespace core
+    namespace coder {
+        class ElementwiseFusion;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that fuses chains of elementwise blocks of a coder::ModelGraph
+ *
+ * Blocks that describe their output with core::Block::getElementwiseKernel are fused in groups.
+ * A block joins the group of the previous block in the execution order if it consumes its output,
+ * and if that output is not consumed by any other port. The output of a group is computed in a
+ * single pass over the data: the signals are split in tiles of
+ * coder::ElementwiseFusion::TileSize elements, and all the kernels of the group are applied to a
+ * tile while it is in the cache. The intermediate signals of the group are never written.
+ *
+ * The groups are executed in place of their last block, and the other blocks of the group are
+ * skipped. coder::ParallelScheduler and coder::MultiRateScheduler do it when the fusion is passed
+ * to their `configure` method. A serial loop over the blocks would be:
+ *
+ * ```cpp
+ * coder::ElementwiseFusion fusion;
+ * fusion.configure(graph, blocks);
+ * fusion.bind(blockInfos);
+ *
+ * for (coder::ModelGraph::BlockIndex block = 0; block < blocks.size(); ++block) {
+ *     switch (fusion.getRole(block)) {
+ *         case coder::ElementwiseFusion::Role::NONE:
+ *             blocks[block]->output(blockInfos[block]);
+ *             break;
+ *         case coder::ElementwiseFusion::Role::INTERMEDIATE:
+ *             break;
+ *         case coder::ElementwiseFusion::Role::LAST:
+ *             fusion.output(block);
+ *             break;
+ *     }
+ * }
+ * ```
+ *
+ * @note The blocks of a group are consecutive in the execution order, hence the fused execution
+ *       is equivalent to the serial one. With coder::ParallelScheduler, disable the buffer reuse
+ *       of coder::SignalMemoryPlanner.
+ * @see core::ElementwiseKernel, coder::ModelGraph, coder::ParallelScheduler,
+ *      coder::MultiRateScheduler
+ */
+class blockfactory::coder::ElementwiseFusion
+{
+public:
+    /// The number of elements processed by all the kernels of a group before the next ones
+    static constexpr size_t TileSize = 512;
+
+    /// The role of a block in the fused execution
+    enum class Role
+    {
+        /// The block is not fused, and core::Block::output must be called
+        NONE,
+        /// The block is computed by the group, and it must be skipped
+        INTERMEDIATE,
+        /// The last block of a group, that is computed with coder::ElementwiseFusion::output
+        LAST,
+    };
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    ElementwiseFusion();
+    ~ElementwiseFusion();
+
+    ElementwiseFusion(const ElementwiseFusion& other) = delete;
+    ElementwiseFusion& operator=(const ElementwiseFusion& other) = delete;
+
+    /**
+     * @brief Find the groups of fusible blocks
+     *
+     * The kernels are read from the blocks, that must be already initialized.
+     *
+     * @param graph The graph of the model.
+     * @param blocks The blocks of the model, indexed as in the graph.
+     * @return True for success, false if the number of blocks does not match the graph.
+     */
+    bool configure(const ModelGraph& graph, const std::vector<core::Block*>& blocks);
+
+    /**
+     * @brief Read the addresses of the signals of the groups
+     *
+     * The signals are read once, hence their buffers must not move afterwards, as in the case of
+     * the signals of coder::CoderBlockInformation. Groups whose output partially overlaps one of
+     * their inputs cannot be computed in a single pass, and their blocks are not fused.
+     *
+     * @param blockInfos The BlockInformation objects of the blocks, indexed as in the graph.
+     * @return True for success, false if the signals are not valid.
+     */
+    bool bind(const std::vector<const core::BlockInformation*>& blockInfos);
+
+    /**
+     * @brief Get the role of a block in the fused execution
+     *
+     * @param block The index of the block.
+     * @return The role of the block, or Role::NONE if it does not exist.
+     */
+    Role getRole(const ModelGraph::BlockIndex block) const;
+
+    /**
+     * @brief Get the number of groups of fused blocks
+     *
+     * @return The number of groups.
+     */
+    size_t getNumberOfGroups() const;
+
+    /**
+     * @brief Compute the output of a group
+     *
+     * @param block The index of the last block of the group.
+     * @return True for success, false if the block is not the last one of a group.
+     */
+    bool output(const ModelGraph::BlockIndex block);
+};
+
+#endif // BLOCKFACTORY_CODER_ELEMENTWISEFUSION_H
@@ -13,9 +13,55 @@
 #error "MODEL option not specified"
 #endif
 
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/Span.h"
+#include "BlockFactory/Core/Tracer.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#define BF_CODER_CONCAT_IMPL(a, b) a##b
+#define BF_CODER_CONCAT(a, b) BF_CODER_CONCAT_IMPL(a, b)
+
+/// Member of the generated class that stores the root inputs, e.g. `MyModel_U`
+#define BF_CODER_ROOT_INPUTS BF_CODER_CONCAT(MODEL, _U)
+/// Member of the generated class that stores the root outputs, e.g. `MyModel_Y`
+#define BF_CODER_ROOT_OUTPUTS BF_CODER_CONCAT(MODEL, _Y)
+
+/**
+ * @brief Register a root input of the model wrapped by a coder::GeneratedCodeWrapper
+ *
+ * @param wrapper The wrapper object.
+ * @param field The name of the field of the root inputs structure, e.g. `input2`.
+ */
+#define BF_CODER_ADD_INPUT(wrapper, field)                                                 \
+    (wrapper).addInput(                                                                    \
+        #field,                                                                            \
+        &decltype(std::declval<typename std::remove_reference<decltype(wrapper)>::type::Model&>() \
+                      .BF_CODER_ROOT_INPUTS)::field)
+
+/**
+ * @brief Register a root output of the model wrapped by a coder::GeneratedCodeWrapper
+ *
+ * @param wrapper The wrapper object.
+ * @param field The name of the field of the root outputs structure, e.g. `Result`.
+ */
+#define BF_CODER_ADD_OUTPUT(wrapper, field)                                                \
+    (wrapper).addOutput(                                                                   \
+        #field,                                                                            \
+        &decltype(std::declval<typename std::remove_reference<decltype(wrapper)>::type::Model&>() \
+                      .BF_CODER_ROOT_OUTPUTS)::field)
 
 namespace blockfactory {
     namespace coder {
@@ -24,30 +70,467 @@ namespace blockfactory {
     } // namespace coder
 } // namespace blockfactory
 
+/**
+ * @brief Class that wraps the C++ class generated by Simulink Coder
+ *
+ * The root inputs and outputs of the generated class are fields of the `MODEL_U` and `MODEL_Y`
+ * structures. They can be registered with the BF_CODER_ADD_INPUT and BF_CODER_ADD_OUTPUT macros,
+ * and then accessed by index (the registration order) or by name through core::Span objects
+ * that point directly to the memory of the model:
+ *
+ * @code{.cpp}
+ * blockfactory::coder::GeneratedCodeWrapper<MyModelModelClass> model("MyModel");
+ * BF_CODER_ADD_INPUT(model, input2);
+ * BF_CODER_ADD_OUTPUT(model, Result);
+ * model.initialize();
+ *
+ * auto input = model.getInput<double>("input2");
+ * auto output = model.getOutput<double>(0);
+ * std::fill(input.begin(), input.end(), 2.0);
+ * model.step();
+ * @endcode
+ *
+ * The spans are invalidated by coder::GeneratedCodeWrapper::initialize, which allocates a new
+ * model.
+ *
+ * In addition, application buffers can be bound to the root inputs and outputs with
+ * coder::GeneratedCodeWrapper::bindInput and coder::GeneratedCodeWrapper::bindOutput. The port
+ * signals of the BlockFactory blocks of the model that read a bound input or write a bound output
+ * are relocated to the application buffer (see coder::CoderBlockInformation::relocateSignals),
+ * and the step reads and writes the application memory with no copy.
+ *
+ * @note Only the blocks implemented with BlockFactory can be relocated. Blocks natively generated
+ *       by Simulink Coder keep accessing the fields of the model structures. Binding fails if the
+ *       root input or output is not directly connected to a BlockFactory block.
+ */
 template <typename T>
 class blockfactory::coder::GeneratedCodeWrapper
 {
+public:
+    /// The type of the generated class
+    using Model = T;
+
 private:
+    struct RootPort
+    {
+        std::string name;
+        // Offset of the field in the structure of the root inputs or outputs
+        size_t offset;
+        size_t numberOfElements;
+        size_t elementSize;
+        std::type_index type;
+        // Application buffer bound to the port, if any
+        void* bound;
+    };
+
+    static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+
     std::unique_ptr<T> m_model;
     std::string m_modelName;
     unsigned m_numSampleTimes;
 
+    // Identifiers of the trace events of the steps
+    uint32_t m_traceName;
+    uint32_t m_traceCategory;
+
+    std::vector<RootPort> m_inputs;
+    std::vector<RootPort> m_outputs;
+
     bool modelFailed() const;
 
+    uint8_t* rootInputs() const;
+    uint8_t* rootOutputs() const;
+
+    template <typename S, typename M>
+    static bool addPort(std::vector<RootPort>& ports, const std::string& name, M S::*field);
+    static size_t findPort(const std::vector<RootPort>& ports, const std::string& name);
+    template <typename E>
+    static E* portAddress(const RootPort& port, uint8_t* root);
+    static bool bindPort(RootPort& port, uint8_t* root, void* buffer);
+
 public:
     GeneratedCodeWrapper(const std::string& modelName = {}, const unsigned& numSampleTimes = 0);
     ~GeneratedCodeWrapper() = default;
 
+    /**
+     * @brief Allocate and initialize the model
+     *
+     * The buffers previously bound to the root inputs and outputs are bound to the new model.
+     *
+     * @return True for success, false otherwise.
+     */
     bool initialize();
+
+    /**
+     * @brief Execute a step of the model
+     *
+     * If the core::Tracer is enabled, the step is recorded as an event named after the model.
+     *
+     * @return True for success, false otherwise.
+     */
     bool step();
+
+    /**
+     * @brief Terminate the model
+     *
+     * The trace is written to the file specified by the `BLOCKFACTORY_TRACE` environment
+     * variable, if set (see core::Tracer::flush).
+     *
+     * @return True for success, false otherwise.
+     */
     bool terminate();
 
-    //    double* getOutput(const unsigned& index) const;
+    /**
+     * @brief Register a field of the root inputs structure
+     *
+     * Use the BF_CODER_ADD_INPUT macro instead of calling this method directly.
+     *
+     * @param name The name of the input.
+     * @param field The pointer to the field of the `MODEL_U` structure.
+     * @return True for success, false if an input with the same name is already registered.
+     */
+    template <typename S, typename M>
+    bool addInput(const std::string& name, M S::*field);
+
+    /**
+     * @brief Register a field of the root outputs structure
+     *
+     * Use the BF_CODER_ADD_OUTPUT macro instead of calling this method directly.
+     *
+     * @param name The name of the output.
+     * @param field The pointer to the field of the `MODEL_Y` structure.
+     * @return True for success, false if an output with the same name is already registered.
+     */
+    template <typename S, typename M>
+    bool addOutput(const std::string& name, M S::*field);
+
+    /**
+     * @brief Get the number of registered root inputs
+     *
+     * @return The number of inputs.
+     */
+    size_t getNumberOfInputs() const;
+
+    /**
+     * @brief Get the number of registered root outputs
+     *
+     * @return The number of outputs.
+     */
+    size_t getNumberOfOutputs() const;
+
+    /**
+     * @brief Get a view of a root input
+     *
+     * @tparam E The type of the elements, which must match the type of the field.
+     * @param index The index of the input in registration order.
+     * @return The span over the memory read by the model, or an empty span if the input does not
+     *         exist, the type does not match or the model is not initialized.
+     */
+    template <typename E = double>
+    core::Span<E> getInput(const size_t index) const;
+
+    /**
+     * @brief Get a view of a root input
+     *
+     * @tparam E The type of the elements, which must match the type of the field.
+     * @param name The name of the input.
+     * @return The span over the memory read by the model, or an empty span if the input does not
+     *         exist, the type does not match or the model is not initialized.
+     */
+    template <typename E = double>
+    core::Span<E> getInput(const std::string& name) const;
+
+    /**
+     * @brief Get a read-only view of a root output
+     *
+     * @tparam E The type of the elements, which must match the type of the field.
+     * @param index The index of the output in registration order.
+     * @return The span over the memory written by the model, or an empty span if the output does
+     *         not exist, the type does not match or the model is not initialized.
+     */
+    template <typename E = double>
+    core::Span<const E> getOutput(const size_t index) const;
+
+    /**
+     * @brief Get a read-only view of a root output
+     *
+     * @tparam E The type of the elements, which must match the type of the field.
+     * @param name The name of the output.
+     * @return The span over the memory written by the model, or an empty span if the output does
+     *         not exist, the type does not match or the model is not initialized.
+     */
+    template <typename E = double>
+    core::Span<const E> getOutput(const std::string& name) const;
+
+    /**
+     * @brief Bind an application buffer to a root input
+     *
+     * After binding, the blocks reading the input read the application buffer, and
+     * coder::GeneratedCodeWrapper::getInput returns a span over it.
+     *
+     * @param name The name of the input.
+     * @param buffer The application buffer, with as many elements as the input. It must outlive
+     *               the binding. Pass nullptr to restore the memory of the model.
+     * @return True for success, false otherwise.
+     */
+    template <typename E>
+    bool bindInput(const std::string& name, E* buffer);
+
+    /**
+     * @brief Bind an application buffer to a root output
+     *
+     * After binding, the blocks writing the output write the application buffer, and
+     * coder::GeneratedCodeWrapper::getOutput returns a span over it.
+     *
+     * @param name The name of the output.
+     * @param buffer The application buffer, with as many elements as the output. It must outlive
+     *               the binding. Pass nullptr to restore the memory of the model.
+     * @return True for success, false otherwise.
+     */
+    template <typename E>
+    bool bindOutput(const std::string& name, E* buffer);
+
+    /**
+     * @brief Get the number of sample times of the model
+     *
+     * Multi-rate models generated for single-tasking execution handle the rates internally, and
+     * GeneratedCodeWrapper::step must be called with the base period.
+     *
+     * @return The number of sample times passed to the constructor.
+     */
+    unsigned getNumberOfSampleTimes() const;
 
     std::string getErrors() const;
     //    std::string getWarnings() const;
 };
 
+template <typename T>
+constexpr size_t blockfactory::coder::GeneratedCodeWrapper<T>::InvalidIndex;
+
+template <typename T>
+uint8_t* blockfactory::coder::GeneratedCodeWrapper<T>::rootInputs() const
+{
+    return m_model ? reinterpret_cast<uint8_t*>(&m_model->BF_CODER_ROOT_INPUTS) : nullptr;
+}
+
+template <typename T>
+uint8_t* blockfactory::coder::GeneratedCodeWrapper<T>::rootOutputs() const
+{
+    return m_model ? reinterpret_cast<uint8_t*>(&m_model->BF_CODER_ROOT_OUTPUTS) : nullptr;
+}
+
+template <typename T>
+template <typename S, typename M>
+bool blockfactory::coder::GeneratedCodeWrapper<T>::addPort(std::vector<RootPort>& ports,
+                                                          const std::string& name,
+                                                          M S::*field)
+{
+    using Element = typename std::remove_all_extents<M>::type;
+    static_assert(std::is_arithmetic<Element>::value,
+                  "Only fields of arithmetic types and arrays of them are supported");
+
+    if (findPort(ports, name) != InvalidIndex) {
+        bfError << "The port " << name << " is already registered.";
+        return false;
+    }
+
+    // Compute the offset of the field from a temporary structure
+    const auto reference = std::make_unique<S>();
+    const auto* base = reinterpret_cast<const uint8_t*>(reference.get());
+    const auto* member = reinterpret_cast<const uint8_t*>(&(reference.get()->*field));
+
+    ports.push_back({name,
+                     static_cast<size_t>(member - base),
+                     sizeof(M) / sizeof(Element),
+                     sizeof(Element),
+                     std::type_index(typeid(Element)),
+                     nullptr});
+    return true;
+}
+
+template <typename T>
+size_t blockfactory::coder::GeneratedCodeWrapper<T>::findPort(const std::vector<RootPort>& ports,
+                                                              const std::string& name)
+{
+    for (size_t i = 0; i < ports.size(); ++i) {
+        if (ports[i].name == name) {
+            return i;
+        }
+    }
+    return InvalidIndex;
+}
+
+template <typename T>
+template <typename E>
+E* blockfactory::coder::GeneratedCodeWrapper<T>::portAddress(const RootPort& port, uint8_t* root)
+{
+    if (port.type != std::type_index(typeid(typename std::remove_const<E>::type))) {
+        bfError << "The type requested for port " << port.name << " does not match its type.";
+        return nullptr;
+    }
+
+    if (port.bound) {
+        return static_cast<E*>(port.bound);
+    }
+
+    return root ? reinterpret_cast<E*>(root + port.offset) : nullptr;
+}
+
+template <typename T>
+bool blockfactory::coder::GeneratedCodeWrapper<T>::bindPort(RootPort& port,
+                                                            uint8_t* root,
+                                                            void* buffer)
+{
+    if (!root) {
+        // The binding is applied by initialize()
+        port.bound = buffer;
+        return true;
+    }
+
+    void* current = port.bound ? port.bound : root + port.offset;
+    void* target = buffer ? buffer : root + port.offset;
+
+    if (current == target) {
+        return true;
+    }
+
+    const size_t size = port.numberOfElements * port.elementSize;
+    if (CoderBlockInformation::relocateSignals(current, size, target) == 0) {
+        bfError << "The port " << port.name << " is not connected to any BlockFactory block "
+                << "and it cannot be bound to an external buffer.";
+        return false;
+    }
+
+    port.bound = buffer;
+    return true;
+}
+
+template <typename T>
+template <typename S, typename M>
+bool blockfactory::coder::GeneratedCodeWrapper<T>::addInput(const std::string& name, M S::*field)
+{
+    using RootInputs =
+        typename std::remove_reference<decltype(std::declval<T&>().BF_CODER_ROOT_INPUTS)>::type;
+    static_assert(std::is_same<S, RootInputs>::value,
+                  "The field does not belong to the root inputs of the model");
+    return addPort(m_inputs, name, field);
+}
+
+template <typename T>
+template <typename S, typename M>
+bool blockfactory::coder::GeneratedCodeWrapper<T>::addOutput(const std::string& name, M S::*field)
+{
+    using RootOutputs =
+        typename std::remove_reference<decltype(std::declval<T&>().BF_CODER_ROOT_OUTPUTS)>::type;
+    static_assert(std::is_same<S, RootOutputs>::value,
+                  "The field does not belong to the root outputs of the model");
+    return addPort(m_outputs, name, field);
+}
+
+template <typename T>
+size_t blockfactory::coder::GeneratedCodeWrapper<T>::getNumberOfInputs() const
+{
+    return m_inputs.size();
+}
+
+template <typename T>
+size_t blockfactory::coder::GeneratedCodeWrapper<T>::getNumberOfOutputs() const
+{
+    return m_outputs.size();
+}
+
+template <typename T>
+template <typename E>
+blockfactory::core::Span<E>
+blockfactory::coder::GeneratedCodeWrapper<T>::getInput(const size_t index) const
+{
+    if (index >= m_inputs.size()) {
+        bfError << "The model has no registered input at index " << index << ".";
+        return {};
+    }
+
+    const auto& port = m_inputs[index];
+    E* data = portAddress<E>(port, rootInputs());
+    return data ? core::Span<E>(data, port.numberOfElements) : core::Span<E>();
+}
+
+template <typename T>
+template <typename E>
+blockfactory::core::Span<E>
+blockfactory::coder::GeneratedCodeWrapper<T>::getInput(const std::string& name) const
+{
+    const size_t index = findPort(m_inputs, name);
+    if (index == InvalidIndex) {
+        bfError << "The model has no registered input " << name << ".";
+        return {};
+    }
+    return getInput<E>(index);
+}
+
+template <typename T>
+template <typename E>
+blockfactory::core::Span<const E>
+blockfactory::coder::GeneratedCodeWrapper<T>::getOutput(const size_t index) const
+{
+    if (index >= m_outputs.size()) {
+        bfError << "The model has no registered output at index " << index << ".";
+        return {};
+    }
+
+    const auto& port = m_outputs[index];
+    const E* data = portAddress<const E>(port, rootOutputs());
+    return data ? core::Span<const E>(data, port.numberOfElements) : core::Span<const E>();
+}
+
+template <typename T>
+template <typename E>
+blockfactory::core::Span<const E>
+blockfactory::coder::GeneratedCodeWrapper<T>::getOutput(const std::string& name) const
+{
+    const size_t index = findPort(m_outputs, name);
+    if (index == InvalidIndex) {
+        bfError << "The model has no registered output " << name << ".";
+        return {};
+    }
+    return getOutput<E>(index);
+}
+
+template <typename T>
+template <typename E>
+bool blockfactory::coder::GeneratedCodeWrapper<T>::bindInput(const std::string& name, E* buffer)
+{
+    const size_t index = findPort(m_inputs, name);
+    if (index == InvalidIndex) {
+        bfError << "The model has no registered input " << name << ".";
+        return false;
+    }
+
+    if (m_inputs[index].type != std::type_index(typeid(E))) {
+        bfError << "The type of the buffer does not match the type of the input " << name << ".";
+        return false;
+    }
+
+    return bindPort(m_inputs[index], rootInputs(), buffer);
+}
+
+template <typename T>
+template <typename E>
+bool blockfactory::coder::GeneratedCodeWrapper<T>::bindOutput(const std::string& name, E* buffer)
+{
+    const size_t index = findPort(m_outputs, name);
+    if (index == InvalidIndex) {
+        bfError << "The model has no registered output " << name << ".";
+        return false;
+    }
+
+    if (m_outputs[index].type != std::type_index(typeid(E))) {
+        bfError << "The type of the buffer does not match the type of the output " << name << ".";
+        return false;
+    }
+
+    return bindPort(m_outputs[index], rootOutputs(), buffer);
+}
+
 template <typename T>
 bool blockfactory::coder::GeneratedCodeWrapper<T>::modelFailed() const
 {
@@ -65,8 +548,16 @@ blockfactory::coder::GeneratedCodeWrapper<T>::GeneratedCodeWrapper(const std::st
                                                                    const unsigned& numSampleTimes)
     : m_modelName(modelName)
     , m_numSampleTimes(numSampleTimes)
+    , m_traceName(core::Tracer::registerName(modelName.empty() ? "model" : modelName))
+    , m_traceCategory(core::Tracer::registerName("step"))
 {}
 
+template <typename T>
+unsigned blockfactory::coder::GeneratedCodeWrapper<T>::getNumberOfSampleTimes() const
+{
+    return m_numSampleTimes;
+}
+
 template <typename T>
 bool blockfactory::coder::GeneratedCodeWrapper<T>::initialize()
 {
@@ -81,6 +572,18 @@ bool blockfactory::coder::GeneratedCodeWrapper<T>::initialize()
         return false;
     }
 
+    // The port signals of the new model point to its own structures
+    for (auto* ports : {&m_inputs, &m_outputs}) {
+        uint8_t* root = ports == &m_inputs ? rootInputs() : rootOutputs();
+        for (auto& port : *ports) {
+            void* buffer = port.bound;
+            port.bound = nullptr;
+            if (buffer && !bindPort(port, root, buffer)) {
+                return false;
+            }
+        }
+    }
+
     return true;
 }
 
@@ -91,7 +594,10 @@ bool blockfactory::coder::GeneratedCodeWrapper<T>::step()
         return false;
     }
 
-    m_model->step();
+    {
+        const core::Tracer::Scope scope(m_traceName, m_traceCategory);
+        m_model->step();
+    }
 
     if (modelFailed()) {
         return false;
@@ -109,6 +615,9 @@ bool blockfactory::coder::GeneratedCodeWrapper<T>::terminate()
 
     m_model->terminate();
 
+    // Export the trace of the execution, if requested by the environment
+    core::Tracer::flush();
+
     if (modelFailed()) {
         return false;
     }
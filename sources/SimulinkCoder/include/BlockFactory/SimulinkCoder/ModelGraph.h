@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_MODELGRAPH_H
+#define BLOCKFACTORY_CODER_MODELGRAPH_H
+
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Port.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace blockfactory {
+    namespace coder {
+        class ModelGraph;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that describes the topology of a model executed without Simulink
+ *
+ * A model is a set of blocks connected by signals. This class stores the port information of
+ * each block and the connections between output and input ports. It is the input of the classes
+ * that plan the memory and the execution of a model outside the Simulink engine, e.g. a
+ * standalone runner that drives blocks through coder::CoderBlockInformation.
+ *
+ * Blocks must be added in their execution order. The index returned by
+ * coder::ModelGraph::addBlock is used to refer to a block in all the other methods.
+ *
+ * An input port that is not connected to any output port is considered an external input of the
+ * model, and an output port that is not connected to any input port is considered an external
+ * output of the model.
+ *
+ * @note Ports with dynamic size are not supported.
+ * @see coder::SignalMemoryPlanner
+ */
+class blockfactory::coder::ModelGraph
+{
+public:
+    /// The 0-based index of a block, that matches its position in the execution order
+    using BlockIndex = size_t;
+
+    /// Reference to a port of a block
+    struct PortRef
+    {
+        BlockIndex block;
+        core::Port::Index port;
+    };
+
+    /// Connection from an output port (source) to an input port (destination)
+    struct Connection
+    {
+        PortRef source;
+        PortRef destination;
+    };
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    ModelGraph();
+    ~ModelGraph();
+
+    ModelGraph(const ModelGraph& other) = delete;
+    ModelGraph& operator=(const ModelGraph& other) = delete;
+
+    /**
+     * @brief Add a block to the graph
+     *
+     * @param name The name of the block.
+     * @param inputPortsInfo The information of the input ports of the block.
+     * @param outputPortsInfo The information of the output ports of the block.
+     * @param hasStates True if the block has discrete or continuous states.
+     * @return The index of the new block.
+     */
+    BlockIndex addBlock(const std::string& name,
+                        const core::InputPortsInfo& inputPortsInfo,
+                        const core::OutputPortsInfo& outputPortsInfo,
+                        const bool hasStates = false);
+
+    /**
+     * @brief Connect an output port to an input port
+     *
+     * An output port can be connected to many input ports, and an input port can be connected to
+     * only one output port. The two ports must have the same data type and number of elements.
+     *
+     * @param source The output port producing the signal.
+     * @param destination The input port consuming the signal.
+     * @return True for success, false otherwise.
+     */
+    bool connect(const PortRef& source, const PortRef& destination);
+
+    /**
+     * @brief Get the number of blocks
+     *
+     * @return The number of blocks stored in the graph.
+     */
+    size_t getNumberOfBlocks() const;
+
+    /**
+     * @brief Get the name of a block
+     *
+     * @param block The index of the block.
+     * @return The name of the block if it exists, an empty string otherwise.
+     */
+    std::string getBlockName(const BlockIndex block) const;
+
+    /**
+     * @brief Check if a block has states
+     *
+     * @param block The index of the block.
+     * @return True if the block exists and has discrete or continuous states, false otherwise.
+     */
+    bool hasStates(const BlockIndex block) const;
+
+    /**
+     * @brief Get the information of the input ports of a block
+     *
+     * @param block The index of the block.
+     * @return The input ports information if the block exists, an empty vector otherwise.
+     */
+    const core::InputPortsInfo& getInputPortsInfo(const BlockIndex block) const;
+
+    /**
+     * @brief Get the information of the output ports of a block
+     *
+     * @param block The index of the block.
+     * @return The output ports information if the block exists, an empty vector otherwise.
+     */
+    const core::OutputPortsInfo& getOutputPortsInfo(const BlockIndex block) const;
+
+    /**
+     * @brief Get all the connections of the graph
+     *
+     * @return The vector of connections, in the order they were created.
+     */
+    const std::vector<Connection>& getConnections() const;
+
+    /**
+     * @brief Get the output port connected to an input port
+     *
+     * @param destination The input port.
+     * @param[out] source The output port connected to the input port.
+     * @return True if the input port is connected, false otherwise.
+     */
+    bool getSource(const PortRef& destination, PortRef& source) const;
+
+    /**
+     * @brief Get the number of elements of a port
+     *
+     * @param portInfo The information of the port.
+     * @return The product of the port dimensions, or 0 if any dimension is not concrete.
+     */
+    static size_t getNumberOfElements(const core::Port::Info& portInfo);
+
+    /**
+     * @brief Get the size in bytes of a single element of a given data type
+     *
+     * @param dataType The port data type.
+     * @return The size of the element in bytes.
+     */
+    static size_t getDataTypeSize(const core::Port::DataType dataType);
+};
+
+#endif // BLOCKFACTORY_CODER_MODELGRAPH_H
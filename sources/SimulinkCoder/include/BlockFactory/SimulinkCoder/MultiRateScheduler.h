@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_MULTIRATESCHEDULER_H
+#define BLOCKFACTORY_CODER_MULTIRATESCHEDULER_H
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace blockfactory {
+    namespace coder {
+        class ElementwiseFusion;
+        class MultiRateScheduler;
+        class SignalMemoryPlanner;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that executes the blocks of a coder::ModelGraph at their own rate
+ *
+ * Every block belongs to a rate, defined by the period returned by core::Block::sampleTime.
+ * Blocks with an inherited sample time get the fastest rate of the blocks producing their inputs,
+ * or the base rate if they have no inputs. The base rate is the fastest rate of the model, and
+ * the periods of the other rates must be integer multiples of the faster ones (harmonic rates).
+ *
+ * The application calls coder::MultiRateScheduler::tick every base period. The blocks of the base
+ * rate are executed at every tick by the calling thread, and the blocks of a slower rate only on
+ * the ticks that are multiple of their period. The slower rates can be executed by dedicated
+ * threads, so that a long computation of a slow block does not delay the ticks of the faster
+ * rates. With coder::MultiRateScheduler::setBasePriority, the threads follow a rate-monotonic
+ * policy: they are scheduled with `SCHED_FIFO` and their priority decreases with their period.
+ *
+ * Signals crossing two rates are exchanged through rate transition buffers. The consumer reads a
+ * copy of the signal that is refreshed only when both the rates are idle, i.e. at the ticks of the
+ * slower of the two rates:
+ *
+ * - From a fast to a slow rate, the slow blocks read the value computed by the fast blocks in the
+ *   tick that released them, and the value is held for the entire slow period. If the fast rate
+ *   is not the base rate, the execution of the slow rate starts when the fast rate completes.
+ * - From a slow to a fast rate, the fast blocks read the value computed by the slow blocks in
+ *   their previous period, i.e. the output is delayed by one slow period.
+ *
+ * External inputs of the model belong to the base rate.
+ *
+ * If a coder::ElementwiseFusion is passed to coder::MultiRateScheduler::configure, the
+ * intermediate blocks of its groups are skipped, and the last block of each group is executed
+ * with coder::ElementwiseFusion::output instead of the task. All the blocks of a group must belong
+ * to the same rate.
+ *
+ * @note Signals must persist between ticks. The signals must be planned with a
+ *       coder::SignalMemoryPlanner that does not reuse buffers.
+ * @note Offsets of the sample times are not supported.
+ * @see core::Block::sampleTime, coder::SignalMemoryPlanner
+ */
+class blockfactory::coder::MultiRateScheduler
+{
+public:
+    /// The function that executes a block. It returns true for success, false otherwise.
+    using Task = std::function<bool(const ModelGraph::BlockIndex)>;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    MultiRateScheduler();
+    ~MultiRateScheduler();
+
+    MultiRateScheduler(const MultiRateScheduler& other) = delete;
+    MultiRateScheduler& operator=(const MultiRateScheduler& other) = delete;
+
+    /**
+     * @brief Compute the rates of the blocks and create the rate transition buffers
+     *
+     * The input ports that read a signal of a different rate are redirected to the rate
+     * transition buffers using coder::SignalMemoryPlanner::redirectInputPort. Call this method
+     * before configuring the coder::CoderBlockInformation objects of the blocks. Configuring the
+     * scheduler again frees the previous transition buffers and restores the input ports that
+     * were redirected to them, hence the planner of the previous configuration must still exist.
+     *
+     * @param graph The model graph. Its blocks must be stored in execution order.
+     * @param sampleTimes The sample times of the blocks, indexed as the blocks of the graph.
+     * @param planner The memory planner that allocated the signals of the graph.
+     * @param fusion The optional fusion of the elementwise blocks of the graph. It is used by the
+     *               scheduler until it is stopped, hence it must outlive the scheduler and be
+     *               bound before coder::MultiRateScheduler::start.
+     * @return True for success, false otherwise.
+     */
+    bool configure(const ModelGraph& graph,
+                   const std::vector<core::Block::SampleTime>& sampleTimes,
+                   SignalMemoryPlanner& planner,
+                   ElementwiseFusion* fusion = nullptr);
+
+    /**
+     * @brief Set the real-time priority of the base rate
+     *
+     * The thread of the rate `r` is scheduled with the `SCHED_FIFO` policy and the priority
+     * `priority - r`, limited to the minimum priority of the policy, so that faster rates preempt
+     * the slower ones. The base rate is executed by the thread calling
+     * coder::MultiRateScheduler::tick, whose priority must be set by the application, e.g. with
+     * coder::PeriodicExecutor::setPriority. Real-time priorities usually require the
+     * `CAP_SYS_NICE` capability or a suitable `RLIMIT_RTPRIO` limit.
+     *
+     * @param priority The `SCHED_FIFO` priority of the base rate, or 0 to keep the default
+     *                 policy for all the threads.
+     * @return True for success, false if the priority is out of range, not supported on this
+     *         platform, or if the scheduler is running.
+     */
+    bool setBasePriority(const int priority);
+
+    /**
+     * @brief Get the real-time priority of a rate
+     *
+     * @param rate The index of the rate.
+     * @return The `SCHED_FIFO` priority of the thread of the rate, or 0 if the threads use the
+     *         default policy or the rate does not exist.
+     */
+    int getPriority(const size_t rate) const;
+
+    /**
+     * @brief Start the execution
+     *
+     * @param task The function that executes a block.
+     * @param multiThreading If true, every rate slower than the base rate is executed by a
+     *                       dedicated thread. Otherwise, all the rates are executed by the thread
+     *                       calling coder::MultiRateScheduler::tick.
+     * @return True for success, false otherwise, e.g. if the priorities of the threads cannot be
+     *         set or if a group of fused blocks spans two rates.
+     */
+    bool start(const Task& task, const bool multiThreading = true);
+
+    /**
+     * @brief Execute a base period of the model
+     *
+     * If a slower rate has not yet completed its previous execution when it should be released
+     * again, the method waits for its completion and the overrun is counted.
+     *
+     * @return True if the executed blocks succeeded, false otherwise. Failures of the blocks of
+     *         slower rates are reported by the first tick after their completion.
+     */
+    bool tick();
+
+    /**
+     * @brief Stop the execution and join the threads
+     */
+    void stop();
+
+    /**
+     * @brief Get the base period of the model
+     *
+     * @return The period in seconds of the base rate.
+     */
+    double getBasePeriod() const;
+
+    /**
+     * @brief Get the number of rates of the model
+     *
+     * @return The number of rates.
+     */
+    size_t getNumberOfRates() const;
+
+    /**
+     * @brief Get the period of a rate
+     *
+     * @param rate The index of the rate. Rates are sorted from the fastest (0, the base rate) to
+     *             the slowest.
+     * @return The period of the rate in seconds, or 0 if the rate does not exist.
+     */
+    double getPeriod(const size_t rate) const;
+
+    /**
+     * @brief Get the rate of a block
+     *
+     * @param block The index of the block.
+     * @return The index of the rate of the block.
+     */
+    size_t getRate(const ModelGraph::BlockIndex block) const;
+
+    /**
+     * @brief Get the number of rate transition buffers
+     *
+     * @return The number of buffers.
+     */
+    size_t getNumberOfRateTransitions() const;
+
+    /**
+     * @brief Get the number of overruns of a rate
+     *
+     * @param rate The index of the rate.
+     * @return The number of times the rate was not completed before its next release.
+     */
+    size_t getNumberOfOverruns(const size_t rate) const;
+};
+
+#endif // BLOCKFACTORY_CODER_MULTIRATESCHEDULER_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_PARALLELSCHEDULER_H
+#define BLOCKFACTORY_CODER_PARALLELSCHEDULER_H
+
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace blockfactory {
+    namespace coder {
+        class ElementwiseFusion;
+        class ParallelScheduler;
+        class SignalMemoryPlanner;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that executes the blocks of a coder::ModelGraph concurrently
+ *
+ * The scheduler computes the data dependencies between the blocks of a model and groups them in
+ * levels. Blocks belonging to the same level do not depend on each other and can be executed
+ * concurrently. The dependencies of a block are:
+ *
+ * - The producers of its input signals executed before it in the graph order.
+ * - The blocks that are executed before it in the graph order and read (as feedback) the previous
+ *   value of one of its output signals.
+ * - The ordering constraints of the buffer reuse, if a coder::SignalMemoryPlanner is passed.
+ *
+ * Every step is executed by a pool of threads, including the thread calling
+ * coder::ParallelScheduler::step. Each thread owns a queue of ready blocks and, when it runs out of
+ * work, steals blocks from the queues of the other threads. Dependencies are tracked with atomic
+ * counters: when a block completes, it decrements the counters of the blocks depending on it, and
+ * a block becomes ready when its counter reaches zero.
+ *
+ * The function that executes a block is provided by the user, and it is usually a call to the
+ * core::Block::output method of the block with its coder::CoderBlockInformation object:
+ *
+ * ```cpp
+ * coder::ParallelScheduler scheduler;
+ * scheduler.configure(graph, &planner);
+ * scheduler.start(4);
+ *
+ * while (running) {
+ *     scheduler.step([&](const coder::ModelGraph::BlockIndex block) {
+ *         return blocks[block]->output(blockInfos[block].get());
+ *     });
+ * }
+ *
+ * scheduler.stop();
+ * ```
+ *
+ * If a coder::ElementwiseFusion is passed to coder::ParallelScheduler::configure, the intermediate
+ * blocks of its groups are skipped, and the last block of each group is executed with
+ * coder::ElementwiseFusion::output instead of the task.
+ * @note The blocks executed concurrently must not share any state other than their signals.
+ * @note The code generated by the Simulink Coder TLC executes the blocks serially in the model
+ *       step. This class is meant to be used by runners that execute a coder::ModelGraph.
+ * @see coder::ModelGraph, coder::SignalMemoryPlanner
+ */
+class blockfactory::coder::ParallelScheduler
+{
+public:
+    /// The function that executes a block. It returns true for success, false otherwise.
+    using Task = std::function<bool(const ModelGraph::BlockIndex)>;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    ParallelScheduler();
+    ~ParallelScheduler();
+
+    ParallelScheduler(const ParallelScheduler& other) = delete;
+    ParallelScheduler& operator=(const ParallelScheduler& other) = delete;
+
+    /**
+     * @brief Compute the dependencies and the levels of the blocks of a model
+     *
+     * This method can be called only when the scheduler is not started.
+     *
+     * @param graph The model graph. Its blocks must be stored in execution order.
+     * @param planner The optional memory planner used to allocate the signals of the graph. If
+     *                the buffers are reused, the scheduler respects the resulting constraints.
+     * @param fusion The optional fusion of the elementwise blocks of the graph. It is used by
+     *               coder::ParallelScheduler::step, hence it must outlive the scheduler and be
+     *               bound before the first step. It requires a planner without buffer reuse.
+     * @return True for success, false otherwise.
+     */
+    bool configure(const ModelGraph& graph,
+                   const SignalMemoryPlanner* planner = nullptr,
+                   ElementwiseFusion* fusion = nullptr);
+
+    /**
+     * @brief Start the thread pool
+     *
+     * @param numberOfThreads The number of threads executing the blocks, including the thread that
+     *        calls coder::ParallelScheduler::step. If 0, the number of hardware threads is used.
+     * @return True for success, false otherwise.
+     */
+    bool start(const size_t numberOfThreads = 0);
+
+    /**
+     * @brief Execute all the blocks of the model once
+     *
+     * The method returns when all the blocks have been executed. If a task fails, the blocks that
+     * were not yet started are skipped. The task is not called for the blocks fused by the
+     * coder::ElementwiseFusion passed to coder::ParallelScheduler::configure.
+     *
+     * @param task The function that executes a block.
+     * @return True if all the tasks succeeded, false otherwise.
+     */
+    bool step(const Task& task);
+
+    /**
+     * @brief Stop and join the thread pool
+     */
+    void stop();
+
+    /**
+     * @brief Get the number of threads of the pool
+     *
+     * @return The number of threads, including the thread calling coder::ParallelScheduler::step.
+     */
+    size_t getNumberOfThreads() const;
+
+    /**
+     * @brief Get the levels of the blocks
+     *
+     * @return A vector containing, for each level, the indices of the blocks belonging to it.
+     */
+    const std::vector<std::vector<ModelGraph::BlockIndex>>& getLevels() const;
+
+    /**
+     * @brief Get the blocks that must be executed before a given block
+     *
+     * @param block The index of the block.
+     * @return The indices of the blocks on which the block depends.
+     */
+    std::vector<ModelGraph::BlockIndex> getDependencies(const ModelGraph::BlockIndex block) const;
+};
+
+#endif // BLOCKFACTORY_CODER_PARALLELSCHEDULER_H
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_PERIODICEXECUTOR_H
+#define BLOCKFACTORY_CODER_PERIODICEXECUTOR_H
+
+#include "BlockFactory/Core/LatencyHistogram.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace blockfactory {
+    namespace coder {
+        class PeriodicExecutor;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that executes a function periodically
+ *
+ * This class is meant to run the step of a model generated by Simulink Coder, e.g. wrapped by
+ * coder::GeneratedCodeWrapper, at its base period:
+ *
+ * @code{.cpp}
+ * blockfactory::coder::PeriodicExecutor executor;
+ * executor.setPeriod(0.001);
+ * executor.setPriority(80);
+ * executor.run([&]() { return model.step(); });
+ * @endcode
+ *
+ * The releases are computed on absolute deadlines, so that the period does not drift with the
+ * execution time of the step. On Linux the thread sleeps with `clock_nanosleep` on the monotonic
+ * clock, and it can be pinned to a set of CPUs and scheduled with the `SCHED_FIFO` real-time
+ * policy. On other platforms only the period is supported.
+ *
+ * For every step the executor records:
+ *
+ * - The execution time, from the wake up to the return of the step.
+ * - The jitter, i.e. the delay of the wake up with respect to the deadline.
+ * - The overruns, i.e. the steps that did not complete before the next release. The releases
+ *   already missed are skipped.
+ *
+ * The statistics are stored in core::LatencyHistogram objects with a nanoseconds resolution, and
+ * can be read by another thread while the executor is running.
+ */
+class blockfactory::coder::PeriodicExecutor
+{
+public:
+    /// The function executed every period. It returns true for success, false otherwise.
+    using Step = std::function<bool()>;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    PeriodicExecutor();
+    ~PeriodicExecutor();
+
+    PeriodicExecutor(const PeriodicExecutor& other) = delete;
+    PeriodicExecutor& operator=(const PeriodicExecutor& other) = delete;
+
+    /**
+     * @brief Set the period of the execution
+     *
+     * @param period The period in seconds. It must be positive.
+     * @return True for success, false otherwise.
+     */
+    bool setPeriod(const double period);
+
+    /**
+     * @brief Set the CPUs the executing thread is allowed to run on
+     *
+     * The affinity is applied by coder::PeriodicExecutor::run to the calling thread, and the
+     * previous affinity is restored when it returns.
+     *
+     * @param cpus The indices of the CPUs. An empty vector does not change the affinity.
+     * @return True for success, false if the affinity is not supported on this platform.
+     */
+    bool setCpuAffinity(const std::vector<unsigned>& cpus);
+
+    /**
+     * @brief Set the real-time priority of the executing thread
+     *
+     * A positive priority schedules the thread with the `SCHED_FIFO` policy, which usually
+     * requires the `CAP_SYS_NICE` capability or a suitable `RLIMIT_RTPRIO` limit. The priority is
+     * applied by coder::PeriodicExecutor::run to the calling thread, and the previous scheduling
+     * policy is restored when it returns.
+     *
+     * @param priority The `SCHED_FIFO` priority, or 0 to keep the default policy.
+     * @return True for success, false if the priority is out of range or not supported on this
+     *         platform.
+     */
+    bool setPriority(const int priority);
+
+    /**
+     * @brief Execute the step periodically in the calling thread
+     *
+     * The method returns when the requested number of steps is executed, when
+     * coder::PeriodicExecutor::requestStop is called, or when the step fails.
+     *
+     * @param step The function to execute.
+     * @param numberOfSteps The number of steps to execute, or 0 to run until a stop is requested.
+     * @return True if all the steps succeeded, false otherwise or if the configuration of the
+     *         thread could not be applied.
+     */
+    bool run(const Step& step, const uint64_t numberOfSteps = 0);
+
+    /**
+     * @brief Ask a running executor to return after the current step
+     *
+     * This method can be called by any thread.
+     */
+    void requestStop();
+
+    /**
+     * @brief Check if the executor is running
+     *
+     * @return True if coder::PeriodicExecutor::run is executing, false otherwise.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Get the period of the execution
+     *
+     * @return The period in seconds.
+     */
+    double getPeriod() const;
+
+    /**
+     * @brief Get the number of executed steps
+     *
+     * @return The number of steps since the last reset of the statistics.
+     */
+    uint64_t getNumberOfSteps() const;
+
+    /**
+     * @brief Get the number of deadline overruns
+     *
+     * @return The number of steps that did not complete before their next release.
+     */
+    uint64_t getNumberOfOverruns() const;
+
+    /**
+     * @brief Get the histogram of the execution times of the step
+     *
+     * @return The histogram, in nanoseconds.
+     */
+    const core::LatencyHistogram& getExecutionTimeHistogram() const;
+
+    /**
+     * @brief Get the histogram of the wake up delays with respect to the deadlines
+     *
+     * @return The histogram, in nanoseconds.
+     */
+    const core::LatencyHistogram& getJitterHistogram() const;
+
+    /**
+     * @brief Clear the recorded statistics
+     */
+    void resetStatistics();
+};
+
+#endif // BLOCKFACTORY_CODER_PERIODICEXECUTOR_H
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_REALTIMERUNNER_H
+#define BLOCKFACTORY_CODER_REALTIMERUNNER_H
+
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/SimulinkCoder/PeriodicExecutor.h"
+#include "BlockFactory/SimulinkCoder/SpscRingBuffer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace blockfactory {
+    namespace coder {
+        template <typename Model, typename Input, typename Output>
+        class RealTimeRunner;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that runs a model in a dedicated real-time thread
+ *
+ * The step of the model, usually a coder::GeneratedCodeWrapper object, is executed periodically
+ * by a coder::PeriodicExecutor in a thread owned by this class. The thread can be pinned to a set
+ * of CPUs and scheduled with a real-time priority configuring the executor returned by
+ * coder::RealTimeRunner::getExecutor.
+ *
+ * The other threads of the application exchange data with the model only through two wait-free
+ * coder::SpscRingBuffer queues, so that they never take a lock shared with the real-time thread:
+ *
+ * - The messages pushed with coder::RealTimeRunner::pushInput are applied to the model before
+ *   the step by the input handler, in the order they were pushed.
+ * - After every successful step, the output handler fills a message that can be extracted with
+ *   coder::RealTimeRunner::popOutput. If the output queue is full, the message is dropped and
+ *   counted.
+ *
+ * @code{.cpp}
+ * using Setpoint = std::array<double, 5>;
+ * blockfactory::coder::RealTimeRunner<Wrapper, Setpoint, Setpoint> runner(model);
+ *
+ * runner.setInputHandler([](Wrapper& model, const Setpoint& input) {
+ *     std::copy(input.begin(), input.end(), model.getInput("input2").begin());
+ *     return true;
+ * });
+ * runner.setOutputHandler([](Wrapper& model, Setpoint& output) {
+ *     const auto result = model.getOutput("Result");
+ *     std::copy(result.begin(), result.end(), output.begin());
+ *     return true;
+ * });
+ *
+ * runner.getExecutor().setPeriod(0.001);
+ * runner.getExecutor().setCpuAffinity({3});
+ * runner.start();
+ * @endcode
+ *
+ * @note A single application thread can push the inputs and a single application thread can pop
+ *       the outputs. The handlers are called by the real-time thread.
+ *
+ * @tparam Model The type of the model. It must have a `bool step()` method.
+ * @tparam Input The type of the input messages. It must not allocate memory when copied.
+ * @tparam Output The type of the output messages. It must not allocate memory when copied.
+ */
+template <typename Model, typename Input, typename Output>
+class blockfactory::coder::RealTimeRunner
+{
+public:
+    /// Function that applies an input message to the model before the step
+    using InputHandler = std::function<bool(Model&, const Input&)>;
+    /// Function that fills an output message after the step
+    using OutputHandler = std::function<bool(Model&, Output&)>;
+
+    /// Default capacity of the input and output queues
+    static constexpr size_t DefaultQueueCapacity = 64;
+
+private:
+    Model& m_model;
+    PeriodicExecutor m_executor;
+
+    SpscRingBuffer<Input> m_inputs;
+    SpscRingBuffer<Output> m_outputs;
+    InputHandler m_inputHandler;
+    OutputHandler m_outputHandler;
+
+    // Messages used only by the real-time thread, allocated once
+    Input m_input;
+    Output m_output;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<bool> m_failed{false};
+    std::atomic<uint64_t> m_numberOfDroppedOutputs{0};
+
+    bool step();
+
+public:
+    /**
+     * @brief Construct a runner
+     *
+     * @param model The model to run. It must outlive the runner and it should not be accessed by
+     *        other threads while the runner is running.
+     * @param queueCapacity The capacity of the input and output queues.
+     */
+    RealTimeRunner(Model& model, const size_t queueCapacity = DefaultQueueCapacity);
+    ~RealTimeRunner();
+
+    RealTimeRunner(const RealTimeRunner& other) = delete;
+    RealTimeRunner& operator=(const RealTimeRunner& other) = delete;
+
+    /**
+     * @brief Set the function that applies the input messages
+     *
+     * @param handler The input handler.
+     * @return True for success, false if the runner is running.
+     */
+    bool setInputHandler(const InputHandler& handler);
+
+    /**
+     * @brief Set the function that fills the output messages
+     *
+     * If no output handler is set, no output message is produced.
+     *
+     * @param handler The output handler.
+     * @return True for success, false if the runner is running.
+     */
+    bool setOutputHandler(const OutputHandler& handler);
+
+    /**
+     * @brief Get the executor of the real-time thread
+     *
+     * Use the returned object to configure the period, the CPU affinity and the priority of the
+     * thread before calling coder::RealTimeRunner::start, and to read the timing statistics.
+     *
+     * @return The executor.
+     */
+    PeriodicExecutor& getExecutor();
+
+    /**
+     * @brief Start the real-time thread
+     *
+     * @param numberOfSteps The number of steps to execute, or 0 to run until
+     *        coder::RealTimeRunner::stop is called.
+     * @return True for success, false if the runner is already running.
+     */
+    bool start(const uint64_t numberOfSteps = 0);
+
+    /**
+     * @brief Stop the real-time thread and wait for its termination
+     *
+     * The step in progress, if any, is completed.
+     *
+     * @return True if all the steps and the handlers succeeded, false otherwise.
+     */
+    bool stop();
+
+    /**
+     * @brief Check if the real-time thread is running
+     *
+     * @return True if the thread is executing the model, false otherwise. The thread terminates
+     *         by itself after the requested number of steps or after a failure.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Queue an input message for the model
+     *
+     * This method never blocks and it can be called by a single application thread.
+     *
+     * @param input The message.
+     * @return True for success, false if the input queue is full.
+     */
+    bool pushInput(const Input& input);
+
+    /**
+     * @brief Extract the oldest output message of the model
+     *
+     * This method never blocks and it can be called by a single application thread.
+     *
+     * @param[out] output The message.
+     * @return True for success, false if no output is available.
+     */
+    bool popOutput(Output& output);
+
+    /**
+     * @brief Get the number of output messages dropped because the output queue was full
+     *
+     * @return The number of dropped messages.
+     */
+    uint64_t getNumberOfDroppedOutputs() const;
+};
+
+template <typename Model, typename Input, typename Output>
+constexpr size_t blockfactory::coder::RealTimeRunner<Model, Input, Output>::DefaultQueueCapacity;
+
+template <typename Model, typename Input, typename Output>
+blockfactory::coder::RealTimeRunner<Model, Input, Output>::RealTimeRunner(
+    Model& model,
+    const size_t queueCapacity)
+    : m_model(model)
+    , m_inputs(queueCapacity)
+    , m_outputs(queueCapacity)
+    , m_input()
+    , m_output()
+{}
+
+template <typename Model, typename Input, typename Output>
+blockfactory::coder::RealTimeRunner<Model, Input, Output>::~RealTimeRunner()
+{
+    stop();
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::step()
+{
+    // The executor ignores stop requests received before it started
+    if (m_stopRequested.load(std::memory_order_acquire)) {
+        m_executor.requestStop();
+        return true;
+    }
+
+    while (m_inputs.pop(m_input)) {
+        if (m_inputHandler && !m_inputHandler(m_model, m_input)) {
+            bfError << "Failed to apply the input to the model.";
+            return false;
+        }
+    }
+
+    if (!m_model.step()) {
+        return false;
+    }
+
+    if (m_outputHandler) {
+        if (!m_outputHandler(m_model, m_output)) {
+            bfError << "Failed to read the output of the model.";
+            return false;
+        }
+        if (!m_outputs.push(m_output)) {
+            m_numberOfDroppedOutputs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    return true;
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::setInputHandler(
+    const InputHandler& handler)
+{
+    if (isRunning()) {
+        bfError << "The input handler cannot be changed while the runner is running.";
+        return false;
+    }
+
+    m_inputHandler = handler;
+    return true;
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::setOutputHandler(
+    const OutputHandler& handler)
+{
+    if (isRunning()) {
+        bfError << "The output handler cannot be changed while the runner is running.";
+        return false;
+    }
+
+    m_outputHandler = handler;
+    return true;
+}
+
+template <typename Model, typename Input, typename Output>
+blockfactory::coder::PeriodicExecutor&
+blockfactory::coder::RealTimeRunner<Model, Input, Output>::getExecutor()
+{
+    return m_executor;
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::start(
+    const uint64_t numberOfSteps)
+{
+    if (m_running.exchange(true)) {
+        bfError << "The runner is already running.";
+        return false;
+    }
+
+    // Join a thread that terminated by itself
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_stopRequested = false;
+    m_failed = false;
+
+    m_thread = std::thread([this, numberOfSteps]() {
+        if (!m_executor.run([this]() { return step(); }, numberOfSteps)) {
+            m_failed = true;
+        }
+        m_running = false;
+    });
+
+    return true;
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::stop()
+{
+    m_stopRequested = true;
+    m_executor.requestStop();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    return !m_failed;
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::isRunning() const
+{
+    return m_running.load(std::memory_order_acquire);
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::pushInput(const Input& input)
+{
+    return m_inputs.push(input);
+}
+
+template <typename Model, typename Input, typename Output>
+bool blockfactory::coder::RealTimeRunner<Model, Input, Output>::popOutput(Output& output)
+{
+    return m_outputs.pop(output);
+}
+
+template <typename Model, typename Input, typename Output>
+uint64_t
+blockfactory::coder::RealTimeRunner<Model, Input, Output>::getNumberOfDroppedOutputs() const
+{
+    return m_numberOfDroppedOutputs.load(std::memory_order_relaxed);
+}
+
+#endif // BLOCKFACTORY_CODER_REALTIMERUNNER_H
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_SIGNALMEMORYPLANNER_H
+#define BLOCKFACTORY_CODER_SIGNALMEMORYPLANNER_H
+
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace blockfactory {
+    namespace coder {
+        class CoderBlockInformation;
+        class SignalMemoryPlanner;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Class that allocates the signals of a coder::ModelGraph in a single memory arena
+ *
+ * The planner computes the lifetime of every signal of the model from the execution order of the
+ * blocks, i.e. from the block that produces it to the last block that consumes it. Signals whose
+ * lifetimes do not overlap can share the same memory region. The offsets inside the arena are
+ * assigned greedily starting from the biggest signals, and each signal buffer is aligned to
+ * coder::SignalMemoryPlanner::Alignment bytes.
+ *
+ * The following signals are kept alive for the entire step (persistent) and never share memory:
+ *
+ * - External inputs, i.e. signals connected to input ports without a source.
+ * - External outputs, i.e. signals produced by output ports without any destination.
+ * - Feedback signals, i.e. signals consumed by a block that is executed before (or is) the
+ *   producer and that hence read the value computed in the previous step.
+ *
+ * Output ports that declare core::Port::Info::inPlaceInput share the buffer of that input
+ * signal, if the block is its only consumer, the block has no states and neither signal is
+ * persistent. Blocks with states can read their inputs outside core::Block::output, hence their
+ * outputs always have a dedicated buffer. The in-place outputs are planned only when the buffer
+ * reuse is enabled.
+ *
+ * All the signals are exposed as core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY objects that
+ * point inside the arena. The memory is allocated once by coder::SignalMemoryPlanner::plan, and no
+ * allocation occurs while the model is executed.
+ *
+ * @note Blocks that read the value of their own output ports from a previous step rely on outputs
+ *       that are not overwritten between steps. For models containing such blocks, disable the
+ *       buffer reuse with coder::SignalMemoryPlanner::setBufferReuse.
+ * @see coder::ModelGraph, coder::CoderBlockInformation
+ */
+class blockfactory::coder::SignalMemoryPlanner
+{
+public:
+    /// The alignment in bytes of every signal buffer stored in the arena
+    static const size_t Alignment = 64;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class impl;
+    std::unique_ptr<impl> pImpl;
+#endif
+
+public:
+    SignalMemoryPlanner();
+    ~SignalMemoryPlanner();
+
+    SignalMemoryPlanner(const SignalMemoryPlanner& other) = delete;
+    SignalMemoryPlanner& operator=(const SignalMemoryPlanner& other) = delete;
+
+    /**
+     * @brief Enable or disable the reuse of memory between signals with disjoint lifetimes
+     *
+     * The buffer reuse is enabled by default. It must be configured before calling
+     * coder::SignalMemoryPlanner::plan.
+     *
+     * @param enable True to enable the buffer reuse, false to allocate a dedicated buffer to each
+     *               signal.
+     */
+    void setBufferReuse(const bool enable);
+
+    /**
+     * @brief Check if the memory is reused between signals with disjoint lifetimes
+     *
+     * @return True if the buffer reuse is enabled, false otherwise.
+     */
+    bool isBufferReuseEnabled() const;
+
+    /**
+     * @brief Plan and allocate the memory of the signals of a model
+     *
+     * Calling this method again discards the previous plan and invalidates all the signals and the
+     * addresses previously returned.
+     *
+     * @param graph The model graph. Its blocks must be stored in execution order.
+     * @return True for success, false otherwise.
+     */
+    bool plan(const ModelGraph& graph);
+
+    /**
+     * @brief Get the size of the arena
+     *
+     * @return The size in bytes of the memory that stores all the signals.
+     */
+    size_t getArenaSize() const;
+
+    /**
+     * @brief Get the memory that would be required without buffer reuse
+     *
+     * @return The sum of the (aligned) sizes in bytes of all the signals.
+     */
+    size_t getRequiredMemoryWithoutReuse() const;
+
+    /**
+     * @brief Get the number of signals of the planned model
+     *
+     * @return The number of signals.
+     */
+    size_t getNumberOfSignals() const;
+
+    /**
+     * @brief Get the ordering constraints introduced by the buffer reuse
+     *
+     * The planned memory is valid only if blocks are executed in the order of the graph. When
+     * blocks are executed in a different order (e.g. concurrently), a block that writes a signal
+     * sharing memory with another signal must wait all the blocks that use the other signal.
+     *
+     * @return A vector of pairs `{before, after}` of block indices, meaning that the block
+     *         `after` must be executed after the block `before`.
+     */
+    std::vector<std::pair<ModelGraph::BlockIndex, ModelGraph::BlockIndex>>
+    getReuseDependencies() const;
+
+    /**
+     * @brief Get the signal connected to an input port
+     *
+     * @param input The input port.
+     * @return The signal if the port exists, `nullptr` otherwise.
+     */
+    core::InputSignalPtr getInputPortSignal(const ModelGraph::PortRef& input) const;
+
+    /**
+     * @brief Get the signal connected to an output port
+     *
+     * @param output The output port.
+     * @return The signal if the port exists, `nullptr` otherwise.
+     */
+    core::OutputSignalPtr getOutputPortSignal(const ModelGraph::PortRef& output) const;
+
+    /**
+     * @brief Get the address of the buffer of the signal connected to an input port
+     *
+     * This is the address to fill with data for the external inputs of the model.
+     *
+     * @param input The input port.
+     * @return The address if the port exists, `nullptr` otherwise.
+     */
+    void* getInputPortAddress(const ModelGraph::PortRef& input) const;
+
+    /**
+     * @brief Get the address of the buffer of the signal connected to an output port
+     *
+     * @param output The output port.
+     * @return The address if the port exists, `nullptr` otherwise.
+     */
+    void* getOutputPortAddress(const ModelGraph::PortRef& output) const;
+
+    /**
+     * @brief Connect an input port to a buffer that does not belong to the arena
+     *
+     * After this call, the input port reads its data from the passed buffer instead of the planned
+     * signal. This is useful to insert intermediate buffers between blocks, e.g. the rate
+     * transition buffers of coder::MultiRateScheduler. The redirection is discarded by the next
+     * call of coder::SignalMemoryPlanner::plan.
+     *
+     * @param input The input port.
+     * @param address The address of the buffer. It must be big enough to store the signal, and it
+     *                must outlive the planner.
+     * @return True for success, false otherwise.
+     */
+    bool redirectInputPort(const ModelGraph::PortRef& input, void* address);
+
+    /**
+     * @brief Connect a redirected input port back to its planned signal
+     *
+     * @param input The input port.
+     * @return True for success, false if the port has not been planned.
+     * @see coder::SignalMemoryPlanner::redirectInputPort
+     */
+    bool restoreInputPort(const ModelGraph::PortRef& input);
+
+    /**
+     * @brief Configure the ports of a coder::CoderBlockInformation object
+     *
+     * Set the input and output ports of the passed object using the planned buffers, analogously
+     * to what the code generated by Simulink Coder does.
+     *
+     * @param block The index of the block in the planned graph.
+     * @param blockInfo The (not yet configured) block information object of the block.
+     * @return True for success, false otherwise.
+     */
+    bool configureBlockInformation(const ModelGraph::BlockIndex block,
+                                   CoderBlockInformation& blockInfo) const;
+};
+
+#endif // BLOCKFACTORY_CODER_SIGNALMEMORYPLANNER_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_CODER_SPSCRINGBUFFER_H
+#define BLOCKFACTORY_CODER_SPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace blockfactory {
+    namespace coder {
+        template <typename T>
+        class SpscRingBuffer;
+    } // namespace coder
+} // namespace blockfactory
+
+/**
+ * @brief Wait-free single-producer / single-consumer ring buffer
+ *
+ * This class moves data between two threads without locks, e.g. between a non real-time
+ * application thread and the thread running a model. Exactly one thread can call
+ * coder::SpscRingBuffer::push and exactly one thread can call coder::SpscRingBuffer::pop. Both
+ * operations complete in a bounded number of steps and never allocate memory: all the elements
+ * are allocated by the constructor.
+ *
+ * The indices of the producer and of the consumer are stored in different cache lines, and each
+ * side caches the last index read from the other side. In this way the cache line owned by the
+ * other thread is accessed only when the buffer looks full or empty.
+ *
+ * @tparam T The type of the elements. It must be default constructible and copy assignable.
+ *           Prefer types that do not allocate memory when copied, e.g. `std::array`.
+ */
+template <typename T>
+class blockfactory::coder::SpscRingBuffer
+{
+private:
+    static constexpr size_t CacheLineSize = 64;
+    using Index = std::atomic<size_t>;
+
+    std::vector<T> m_buffer;
+    size_t m_mask;
+
+    // Consumer side
+    char m_padding0[CacheLineSize];
+    Index m_head{0};
+    size_t m_cachedTail = 0;
+
+    // Producer side
+    char m_padding1[CacheLineSize - sizeof(Index) - sizeof(size_t)];
+    Index m_tail{0};
+    size_t m_cachedHead = 0;
+    char m_padding2[CacheLineSize - sizeof(Index) - sizeof(size_t)];
+
+    static size_t roundCapacity(const size_t capacity)
+    {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+public:
+    /**
+     * @brief Construct a ring buffer
+     *
+     * @param capacity The minimum number of elements the buffer can store. It is rounded up to the
+     *        next power of two.
+     */
+    explicit SpscRingBuffer(const size_t capacity)
+        : m_buffer(roundCapacity(capacity))
+        , m_mask(m_buffer.size() - 1)
+    {}
+
+    SpscRingBuffer(const SpscRingBuffer& other) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer& other) = delete;
+
+    /**
+     * @brief Insert an element at the end of the buffer
+     *
+     * This method must be called only by the producer thread.
+     *
+     * @param value The element to insert.
+     * @return True for success, false if the buffer is full.
+     */
+    bool push(const T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_cachedHead == m_buffer.size()) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_buffer.size()) {
+                return false;
+            }
+        }
+
+        m_buffer[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Extract the element at the beginning of the buffer
+     *
+     * This method must be called only by the consumer thread.
+     *
+     * @param[out] value The extracted element.
+     * @return True for success, false if the buffer is empty.
+     */
+    bool pop(T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+
+        value = m_buffer[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of stored elements
+     *
+     * The value is only a snapshot if the producer or the consumer are running.
+     *
+     * @return The number of elements.
+     */
+    size_t size() const
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    /**
+     * @brief Check if the buffer is empty
+     *
+     * @return True if the buffer has no elements, false otherwise.
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get the maximum number of elements
+     *
+     * @return The capacity of the buffer.
+     */
+    size_t capacity() const { return m_buffer.size(); }
+};
+
+#endif // BLOCKFACTORY_CODER_SPSCRINGBUFFER_H
@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/BatchRunner.h"
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+
+#include <functional>
+#include <ostream>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+class BatchRunner::impl
+{
+public:
+    struct PortData
+    {
+        core::Port::Info info;
+        size_t width = 0;
+        // Signals of all the instances, in structure-of-arrays layout
+        std::vector<double> batched;
+        // Signal of a single instance, used when the block does not support the batched output
+        std::vector<double> scratch;
+
+        void allocate(const size_t width, const size_t batchSize);
+        void gather(const size_t instance, const size_t batchSize);
+        void scatter(const size_t instance, const size_t batchSize);
+    };
+
+    core::Block* block = nullptr;
+    size_t batchSize = 0;
+    bool batched = false;
+
+    std::vector<PortData> inputs;
+    std::vector<PortData> outputs;
+
+    // The states of the instances use the same layout of the ports
+    PortData discreteStates;
+    PortData continuousStates;
+    PortData derivatives;
+
+    std::unique_ptr<CoderBlockInformation> instanceInfo;
+    std::unique_ptr<CoderBlockInformation> batchInfo;
+
+    static bool createPorts(const std::vector<core::Port::Info>& portsInfo,
+                            const size_t batchSize,
+                            std::vector<PortData>& ports);
+    static PortData* findPort(std::vector<PortData>& ports, const core::Port::Index idx);
+
+    using Callback = std::function<bool(const core::BlockInformation*)>;
+    bool runInstances(const Callback& callback, const bool writesOutputs, const char* name);
+};
+
+void BatchRunner::impl::PortData::allocate(const size_t width, const size_t batchSize)
+{
+    this->width = width;
+    batched.assign(width * batchSize, 0.0);
+    scratch.assign(width, 0.0);
+}
+
+void BatchRunner::impl::PortData::gather(const size_t instance, const size_t batchSize)
+{
+    for (size_t element = 0; element < width; ++element) {
+        scratch[element] = batched[element * batchSize + instance];
+    }
+}
+
+void BatchRunner::impl::PortData::scatter(const size_t instance, const size_t batchSize)
+{
+    for (size_t element = 0; element < width; ++element) {
+        batched[element * batchSize + instance] = scratch[element];
+    }
+}
+
+bool BatchRunner::impl::runInstances(const Callback& callback,
+                                     const bool writesOutputs,
+                                     const char* name)
+{
+    for (size_t instance = 0; instance < batchSize; ++instance) {
+        for (auto& port : inputs) {
+            port.gather(instance, batchSize);
+        }
+        discreteStates.gather(instance, batchSize);
+        continuousStates.gather(instance, batchSize);
+        derivatives.gather(instance, batchSize);
+
+        if (!callback(instanceInfo.get())) {
+            bfError << "Failed to compute the " << name << " of the instance " << instance << ".";
+            return false;
+        }
+
+        if (writesOutputs) {
+            for (auto& port : outputs) {
+                port.scatter(instance, batchSize);
+            }
+        }
+        discreteStates.scatter(instance, batchSize);
+        continuousStates.scatter(instance, batchSize);
+        derivatives.scatter(instance, batchSize);
+    }
+
+    return true;
+}
+
+bool BatchRunner::impl::createPorts(const std::vector<core::Port::Info>& portsInfo,
+                                    const size_t batchSize,
+                                    std::vector<PortData>& ports)
+{
+    ports.clear();
+
+    for (const auto& portInfo : portsInfo) {
+        if (portInfo.dataType != core::Port::DataType::DOUBLE) {
+            bfError << "The batched execution supports only ports of type double.";
+            return false;
+        }
+
+        const size_t width = ModelGraph::getNumberOfElements(portInfo);
+        if (width == 0) {
+            bfError << "The port " << portInfo.index << " has not a concrete size.";
+            return false;
+        }
+
+        PortData port;
+        port.info = portInfo;
+        port.allocate(width, batchSize);
+        ports.push_back(std::move(port));
+    }
+
+    return true;
+}
+
+BatchRunner::impl::PortData* BatchRunner::impl::findPort(std::vector<PortData>& ports,
+                                                         const core::Port::Index idx)
+{
+    for (auto& port : ports) {
+        if (port.info.index == idx) {
+            return &port;
+        }
+    }
+    return nullptr;
+}
+
+BatchRunner::BatchRunner()
+    : pImpl(std::make_unique<BatchRunner::impl>())
+{}
+
+BatchRunner::~BatchRunner() = default;
+
+bool BatchRunner::configure(core::Block* block,
+                            const core::InputPortsInfo& inputPortsInfo,
+                            const core::OutputPortsInfo& outputPortsInfo,
+                            const size_t batchSize,
+                            const core::Parameters& parameters,
+                            const std::string& blockUniqueName)
+{
+    if (!block) {
+        bfError << "The block is not valid.";
+        return false;
+    }
+
+    if (batchSize == 0) {
+        bfError << "The batch must contain at least one instance.";
+        return false;
+    }
+
+    if (!impl::createPorts(inputPortsInfo, batchSize, pImpl->inputs)
+        || !impl::createPorts(outputPortsInfo, batchSize, pImpl->outputs)) {
+        return false;
+    }
+
+    pImpl->block = block;
+    pImpl->batchSize = batchSize;
+    pImpl->batched = block->supportsBatchedOutput();
+    pImpl->instanceInfo = std::make_unique<CoderBlockInformation>();
+    pImpl->batchInfo = std::make_unique<CoderBlockInformation>();
+
+    for (auto* blockInfo : {pImpl->instanceInfo.get(), pImpl->batchInfo.get()}) {
+        blockInfo->setUniqueBlockName(blockUniqueName);
+        if (parameters.getNumberOfParameters() > 0 && !blockInfo->storeRTWParameters(parameters)) {
+            return false;
+        }
+    }
+
+    // CoderBlockInformation expects {rows, cols} dimensions
+    for (auto* ports : {&pImpl->inputs, &pImpl->outputs}) {
+        const bool input = ports == &pImpl->inputs;
+
+        for (auto& port : *ports) {
+            const int width = static_cast<int>(port.width);
+            const int batchedWidth = static_cast<int>(port.width * batchSize);
+            const core::Port::Info instancePort = {port.info.index, {1, width}, port.info.dataType};
+            const core::Port::Info batchPort = {
+                port.info.index, {1, batchedWidth}, port.info.dataType};
+
+            const bool ok =
+                input ? pImpl->instanceInfo->setInputPort(instancePort, port.scratch.data())
+                            && pImpl->batchInfo->setInputPort(batchPort, port.batched.data())
+                      : pImpl->instanceInfo->setOutputPort(instancePort, port.scratch.data())
+                            && pImpl->batchInfo->setOutputPort(batchPort, port.batched.data());
+            if (!ok) {
+                bfError << "Failed to configure the port " << port.info.index << ".";
+                return false;
+            }
+        }
+    }
+
+    // Every instance has its own states. The batch information receives the states of all the
+    // instances, and the instance information the states gathered from them.
+    const size_t numberOfDiscreteStates = block->numberOfDiscreteStates();
+    const size_t numberOfContinuousStates = block->numberOfContinuousStates();
+    pImpl->discreteStates.allocate(numberOfDiscreteStates, batchSize);
+    pImpl->continuousStates.allocate(numberOfContinuousStates, batchSize);
+    pImpl->derivatives.allocate(numberOfContinuousStates, batchSize);
+
+    if (numberOfDiscreteStates > 0
+        && (!pImpl->batchInfo->setDiscreteStates(pImpl->discreteStates.batched.data(),
+                                                 numberOfDiscreteStates * batchSize)
+            || !pImpl->instanceInfo->setDiscreteStates(pImpl->discreteStates.scratch.data(),
+                                                       numberOfDiscreteStates))) {
+        return false;
+    }
+
+    if (numberOfContinuousStates > 0
+        && (!pImpl->batchInfo->setContinuousStates(pImpl->continuousStates.batched.data(),
+                                                   pImpl->derivatives.batched.data(),
+                                                   numberOfContinuousStates * batchSize)
+            || !pImpl->instanceInfo->setContinuousStates(pImpl->continuousStates.scratch.data(),
+                                                         pImpl->derivatives.scratch.data(),
+                                                         numberOfContinuousStates))) {
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchRunner::initialize()
+{
+    if (!pImpl->block) {
+        bfError << "The runner must be configured before being initialized.";
+        return false;
+    }
+
+    core::Block* block = pImpl->block;
+
+    if (!block->initialize(pImpl->instanceInfo.get())) {
+        return false;
+    }
+
+    // The initial conditions are written in the states of every instance
+    if (pImpl->discreteStates.width == 0 && pImpl->continuousStates.width == 0) {
+        return block->initializeInitialConditions(pImpl->instanceInfo.get());
+    }
+
+    return pImpl->runInstances(
+        [&](const core::BlockInformation* blockInfo) {
+            return block->initializeInitialConditions(blockInfo);
+        },
+        /*writesOutputs=*/false,
+        "initial conditions");
+}
+
+bool BatchRunner::output()
+{
+    if (!pImpl->block) {
+        bfError << "The runner is not configured.";
+        return false;
+    }
+
+    core::Block* block = pImpl->block;
+
+    if (pImpl->batched) {
+        return block->outputBatched(pImpl->batchInfo.get(), pImpl->batchSize);
+    }
+
+    return pImpl->runInstances(
+        [&](const core::BlockInformation* blockInfo) { return block->output(blockInfo); },
+        /*writesOutputs=*/true,
+        "output");
+}
+
+bool BatchRunner::updateDiscreteState()
+{
+    if (!pImpl->block) {
+        bfError << "The runner is not configured.";
+        return false;
+    }
+
+    if (pImpl->discreteStates.width == 0) {
+        return true;
+    }
+
+    core::Block* block = pImpl->block;
+    return pImpl->runInstances(
+        [&](const core::BlockInformation* blockInfo) {
+            return block->updateDiscreteState(blockInfo);
+        },
+        /*writesOutputs=*/false,
+        "discrete state");
+}
+
+bool BatchRunner::stateDerivative()
+{
+    if (!pImpl->block) {
+        bfError << "The runner is not configured.";
+        return false;
+    }
+
+    if (pImpl->continuousStates.width == 0) {
+        return true;
+    }
+
+    core::Block* block = pImpl->block;
+    return pImpl->runInstances(
+        [&](const core::BlockInformation* blockInfo) { return block->stateDerivative(blockInfo); },
+        /*writesOutputs=*/false,
+        "state derivative");
+}
+
+bool BatchRunner::terminate()
+{
+    if (!pImpl->block) {
+        bfError << "The runner is not configured.";
+        return false;
+    }
+
+    return pImpl->block->terminate(pImpl->instanceInfo.get());
+}
+
+bool BatchRunner::isBatched() const
+{
+    return pImpl->batched;
+}
+
+size_t BatchRunner::getBatchSize() const
+{
+    return pImpl->batchSize;
+}
+
+size_t BatchRunner::getIndex(const size_t instance, const size_t element) const
+{
+    return element * pImpl->batchSize + instance;
+}
+
+double* BatchRunner::getInputPortBuffer(const core::Port::Index idx)
+{
+    auto* port = impl::findPort(pImpl->inputs, idx);
+    return port ? port->batched.data() : nullptr;
+}
+
+const double* BatchRunner::getOutputPortBuffer(const core::Port::Index idx) const
+{
+    auto* port = impl::findPort(pImpl->outputs, idx);
+    return port ? port->batched.data() : nullptr;
+}
+
+double* BatchRunner::getDiscreteStateBuffer()
+{
+    return pImpl->discreteStates.width > 0 ? pImpl->discreteStates.batched.data() : nullptr;
+}
+
+double* BatchRunner::getContinuousStateBuffer()
+{
+    return pImpl->continuousStates.width > 0 ? pImpl->continuousStates.batched.data() : nullptr;
+}
+
+const double* BatchRunner::getContinuousStateDerivativeBuffer() const
+{
+    return pImpl->derivatives.width > 0 ? pImpl->derivatives.batched.data() : nullptr;
+}
@@ -12,10 +12,13 @@
 #include "BlockFactory/Core/Parameters.h"
 
 #include <cassert>
+#include <cstdint>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -28,6 +31,55 @@ struct PortAndSignalData
     core::Port::Info portInfo;
 };
 
+static core::Port::Size::Vector getWidth(const core::Port::Info& portInfo)
+{
+    const auto& dimensions = portInfo.dimension;
+
+    // Frames store all their samples in the same signal
+    if (dimensions.size() <= 2) {
+        return portInfo.frameSize * dimensions.back();
+    }
+
+    core::Port::Size::Vector width = 1;
+    for (const auto dim : dimensions) {
+        width *= dim;
+    }
+    return width;
+}
+
+template <typename T>
+static const void* getData(const core::Signal& signal, size_t& bytes)
+{
+    bytes = signal.getWidth() * sizeof(T);
+    return signal.getBuffer<T>();
+}
+
+// Get the raw buffer of a signal of any data type and its size in bytes
+static const void* getData(const core::Signal& signal, size_t& bytes)
+{
+    switch (signal.getPortDataType()) {
+        case core::Port::DataType::DOUBLE:
+            return getData<double>(signal, bytes);
+        case core::Port::DataType::SINGLE:
+            return getData<float>(signal, bytes);
+        case core::Port::DataType::INT8:
+            return getData<int8_t>(signal, bytes);
+        case core::Port::DataType::UINT8:
+            return getData<uint8_t>(signal, bytes);
+        case core::Port::DataType::INT16:
+            return getData<int16_t>(signal, bytes);
+        case core::Port::DataType::UINT16:
+            return getData<uint16_t>(signal, bytes);
+        case core::Port::DataType::INT32:
+            return getData<int32_t>(signal, bytes);
+        case core::Port::DataType::UINT32:
+            return getData<uint32_t>(signal, bytes);
+        case core::Port::DataType::BOOLEAN:
+            return getData<bool>(signal, bytes);
+    }
+    return nullptr;
+}
+
 class CoderBlockInformation::impl
 {
 public:
@@ -41,9 +93,17 @@ public:
     IndexToPortAndSignalDataMap inputPortAndSignalMap;
     IndexToPortAndSignalDataMap outputPortAndSignalMap;
 
+    std::shared_ptr<core::Signal> continuousStates;
+    std::shared_ptr<core::Signal> continuousStateDerivatives;
+    std::shared_ptr<core::Signal> discreteStates;
+
     static bool storePortInfo(const core::Port::Info& portInfo,
                               void* signalAddress,
                               IndexToPortAndSignalDataMap& dataMap);
+    static size_t relocatePorts(const uint8_t* begin,
+                                const uint8_t* end,
+                                uint8_t* newAddress,
+                                IndexToPortAndSignalDataMap& dataMap);
 
     bool inputPortAtIndexExists(const core::Port::Index idx) const;
     bool outputPortAtIndexExists(const core::Port::Index idx) const;
@@ -67,9 +127,25 @@ bool CoderBlockInformation::impl::outputPortAtIndexExists(const core::Port::Inde
     return true;
 }
 
+// Registry of the existing objects, used for relocating the signals of the generated code
+static std::mutex& registryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::unordered_set<CoderBlockInformation*>& registry()
+{
+    static std::unordered_set<CoderBlockInformation*> objects;
+    return objects;
+}
+
 CoderBlockInformation::CoderBlockInformation()
     : pImpl(std::make_unique<CoderBlockInformation::impl>())
-{}
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().insert(this);
+}
 
 bool CoderBlockInformation::getUniqueName(std::string& blockUniqueName) const
 {
@@ -77,7 +153,11 @@ bool CoderBlockInformation::getUniqueName(std::string& blockUniqueName) const
     return true;
 }
 
-CoderBlockInformation::~CoderBlockInformation() = default;
+CoderBlockInformation::~CoderBlockInformation()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().erase(this);
+}
 
 // BLOCK OPTIONS METHODS
 // =====================
@@ -109,8 +189,9 @@ core::Port::Size::Vector CoderBlockInformation::getInputPortWidth(const core::Po
     }
 
     // mdlRTW writes always a {rows, cols} structure, and vectors are row vectors.
-    // This means that their dimension is the cols entry.
-    return pImpl->inputPortAndSignalMap.at(idx).portInfo.dimension.at(1);
+    // This means that their dimension is the cols entry. N-D signals have all their dimensions,
+    // and their width is the number of elements. Frames have the width of all their samples.
+    return getWidth(pImpl->inputPortAndSignalMap.at(idx).portInfo);
 }
 
 core::Port::Size::Vector
@@ -122,8 +203,9 @@ CoderBlockInformation::getOutputPortWidth(const core::Port::Index idx) const
     }
 
     // mdlRTW writes always a {rows, cols} structure, and vectors are row vectors.
-    // This means that their dimension is the cols entry.
-    return pImpl->outputPortAndSignalMap.at(idx).portInfo.dimension.at(1);
+    // This means that their dimension is the cols entry. N-D signals have all their dimensions,
+    // and their width is the number of elements. Frames have the width of all their samples.
+    return getWidth(pImpl->outputPortAndSignalMap.at(idx).portInfo);
 }
 
 core::InputSignalPtr CoderBlockInformation::getInputPortSignal(const core::Port::Index idx) const
@@ -133,11 +215,13 @@ core::InputSignalPtr CoderBlockInformation::getInputPortSignal(const core::Port:
         return {};
     }
 
-    // Get the signal
-    auto signal = pImpl->inputPortAndSignalMap.at(idx).signal;
+    // Get the signal. The data is accessed by reference since this method is called at every
+    // step by the blocks, and it must not allocate.
+    const auto& data = pImpl->inputPortAndSignalMap.at(idx);
+    auto signal = data.signal;
 
     // Check that the port to which the signal is connected does not have dynamic sizes
-    for (const auto dim : getInputPortInfo(idx).dimension) {
+    for (const auto dim : data.portInfo.dimension) {
         if (dim == core::Port::DynamicSize) {
             bfError << "The input port " << idx << " has dynamic sizes. "
                     << "This should not happen in the Simulink Coder implementation.";
@@ -160,11 +244,13 @@ core::OutputSignalPtr CoderBlockInformation::getOutputPortSignal(const core::Por
         return {};
     }
 
-    // Get the signal
-    auto signal = pImpl->outputPortAndSignalMap.at(idx).signal;
+    // Get the signal. The data is accessed by reference since this method is called at every
+    // step by the blocks, and it must not allocate.
+    const auto& data = pImpl->outputPortAndSignalMap.at(idx);
+    auto signal = data.signal;
 
     // Check that the port to which the signal is connected does not have dynamic sizes
-    for (const auto dim : getOutputPortInfo(idx).dimension) {
+    for (const auto dim : data.portInfo.dimension) {
         if (dim == core::Port::DynamicSize) {
             bfError << "The output port " << idx << " has dynamic sizes. "
                     << "This should not happen in the Simulink Coder implementation.";
@@ -194,7 +280,13 @@ CoderBlockInformation::getInputPortMatrixSize(const core::Port::Index idx) const
         return {};
     }
 
-    auto dims = pImpl->inputPortAndSignalMap.at(idx).portInfo.dimension;
+    const auto& portInfo = pImpl->inputPortAndSignalMap.at(idx).portInfo;
+    const auto& dims = portInfo.dimension;
+
+    // Frames are frameSize x width matrices, as in Simulink
+    if (portInfo.frameSize > 1) {
+        return {portInfo.frameSize, dims.back()};
+    }
 
     assert(dims.size() >= 2);
     return {dims[0], dims[1]};
@@ -208,7 +300,13 @@ CoderBlockInformation::getOutputPortMatrixSize(const core::Port::Index idx) cons
         return {};
     }
 
-    auto dims = pImpl->outputPortAndSignalMap.at(idx).portInfo.dimension;
+    const auto& portInfo = pImpl->outputPortAndSignalMap.at(idx).portInfo;
+    const auto& dims = portInfo.dimension;
+
+    // Frames are frameSize x width matrices, as in Simulink
+    if (portInfo.frameSize > 1) {
+        return {portInfo.frameSize, dims.back()};
+    }
 
     assert(dims.size() >= 2);
     return {dims[0], dims[1]};
@@ -324,13 +422,8 @@ bool CoderBlockInformation::impl::storePortInfo(const core::Port::Info& portInfo
         return false;
     }
 
-    if (dimensions.size() > 2) {
-        bfError << "Signals with more than 2 dimensions are not currently supported.";
-        return false;
-    }
-
-    if (dataType != core::Port::DataType::DOUBLE) {
-        bfError << "Only DataType::DOUBLE is currently supported.";
+    if (dimensions.empty()) {
+        bfError << "The port with index " << idx << " has no dimensions.";
         return false;
     }
 
@@ -344,8 +437,21 @@ bool CoderBlockInformation::impl::storePortInfo(const core::Port::Info& portInfo
         }
     }
 
-    // Compute the width of the signal
-    unsigned numElements = 1;
+    if (portInfo.frameSize < 1) {
+        bfError << "The frame size of the port with index " << idx << " is not valid.";
+        return false;
+    }
+
+    // Frames are supported only by vectors, which are stored as {1, width}
+    const bool isVector =
+        dimensions.size() == 1 || (dimensions.size() == 2 && dimensions.front() == 1);
+    if (portInfo.frameSize > 1 && !isVector) {
+        bfError << "The port with index " << idx << " has a frame size but it is not a vector.";
+        return false;
+    }
+
+    // Compute the width of the signal, which contains all the samples of a frame
+    unsigned numElements = static_cast<unsigned>(portInfo.frameSize);
     for (const auto dim : dimensions) {
         // Compute the overall number of elements. This is needed to configure properly
         // the returned Signal object.
@@ -390,3 +496,133 @@ bool CoderBlockInformation::setOutputPort(const core::Port::Info& portInfo, void
 
     return true;
 }
+
+core::OutputSignalPtr CoderBlockInformation::getContinuousStateSignal() const
+{
+    if (!pImpl->continuousStates) {
+        bfError << "The continuous states of the block have not been stored.";
+        return {};
+    }
+
+    return pImpl->continuousStates;
+}
+
+core::OutputSignalPtr CoderBlockInformation::getContinuousStateDerivativeSignal() const
+{
+    if (!pImpl->continuousStateDerivatives) {
+        bfError << "The continuous states of the block have not been stored.";
+        return {};
+    }
+
+    return pImpl->continuousStateDerivatives;
+}
+
+bool CoderBlockInformation::setContinuousStates(double* states,
+                                                double* derivatives,
+                                                const size_t numberOfStates)
+{
+    if (!states || !derivatives || numberOfStates == 0) {
+        bfError << "The continuous states to store are not valid.";
+        return false;
+    }
+
+    auto stateSignal = std::make_shared<core::Signal>(
+        core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY, core::Port::DataType::DOUBLE);
+    auto derivativeSignal = std::make_shared<core::Signal>(
+        core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY, core::Port::DataType::DOUBLE);
+
+    if (!stateSignal->initializeBufferFromContiguousZeroCopy(states, numberOfStates)
+        || !derivativeSignal->initializeBufferFromContiguousZeroCopy(derivatives,
+                                                                     numberOfStates)) {
+        bfError << "Failed to configure the buffers of the continuous states.";
+        return false;
+    }
+
+    pImpl->continuousStates = stateSignal;
+    pImpl->continuousStateDerivatives = derivativeSignal;
+    return true;
+}
+
+core::OutputSignalPtr CoderBlockInformation::getDiscreteStateSignal() const
+{
+    if (!pImpl->discreteStates) {
+        bfError << "The discrete states of the block have not been stored.";
+        return {};
+    }
+
+    return pImpl->discreteStates;
+}
+
+bool CoderBlockInformation::setDiscreteStates(double* states, const size_t numberOfStates)
+{
+    if (!states || numberOfStates == 0) {
+        bfError << "The discrete states to store are not valid.";
+        return false;
+    }
+
+    auto signal = std::make_shared<core::Signal>(core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY,
+                                                 core::Port::DataType::DOUBLE);
+
+    if (!signal->initializeBufferFromContiguousZeroCopy(states, numberOfStates)) {
+        bfError << "Failed to configure the buffer of the discrete states.";
+        return false;
+    }
+
+    pImpl->discreteStates = signal;
+    return true;
+}
+
+size_t CoderBlockInformation::impl::relocatePorts(const uint8_t* begin,
+                                                  const uint8_t* end,
+                                                  uint8_t* newAddress,
+                                                  IndexToPortAndSignalDataMap& dataMap)
+{
+    size_t relocated = 0;
+
+    for (auto& entry : dataMap) {
+        auto& data = entry.second;
+        size_t size = 0;
+        const auto* buffer = static_cast<const uint8_t*>(getData(*data.signal, size));
+
+        if (!buffer || buffer < begin || buffer + size > end) {
+            continue;
+        }
+
+        auto signal = std::make_shared<core::Signal>(core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY,
+                                                     data.portInfo.dataType);
+        if (!signal->initializeBufferFromContiguousZeroCopy(newAddress + (buffer - begin),
+                                                            data.signal->getWidth())) {
+            bfError << "Failed to relocate the signal of the port " << entry.first << ".";
+            continue;
+        }
+
+        data.signal = signal;
+        ++relocated;
+    }
+
+    return relocated;
+}
+
+size_t CoderBlockInformation::relocateSignals(const void* address,
+                                              const size_t size,
+                                              void* newAddress)
+{
+    if (!address || !newAddress || size == 0) {
+        return 0;
+    }
+
+    const auto* begin = static_cast<const uint8_t*>(address);
+    auto* destination = static_cast<uint8_t*>(newAddress);
+    size_t relocated = 0;
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    for (auto* object : registry()) {
+        relocated += impl::relocatePorts(
+            begin, begin + size, destination, object->pImpl->inputPortAndSignalMap);
+        relocated += impl::relocatePorts(
+            begin, begin + size, destination, object->pImpl->outputPortAndSignalMap);
+    }
+
+    return relocated;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/ContinuousStateIntegrator.h"
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <ostream>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+class ContinuousStateIntegrator::impl
+{
+public:
+    struct RegisteredBlock
+    {
+        core::Block* block;
+        CoderBlockInformation* blockInfo;
+        size_t offset;
+        size_t numberOfStates;
+    };
+
+    std::vector<RegisteredBlock> blocks;
+    Method method = Method::RungeKutta4;
+    bool configured = false;
+
+    // Contiguous storage of the states of all the blocks
+    std::vector<double> states;
+    std::vector<double> derivatives;
+    // Scratch vectors of the multi-stage methods
+    std::vector<double> initialStates;
+    std::vector<double> accumulator;
+
+    bool evaluateDerivatives();
+
+    // x = x0 + h * dx
+    static void axpy(const size_t n, double* x, const double* x0, const double h, const double* dx)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = x0[i] + h * dx[i];
+        }
+    }
+};
+
+bool ContinuousStateIntegrator::impl::evaluateDerivatives()
+{
+    for (const auto& registered : blocks) {
+        if (!registered.block->stateDerivative(registered.blockInfo)) {
+            bfError << "Failed to compute the state derivative of a block.";
+            return false;
+        }
+    }
+    return true;
+}
+
+ContinuousStateIntegrator::ContinuousStateIntegrator()
+    : pImpl(std::make_unique<ContinuousStateIntegrator::impl>())
+{}
+
+ContinuousStateIntegrator::~ContinuousStateIntegrator() = default;
+
+bool ContinuousStateIntegrator::addBlock(core::Block* block, CoderBlockInformation* blockInfo)
+{
+    if (!block || !blockInfo) {
+        bfError << "The block or its BlockInformation object are not valid.";
+        return false;
+    }
+
+    if (pImpl->configured) {
+        bfError << "Blocks cannot be added after the integrator has been configured.";
+        return false;
+    }
+
+    const size_t numberOfStates = block->numberOfContinuousStates();
+    if (numberOfStates == 0) {
+        return true;
+    }
+
+    pImpl->blocks.push_back({block, blockInfo, getNumberOfStates(), numberOfStates});
+    return true;
+}
+
+bool ContinuousStateIntegrator::configure(const Method method)
+{
+    const size_t numberOfStates = getNumberOfStates();
+
+    pImpl->method = method;
+    pImpl->states.assign(numberOfStates, 0.0);
+    pImpl->derivatives.assign(numberOfStates, 0.0);
+    pImpl->initialStates.assign(method == Method::RungeKutta4 ? numberOfStates : 0, 0.0);
+    pImpl->accumulator.assign(method == Method::RungeKutta4 ? numberOfStates : 0, 0.0);
+
+    for (const auto& registered : pImpl->blocks) {
+        if (!registered.blockInfo->setContinuousStates(pImpl->states.data() + registered.offset,
+                                                       pImpl->derivatives.data()
+                                                           + registered.offset,
+                                                       registered.numberOfStates)) {
+            return false;
+        }
+    }
+
+    pImpl->configured = true;
+    return true;
+}
+
+bool ContinuousStateIntegrator::integrate(const double stepSize, const MinorStep& minorStep)
+{
+    if (!pImpl->configured) {
+        bfError << "The integrator must be configured before integrating the states.";
+        return false;
+    }
+
+    if (!(stepSize > 0)) {
+        bfError << "The integration step must be positive.";
+        return false;
+    }
+
+    const size_t n = pImpl->states.size();
+    double* x = pImpl->states.data();
+    const double* dx = pImpl->derivatives.data();
+
+    if (n == 0) {
+        return true;
+    }
+
+    if (pImpl->method == Method::ForwardEuler) {
+        if (!pImpl->evaluateDerivatives()) {
+            return false;
+        }
+        impl::axpy(n, x, x, stepSize, dx);
+        return true;
+    }
+
+    // Classic Runge-Kutta: x = x0 + h / 6 * (k1 + 2 * k2 + 2 * k3 + k4)
+    double* x0 = pImpl->initialStates.data();
+    double* sum = pImpl->accumulator.data();
+
+    for (size_t i = 0; i < n; ++i) {
+        x0[i] = x[i];
+    }
+
+    const double stageSteps[] = {stepSize / 2, stepSize / 2, stepSize};
+    const double stageWeights[] = {1, 2, 2};
+
+    for (size_t stage = 0; stage < 3; ++stage) {
+        if (!pImpl->evaluateDerivatives()) {
+            return false;
+        }
+
+        const double weight = stageWeights[stage];
+        for (size_t i = 0; i < n; ++i) {
+            sum[i] = (stage == 0 ? 0 : sum[i]) + weight * dx[i];
+        }
+
+        impl::axpy(n, x, x0, stageSteps[stage], dx);
+
+        if (minorStep && !minorStep()) {
+            bfError << "Failed to update the outputs at an intermediate state.";
+            return false;
+        }
+    }
+
+    if (!pImpl->evaluateDerivatives()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = x0[i] + stepSize / 6 * (sum[i] + dx[i]);
+    }
+
+    return true;
+}
+
+size_t ContinuousStateIntegrator::getNumberOfStates() const
+{
+    if (pImpl->blocks.empty()) {
+        return 0;
+    }
+
+    const auto& last = pImpl->blocks.back();
+    return last.offset + last.numberOfStates;
+}
+
+double* ContinuousStateIntegrator::getStates()
+{
+    return pImpl->configured ? pImpl->states.data() : nullptr;
+}
+
+const double* ContinuousStateIntegrator::getStateDerivatives() const
+{
+    return pImpl->configured ? pImpl->derivatives.data() : nullptr;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/DiscreteStateArena.h"
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+const size_t DiscreteStateArena::Alignment;
+
+class DiscreteStateArena::impl
+{
+public:
+    struct RegisteredBlock
+    {
+        core::Block* block;
+        CoderBlockInformation* blockInfo;
+        size_t numberOfStates;
+        // Offset in the arena, in number of doubles
+        size_t offset;
+    };
+
+    std::vector<RegisteredBlock> blocks;
+
+    std::unique_ptr<double[]> memory;
+    double* arena = nullptr;
+    // Size of the arena in number of doubles
+    size_t arenaLength = 0;
+
+    static constexpr size_t DoublesPerAlignment = DiscreteStateArena::Alignment / sizeof(double);
+
+    static size_t align(const size_t length)
+    {
+        return (length + DoublesPerAlignment - 1) / DoublesPerAlignment * DoublesPerAlignment;
+    }
+};
+
+constexpr size_t DiscreteStateArena::impl::DoublesPerAlignment;
+
+DiscreteStateArena::DiscreteStateArena()
+    : pImpl(std::make_unique<DiscreteStateArena::impl>())
+{}
+
+DiscreteStateArena::~DiscreteStateArena() = default;
+
+bool DiscreteStateArena::addBlock(core::Block* block, CoderBlockInformation* blockInfo)
+{
+    if (!block || !blockInfo) {
+        bfError << "The block or its BlockInformation object are not valid.";
+        return false;
+    }
+
+    if (pImpl->arena) {
+        bfError << "Blocks cannot be added after the arena has been configured.";
+        return false;
+    }
+
+    const size_t numberOfStates = block->numberOfDiscreteStates();
+    if (numberOfStates == 0) {
+        return true;
+    }
+
+    pImpl->blocks.push_back({block, blockInfo, numberOfStates, 0});
+    return true;
+}
+
+bool DiscreteStateArena::configure()
+{
+    size_t length = 0;
+    for (auto& registered : pImpl->blocks) {
+        registered.offset = length;
+        length += impl::align(registered.numberOfStates);
+    }
+
+    // Allocate the arena, initialized to zero, with room for the alignment of its beginning
+    pImpl->memory.reset(new double[length + impl::DoublesPerAlignment]());
+    const auto base = reinterpret_cast<uintptr_t>(pImpl->memory.get());
+    const size_t padding = (Alignment - base % Alignment) % Alignment;
+    pImpl->arena = pImpl->memory.get() + padding / sizeof(double);
+    pImpl->arenaLength = length;
+
+    for (const auto& registered : pImpl->blocks) {
+        if (!registered.blockInfo->setDiscreteStates(pImpl->arena + registered.offset,
+                                                     registered.numberOfStates)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DiscreteStateArena::update()
+{
+    if (!pImpl->arena) {
+        bfError << "The arena must be configured before updating the states.";
+        return false;
+    }
+
+    for (const auto& registered : pImpl->blocks) {
+        if (!registered.block->updateDiscreteState(registered.blockInfo)) {
+            bfError << "Failed to update the discrete state of a block.";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t DiscreteStateArena::getNumberOfStates() const
+{
+    size_t numberOfStates = 0;
+    for (const auto& registered : pImpl->blocks) {
+        numberOfStates += registered.numberOfStates;
+    }
+    return numberOfStates;
+}
+
+size_t DiscreteStateArena::getArenaSize() const
+{
+    return pImpl->arenaLength * sizeof(double);
+}
+
+bool DiscreteStateArena::snapshot(std::vector<double>& snapshot) const
+{
+    if (!pImpl->arena) {
+        bfError << "The arena is not configured.";
+        return false;
+    }
+
+    snapshot.resize(pImpl->arenaLength);
+    if (pImpl->arenaLength > 0) {
+        std::memcpy(snapshot.data(), pImpl->arena, getArenaSize());
+    }
+    return true;
+}
+
+bool DiscreteStateArena::restore(const std::vector<double>& snapshot)
+{
+    if (!pImpl->arena) {
+        bfError << "The arena is not configured.";
+        return false;
+    }
+
+    if (snapshot.size() != pImpl->arenaLength) {
+        bfError << "The snapshot does not match the size of the arena.";
+        return false;
+    }
+
+    if (pImpl->arenaLength > 0) {
+        std::memcpy(pImpl->arena, snapshot.data(), getArenaSize());
+    }
+    return true;
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/ElementwiseFusion.h"
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/ElementwiseKernel.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/Core/Span.h"
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+constexpr size_t ElementwiseFusion::TileSize;
+
+// The input port of a step that is fed by the previous step of the group
+static const size_t NotChained = std::numeric_limits<size_t>::max();
+
+struct Step
+{
+    ModelGraph::BlockIndex block;
+    core::ElementwiseKernel kernel;
+    size_t chainedInput;
+    const double* inputs[2];
+};
+
+struct Group
+{
+    std::vector<Step> steps;
+    size_t numberOfElements = 0;
+    double* output = nullptr;
+    std::vector<double> tile;
+    bool bound = false;
+};
+
+class ElementwiseFusion::impl
+{
+public:
+    std::vector<Group> groups;
+
+    // The group of every block, or -1 if the block is not part of any group
+    std::vector<int> groupOfBlock;
+
+    static bool isFusible(const ModelGraph& graph,
+                          const ModelGraph::BlockIndex block,
+                          const core::ElementwiseKernel& kernel,
+                          size_t& numberOfElements);
+    static bool overlap(const double* a, const double* b, const size_t length);
+    void addGroup(Group& group);
+};
+
+bool ElementwiseFusion::impl::isFusible(const ModelGraph& graph,
+                                        const ModelGraph::BlockIndex block,
+                                        const core::ElementwiseKernel& kernel,
+                                        size_t& numberOfElements)
+{
+    const auto& inputPortsInfo = graph.getInputPortsInfo(block);
+    const auto& outputPortsInfo = graph.getOutputPortsInfo(block);
+
+    if (outputPortsInfo.size() != 1 || outputPortsInfo.front().index != 0
+        || outputPortsInfo.front().dataType != core::Port::DataType::DOUBLE
+        || inputPortsInfo.size() != core::ElementwiseKernel::getNumberOfInputs(kernel.operation)) {
+        return false;
+    }
+
+    numberOfElements = ModelGraph::getNumberOfElements(outputPortsInfo.front());
+
+    for (const auto& portInfo : inputPortsInfo) {
+        if (portInfo.index >= inputPortsInfo.size()
+            || portInfo.dataType != core::Port::DataType::DOUBLE
+            || ModelGraph::getNumberOfElements(portInfo) != numberOfElements) {
+            return false;
+        }
+    }
+
+    return numberOfElements > 0;
+}
+
+bool ElementwiseFusion::impl::overlap(const double* a, const double* b, const size_t length)
+{
+    return a != b && a < b + length && b < a + length;
+}
+
+void ElementwiseFusion::impl::addGroup(Group& group)
+{
+    // A single block does not need to be fused
+    if (group.steps.size() > 1) {
+        for (const auto& step : group.steps) {
+            groupOfBlock[step.block] = static_cast<int>(groups.size());
+        }
+        groups.push_back(std::move(group));
+    }
+
+    group = Group();
+}
+
+ElementwiseFusion::ElementwiseFusion()
+    : pImpl(std::make_unique<ElementwiseFusion::impl>())
+{}
+
+ElementwiseFusion::~ElementwiseFusion() = default;
+
+bool ElementwiseFusion::configure(const ModelGraph& graph, const std::vector<core::Block*>& blocks)
+{
+    pImpl->groups.clear();
+    pImpl->groupOfBlock.assign(blocks.size(), -1);
+
+    if (blocks.size() != graph.getNumberOfBlocks()) {
+        bfError << "The number of blocks (" << blocks.size()
+                << ") does not match the number of blocks of the graph ("
+                << graph.getNumberOfBlocks() << ").";
+        return false;
+    }
+
+    // Count the destinations of the outputs of every block
+    std::vector<size_t> numberOfDestinations(blocks.size(), 0);
+    for (const auto& connection : graph.getConnections()) {
+        ++numberOfDestinations[connection.source.block];
+    }
+
+    Group group;
+
+    for (ModelGraph::BlockIndex block = 0; block < blocks.size(); ++block) {
+        core::ElementwiseKernel kernel;
+        size_t numberOfElements = 0;
+
+        if (!blocks[block] || !blocks[block]->getElementwiseKernel(kernel)
+            || !impl::isFusible(graph, block, kernel, numberOfElements)) {
+            pImpl->addGroup(group);
+            continue;
+        }
+
+        // The block joins the group if it is the only consumer of the previous block
+        size_t chainedInput = NotChained;
+        if (!group.steps.empty() && group.steps.back().block + 1 == block
+            && group.numberOfElements == numberOfElements
+            && numberOfDestinations[block - 1] == 1) {
+            for (const auto& portInfo : graph.getInputPortsInfo(block)) {
+                ModelGraph::PortRef source;
+                if (graph.getSource({block, portInfo.index}, source) && source.block == block - 1) {
+                    chainedInput = portInfo.index;
+                }
+            }
+        }
+
+        if (chainedInput == NotChained) {
+            pImpl->addGroup(group);
+            group.numberOfElements = numberOfElements;
+        }
+
+        group.steps.push_back({block, kernel, chainedInput, {nullptr, nullptr}});
+    }
+
+    pImpl->addGroup(group);
+    return true;
+}
+
+bool ElementwiseFusion::bind(const std::vector<const core::BlockInformation*>& blockInfos)
+{
+    if (blockInfos.size() != pImpl->groupOfBlock.size()) {
+        bfError << "The number of BlockInformation objects (" << blockInfos.size()
+                << ") does not match the number of blocks (" << pImpl->groupOfBlock.size()
+                << ").";
+        return false;
+    }
+
+    for (auto& group : pImpl->groups) {
+        group.bound = false;
+        const size_t length = group.numberOfElements;
+
+        const auto output = blockInfos[group.steps.back().block]->getOutputPortSignal(0);
+        group.output = output ? output->getBuffer<double>() : nullptr;
+
+        if (!group.output || output->getWidth() != length) {
+            bfError << "The output signal of the block " << group.steps.back().block
+                    << " is not valid.";
+            return false;
+        }
+
+        bool overlapping = false;
+
+        for (auto& step : group.steps) {
+            const size_t numberOfInputs =
+                core::ElementwiseKernel::getNumberOfInputs(step.kernel.operation);
+
+            for (size_t port = 0; port < numberOfInputs; ++port) {
+                if (port == step.chainedInput) {
+                    step.inputs[port] = nullptr;
+                    continue;
+                }
+
+                const auto input = blockInfos[step.block]->getInputPortSignal(port);
+                step.inputs[port] = input ? input->getBuffer<double>() : nullptr;
+
+                if (!step.inputs[port] || input->getWidth() != length) {
+                    bfError << "The input signal " << port << " of the block " << step.block
+                            << " is not valid.";
+                    return false;
+                }
+
+                overlapping = overlapping || impl::overlap(step.inputs[port], group.output, length);
+            }
+        }
+
+        // The tiles of the output would overwrite the inputs of the next tiles
+        if (overlapping) {
+            continue;
+        }
+
+        group.tile.resize(std::min(length, TileSize));
+        group.bound = true;
+    }
+
+    return true;
+}
+
+ElementwiseFusion::Role ElementwiseFusion::getRole(const ModelGraph::BlockIndex block) const
+{
+    if (block >= pImpl->groupOfBlock.size() || pImpl->groupOfBlock[block] < 0) {
+        return Role::NONE;
+    }
+
+    const auto& group = pImpl->groups[static_cast<size_t>(pImpl->groupOfBlock[block])];
+
+    if (!group.bound) {
+        return Role::NONE;
+    }
+
+    return group.steps.back().block == block ? Role::LAST : Role::INTERMEDIATE;
+}
+
+size_t ElementwiseFusion::getNumberOfGroups() const
+{
+    return pImpl->groups.size();
+}
+
+bool ElementwiseFusion::output(const ModelGraph::BlockIndex block)
+{
+    if (getRole(block) != Role::LAST) {
+        bfError << "The block " << block << " is not the last block of a fused group.";
+        return false;
+    }
+
+    auto& group = pImpl->groups[static_cast<size_t>(pImpl->groupOfBlock[block])];
+    const size_t length = group.numberOfElements;
+
+    for (size_t offset = 0; offset < length; offset += TileSize) {
+        const size_t tileLength = std::min(TileSize, length - offset);
+        const core::Span<double> tile(group.tile.data(), tileLength);
+
+        for (size_t i = 0; i < group.steps.size(); ++i) {
+            const Step& step = group.steps[i];
+
+            // Read the inputs from the signals and the chained input from the tile
+            core::Span<const double> inputs[2];
+            for (size_t port = 0; port < 2; ++port) {
+                if (port == step.chainedInput) {
+                    inputs[port] = tile;
+                }
+                else if (step.inputs[port]) {
+                    inputs[port] = {step.inputs[port] + offset, tileLength};
+                }
+            }
+
+            // Only the last step writes its output to the signal
+            const core::Span<double> output = i + 1 == group.steps.size()
+                                                  ? core::Span<double>(group.output + offset,
+                                                                       tileLength)
+                                                  : tile;
+
+            if (!step.kernel.apply(inputs[0], inputs[1], output)) {
+                bfError << "Failed to compute the kernel of the block " << step.block << ".";
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+#include "BlockFactory/Core/Log.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+struct BlockData
+{
+    std::string name;
+    core::InputPortsInfo inputPortsInfo;
+    core::OutputPortsInfo outputPortsInfo;
+    bool hasStates;
+};
+
+class ModelGraph::impl
+{
+public:
+    std::vector<BlockData> blocks;
+    std::vector<ModelGraph::Connection> connections;
+
+    // The sources of the input ports, indexed as [block][input port]
+    std::vector<std::vector<ModelGraph::PortRef>> sources;
+    std::vector<std::vector<bool>> isConnected;
+
+    const core::Port::Info* findPortInfo(const ModelGraph::PortRef& ref, bool input) const;
+};
+
+const core::Port::Info* ModelGraph::impl::findPortInfo(const ModelGraph::PortRef& ref,
+                                                       bool input) const
+{
+    if (ref.block >= blocks.size()) {
+        return nullptr;
+    }
+
+    const auto& portsInfo =
+        input ? blocks[ref.block].inputPortsInfo : blocks[ref.block].outputPortsInfo;
+
+    for (const auto& portInfo : portsInfo) {
+        if (portInfo.index == ref.port) {
+            return &portInfo;
+        }
+    }
+
+    return nullptr;
+}
+
+ModelGraph::ModelGraph()
+    : pImpl(std::make_unique<ModelGraph::impl>())
+{}
+
+ModelGraph::~ModelGraph() = default;
+
+ModelGraph::BlockIndex ModelGraph::addBlock(const std::string& name,
+                                            const core::InputPortsInfo& inputPortsInfo,
+                                            const core::OutputPortsInfo& outputPortsInfo,
+                                            const bool hasStates)
+{
+    pImpl->blocks.push_back({name, inputPortsInfo, outputPortsInfo, hasStates});
+
+    size_t maxInputIndex = 0;
+    for (const auto& portInfo : inputPortsInfo) {
+        maxInputIndex = std::max(maxInputIndex, portInfo.index + 1);
+    }
+
+    pImpl->sources.emplace_back(maxInputIndex, PortRef{0, 0});
+    pImpl->isConnected.emplace_back(maxInputIndex, false);
+
+    return pImpl->blocks.size() - 1;
+}
+
+bool ModelGraph::connect(const PortRef& source, const PortRef& destination)
+{
+    const core::Port::Info* sourceInfo = pImpl->findPortInfo(source, /*input=*/false);
+    const core::Port::Info* destinationInfo = pImpl->findPortInfo(destination, /*input=*/true);
+
+    if (!sourceInfo) {
+        bfError << "Block " << source.block << " has no output port at index " << source.port
+                << ".";
+        return false;
+    }
+
+    if (!destinationInfo) {
+        bfError << "Block " << destination.block << " has no input port at index "
+                << destination.port << ".";
+        return false;
+    }
+
+    if (pImpl->isConnected[destination.block][destination.port]) {
+        bfError << "The input port " << destination.port << " of block " << destination.block
+                << " is already connected.";
+        return false;
+    }
+
+    if (sourceInfo->dataType != destinationInfo->dataType) {
+        bfError << "Trying to connect ports with different data types.";
+        return false;
+    }
+
+    if (sourceInfo->frameSize != destinationInfo->frameSize) {
+        bfError << "Trying to connect ports with different frame sizes.";
+        return false;
+    }
+
+    const size_t sourceElements = getNumberOfElements(*sourceInfo);
+    const size_t destinationElements = getNumberOfElements(*destinationInfo);
+
+    if (sourceElements == 0 || sourceElements != destinationElements) {
+        bfError << "Trying to connect ports with different or not concrete sizes.";
+        return false;
+    }
+
+    pImpl->sources[destination.block][destination.port] = source;
+    pImpl->isConnected[destination.block][destination.port] = true;
+    pImpl->connections.push_back({source, destination});
+
+    return true;
+}
+
+size_t ModelGraph::getNumberOfBlocks() const
+{
+    return pImpl->blocks.size();
+}
+
+std::string ModelGraph::getBlockName(const BlockIndex block) const
+{
+    if (block >= pImpl->blocks.size()) {
+        bfError << "The graph has no block at index " << block << ".";
+        return {};
+    }
+
+    return pImpl->blocks[block].name;
+}
+
+bool ModelGraph::hasStates(const BlockIndex block) const
+{
+    if (block >= pImpl->blocks.size()) {
+        bfError << "The graph has no block at index " << block << ".";
+        return false;
+    }
+
+    return pImpl->blocks[block].hasStates;
+}
+
+const core::InputPortsInfo& ModelGraph::getInputPortsInfo(const BlockIndex block) const
+{
+    static const core::InputPortsInfo empty;
+
+    if (block >= pImpl->blocks.size()) {
+        bfError << "The graph has no block at index " << block << ".";
+        return empty;
+    }
+
+    return pImpl->blocks[block].inputPortsInfo;
+}
+
+const core::OutputPortsInfo& ModelGraph::getOutputPortsInfo(const BlockIndex block) const
+{
+    static const core::OutputPortsInfo empty;
+
+    if (block >= pImpl->blocks.size()) {
+        bfError << "The graph has no block at index " << block << ".";
+        return empty;
+    }
+
+    return pImpl->blocks[block].outputPortsInfo;
+}
+
+const std::vector<ModelGraph::Connection>& ModelGraph::getConnections() const
+{
+    return pImpl->connections;
+}
+
+bool ModelGraph::getSource(const PortRef& destination, PortRef& source) const
+{
+    if (destination.block >= pImpl->blocks.size()
+        || destination.port >= pImpl->isConnected[destination.block].size()
+        || !pImpl->isConnected[destination.block][destination.port]) {
+        return false;
+    }
+
+    source = pImpl->sources[destination.block][destination.port];
+    return true;
+}
+
+size_t ModelGraph::getNumberOfElements(const core::Port::Info& portInfo)
+{
+    if (portInfo.dimension.empty() || portInfo.frameSize <= 0) {
+        return 0;
+    }
+
+    // Frames store all their samples in the same signal
+    size_t numElements = static_cast<size_t>(portInfo.frameSize);
+    for (const auto dim : portInfo.dimension) {
+        if (dim <= 0) {
+            return 0;
+        }
+        numElements *= static_cast<size_t>(dim);
+    }
+
+    return numElements;
+}
+
+size_t ModelGraph::getDataTypeSize(const core::Port::DataType dataType)
+{
+    switch (dataType) {
+        case core::Port::DataType::DOUBLE:
+            return sizeof(double);
+        case core::Port::DataType::SINGLE:
+            return sizeof(float);
+        case core::Port::DataType::INT8:
+            return sizeof(int8_t);
+        case core::Port::DataType::UINT8:
+            return sizeof(uint8_t);
+        case core::Port::DataType::INT16:
+            return sizeof(int16_t);
+        case core::Port::DataType::UINT16:
+            return sizeof(uint16_t);
+        case core::Port::DataType::INT32:
+            return sizeof(int32_t);
+        case core::Port::DataType::UINT32:
+            return sizeof(uint32_t);
+        case core::Port::DataType::BOOLEAN:
+            // Simulink stores booleans as unsigned char
+            return sizeof(uint8_t);
+    }
+
+    return 0;
+}
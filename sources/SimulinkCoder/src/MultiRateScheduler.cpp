@@ -0,0 +1,683 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/MultiRateScheduler.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/SimulinkCoder/ElementwiseFusion.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+struct RateTransition
+{
+    const void* source;
+    size_t bufferOffset;
+    size_t size;
+    // The transition is performed at the ticks of the slower of the two rates
+    size_t sourceRate;
+    size_t consumerRate;
+};
+
+// Thread executing the blocks of a rate slower than the base rate
+struct RateThread
+{
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool released = false;
+    bool running = false;
+    bool stopping = false;
+    bool failed = false;
+    size_t overruns = 0;
+    // Tick of the last release, and number of faster rates that must still complete in that tick
+    // before the blocks of this rate can read their outputs
+    uint64_t releaseTick = 0;
+    size_t pendingProducers = 0;
+};
+
+class MultiRateScheduler::impl
+{
+public:
+    std::vector<double> periods;
+    std::vector<uint64_t> dividers;
+    std::vector<size_t> blockRates;
+    std::vector<std::vector<ModelGraph::BlockIndex>> rateBlocks;
+
+    std::vector<RateTransition> transitions;
+    // Rates slower than the base rate that feed each rate through a transition
+    std::vector<std::vector<size_t>> producerRates;
+    // Input ports redirected to the transition buffers, and the planner owning them
+    std::vector<ModelGraph::PortRef> redirectedInputs;
+    SignalMemoryPlanner* redirectedPlanner = nullptr;
+    std::unique_ptr<uint8_t[]> memory;
+    uint8_t* buffers = nullptr;
+
+    ElementwiseFusion* fusion = nullptr;
+    Task task;
+    bool started = false;
+    bool multiThreading = true;
+    int basePriority = 0;
+    uint64_t tickCount = 0;
+
+    std::vector<std::unique_ptr<RateThread>> rateThreads;
+    std::vector<size_t> overrunsAfterStop;
+
+    bool isHit(const size_t rate, const uint64_t tick) const { return tick % dividers[rate] == 0; }
+    bool isHit(const size_t rate) const { return isHit(rate, tickCount); }
+    bool runBlock(const ModelGraph::BlockIndex block);
+    bool runBlocks(const size_t rate);
+    bool checkFusedRates() const;
+    void restoreInputPorts();
+    void publishSlowerRates();
+    void publishRate(const size_t rate, const uint64_t tick);
+    void rateLoop(const size_t rate);
+    void notifyConsumers(const size_t rate, const uint64_t tick);
+    bool setThreadPriority(const size_t rate);
+};
+
+bool MultiRateScheduler::impl::runBlock(const ModelGraph::BlockIndex block)
+{
+    if (!fusion) {
+        return task(block);
+    }
+
+    // The intermediate blocks of a group are computed by its last block
+    switch (fusion->getRole(block)) {
+        case ElementwiseFusion::Role::NONE:
+            return task(block);
+        case ElementwiseFusion::Role::INTERMEDIATE:
+            return true;
+        case ElementwiseFusion::Role::LAST:
+            return fusion->output(block);
+    }
+    return false;
+}
+
+bool MultiRateScheduler::impl::checkFusedRates() const
+{
+    if (!fusion) {
+        return true;
+    }
+
+    // The blocks of a group are consecutive in the execution order, and they are all computed by
+    // the last one in the thread of its rate
+    for (size_t block = 0; block + 1 < blockRates.size(); ++block) {
+        if (fusion->getRole(block) == ElementwiseFusion::Role::INTERMEDIATE
+            && blockRates[block] != blockRates[block + 1]) {
+            bfError << "The fused blocks " << block << " and " << block + 1
+                    << " belong to different rates.";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MultiRateScheduler::impl::runBlocks(const size_t rate)
+{
+    for (const auto block : rateBlocks[rate]) {
+        if (!runBlock(block)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MultiRateScheduler::impl::restoreInputPorts()
+{
+    // Ports that are no longer planned have already lost their redirection
+    for (const auto& input : redirectedInputs) {
+        redirectedPlanner->restoreInputPort(input);
+    }
+    redirectedInputs.clear();
+    redirectedPlanner = nullptr;
+}
+
+void MultiRateScheduler::impl::publishSlowerRates()
+{
+    for (const auto& transition : transitions) {
+        if (transition.sourceRate > transition.consumerRate && isHit(transition.sourceRate)) {
+            std::memcpy(buffers + transition.bufferOffset, transition.source, transition.size);
+        }
+    }
+}
+
+void MultiRateScheduler::impl::publishRate(const size_t rate, const uint64_t tick)
+{
+    for (const auto& transition : transitions) {
+        if (transition.sourceRate == rate && transition.consumerRate > rate
+            && isHit(transition.consumerRate, tick)) {
+            std::memcpy(buffers + transition.bufferOffset, transition.source, transition.size);
+        }
+    }
+}
+
+void MultiRateScheduler::impl::rateLoop(const size_t rate)
+{
+    RateThread& rateThread = *rateThreads[rate];
+
+    while (true) {
+        std::unique_lock<std::mutex> lock(rateThread.mutex);
+        const auto ready = [&]() {
+            return rateThread.released && rateThread.pendingProducers == 0;
+        };
+        rateThread.condition.wait(lock, [&]() { return ready() || rateThread.stopping; });
+
+        // The producers of a released rate are stopped after having completed
+        if (!ready()) {
+            return;
+        }
+
+        rateThread.released = false;
+        rateThread.running = true;
+        const uint64_t tick = rateThread.releaseTick;
+        lock.unlock();
+
+        const bool ok = runBlocks(rate);
+        notifyConsumers(rate, tick);
+
+        lock.lock();
+        rateThread.running = false;
+        rateThread.failed = rateThread.failed || !ok;
+        rateThread.condition.notify_all();
+    }
+}
+
+void MultiRateScheduler::impl::notifyConsumers(const size_t rate, const uint64_t tick)
+{
+    // The slower rates released in the same tick are waiting for these outputs
+    publishRate(rate, tick);
+
+    for (size_t consumer = rate + 1; consumer < rateThreads.size(); ++consumer) {
+        const auto& producers = producerRates[consumer];
+        if (!isHit(consumer, tick)
+            || std::find(producers.begin(), producers.end(), rate) == producers.end()) {
+            continue;
+        }
+
+        RateThread& consumerThread = *rateThreads[consumer];
+        {
+            std::lock_guard<std::mutex> lock(consumerThread.mutex);
+            consumerThread.pendingProducers--;
+        }
+        consumerThread.condition.notify_all();
+    }
+}
+
+bool MultiRateScheduler::impl::setThreadPriority(const size_t rate)
+{
+#if defined(__linux__)
+    sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = std::max(basePriority - static_cast<int>(rate),
+                                    sched_get_priority_min(SCHED_FIFO));
+
+    const int error =
+        pthread_setschedparam(rateThreads[rate]->thread.native_handle(), SCHED_FIFO, &param);
+    if (error != 0) {
+        bfError << "Failed to set the SCHED_FIFO policy with priority " << param.sched_priority
+                << " to the thread of the rate " << rate << ": " << std::strerror(error) << ".";
+        return false;
+    }
+    return true;
+#else
+    bfError << "The real-time priority is not supported on this platform.";
+    return false;
+#endif
+}
+
+MultiRateScheduler::MultiRateScheduler()
+    : pImpl(std::make_unique<MultiRateScheduler::impl>())
+{}
+
+MultiRateScheduler::~MultiRateScheduler()
+{
+    stop();
+}
+
+bool MultiRateScheduler::configure(const ModelGraph& graph,
+                                   const std::vector<core::Block::SampleTime>& sampleTimes,
+                                   SignalMemoryPlanner& planner,
+                                   ElementwiseFusion* fusion)
+{
+    if (pImpl->started) {
+        bfError << "The scheduler cannot be configured while it is running.";
+        return false;
+    }
+
+    // The input ports redirected by a previous configuration read the transition buffers that are
+    // going to be freed. They also hide the addresses of the signals in the planner.
+    pImpl->restoreInputPorts();
+    pImpl->transitions.clear();
+    pImpl->periods.clear();
+
+    const size_t numberOfBlocks = graph.getNumberOfBlocks();
+
+    if (numberOfBlocks == 0 || sampleTimes.size() != numberOfBlocks) {
+        bfError << "The number of sample times does not match the number of blocks.";
+        return false;
+    }
+
+    if (planner.isBufferReuseEnabled()) {
+        bfError << "Multi-rate models require signals planned without buffer reuse.";
+        return false;
+    }
+
+    // Collect the periods of the rates
+    std::vector<double> periods;
+    for (const auto& sampleTime : sampleTimes) {
+        if (sampleTime.period == core::Block::InheritedSampleTime) {
+            continue;
+        }
+        if (sampleTime.period <= 0) {
+            bfError << "Found a block with an invalid period " << sampleTime.period << ".";
+            return false;
+        }
+        if (sampleTime.offset != 0) {
+            bfError << "Sample times with an offset are not supported.";
+            return false;
+        }
+        periods.push_back(sampleTime.period);
+    }
+
+    if (periods.empty()) {
+        bfError << "At least one block must declare its sample time.";
+        return false;
+    }
+
+    std::sort(periods.begin(), periods.end());
+
+    const auto samePeriod = [](const double a, const double b) {
+        return std::abs(a - b) <= 1e-9 * std::max(a, b);
+    };
+
+    periods.erase(std::unique(periods.begin(), periods.end(), samePeriod), periods.end());
+
+    // Check that rates are harmonic
+    std::vector<uint64_t> dividers;
+    for (size_t rate = 0; rate < periods.size(); ++rate) {
+        const double ratio = periods[rate] / periods.front();
+        const auto divider = static_cast<uint64_t>(std::llround(ratio));
+
+        if (rate > 0) {
+            const double ratioToFaster = periods[rate] / periods[rate - 1];
+            if (!samePeriod(ratioToFaster, std::round(ratioToFaster))) {
+                bfError << "The period " << periods[rate] << " is not a multiple of the period "
+                        << periods[rate - 1] << ".";
+                return false;
+            }
+        }
+        dividers.push_back(divider);
+    }
+
+    const auto rateOfPeriod = [&](const double period) -> size_t {
+        for (size_t rate = 0; rate < periods.size(); ++rate) {
+            if (samePeriod(periods[rate], period)) {
+                return rate;
+            }
+        }
+        return 0;
+    };
+
+    // Assign the rates to the blocks. Blocks inheriting the sample time get the fastest rate of
+    // the blocks producing their inputs.
+    std::vector<size_t> blockRates(numberOfBlocks, 0);
+
+    for (size_t block = 0; block < numberOfBlocks; ++block) {
+        if (sampleTimes[block].period != core::Block::InheritedSampleTime) {
+            blockRates[block] = rateOfPeriod(sampleTimes[block].period);
+            continue;
+        }
+
+        size_t rate = periods.size();
+        for (const auto& portInfo : graph.getInputPortsInfo(block)) {
+            ModelGraph::PortRef source;
+            if (graph.getSource({block, portInfo.index}, source) && source.block < block) {
+                rate = std::min(rate, blockRates[source.block]);
+            }
+        }
+        blockRates[block] = (rate == periods.size()) ? 0 : rate;
+    }
+
+    // Find the input ports that read signals of a different rate. Consumers of the same rate
+    // share the same transition buffer.
+    struct PendingTransition
+    {
+        RateTransition transition;
+        std::vector<ModelGraph::PortRef> consumers;
+    };
+
+    std::vector<PendingTransition> pending;
+    std::map<std::pair<const void*, size_t>, size_t> sourceAndRateToTransition;
+    size_t buffersSize = 0;
+
+    for (size_t block = 0; block < numberOfBlocks; ++block) {
+        for (const auto& portInfo : graph.getInputPortsInfo(block)) {
+            const ModelGraph::PortRef input = {block, portInfo.index};
+
+            // External inputs belong to the base rate
+            ModelGraph::PortRef source;
+            const bool connected = graph.getSource(input, source);
+            const size_t sourceRate = connected ? blockRates[source.block] : 0;
+            const size_t consumerRate = blockRates[block];
+
+            if (sourceRate == consumerRate) {
+                continue;
+            }
+
+            // Read the signal from its producer, whose address is never redirected
+            const void* sourceAddress = connected ? planner.getOutputPortAddress(source)
+                                                  : planner.getInputPortAddress(input);
+            const auto key = std::make_pair(sourceAddress, consumerRate);
+
+            auto it = sourceAndRateToTransition.find(key);
+            if (it == sourceAndRateToTransition.end()) {
+                const size_t size = ModelGraph::getNumberOfElements(portInfo)
+                                    * ModelGraph::getDataTypeSize(portInfo.dataType);
+                RateTransition transition;
+                transition.source = sourceAddress;
+                transition.bufferOffset = buffersSize;
+                transition.size = size;
+                transition.sourceRate = sourceRate;
+                transition.consumerRate = consumerRate;
+
+                buffersSize += (size + SignalMemoryPlanner::Alignment - 1)
+                               / SignalMemoryPlanner::Alignment * SignalMemoryPlanner::Alignment;
+
+                it = sourceAndRateToTransition.insert({key, pending.size()}).first;
+                pending.push_back({transition, {}});
+            }
+            pending[it->second].consumers.push_back(input);
+        }
+    }
+
+    // Allocate the transition buffers and connect them to the consumers
+    pImpl->memory.reset(new uint8_t[buffersSize + SignalMemoryPlanner::Alignment]());
+    const auto base = reinterpret_cast<uintptr_t>(pImpl->memory.get());
+    pImpl->buffers = pImpl->memory.get()
+                     + (SignalMemoryPlanner::Alignment - base % SignalMemoryPlanner::Alignment)
+                           % SignalMemoryPlanner::Alignment;
+
+    pImpl->redirectedPlanner = &planner;
+    for (const auto& p : pending) {
+        for (const auto& consumer : p.consumers) {
+            if (!planner.redirectInputPort(consumer,
+                                           pImpl->buffers + p.transition.bufferOffset)) {
+                bfError << "Failed to connect the rate transition buffer to block "
+                        << consumer.block << ".";
+                return false;
+            }
+            pImpl->redirectedInputs.push_back(consumer);
+        }
+        pImpl->transitions.push_back(p.transition);
+    }
+
+    pImpl->producerRates.assign(periods.size(), {});
+    for (const auto& transition : pImpl->transitions) {
+        auto& producers = pImpl->producerRates[transition.consumerRate];
+        if (transition.sourceRate > 0 && transition.sourceRate < transition.consumerRate
+            && std::find(producers.begin(), producers.end(), transition.sourceRate)
+                   == producers.end()) {
+            producers.push_back(transition.sourceRate);
+        }
+    }
+
+    pImpl->periods = periods;
+    pImpl->dividers = dividers;
+    pImpl->blockRates = blockRates;
+    pImpl->fusion = fusion;
+    pImpl->rateBlocks.assign(periods.size(), {});
+    for (size_t block = 0; block < numberOfBlocks; ++block) {
+        pImpl->rateBlocks[blockRates[block]].push_back(block);
+    }
+
+    return true;
+}
+
+bool MultiRateScheduler::start(const Task& task, const bool multiThreading)
+{
+    if (pImpl->periods.empty()) {
+        bfError << "The scheduler must be configured before being started.";
+        return false;
+    }
+
+    if (pImpl->started) {
+        bfError << "The scheduler is already running.";
+        return false;
+    }
+
+    // The groups are known only after the fusion is bound
+    if (!pImpl->checkFusedRates()) {
+        return false;
+    }
+
+    pImpl->task = task;
+    pImpl->multiThreading = multiThreading;
+    pImpl->tickCount = 0;
+    pImpl->overrunsAfterStop.assign(pImpl->periods.size(), 0);
+    pImpl->rateThreads.clear();
+
+    if (multiThreading) {
+        for (size_t rate = 0; rate < pImpl->periods.size(); ++rate) {
+            pImpl->rateThreads.emplace_back(new RateThread);
+        }
+        // The base rate is executed by the thread calling tick()
+        for (size_t rate = 1; rate < pImpl->periods.size(); ++rate) {
+            pImpl->rateThreads[rate]->thread =
+                std::thread(&MultiRateScheduler::impl::rateLoop, pImpl.get(), rate);
+        }
+    }
+
+    pImpl->started = true;
+
+    // The threads are waiting for their first release, hence they can be configured here
+    for (size_t rate = 1; rate < pImpl->rateThreads.size() && pImpl->basePriority > 0; ++rate) {
+        if (!pImpl->setThreadPriority(rate)) {
+            stop();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MultiRateScheduler::tick()
+{
+    if (!pImpl->started) {
+        bfError << "The scheduler is not running.";
+        return false;
+    }
+
+    bool ok = true;
+    const size_t numberOfRates = pImpl->periods.size();
+
+    // Wait the completion of the slower rates that should be released in this tick
+    if (pImpl->multiThreading) {
+        for (size_t rate = 1; rate < numberOfRates; ++rate) {
+            RateThread& rateThread = *pImpl->rateThreads[rate];
+            std::unique_lock<std::mutex> lock(rateThread.mutex);
+
+            if (pImpl->isHit(rate) && (rateThread.released || rateThread.running)) {
+                rateThread.overruns++;
+                rateThread.condition.wait(
+                    lock, [&]() { return !rateThread.released && !rateThread.running; });
+            }
+
+            // Report failures of previous executions
+            ok = ok && !rateThread.failed;
+            rateThread.failed = false;
+        }
+    }
+
+    // Publish the outputs of the slower rates computed in their previous period
+    pImpl->publishSlowerRates();
+
+    ok = pImpl->runBlocks(0) && ok;
+
+    // Pass the outputs of the base rate to the slower rates released in this tick
+    pImpl->publishRate(0, pImpl->tickCount);
+
+    if (!pImpl->multiThreading) {
+        for (size_t rate = 1; rate < numberOfRates; ++rate) {
+            if (pImpl->isHit(rate)) {
+                ok = pImpl->runBlocks(rate) && ok;
+                pImpl->publishRate(rate, pImpl->tickCount);
+            }
+        }
+    }
+    else {
+        // The slower rates are released first, so that their producers cannot complete before
+        // the counters of the pending producers are set
+        for (size_t rate = numberOfRates - 1; rate > 0; --rate) {
+            if (!pImpl->isHit(rate)) {
+                continue;
+            }
+
+            RateThread& rateThread = *pImpl->rateThreads[rate];
+            {
+                std::lock_guard<std::mutex> lock(rateThread.mutex);
+                rateThread.released = true;
+                rateThread.releaseTick = pImpl->tickCount;
+                rateThread.pendingProducers = pImpl->producerRates[rate].size();
+            }
+            rateThread.condition.notify_all();
+        }
+    }
+
+    pImpl->tickCount++;
+    return ok;
+}
+
+void MultiRateScheduler::stop()
+{
+    if (!pImpl->started) {
+        return;
+    }
+
+    for (size_t rate = 1; rate < pImpl->rateThreads.size(); ++rate) {
+        RateThread& rateThread = *pImpl->rateThreads[rate];
+        {
+            std::lock_guard<std::mutex> lock(rateThread.mutex);
+            rateThread.stopping = true;
+        }
+        rateThread.condition.notify_all();
+        rateThread.thread.join();
+        pImpl->overrunsAfterStop[rate] = rateThread.overruns;
+    }
+
+    pImpl->rateThreads.clear();
+    pImpl->started = false;
+}
+
+double MultiRateScheduler::getBasePeriod() const
+{
+    return pImpl->periods.empty() ? 0.0 : pImpl->periods.front();
+}
+
+size_t MultiRateScheduler::getNumberOfRates() const
+{
+    return pImpl->periods.size();
+}
+
+bool MultiRateScheduler::setBasePriority(const int priority)
+{
+    if (pImpl->started) {
+        bfError << "The priority cannot be changed while the scheduler is running.";
+        return false;
+    }
+
+#if defined(__linux__)
+    if (priority != 0
+        && (priority < sched_get_priority_min(SCHED_FIFO)
+            || priority > sched_get_priority_max(SCHED_FIFO))) {
+        bfError << "The priority " << priority << " is out of the SCHED_FIFO range.";
+        return false;
+    }
+
+    pImpl->basePriority = priority;
+    return true;
+#else
+    if (priority == 0) {
+        pImpl->basePriority = 0;
+        return true;
+    }
+
+    bfError << "The real-time priority is not supported on this platform.";
+    return false;
+#endif
+}
+
+int MultiRateScheduler::getPriority(const size_t rate) const
+{
+    if (pImpl->basePriority == 0 || rate >= pImpl->periods.size()) {
+        return 0;
+    }
+
+#if defined(__linux__)
+    return std::max(pImpl->basePriority - static_cast<int>(rate),
+                    sched_get_priority_min(SCHED_FIFO));
+#else
+    return 0;
+#endif
+}
+
+double MultiRateScheduler::getPeriod(const size_t rate) const
+{
+    if (rate >= pImpl->periods.size()) {
+        bfError << "The model has no rate with index " << rate << ".";
+        return 0.0;
+    }
+
+    return pImpl->periods[rate];
+}
+
+size_t MultiRateScheduler::getRate(const ModelGraph::BlockIndex block) const
+{
+    if (block >= pImpl->blockRates.size()) {
+        bfError << "The scheduler has no block at index " << block << ".";
+        return 0;
+    }
+
+    return pImpl->blockRates[block];
+}
+
+size_t MultiRateScheduler::getNumberOfRateTransitions() const
+{
+    return pImpl->transitions.size();
+}
+
+size_t MultiRateScheduler::getNumberOfOverruns(const size_t rate) const
+{
+    if (rate < pImpl->rateThreads.size() && pImpl->rateThreads[rate]) {
+        std::lock_guard<std::mutex> lock(pImpl->rateThreads[rate]->mutex);
+        return pImpl->rateThreads[rate]->overruns;
+    }
+
+    if (rate < pImpl->overrunsAfterStop.size()) {
+        return pImpl->overrunsAfterStop[rate];
+    }
+
+    return 0;
+}
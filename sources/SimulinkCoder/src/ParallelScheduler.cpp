@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/ParallelScheduler.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/SimulinkCoder/ElementwiseFusion.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+// Queue of ready blocks owned by a thread. The owner pushes and pops blocks from the back, and the
+// other threads steal blocks from the front. The critical sections are very short, hence a spin
+// lock is used instead of a mutex.
+class WorkQueue
+{
+public:
+    explicit WorkQueue(const size_t capacity)
+        : m_buffer(capacity)
+    {}
+
+    void reset()
+    {
+        lock();
+        m_head = 0;
+        m_tail = 0;
+        unlock();
+    }
+
+    void push(const ModelGraph::BlockIndex block)
+    {
+        lock();
+        m_buffer[m_tail++] = block;
+        unlock();
+    }
+
+    bool pop(ModelGraph::BlockIndex& block)
+    {
+        lock();
+        const bool found = m_tail > m_head;
+        if (found) {
+            block = m_buffer[--m_tail];
+        }
+        unlock();
+        return found;
+    }
+
+    bool steal(ModelGraph::BlockIndex& block)
+    {
+        lock();
+        const bool found = m_tail > m_head;
+        if (found) {
+            block = m_buffer[m_head++];
+        }
+        unlock();
+        return found;
+    }
+
+private:
+    void lock()
+    {
+        while (m_lock.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock() { m_lock.clear(std::memory_order_release); }
+
+    // Every block is pushed at most once per step, and the queues are reset at the beginning of
+    // every step. A buffer as big as the number of blocks never overflows.
+    std::vector<ModelGraph::BlockIndex> m_buffer;
+    size_t m_head = 0;
+    size_t m_tail = 0;
+    std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+};
+
+class ParallelScheduler::impl
+{
+public:
+    size_t numberOfBlocks = 0;
+    std::vector<std::vector<ModelGraph::BlockIndex>> predecessors;
+    std::vector<std::vector<ModelGraph::BlockIndex>> successors;
+    std::vector<std::vector<ModelGraph::BlockIndex>> levels;
+
+    // Number of dependencies of each block that are not yet executed in the current step
+    std::unique_ptr<std::atomic<size_t>[]> pendingDependencies;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+
+    ElementwiseFusion* fusion = nullptr;
+    const Task* task = nullptr;
+    std::atomic<size_t> completed{0};
+    std::atomic<bool> failed{false};
+
+    // Synchronization of the idle threads
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<bool> stopping{false};
+
+    bool started() const { return !queues.empty(); }
+
+    void workerLoop(const size_t id);
+    void runTasks(const size_t id);
+    void execute(const size_t id, const ModelGraph::BlockIndex block);
+    bool runBlock(const ModelGraph::BlockIndex block);
+    bool findTask(const size_t id, ModelGraph::BlockIndex& block);
+};
+
+void ParallelScheduler::impl::workerLoop(const size_t id)
+{
+    uint64_t lastGeneration = 0;
+
+    while (true) {
+        // Busy wait for a short time, since steps usually follow each other quickly
+        for (unsigned i = 0; i < 1000; ++i) {
+            if (generation.load(std::memory_order_acquire) != lastGeneration
+                || stopping.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() {
+                return generation.load(std::memory_order_acquire) != lastGeneration
+                       || stopping.load(std::memory_order_acquire);
+            });
+        }
+
+        if (stopping.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        lastGeneration = generation.load(std::memory_order_acquire);
+        runTasks(id);
+    }
+}
+
+bool ParallelScheduler::impl::findTask(const size_t id, ModelGraph::BlockIndex& block)
+{
+    if (queues[id]->pop(block)) {
+        return true;
+    }
+
+    for (size_t i = 1; i < queues.size(); ++i) {
+        if (queues[(id + i) % queues.size()]->steal(block)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ParallelScheduler::impl::runTasks(const size_t id)
+{
+    ModelGraph::BlockIndex block;
+
+    while (completed.load(std::memory_order_acquire) < numberOfBlocks) {
+        if (findTask(id, block)) {
+            execute(id, block);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool ParallelScheduler::impl::runBlock(const ModelGraph::BlockIndex block)
+{
+    if (!fusion) {
+        return (*task)(block);
+    }
+
+    // The intermediate blocks of a group are computed by its last block. Skipping them still
+    // releases their successors, and the last block depends on them through their signals.
+    switch (fusion->getRole(block)) {
+        case ElementwiseFusion::Role::NONE:
+            return (*task)(block);
+        case ElementwiseFusion::Role::INTERMEDIATE:
+            return true;
+        case ElementwiseFusion::Role::LAST:
+            return fusion->output(block);
+    }
+    return false;
+}
+
+void ParallelScheduler::impl::execute(const size_t id, const ModelGraph::BlockIndex block)
+{
+    // After a failure, the remaining blocks are skipped but their dependencies are still
+    // processed in order to terminate the step
+    if (!failed.load(std::memory_order_relaxed) && !runBlock(block)) {
+        failed.store(true, std::memory_order_relaxed);
+    }
+
+    for (const auto successor : successors[block]) {
+        if (pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            queues[id]->push(successor);
+        }
+    }
+
+    completed.fetch_add(1, std::memory_order_acq_rel);
+}
+
+ParallelScheduler::ParallelScheduler()
+    : pImpl(std::make_unique<ParallelScheduler::impl>())
+{}
+
+ParallelScheduler::~ParallelScheduler()
+{
+    stop();
+}
+
+bool ParallelScheduler::configure(const ModelGraph& graph,
+                                  const SignalMemoryPlanner* planner,
+                                  ElementwiseFusion* fusion)
+{
+    if (pImpl->started()) {
+        bfError << "The scheduler cannot be configured while it is running.";
+        return false;
+    }
+
+    // The last block of a group reads the inputs of the first one. The reuse dependencies do not
+    // take it into account, and the buffers could be overwritten before being read.
+    if (fusion && planner && planner->isBufferReuseEnabled()) {
+        bfError << "The fusion of the elementwise blocks requires signals planned without buffer "
+                << "reuse.";
+        return false;
+    }
+
+    const size_t numberOfBlocks = graph.getNumberOfBlocks();
+
+    if (numberOfBlocks == 0) {
+        bfError << "The model graph does not contain any block.";
+        return false;
+    }
+
+    std::vector<std::pair<ModelGraph::BlockIndex, ModelGraph::BlockIndex>> edges;
+
+    for (const auto& connection : graph.getConnections()) {
+        const auto producer = connection.source.block;
+        const auto consumer = connection.destination.block;
+
+        if (producer < consumer) {
+            // Data dependency
+            edges.emplace_back(producer, consumer);
+        }
+        else if (producer > consumer) {
+            // Feedback: the consumer reads the value of the previous step, and the producer must
+            // not overwrite it before the consumer is executed
+            edges.emplace_back(consumer, producer);
+        }
+    }
+
+    if (planner) {
+        for (const auto& dependency : planner->getReuseDependencies()) {
+            if (dependency.first >= numberOfBlocks || dependency.second >= numberOfBlocks) {
+                bfError << "The memory planner does not match the model graph.";
+                return false;
+            }
+            if (dependency.first != dependency.second) {
+                edges.push_back(dependency);
+            }
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    pImpl->numberOfBlocks = numberOfBlocks;
+    pImpl->predecessors.assign(numberOfBlocks, {});
+    pImpl->successors.assign(numberOfBlocks, {});
+
+    for (const auto& edge : edges) {
+        pImpl->successors[edge.first].push_back(edge.second);
+        pImpl->predecessors[edge.second].push_back(edge.first);
+    }
+
+    // All the edges go from a block to a block with a higher index. The levels can be computed
+    // following the graph order.
+    std::vector<size_t> blockLevels(numberOfBlocks, 0);
+    size_t numberOfLevels = 0;
+
+    for (size_t block = 0; block < numberOfBlocks; ++block) {
+        for (const auto predecessor : pImpl->predecessors[block]) {
+            blockLevels[block] = std::max(blockLevels[block], blockLevels[predecessor] + 1);
+        }
+        numberOfLevels = std::max(numberOfLevels, blockLevels[block] + 1);
+    }
+
+    pImpl->levels.assign(numberOfLevels, {});
+    for (size_t block = 0; block < numberOfBlocks; ++block) {
+        pImpl->levels[blockLevels[block]].push_back(block);
+    }
+
+    pImpl->pendingDependencies.reset(new std::atomic<size_t>[numberOfBlocks]);
+    pImpl->fusion = fusion;
+
+    return true;
+}
+
+bool ParallelScheduler::start(const size_t numberOfThreads)
+{
+    if (pImpl->numberOfBlocks == 0) {
+        bfError << "The scheduler must be configured before being started.";
+        return false;
+    }
+
+    if (pImpl->started()) {
+        bfError << "The scheduler is already running.";
+        return false;
+    }
+
+    size_t threads = numberOfThreads;
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    pImpl->stopping = false;
+    for (size_t id = 0; id < threads; ++id) {
+        pImpl->queues.emplace_back(new WorkQueue(pImpl->numberOfBlocks));
+    }
+
+    // The thread calling step() has the id 0
+    for (size_t id = 1; id < threads; ++id) {
+        pImpl->threads.emplace_back(&ParallelScheduler::impl::workerLoop, pImpl.get(), id);
+    }
+
+    return true;
+}
+
+bool ParallelScheduler::step(const Task& task)
+{
+    if (!pImpl->started()) {
+        bfError << "The scheduler is not running.";
+        return false;
+    }
+
+    pImpl->task = &task;
+    pImpl->failed.store(false, std::memory_order_relaxed);
+    pImpl->completed.store(0, std::memory_order_relaxed);
+
+    for (size_t block = 0; block < pImpl->numberOfBlocks; ++block) {
+        pImpl->pendingDependencies[block].store(pImpl->predecessors[block].size(),
+                                                std::memory_order_relaxed);
+    }
+
+    for (auto& queue : pImpl->queues) {
+        queue->reset();
+    }
+
+    // Distribute the blocks without dependencies among the threads
+    size_t next = 0;
+    for (const auto block : pImpl->levels.front()) {
+        pImpl->queues[next]->push(block);
+        next = (next + 1) % pImpl->queues.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    pImpl->condition.notify_all();
+
+    pImpl->runTasks(0);
+
+    return !pImpl->failed.load(std::memory_order_acquire);
+}
+
+void ParallelScheduler::stop()
+{
+    if (!pImpl->started()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->stopping = true;
+    }
+    pImpl->condition.notify_all();
+
+    for (auto& thread : pImpl->threads) {
+        thread.join();
+    }
+
+    pImpl->threads.clear();
+    pImpl->queues.clear();
+}
+
+size_t ParallelScheduler::getNumberOfThreads() const
+{
+    return pImpl->queues.size();
+}
+
+const std::vector<std::vector<ModelGraph::BlockIndex>>& ParallelScheduler::getLevels() const
+{
+    return pImpl->levels;
+}
+
+std::vector<ModelGraph::BlockIndex>
+ParallelScheduler::getDependencies(const ModelGraph::BlockIndex block) const
+{
+    if (block >= pImpl->predecessors.size()) {
+        bfError << "The scheduler has no block at index " << block << ".";
+        return {};
+    }
+
+    return pImpl->predecessors[block];
+}
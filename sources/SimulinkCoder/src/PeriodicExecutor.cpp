@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/PeriodicExecutor.h"
+#include "BlockFactory/Core/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+// Nanoseconds of the monotonic clock
+using Nanoseconds = int64_t;
+
+#if defined(__linux__)
+static Nanoseconds now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<Nanoseconds>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static void sleepUntil(const Nanoseconds deadline)
+{
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline / 1000000000);
+    ts.tv_nsec = static_cast<long>(deadline % 1000000000);
+
+    // The sleep can be interrupted by signals. The deadline is absolute, hence it can be resumed.
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+#else
+static Nanoseconds now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static void sleepUntil(const Nanoseconds deadline)
+{
+    std::this_thread::sleep_until(
+        std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline)));
+}
+#endif
+
+class PeriodicExecutor::impl
+{
+public:
+    Nanoseconds period = 1000000;
+    std::vector<unsigned> cpus;
+    int priority = 0;
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopRequested{false};
+
+    std::atomic<uint64_t> numberOfSteps{0};
+    std::atomic<uint64_t> numberOfOverruns{0};
+    core::LatencyHistogram executionTime;
+    core::LatencyHistogram jitter;
+
+#if defined(__linux__)
+    // Configuration of the thread before the execution, restored at the end
+    cpu_set_t previousCpus;
+    bool restoreCpus = false;
+    int previousPolicy = SCHED_OTHER;
+    sched_param previousParam;
+    bool restoreScheduling = false;
+#endif
+
+    bool configureThread();
+    void restoreThread();
+};
+
+bool PeriodicExecutor::impl::configureThread()
+{
+#if defined(__linux__)
+    const pthread_t thread = pthread_self();
+
+    if (!cpus.empty()) {
+        if (pthread_getaffinity_np(thread, sizeof(cpu_set_t), &previousCpus) != 0) {
+            bfError << "Failed to read the CPU affinity of the thread.";
+            return false;
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (const auto cpu : cpus) {
+            CPU_SET(cpu, &set);
+        }
+
+        const int error = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &set);
+        if (error != 0) {
+            bfError << "Failed to set the CPU affinity of the thread: " << std::strerror(error)
+                    << ".";
+            return false;
+        }
+        restoreCpus = true;
+    }
+
+    if (priority > 0) {
+        if (pthread_getschedparam(thread, &previousPolicy, &previousParam) != 0) {
+            bfError << "Failed to read the scheduling policy of the thread.";
+            return false;
+        }
+
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+
+        const int error = pthread_setschedparam(thread, SCHED_FIFO, &param);
+        if (error != 0) {
+            bfError << "Failed to set the SCHED_FIFO policy with priority " << priority << ": "
+                    << std::strerror(error) << ". Real-time scheduling usually requires the "
+                    << "CAP_SYS_NICE capability or a suitable RLIMIT_RTPRIO limit.";
+            return false;
+        }
+        restoreScheduling = true;
+    }
+#endif
+    return true;
+}
+
+void PeriodicExecutor::impl::restoreThread()
+{
+#if defined(__linux__)
+    const pthread_t thread = pthread_self();
+
+    if (restoreScheduling) {
+        pthread_setschedparam(thread, previousPolicy, &previousParam);
+        restoreScheduling = false;
+    }
+
+    if (restoreCpus) {
+        pthread_setaffinity_np(thread, sizeof(cpu_set_t), &previousCpus);
+        restoreCpus = false;
+    }
+#endif
+}
+
+PeriodicExecutor::PeriodicExecutor()
+    : pImpl(std::make_unique<PeriodicExecutor::impl>())
+{}
+
+PeriodicExecutor::~PeriodicExecutor() = default;
+
+bool PeriodicExecutor::setPeriod(const double period)
+{
+    if (isRunning()) {
+        bfError << "The period cannot be changed while the executor is running.";
+        return false;
+    }
+
+    const auto nanoseconds = static_cast<Nanoseconds>(period * 1e9);
+
+    if (!(period > 0) || nanoseconds <= 0) {
+        bfError << "The period must be positive.";
+        return false;
+    }
+
+    pImpl->period = nanoseconds;
+    return true;
+}
+
+bool PeriodicExecutor::setCpuAffinity(const std::vector<unsigned>& cpus)
+{
+    if (isRunning()) {
+        bfError << "The CPU affinity cannot be changed while the executor is running.";
+        return false;
+    }
+
+#if defined(__linux__)
+    for (const auto cpu : cpus) {
+        if (cpu >= CPU_SETSIZE) {
+            bfError << "The CPU index " << cpu << " is out of range.";
+            return false;
+        }
+    }
+
+    pImpl->cpus = cpus;
+    return true;
+#else
+    if (cpus.empty()) {
+        pImpl->cpus.clear();
+        return true;
+    }
+
+    bfError << "The CPU affinity is not supported on this platform.";
+    return false;
+#endif
+}
+
+bool PeriodicExecutor::setPriority(const int priority)
+{
+    if (isRunning()) {
+        bfError << "The priority cannot be changed while the executor is running.";
+        return false;
+    }
+
+#if defined(__linux__)
+    if (priority != 0
+        && (priority < sched_get_priority_min(SCHED_FIFO)
+            || priority > sched_get_priority_max(SCHED_FIFO))) {
+        bfError << "The priority " << priority << " is out of the SCHED_FIFO range.";
+        return false;
+    }
+
+    pImpl->priority = priority;
+    return true;
+#else
+    if (priority == 0) {
+        pImpl->priority = 0;
+        return true;
+    }
+
+    bfError << "The real-time priority is not supported on this platform.";
+    return false;
+#endif
+}
+
+bool PeriodicExecutor::run(const Step& step, const uint64_t numberOfSteps)
+{
+    if (!step) {
+        bfError << "The step function is not valid.";
+        return false;
+    }
+
+    if (pImpl->running.exchange(true)) {
+        bfError << "The executor is already running.";
+        return false;
+    }
+
+    if (!pImpl->configureThread()) {
+        pImpl->restoreThread();
+        pImpl->running = false;
+        return false;
+    }
+
+    bool ok = true;
+    uint64_t executed = 0;
+    Nanoseconds deadline = now();
+
+    while (!pImpl->stopRequested.load(std::memory_order_acquire)
+           && (numberOfSteps == 0 || executed < numberOfSteps)) {
+        sleepUntil(deadline);
+
+        const Nanoseconds wakeUp = now();
+        ok = step();
+        const Nanoseconds completion = now();
+
+        pImpl->jitter.record(static_cast<uint64_t>(std::max<Nanoseconds>(wakeUp - deadline, 0)));
+        pImpl->executionTime.record(static_cast<uint64_t>(completion - wakeUp));
+        pImpl->numberOfSteps.fetch_add(1, std::memory_order_relaxed);
+        ++executed;
+
+        if (!ok) {
+            bfError << "The step failed.";
+            break;
+        }
+
+        deadline += pImpl->period;
+
+        // Skip the releases missed by a step longer than the period
+        if (completion > deadline) {
+            pImpl->numberOfOverruns.fetch_add(1, std::memory_order_relaxed);
+            deadline += ((completion - deadline) / pImpl->period + 1) * pImpl->period;
+        }
+    }
+
+    pImpl->restoreThread();
+    pImpl->stopRequested = false;
+    pImpl->running = false;
+
+    return ok;
+}
+
+void PeriodicExecutor::requestStop()
+{
+    if (isRunning()) {
+        pImpl->stopRequested = true;
+    }
+}
+
+bool PeriodicExecutor::isRunning() const
+{
+    return pImpl->running.load(std::memory_order_acquire);
+}
+
+double PeriodicExecutor::getPeriod() const
+{
+    return static_cast<double>(pImpl->period) / 1e9;
+}
+
+uint64_t PeriodicExecutor::getNumberOfSteps() const
+{
+    return pImpl->numberOfSteps.load(std::memory_order_relaxed);
+}
+
+uint64_t PeriodicExecutor::getNumberOfOverruns() const
+{
+    return pImpl->numberOfOverruns.load(std::memory_order_relaxed);
+}
+
+const core::LatencyHistogram& PeriodicExecutor::getExecutionTimeHistogram() const
+{
+    return pImpl->executionTime;
+}
+
+const core::LatencyHistogram& PeriodicExecutor::getJitterHistogram() const
+{
+    return pImpl->jitter;
+}
+
+void PeriodicExecutor::resetStatistics()
+{
+    pImpl->numberOfSteps = 0;
+    pImpl->numberOfOverruns = 0;
+    pImpl->executionTime.reset();
+    pImpl->jitter.reset();
+}
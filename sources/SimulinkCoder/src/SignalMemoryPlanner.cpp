@@ -0,0 +1,579 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+#include "BlockFactory/Core/Log.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+const size_t SignalMemoryPlanner::Alignment;
+
+struct PlannedSignal
+{
+    core::Port::DataType dataType;
+    size_t numElements;
+    size_t size;
+    size_t offset;
+    // Lifetime expressed as the inclusive range of block indices that use the signal
+    size_t firstUse;
+    size_t lastUse;
+    bool persistent;
+    // Indices of the blocks that produce and consume the signal
+    std::vector<ModelGraph::BlockIndex> users;
+    // Index of the signal whose buffer is shared by an output computed in place
+    size_t sharedWith;
+    std::shared_ptr<core::Signal> signal;
+};
+
+struct RedirectedInput
+{
+    void* address;
+    std::shared_ptr<core::Signal> signal;
+};
+
+class SignalMemoryPlanner::impl
+{
+public:
+    bool bufferReuse = true;
+
+    std::unique_ptr<uint8_t[]> memory;
+    uint8_t* arena = nullptr;
+    size_t arenaSize = 0;
+
+    std::vector<PlannedSignal> signals;
+    std::vector<core::InputPortsInfo> inputPortsInfo;
+    std::vector<core::OutputPortsInfo> outputPortsInfo;
+
+    // Indices of the signals, indexed as [block][port]
+    std::vector<std::vector<size_t>> inputSignals;
+    std::vector<std::vector<size_t>> outputSignals;
+
+    // Input ports connected to buffers outside the arena
+    using PortKey = std::pair<ModelGraph::BlockIndex, core::Port::Index>;
+    std::map<PortKey, RedirectedInput> redirectedInputs;
+
+    static const size_t InvalidSignal = SIZE_MAX;
+
+    void clear();
+    void shareInPlaceBuffer(const ModelGraph& graph,
+                            const ModelGraph::BlockIndex block,
+                            const core::Port::Info& portInfo);
+    void assignOffsets();
+    size_t signalIndex(const std::vector<std::vector<size_t>>& map,
+                       const ModelGraph::PortRef& ref) const;
+
+    static bool lifetimesOverlap(const PlannedSignal& a, const PlannedSignal& b);
+    static size_t alignSize(const size_t size);
+    static core::Port::Info toCoderPortInfo(const core::Port::Info& portInfo);
+};
+
+const size_t SignalMemoryPlanner::impl::InvalidSignal;
+
+void SignalMemoryPlanner::impl::clear()
+{
+    memory.reset();
+    arena = nullptr;
+    arenaSize = 0;
+    signals.clear();
+    inputPortsInfo.clear();
+    outputPortsInfo.clear();
+    inputSignals.clear();
+    outputSignals.clear();
+    redirectedInputs.clear();
+}
+
+bool SignalMemoryPlanner::impl::lifetimesOverlap(const PlannedSignal& a, const PlannedSignal& b)
+{
+    if (a.persistent || b.persistent) {
+        return true;
+    }
+
+    return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+}
+
+size_t SignalMemoryPlanner::impl::alignSize(const size_t size)
+{
+    return (size + SignalMemoryPlanner::Alignment - 1) / SignalMemoryPlanner::Alignment
+           * SignalMemoryPlanner::Alignment;
+}
+
+core::Port::Info SignalMemoryPlanner::impl::toCoderPortInfo(const core::Port::Info& portInfo)
+{
+    // The code generated by Simulink Coder always passes a {rows, cols} structure, and vectors
+    // are row vectors. Keep the same convention expected by CoderBlockInformation.
+    core::Port::Info coderPortInfo = portInfo;
+
+    if (coderPortInfo.dimension.size() == 1) {
+        coderPortInfo.dimension = {1, portInfo.dimension[0]};
+    }
+
+    return coderPortInfo;
+}
+
+size_t SignalMemoryPlanner::impl::signalIndex(const std::vector<std::vector<size_t>>& map,
+                                              const ModelGraph::PortRef& ref) const
+{
+    if (ref.block >= map.size() || ref.port >= map[ref.block].size()) {
+        return InvalidSignal;
+    }
+
+    return map[ref.block][ref.port];
+}
+
+void SignalMemoryPlanner::impl::shareInPlaceBuffer(const ModelGraph& graph,
+                                                   const ModelGraph::BlockIndex block,
+                                                   const core::Port::Info& portInfo)
+{
+    // Blocks with states can read their inputs after computing the outputs, e.g. in
+    // core::Block::updateDiscreteState, hence they never compute their outputs in place
+    if (portInfo.inPlaceInput < 0 || graph.hasStates(block)) {
+        return;
+    }
+
+    const size_t in =
+        signalIndex(inputSignals, {block, static_cast<core::Port::Index>(portInfo.inPlaceInput)});
+    const size_t out = signalIndex(outputSignals, {block, portInfo.index});
+
+    if (in == InvalidSignal || out == InvalidSignal) {
+        return;
+    }
+
+    const PlannedSignal& input = signals[in];
+    PlannedSignal& output = signals[out];
+
+    // The buffer is shared only if the block is the only consumer of the input. Persistent signals
+    // must keep their value between steps, hence they have a dedicated buffer.
+    if (input.persistent || output.persistent || input.users.size() != 2
+        || input.lastUse != block || input.dataType != output.dataType
+        || input.numElements != output.numElements) {
+        return;
+    }
+
+    // Chains of outputs computed in place share the buffer of the first signal, whose lifetime is
+    // extended to cover all of them
+    size_t root = in;
+    while (signals[root].sharedWith != InvalidSignal) {
+        root = signals[root].sharedWith;
+    }
+
+    output.sharedWith = root;
+    signals[root].lastUse = std::max(signals[root].lastUse, output.lastUse);
+    signals[root].users.insert(
+        signals[root].users.end(), output.users.begin(), output.users.end());
+}
+
+void SignalMemoryPlanner::impl::assignOffsets()
+{
+    // Place the biggest signals first
+    std::vector<size_t> order(signals.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+        return signals[a].size > signals[b].size;
+    });
+
+    std::vector<size_t> placed;
+    std::vector<std::pair<size_t, size_t>> busy;
+    placed.reserve(signals.size());
+    busy.reserve(signals.size());
+
+    for (const size_t s : order) {
+        PlannedSignal& signal = signals[s];
+
+        // Signals sharing the buffer of another signal are placed afterwards
+        if (signal.sharedWith != InvalidSignal) {
+            continue;
+        }
+
+        if (!bufferReuse) {
+            signal.offset = arenaSize;
+            arenaSize += signal.size;
+            continue;
+        }
+
+        // Collect the memory regions of the already placed signals that are alive at the same
+        // time of the current one
+        busy.clear();
+        for (const size_t p : placed) {
+            if (lifetimesOverlap(signal, signals[p])) {
+                busy.emplace_back(signals[p].offset, signals[p].offset + signals[p].size);
+            }
+        }
+        std::sort(busy.begin(), busy.end());
+
+        // Find the smallest gap that fits the signal (best fit). If no gap is found, the signal is
+        // placed after the last busy region.
+        size_t bestOffset = SIZE_MAX;
+        size_t bestGap = SIZE_MAX;
+        size_t candidate = 0;
+
+        for (const auto& region : busy) {
+            if (region.first >= candidate) {
+                const size_t gap = region.first - candidate;
+                if (gap >= signal.size && gap < bestGap) {
+                    bestGap = gap;
+                    bestOffset = candidate;
+                }
+            }
+            candidate = std::max(candidate, region.second);
+        }
+
+        signal.offset = (bestOffset == SIZE_MAX) ? candidate : bestOffset;
+        arenaSize = std::max(arenaSize, signal.offset + signal.size);
+        placed.push_back(s);
+    }
+
+    for (auto& signal : signals) {
+        if (signal.sharedWith != InvalidSignal) {
+            signal.offset = signals[signal.sharedWith].offset;
+        }
+    }
+}
+
+SignalMemoryPlanner::SignalMemoryPlanner()
+    : pImpl(std::make_unique<SignalMemoryPlanner::impl>())
+{}
+
+SignalMemoryPlanner::~SignalMemoryPlanner() = default;
+
+void SignalMemoryPlanner::setBufferReuse(const bool enable)
+{
+    pImpl->bufferReuse = enable;
+}
+
+bool SignalMemoryPlanner::plan(const ModelGraph& graph)
+{
+    pImpl->clear();
+
+    const size_t numBlocks = graph.getNumberOfBlocks();
+
+    if (numBlocks == 0) {
+        bfError << "The model graph does not contain any block.";
+        return false;
+    }
+
+    pImpl->inputSignals.resize(numBlocks);
+    pImpl->outputSignals.resize(numBlocks);
+
+    auto createSignal = [&](const core::Port::Info& portInfo, const size_t firstUse) -> size_t {
+        PlannedSignal signal;
+        signal.dataType = portInfo.dataType;
+        signal.numElements = ModelGraph::getNumberOfElements(portInfo);
+        signal.size =
+            impl::alignSize(signal.numElements * ModelGraph::getDataTypeSize(portInfo.dataType));
+        signal.offset = 0;
+        signal.firstUse = firstUse;
+        signal.lastUse = firstUse;
+        signal.persistent = false;
+        signal.users = {firstUse};
+        signal.sharedWith = impl::InvalidSignal;
+        pImpl->signals.push_back(signal);
+        return pImpl->signals.size() - 1;
+    };
+
+    // Create a signal for every output port
+    for (size_t block = 0; block < numBlocks; ++block) {
+        pImpl->inputPortsInfo.push_back(graph.getInputPortsInfo(block));
+        pImpl->outputPortsInfo.push_back(graph.getOutputPortsInfo(block));
+
+        for (const auto& portInfo : graph.getOutputPortsInfo(block)) {
+            if (ModelGraph::getNumberOfElements(portInfo) == 0) {
+                bfError << "The output port " << portInfo.index << " of block "
+                        << graph.getBlockName(block) << " has not a concrete size.";
+                pImpl->clear();
+                return false;
+            }
+
+            auto& blockSignals = pImpl->outputSignals[block];
+            if (portInfo.index >= blockSignals.size()) {
+                blockSignals.resize(portInfo.index + 1, impl::InvalidSignal);
+            }
+            blockSignals[portInfo.index] = createSignal(portInfo, block);
+        }
+    }
+
+    // Connect the input ports to the signals. Input ports without a source get their own
+    // persistent signal.
+    std::vector<bool> consumed(pImpl->signals.size(), false);
+
+    for (size_t block = 0; block < numBlocks; ++block) {
+        for (const auto& portInfo : graph.getInputPortsInfo(block)) {
+            auto& blockSignals = pImpl->inputSignals[block];
+            if (portInfo.index >= blockSignals.size()) {
+                blockSignals.resize(portInfo.index + 1, impl::InvalidSignal);
+            }
+
+            ModelGraph::PortRef source;
+            if (!graph.getSource({block, portInfo.index}, source)) {
+                if (ModelGraph::getNumberOfElements(portInfo) == 0) {
+                    bfError << "The input port " << portInfo.index << " of block "
+                            << graph.getBlockName(block) << " has not a concrete size.";
+                    pImpl->clear();
+                    return false;
+                }
+                const size_t s = createSignal(portInfo, 0);
+                pImpl->signals[s].persistent = true;
+                blockSignals[portInfo.index] = s;
+                continue;
+            }
+
+            const size_t s = pImpl->signalIndex(pImpl->outputSignals, source);
+            PlannedSignal& signal = pImpl->signals[s];
+            consumed[s] = true;
+            blockSignals[portInfo.index] = s;
+            signal.users.push_back(block);
+
+            // Consumers executed before or by the producer read the value of the previous step
+            if (block <= source.block) {
+                signal.persistent = true;
+            }
+            signal.lastUse = std::max(signal.lastUse, block);
+        }
+    }
+
+    // Signals that are not consumed by any block are outputs of the model
+    for (size_t s = 0; s < consumed.size(); ++s) {
+        if (!consumed[s]) {
+            pImpl->signals[s].persistent = true;
+        }
+    }
+
+    // Outputs computed in place share the buffer of their input
+    if (pImpl->bufferReuse) {
+        for (size_t block = 0; block < numBlocks; ++block) {
+            for (const auto& portInfo : graph.getOutputPortsInfo(block)) {
+                pImpl->shareInPlaceBuffer(graph, block, portInfo);
+            }
+        }
+    }
+
+    pImpl->assignOffsets();
+
+    // Allocate the arena, initialized to zero
+    pImpl->memory.reset(new uint8_t[pImpl->arenaSize + Alignment]());
+    const auto base = reinterpret_cast<uintptr_t>(pImpl->memory.get());
+    pImpl->arena = pImpl->memory.get() + (Alignment - base % Alignment) % Alignment;
+
+    // Create the zero-copy signals
+    for (auto& signal : pImpl->signals) {
+        signal.signal = std::make_shared<core::Signal>(
+            core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY, signal.dataType);
+
+        if (!signal.signal->initializeBufferFromContiguousZeroCopy(pImpl->arena + signal.offset,
+                                                                   signal.numElements)) {
+            bfError << "Failed to initialize the signal buffer.";
+            pImpl->clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t SignalMemoryPlanner::getArenaSize() const
+{
+    return pImpl->arenaSize;
+}
+
+size_t SignalMemoryPlanner::getRequiredMemoryWithoutReuse() const
+{
+    size_t size = 0;
+    for (const auto& signal : pImpl->signals) {
+        size += signal.size;
+    }
+    return size;
+}
+
+std::vector<std::pair<ModelGraph::BlockIndex, ModelGraph::BlockIndex>>
+SignalMemoryPlanner::getReuseDependencies() const
+{
+    std::vector<std::pair<ModelGraph::BlockIndex, ModelGraph::BlockIndex>> dependencies;
+
+    for (const auto& first : pImpl->signals) {
+        for (const auto& second : pImpl->signals) {
+            // Only signals that share memory and are used one after the other introduce
+            // dependencies. Persistent signals never share memory.
+            if (first.persistent || second.persistent || first.lastUse >= second.firstUse) {
+                continue;
+            }
+
+            const bool shareMemory = first.offset < second.offset + second.size
+                                     && second.offset < first.offset + first.size;
+
+            if (!shareMemory) {
+                continue;
+            }
+
+            // The producer of the second signal overwrites the memory of the first one. It must
+            // wait all the blocks that use the first signal.
+            for (const auto user : first.users) {
+                dependencies.emplace_back(user, second.firstUse);
+            }
+        }
+    }
+
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+    return dependencies;
+}
+
+size_t SignalMemoryPlanner::getNumberOfSignals() const
+{
+    return pImpl->signals.size();
+}
+
+bool SignalMemoryPlanner::isBufferReuseEnabled() const
+{
+    return pImpl->bufferReuse;
+}
+
+bool SignalMemoryPlanner::redirectInputPort(const ModelGraph::PortRef& input, void* address)
+{
+    const size_t s = pImpl->signalIndex(pImpl->inputSignals, input);
+
+    if (s == impl::InvalidSignal) {
+        bfError << "Block " << input.block << " has no planned input port at index " << input.port
+                << ".";
+        return false;
+    }
+
+    if (!address) {
+        bfError << "The address of the redirected input port is a nullptr.";
+        return false;
+    }
+
+    const PlannedSignal& planned = pImpl->signals[s];
+    auto signal = std::make_shared<core::Signal>(core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY,
+                                                 planned.dataType);
+
+    if (!signal->initializeBufferFromContiguousZeroCopy(address, planned.numElements)) {
+        bfError << "Failed to initialize the signal buffer.";
+        return false;
+    }
+
+    pImpl->redirectedInputs[{input.block, input.port}] = {address, signal};
+    return true;
+}
+
+bool SignalMemoryPlanner::restoreInputPort(const ModelGraph::PortRef& input)
+{
+    if (pImpl->signalIndex(pImpl->inputSignals, input) == impl::InvalidSignal) {
+        bfError << "Block " << input.block << " has no planned input port at index " << input.port
+                << ".";
+        return false;
+    }
+
+    pImpl->redirectedInputs.erase({input.block, input.port});
+    return true;
+}
+
+core::InputSignalPtr SignalMemoryPlanner::getInputPortSignal(const ModelGraph::PortRef& input) const
+{
+    const auto redirected = pImpl->redirectedInputs.find({input.block, input.port});
+    if (redirected != pImpl->redirectedInputs.end()) {
+        return redirected->second.signal;
+    }
+
+    const size_t s = pImpl->signalIndex(pImpl->inputSignals, input);
+
+    if (s == impl::InvalidSignal) {
+        bfError << "Block " << input.block << " has no planned input port at index " << input.port
+                << ".";
+        return nullptr;
+    }
+
+    return pImpl->signals[s].signal;
+}
+
+core::OutputSignalPtr
+SignalMemoryPlanner::getOutputPortSignal(const ModelGraph::PortRef& output) const
+{
+    const size_t s = pImpl->signalIndex(pImpl->outputSignals, output);
+
+    if (s == impl::InvalidSignal) {
+        bfError << "Block " << output.block << " has no planned output port at index "
+                << output.port << ".";
+        return nullptr;
+    }
+
+    return pImpl->signals[s].signal;
+}
+
+void* SignalMemoryPlanner::getInputPortAddress(const ModelGraph::PortRef& input) const
+{
+    const auto redirected = pImpl->redirectedInputs.find({input.block, input.port});
+    if (redirected != pImpl->redirectedInputs.end()) {
+        return redirected->second.address;
+    }
+
+    const size_t s = pImpl->signalIndex(pImpl->inputSignals, input);
+
+    if (s == impl::InvalidSignal) {
+        bfError << "Block " << input.block << " has no planned input port at index " << input.port
+                << ".";
+        return nullptr;
+    }
+
+    return pImpl->arena + pImpl->signals[s].offset;
+}
+
+void* SignalMemoryPlanner::getOutputPortAddress(const ModelGraph::PortRef& output) const
+{
+    const size_t s = pImpl->signalIndex(pImpl->outputSignals, output);
+
+    if (s == impl::InvalidSignal) {
+        bfError << "Block " << output.block << " has no planned output port at index "
+                << output.port << ".";
+        return nullptr;
+    }
+
+    return pImpl->arena + pImpl->signals[s].offset;
+}
+
+bool SignalMemoryPlanner::configureBlockInformation(const ModelGraph::BlockIndex block,
+                                                    CoderBlockInformation& blockInfo) const
+{
+    if (block >= pImpl->inputPortsInfo.size()) {
+        bfError << "The planned graph has no block at index " << block << ".";
+        return false;
+    }
+
+    for (const auto& portInfo : pImpl->inputPortsInfo[block]) {
+        void* address = getInputPortAddress({block, portInfo.index});
+        if (!address || !blockInfo.setInputPort(impl::toCoderPortInfo(portInfo), address)) {
+            bfError << "Failed to configure the input port " << portInfo.index << " of block "
+                    << block << ".";
+            return false;
+        }
+    }
+
+    for (const auto& portInfo : pImpl->outputPortsInfo[block]) {
+        void* address = getOutputPortAddress({block, portInfo.index});
+        if (!address || !blockInfo.setOutputPort(impl::toCoderPortInfo(portInfo), address)) {
+            bfError << "Failed to configure the output port " << portInfo.index << " of block "
+                    << block << ".";
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <utility>
+
+#if defined(__GLIBC__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#define BF_TRACK_MALLOC
+#endif
+
+using namespace blockfactory::test;
+
+const size_t AllocationTracker::MaxStackDepth;
+const size_t AllocationTracker::MaxRecordedAllocations;
+
+namespace {
+    struct Record
+    {
+        size_t size = 0;
+        int depth = 0;
+        std::array<void*, AllocationTracker::MaxStackDepth> frames;
+    };
+
+    // Only trivial types are used here, since they are accessed by the allocation functions
+    thread_local bool tracking = false;
+    thread_local bool recording = false;
+    std::atomic<size_t> numberOfAllocations{0};
+    std::array<Record, AllocationTracker::MaxRecordedAllocations> records;
+
+    void recordAllocation(const size_t size)
+    {
+        if (!tracking || recording) {
+            return;
+        }
+
+        // Prevent the recursion of allocations performed while recording
+        recording = true;
+
+        const size_t index = numberOfAllocations.fetch_add(1);
+        if (index < records.size()) {
+            records[index].size = size;
+#if defined(BF_TRACK_MALLOC)
+            auto& frames = records[index].frames;
+            records[index].depth = backtrace(frames.data(), static_cast<int>(frames.size()));
+#endif
+        }
+
+        recording = false;
+    }
+
+#if defined(BF_TRACK_MALLOC)
+    // The frames of the allocation functions are not part of the reported call stack
+    bool isAllocationFunction(const std::string& symbol)
+    {
+        for (const char* name :
+             {"recordAllocation", "malloc", "calloc", "realloc", "operator new"}) {
+            if (symbol.find(name) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Convert "binary(mangled+offset) [address]" to the demangled function name
+    std::string demangle(const std::string& symbol)
+    {
+        const size_t begin = symbol.find('(');
+        const size_t end = symbol.find('+', begin);
+
+        if (begin == std::string::npos || end == std::string::npos || end == begin + 1) {
+            return symbol;
+        }
+
+        const std::string mangled = symbol.substr(begin + 1, end - begin - 1);
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+
+        if (status != 0 || !demangled) {
+            return mangled;
+        }
+
+        const std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+#endif
+} // namespace
+
+void AllocationTracker::start()
+{
+#if defined(BF_TRACK_MALLOC)
+    // The first call of backtrace loads libgcc, which allocates
+    std::array<void*, 1> frame;
+    backtrace(frame.data(), 1);
+#endif
+
+    numberOfAllocations = 0;
+    tracking = true;
+}
+
+void AllocationTracker::stop()
+{
+    tracking = false;
+}
+
+size_t AllocationTracker::getNumberOfAllocations()
+{
+    return numberOfAllocations;
+}
+
+std::vector<AllocationTracker::Allocation> AllocationTracker::getAllocations()
+{
+    std::vector<Allocation> allocations;
+    const size_t numberOfRecords = std::min(getNumberOfAllocations(), records.size());
+
+    for (size_t i = 0; i < numberOfRecords; ++i) {
+        Allocation allocation{records[i].size, {}};
+
+#if defined(BF_TRACK_MALLOC)
+        char** symbols = backtrace_symbols(records[i].frames.data(), records[i].depth);
+        if (symbols) {
+            for (int frame = 0; frame < records[i].depth; ++frame) {
+                const std::string name = demangle(symbols[frame]);
+
+                // The frames of the test runner are not relevant
+                if (name.find("Catch::") != std::string::npos) {
+                    break;
+                }
+
+                // Keep only the frames after the last allocation function
+                if (isAllocationFunction(name)) {
+                    allocation.stack.clear();
+                    continue;
+                }
+                allocation.stack.push_back(name);
+            }
+            std::free(symbols);
+        }
+#endif
+
+        allocations.push_back(std::move(allocation));
+    }
+
+    return allocations;
+}
+
+std::string AllocationTracker::report()
+{
+    std::ostringstream report;
+    report << getNumberOfAllocations() << " allocations in the tracked window" << std::endl;
+
+    const auto allocations = getAllocations();
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        report << "#" << i << ": " << allocations[i].size << " bytes" << std::endl;
+        for (const auto& frame : allocations[i].stack) {
+            report << "    " << frame << std::endl;
+        }
+    }
+
+    return report.str();
+}
+
+// Replacement of the allocation functions
+// =======================================
+
+#if defined(BF_TRACK_MALLOC)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t number, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size)
+{
+    recordAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t number, size_t size)
+{
+    recordAllocation(number * size);
+    return __libc_calloc(number, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+    recordAllocation(size);
+    return __libc_realloc(pointer, size);
+}
+}
+#endif
+
+static void* allocate(const size_t size) noexcept
+{
+    // With glibc the allocation is recorded by malloc
+#if !defined(BF_TRACK_MALLOC)
+    recordAllocation(size);
+#endif
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size)
+{
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t /*size*/) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t /*size*/) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t& /*tag*/) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t& /*tag*/) noexcept
+{
+    std::free(pointer);
+}
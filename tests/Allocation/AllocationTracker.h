@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef BLOCKFACTORY_TESTS_ALLOCATIONTRACKER_H
+#define BLOCKFACTORY_TESTS_ALLOCATIONTRACKER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace blockfactory {
+    namespace test {
+        class AllocationTracker;
+    } // namespace test
+} // namespace blockfactory
+
+/**
+ * @brief Class that detects the heap allocations performed by a window of code
+ *
+ * The executable that links this class replaces the global `operator new` and, with glibc, also
+ * `malloc`, `calloc` and `realloc`. The allocations performed by the thread that opened the
+ * window are counted, and the call stacks of the first of them are stored and symbolized when
+ * the report is requested.
+ *
+ * @code{.cpp}
+ * {
+ *     const AllocationTracker::Window window;
+ *     block.output(&blockInfo);
+ * }
+ * REQUIRE(AllocationTracker::getNumberOfAllocations() == 0);
+ * @endcode
+ *
+ * The call stacks are available only with glibc. The executable should export its symbols
+ * (`-rdynamic`) in order to resolve the names of its functions. On Windows, the allocations
+ * performed inside other DLLs are not detected.
+ */
+class blockfactory::test::AllocationTracker
+{
+public:
+    /// The maximum number of frames stored for every allocation
+    static const size_t MaxStackDepth = 24;
+
+    /// The maximum number of allocations whose call stack is stored
+    static const size_t MaxRecordedAllocations = 32;
+
+    /// An allocation detected in the tracked window
+    struct Allocation
+    {
+        size_t size;
+        /// The symbolized call stack, starting from the caller of the allocation function
+        std::vector<std::string> stack;
+    };
+
+    /// Track the allocations during the lifetime of the object
+    class Window
+    {
+    public:
+        Window() { AllocationTracker::start(); }
+        ~Window() { AllocationTracker::stop(); }
+
+        Window(const Window& other) = delete;
+        Window& operator=(const Window& other) = delete;
+    };
+
+    /**
+     * @brief Start tracking the allocations of the calling thread
+     *
+     * The allocations of the previous window are discarded.
+     */
+    static void start();
+
+    /**
+     * @brief Stop tracking the allocations
+     */
+    static void stop();
+
+    /**
+     * @brief Get the number of allocations of the last window
+     *
+     * @return The number of allocations.
+     */
+    static size_t getNumberOfAllocations();
+
+    /**
+     * @brief Get the allocations of the last window
+     *
+     * @return The first AllocationTracker::MaxRecordedAllocations allocations.
+     */
+    static std::vector<Allocation> getAllocations();
+
+    /**
+     * @brief Describe the allocations of the last window
+     *
+     * @return A text with the size and the call stack of every allocation.
+     */
+    static std::string report();
+};
+
+#endif // BLOCKFACTORY_TESTS_ALLOCATIONTRACKER_H
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "AllocationTracker.h"
+#include "SignalMath.h"
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/FactorySingleton.h"
+#include "BlockFactory/Core/Parameter.h"
+#include "BlockFactory/Core/Parameters.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Profiler.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/Core/Tracer.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace blockfactory;
+using test::AllocationTracker;
+
+namespace allocation {
+    class AllocatingBlock;
+} // namespace allocation
+
+// Block with a buffer allocated in output(), used to check that the harness detects it
+class allocation::AllocatingBlock : public core::Block
+{
+public:
+    bool output(const core::BlockInformation* /*blockInfo*/) override
+    {
+        std::vector<double> buffer(16, 0.0);
+        return !buffer.empty();
+    }
+};
+
+namespace {
+    const size_t Width = 8;
+    const size_t NumberOfSteps = 100;
+
+    // The memory of a generated model with a block with two inputs and one output
+    struct Model
+    {
+        std::array<double, Width> u1 = {};
+        std::array<double, Width> u2 = {};
+        std::array<double, Width> y = {};
+        coder::CoderBlockInformation blockInfo;
+
+        Model(const std::string& className, const std::string& operation = "Addition")
+        {
+            const auto metadata = [](const unsigned index, const std::string& name) {
+                return core::ParameterMetadata(core::ParameterType::STRING, index, 1, 1, name);
+            };
+
+            core::Parameters parameters;
+            parameters.storeParameter(className, metadata(0, "className"));
+            parameters.storeParameter(std::string("Library"), metadata(1, "libName"));
+            parameters.storeParameter(operation, metadata(2, "Operation"));
+
+            const core::Port::Dimensions dimensions = {1, static_cast<int>(Width)};
+            const auto dataType = core::Port::DataType::DOUBLE;
+
+            blockInfo.setUniqueBlockName("model/" + className);
+            blockInfo.storeRTWParameters(parameters);
+            blockInfo.setInputPort({0, dimensions, dataType}, u1.data());
+            blockInfo.setInputPort({1, dimensions, dataType}, u2.data());
+            blockInfo.setOutputPort({0, dimensions, dataType}, y.data());
+
+            for (size_t i = 0; i < Width; ++i) {
+                u1[i] = static_cast<double>(i);
+                u2[i] = 2.0;
+            }
+        }
+    };
+
+    // Execute the output of the block as the generated code does
+    bool step(core::Block* block, const coder::CoderBlockInformation& blockInfo)
+    {
+        return core::Profiler::call(
+            block, &blockInfo, core::Profiler::Callback::Output, &core::Block::output);
+    }
+
+    // Execute the step loop tracking the allocations
+    bool trackStepLoop(core::Block* block, const coder::CoderBlockInformation& blockInfo)
+    {
+        bool ok = true;
+        {
+            const AllocationTracker::Window window;
+            for (size_t i = 0; i < NumberOfSteps; ++i) {
+                ok = step(block, blockInfo) && ok;
+            }
+        }
+        return ok;
+    }
+
+    template <typename Function>
+    size_t countAllocations(const Function& function)
+    {
+        {
+            const AllocationTracker::Window window;
+            function();
+        }
+        return AllocationTracker::getNumberOfAllocations();
+    }
+} // namespace
+
+TEST_CASE("Detect the allocations of a window", "[Allocation]")
+{
+    REQUIRE(countAllocations([]() {}) == 0);
+
+    REQUIRE(countAllocations([]() { std::vector<double> buffer(16, 0.0); }) == 1);
+    REQUIRE(AllocationTracker::getAllocations().size() == 1);
+    REQUIRE(AllocationTracker::getAllocations().front().size == 16 * sizeof(double));
+
+    // Allocations outside the window are not counted
+    std::vector<double> buffer(16, 0.0);
+    REQUIRE(AllocationTracker::getNumberOfAllocations() == 1);
+}
+
+TEST_CASE("Detect the allocations of a block", "[Allocation]")
+{
+    allocation::AllocatingBlock block;
+    Model model("AllocatingBlock");
+
+    REQUIRE(trackStepLoop(&block, model.blockInfo));
+    REQUIRE(AllocationTracker::getNumberOfAllocations() == NumberOfSteps);
+
+    const std::string report = AllocationTracker::report();
+    REQUIRE(report.find(std::to_string(NumberOfSteps) + " allocations") != std::string::npos);
+#if defined(__GLIBC__)
+    // The executable exports its symbols, hence the block is part of the call stack
+    REQUIRE(report.find("allocation::AllocatingBlock::output") != std::string::npos);
+#endif
+}
+
+TEST_CASE("Output of MockPlugin does not allocate", "[Allocation][Plugin]")
+{
+    auto& factorySingleton = core::ClassFactorySingleton::getInstance();
+    factorySingleton.extendPluginSearchPath(TEST_EXTENDED_PLUGIN_PATH);
+
+    auto factory = factorySingleton.getClassFactory({"MockPlugin", "MockBlock"});
+    REQUIRE(factory != nullptr);
+
+    core::Block* block = factory->create();
+    factory->addRef();
+    REQUIRE(block != nullptr);
+
+    Model model("MockBlock");
+    REQUIRE(block->initialize(&model.blockInfo));
+
+    REQUIRE(trackStepLoop(block, model.blockInfo));
+    INFO(AllocationTracker::report());
+    REQUIRE(AllocationTracker::getNumberOfAllocations() == 0);
+
+    factory->destroy(block);
+    factory->removeRef();
+    factory.reset();
+    REQUIRE(factorySingleton.destroyFactory({"MockPlugin", "MockBlock"}));
+}
+
+TEST_CASE("Output of SignalMath does not allocate", "[Allocation]")
+{
+    for (const std::string operation : {"Addition", "Subtraction", "Multiplication"}) {
+        example::SignalMath block;
+        Model model("SignalMath", operation);
+        REQUIRE(block.initialize(&model.blockInfo));
+
+        REQUIRE(trackStepLoop(&block, model.blockInfo));
+        INFO(operation << ": " << AllocationTracker::report());
+        REQUIRE(AllocationTracker::getNumberOfAllocations() == 0);
+
+        if (operation == "Addition") {
+            REQUIRE(model.y[3] == 5.0);
+        }
+    }
+}
+
+TEST_CASE("Core hot paths do not allocate", "[Allocation]")
+{
+    Model model("Core");
+    const coder::CoderBlockInformation& blockInfo = model.blockInfo;
+
+    SECTION("getInputPortSignal")
+    {
+        const auto allocations = countAllocations([&]() { blockInfo.getInputPortSignal(0); });
+        INFO(AllocationTracker::report());
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("getOutputPortSignal")
+    {
+        const auto allocations = countAllocations([&]() { blockInfo.getOutputPortSignal(0); });
+        INFO(AllocationTracker::report());
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("getInputPortWidth")
+    {
+        const auto allocations = countAllocations([&]() { blockInfo.getInputPortWidth(0); });
+        INFO(AllocationTracker::report());
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("Signal accessors")
+    {
+        const auto input = blockInfo.getInputPortSignal(0);
+        const auto output = blockInfo.getOutputPortSignal(0);
+
+        const auto allocations = countAllocations([&]() {
+            for (size_t i = 0; i < Width; ++i) {
+                output->set(i, input->get<double>(i));
+            }
+            output->setBuffer(input->getBuffer<double>(), Width);
+        });
+        INFO(AllocationTracker::report());
+        REQUIRE(allocations == 0);
+        REQUIRE(model.y == model.u1);
+    }
+
+    SECTION("Profiled step loop")
+    {
+        example::SignalMath block;
+        Model signalMath("SignalMath");
+        REQUIRE(block.initialize(&signalMath.blockInfo));
+
+        core::Profiler::setEnabled(true);
+        REQUIRE(core::Tracer::start(4 * NumberOfSteps));
+
+        // The first call registers the block in the profiler
+        REQUIRE(step(&block, signalMath.blockInfo));
+        REQUIRE(trackStepLoop(&block, signalMath.blockInfo));
+
+        core::Tracer::stop();
+        core::Profiler::setEnabled(false);
+
+        INFO(AllocationTracker::report());
+        REQUIRE(AllocationTracker::getNumberOfAllocations() == 0);
+    }
+}
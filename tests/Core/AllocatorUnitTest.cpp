@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Allocator.h"
+#include "BlockFactory/Core/PoolAllocator.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <vector>
+
+using namespace blockfactory::core;
+
+TEST_CASE("Default allocator", "[Core][Allocator]")
+{
+    Allocator& allocator = Allocator::getDefault();
+
+    for (const size_t alignment : {8u, 16u, 64u, 4096u}) {
+        for (const size_t bytes : {0u, 1u, 100u, 10000u}) {
+            void* ptr = allocator.allocate(bytes, alignment);
+            REQUIRE(ptr);
+            REQUIRE(Allocator::isAligned(ptr, alignment));
+            allocator.deallocate(ptr, bytes, alignment);
+        }
+    }
+}
+
+TEST_CASE("Arena allocator", "[Core][Allocator]")
+{
+    ArenaAllocator arena(1024);
+    REQUIRE(arena.getCapacity() == 1024);
+    REQUIRE(arena.getUsedBytes() == 0);
+
+    void* first = arena.allocate(10, 64);
+    void* second = arena.allocate(10, 64);
+    REQUIRE(arena.owns(first));
+    REQUIRE(arena.owns(second));
+    REQUIRE(Allocator::isAligned(first, 64));
+    REQUIRE(Allocator::isAligned(second, 64));
+    REQUIRE(static_cast<char*>(second) - static_cast<char*>(first) == 64);
+    REQUIRE(arena.getUsedBytes() == 74);
+
+    // The requests that do not fit are served by the upstream allocator
+    void* large = arena.allocate(2048, 64);
+    REQUIRE(large);
+    REQUIRE_FALSE(arena.owns(large));
+    arena.deallocate(large, 2048, 64);
+
+    // The memory of the arena is recycled only after a reset
+    arena.deallocate(first, 10, 64);
+    REQUIRE(arena.getUsedBytes() == 74);
+    arena.reset();
+    REQUIRE(arena.getUsedBytes() == 0);
+    REQUIRE(arena.allocate(10, 64) == first);
+}
+
+TEST_CASE("Aligned Signal buffers", "[Core][Signal][Allocator]")
+{
+    const std::vector<double> buffer = {1, 2, 3, 4, 5};
+
+    // Owned buffers are aligned to the cache line
+    Signal contiguous(Signal::DataFormat::CONTIGUOUS);
+    REQUIRE_FALSE(contiguous.isAligned(Allocator::DefaultAlignment));
+    REQUIRE(contiguous.initializeBufferFromContiguous(buffer.data(), buffer.size()));
+    REQUIRE(contiguous.isAligned(Allocator::DefaultAlignment));
+    REQUIRE(&contiguous.getAllocator() == &Allocator::getDefault());
+
+    // Reallocated buffers and copies are aligned as well
+    const std::vector<double> larger(17, 1.0);
+    REQUIRE(contiguous.setBuffer(larger.data(), larger.size()));
+    REQUIRE(contiguous.isAligned(Allocator::DefaultAlignment));
+    const Signal copy(contiguous);
+    REQUIRE(copy.isAligned(Allocator::DefaultAlignment));
+    REQUIRE(copy.getBuffer<double>() != contiguous.getBuffer<double>());
+
+    const double* pointers[] = {buffer.data()};
+    Signal nonContiguous(Signal::DataFormat::NONCONTIGUOUS);
+    REQUIRE(nonContiguous.initializeBufferFromNonContiguous(
+        reinterpret_cast<const void* const*>(pointers), buffer.size()));
+    REQUIRE(nonContiguous.isAligned(Allocator::DefaultAlignment));
+    REQUIRE(nonContiguous.get<double>(4) == 5);
+
+    // The alignment of zero-copy signals depends on the external buffer
+    Signal zeroCopy(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    REQUIRE(zeroCopy.initializeBufferFromContiguousZeroCopy(buffer.data() + 1, 1));
+    REQUIRE(zeroCopy.isAligned(alignof(double)));
+}
+
+TEST_CASE("Signals allocated from an arena", "[Core][Signal][Allocator]")
+{
+    const std::vector<double> buffer = {1, 2, 3, 4, 5};
+    ArenaAllocator arena(4096);
+
+    Signal signal(Signal::DataFormat::CONTIGUOUS, Port::DataType::DOUBLE, &arena);
+    REQUIRE(signal.initializeBufferFromContiguous(buffer.data(), buffer.size()));
+    REQUIRE(arena.owns(signal.getBuffer<double>()));
+    REQUIRE(signal.isAligned(Allocator::DefaultAlignment));
+
+    // Copies use the allocator of the original signal
+    const Signal copy(signal);
+    REQUIRE(&copy.getAllocator() == &arena);
+    REQUIRE(arena.owns(copy.getBuffer<double>()));
+    REQUIRE(copy.get<double>(2) == 3);
+}
+
+TEST_CASE("Pool allocator", "[Core][Allocator]")
+{
+    PoolAllocator pool;
+    size_t missedBytes = 0;
+    pool.setMissCallback([&](const size_t bytes) { missedBytes += bytes; });
+
+    // Requests are rounded up to the size classes
+    void* first = pool.allocate(100, 64);
+    REQUIRE(first);
+    REQUIRE(Allocator::isAligned(first, 64));
+    REQUIRE(pool.getStatistics().misses == 1);
+    REQUIRE(pool.getStatistics().bytesInUse == 128);
+    REQUIRE(missedBytes == 128);
+
+    // Released blocks serve the requests of the same size class
+    pool.deallocate(first, 100, 64);
+    REQUIRE(pool.getStatistics().bytesInUse == 0);
+    REQUIRE(pool.getStatistics().bytesCached == 128);
+    REQUIRE(pool.allocate(120, 8) == first);
+    REQUIRE(pool.getStatistics().hits == 1);
+    REQUIRE(pool.getStatistics().bytesCached == 0);
+
+    // Requests that cannot be pooled are forwarded
+    void* large = pool.allocate(PoolAllocator::MaxBlockSize + 1, 64);
+    void* overAligned = pool.allocate(64, 4096);
+    REQUIRE(Allocator::isAligned(overAligned, 4096));
+    REQUIRE(pool.getStatistics().misses == 3);
+    pool.deallocate(large, PoolAllocator::MaxBlockSize + 1, 64);
+    pool.deallocate(overAligned, 64, 4096);
+    REQUIRE(pool.getStatistics().bytesCached == 0);
+    REQUIRE(pool.getStatistics().peakBytesInUse == 128 + PoolAllocator::MaxBlockSize + 1 + 64);
+
+    pool.deallocate(first, 120, 8);
+    pool.resetStatistics();
+    REQUIRE(pool.getStatistics().allocations == 0);
+    REQUIRE(pool.getStatistics().peakBytesInUse == 0);
+
+    // Reserved blocks avoid the misses
+    REQUIRE(pool.reserve(1000, 4));
+    REQUIRE(pool.getStatistics().bytesCached == 128 + 4 * 1024);
+    std::vector<void*> blocks;
+    for (int i = 0; i < 4; ++i) {
+        blocks.push_back(pool.allocate(1024, 64));
+        REQUIRE(blocks.back());
+    }
+    REQUIRE(pool.getStatistics().misses == 0);
+    for (void* block : blocks) {
+        pool.deallocate(block, 1024, 64);
+    }
+    REQUIRE_FALSE(pool.reserve(PoolAllocator::MaxBlockSize + 1, 1));
+
+    pool.trim();
+    REQUIRE(pool.getStatistics().bytesCached == 0);
+}
+
+TEST_CASE("Signals allocated from a pool", "[Core][Signal][Allocator]")
+{
+    const std::vector<double> buffer(50, 1.0);
+    PoolAllocator& pool = PoolAllocator::getThreadLocal();
+    pool.trim();
+
+    Signal signal(Signal::DataFormat::CONTIGUOUS, Port::DataType::DOUBLE, &pool);
+    REQUIRE(signal.initializeBufferFromContiguous(buffer.data(), buffer.size()));
+    REQUIRE(signal.isAligned(Allocator::DefaultAlignment));
+
+    // Copying at every step recycles the same block
+    const void* previous = nullptr;
+    pool.resetStatistics();
+    for (int step = 0; step < 10; ++step) {
+        const Signal copy(signal);
+        REQUIRE(&copy.getAllocator() == &pool);
+        REQUIRE(copy.get<double>(49) == 1.0);
+        if (previous) {
+            REQUIRE(copy.getBuffer<double>() == previous);
+        }
+        previous = copy.getBuffer<double>();
+    }
+    REQUIRE(pool.getStatistics().allocations == 10);
+    REQUIRE(pool.getStatistics().hits == 9);
+}
+
+TEST_CASE("Copy a signal whose allocation fails", "[Core][Allocator]")
+{
+    // Allocator that serves only the first request
+    class OneShotAllocator : public Allocator
+    {
+    public:
+        bool used = false;
+
+        void* allocate(const size_t bytes, const size_t alignment) override
+        {
+            if (used) {
+                return nullptr;
+            }
+            used = true;
+            return Allocator::getDefault().allocate(bytes, alignment);
+        }
+
+        void deallocate(void* ptr, const size_t bytes, const size_t alignment) override
+        {
+            Allocator::getDefault().deallocate(ptr, bytes, alignment);
+        }
+    };
+
+    OneShotAllocator allocator;
+    const std::vector<double> data = {1, 2, 3};
+    Signal signal(Signal::DataFormat::CONTIGUOUS, Port::DataType::DOUBLE, &allocator);
+    REQUIRE(signal.initializeBufferFromContiguous(data.data(), data.size()));
+
+    // The copy must not share the buffer of the original signal
+    Signal copy(signal);
+    REQUIRE_FALSE(copy.isValid());
+    REQUIRE(copy.getWidth() == 0);
+    REQUIRE(copy.getBuffer<double>() != signal.getBuffer<double>());
+    REQUIRE(signal.get<double>(2) == 3);
+}
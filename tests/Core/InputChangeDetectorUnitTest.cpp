@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/InputChangeDetector.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace blockfactory;
+
+// Minimal BlockInformation whose signals point to external buffers of doubles
+class BufferBlockInformation : public core::BlockInformation
+{
+public:
+    std::vector<core::InputSignalPtr> inputs;
+    std::vector<core::OutputSignalPtr> outputs;
+
+    static std::shared_ptr<core::Signal> makeSignal(std::vector<double>& buffer)
+    {
+        auto signal = std::make_shared<core::Signal>(core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY,
+                                                     core::Port::DataType::DOUBLE);
+        REQUIRE(signal->initializeBufferFromContiguousZeroCopy(buffer.data(), buffer.size()));
+        return signal;
+    }
+
+    bool getUniqueName(std::string& /*blockUniqueName*/) const override { return false; }
+    bool optionFromKey(const std::string& /*key*/, double& /*option*/) const override
+    {
+        return false;
+    }
+    bool parseParameters(core::Parameters& /*parameters*/) override { return false; }
+    bool addParameterMetadata(const core::ParameterMetadata& /*paramMD*/) override
+    {
+        return false;
+    }
+    bool setPortsInfo(const core::InputPortsInfo& /*inputPortsInfo*/,
+                      const core::OutputPortsInfo& /*outputPortsInfo*/) override
+    {
+        return false;
+    }
+    core::Port::Info getInputPortInfo(core::Port::Index /*idx*/) const override { return {}; }
+    core::Port::Info getOutputPortInfo(core::Port::Index /*idx*/) const override { return {}; }
+    core::Port::Size::Vector getInputPortWidth(const core::Port::Index idx) const override
+    {
+        return static_cast<core::Port::Size::Vector>(inputs[idx]->getWidth());
+    }
+    core::Port::Size::Vector getOutputPortWidth(const core::Port::Index idx) const override
+    {
+        return static_cast<core::Port::Size::Vector>(outputs[idx]->getWidth());
+    }
+    core::Port::Size::Matrix getInputPortMatrixSize(const core::Port::Index /*idx*/) const override
+    {
+        return {};
+    }
+    core::Port::Size::Matrix getOutputPortMatrixSize(const core::Port::Index /*idx*/) const override
+    {
+        return {};
+    }
+    core::InputSignalPtr getInputPortSignal(const core::Port::Index idx) const override
+    {
+        return idx < inputs.size() ? inputs[idx] : nullptr;
+    }
+    core::OutputSignalPtr getOutputPortSignal(const core::Port::Index idx) const override
+    {
+        return idx < outputs.size() ? outputs[idx] : nullptr;
+    }
+};
+
+class NormBlock : public core::Block
+{
+public:
+    size_t calls = 0;
+
+    bool isPure() override { return true; }
+
+    bool output(const core::BlockInformation* blockInfo) override
+    {
+        ++calls;
+        const auto input = blockInfo->getInputPortSignal(0);
+        auto output = blockInfo->getOutputPortSignal(0);
+
+        double norm = 0;
+        for (size_t i = 0; i < input->getWidth(); ++i) {
+            norm += input->get<double>(i) * input->get<double>(i);
+        }
+        return output->set(0, std::sqrt(norm));
+    }
+};
+
+TEST_CASE("Skip the output of pure blocks", "[Core][InputChangeDetector]")
+{
+    std::vector<double> input = {3, 4};
+    std::vector<double> gain = {2};
+    std::vector<double> output = {0};
+
+    BufferBlockInformation blockInfo;
+    blockInfo.inputs = {BufferBlockInformation::makeSignal(input),
+                        BufferBlockInformation::makeSignal(gain)};
+    blockInfo.outputs = {BufferBlockInformation::makeSignal(output)};
+
+    NormBlock block;
+    REQUIRE(block.isPure());
+    core::InputChangeDetector detector;
+
+    const auto step = [&]() {
+        if (!block.isPure() || detector.update(&blockInfo, 2)) {
+            REQUIRE(block.output(&blockInfo));
+        }
+    };
+
+    // The output is always computed in the first step
+    step();
+    REQUIRE(block.calls == 1);
+    REQUIRE(output[0] == 5);
+
+    // Unchanged inputs keep the previous output
+    output[0] = -1;
+    step();
+    step();
+    REQUIRE(block.calls == 1);
+    REQUIRE(output[0] == -1);
+    REQUIRE(detector.getNumberOfSkips() == 2);
+
+    // A change in any port is detected
+    input[1] = 0;
+    step();
+    REQUIRE(block.calls == 2);
+    REQUIRE(output[0] == 3);
+    gain[0] = 3;
+    step();
+    REQUIRE(block.calls == 3);
+    step();
+    REQUIRE(block.calls == 3);
+
+    // Changes of the tunable parameters invalidate the detector
+    detector.invalidate();
+    step();
+    REQUIRE(block.calls == 4);
+    REQUIRE(detector.getNumberOfChanges() == 4);
+
+    // A different number of ports is a change
+    REQUIRE(detector.update(&blockInfo, 1));
+    REQUIRE_FALSE(detector.update(&blockInfo, 1));
+
+    // The base block is not pure
+    class StatefulBlock : public core::Block
+    {
+        bool output(const core::BlockInformation* /*blockInfo*/) override { return true; }
+    } stateful;
+    REQUIRE_FALSE(stateful.isPure());
+}
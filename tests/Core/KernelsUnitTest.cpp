@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Kernels.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace blockfactory::core;
+
+namespace {
+    // The lengths cover the vectorized loops and their remainders for all the types
+    const size_t MaxLength = 67;
+
+    std::vector<Kernels::InstructionSet> getSupportedInstructionSets()
+    {
+        std::vector<Kernels::InstructionSet> instructionSets;
+        for (const auto instructionSet : {Kernels::InstructionSet::Scalar,
+                                          Kernels::InstructionSet::SSE2,
+                                          Kernels::InstructionSet::AVX2,
+                                          Kernels::InstructionSet::AVX512}) {
+            if (Kernels::isSupported(instructionSet)) {
+                instructionSets.push_back(instructionSet);
+            }
+        }
+        return instructionSets;
+    }
+
+    // Small integer values, so that the results are exact and do not overflow any type
+    template <typename T>
+    std::vector<T> generate(const size_t length, const size_t offset)
+    {
+        std::vector<T> values(length);
+        for (size_t i = 0; i < length; ++i) {
+            values[i] = static_cast<T>((i + offset) % 11);
+        }
+        return values;
+    }
+
+    template <typename T>
+    Span<const T> in(const std::vector<T>& vector)
+    {
+        return {vector.data(), vector.size()};
+    }
+
+    template <typename T>
+    Span<T> out(std::vector<T>& vector)
+    {
+        return {vector.data(), vector.size()};
+    }
+} // namespace
+
+TEMPLATE_TEST_CASE("Elementwise kernels",
+                   "[Core][Kernels]",
+                   double,
+                   float,
+                   int8_t,
+                   uint8_t,
+                   int16_t,
+                   uint16_t,
+                   int32_t,
+                   uint32_t)
+{
+    using T = TestType;
+    const auto defaultInstructionSet = Kernels::getInstructionSet();
+
+    for (const auto instructionSet : getSupportedInstructionSets()) {
+        INFO("Instruction set: " << Kernels::getInstructionSetName(instructionSet));
+        REQUIRE(Kernels::setInstructionSet(instructionSet));
+        REQUIRE(Kernels::getInstructionSet() == instructionSet);
+
+        for (size_t length = 0; length <= MaxLength; ++length) {
+            INFO("Length: " << length);
+            const auto a = generate<T>(length, 0);
+            const auto b = generate<T>(length, 3);
+            std::vector<T> y(length);
+
+            REQUIRE(Kernels::add(in(a), in(b), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == static_cast<T>(a[i] + b[i]));
+            }
+
+            REQUIRE(Kernels::subtract(in(a), in(b), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == static_cast<T>(a[i] - b[i]));
+            }
+
+            REQUIRE(Kernels::multiply(in(a), in(b), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == static_cast<T>(a[i] * b[i]));
+            }
+
+            REQUIRE(Kernels::scale(in(a), static_cast<T>(3), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == static_cast<T>(3 * a[i]));
+            }
+
+            y = b;
+            REQUIRE(Kernels::axpy(static_cast<T>(2), in(a), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == static_cast<T>(2 * a[i] + b[i]));
+            }
+
+            REQUIRE(Kernels::clamp(in(a), static_cast<T>(2), static_cast<T>(7), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == (a[i] < 2 ? 2 : (a[i] > 7 ? 7 : a[i])));
+            }
+
+            double expected = 0;
+            for (size_t i = 0; i < length; ++i) {
+                expected += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+            }
+            double result = -1;
+            REQUIRE(Kernels::dot(in(a), in(b), result));
+            REQUIRE(result == expected);
+
+            expected = 0;
+            for (size_t i = 0; i < length; ++i) {
+                expected += static_cast<double>(a[i]) * static_cast<double>(a[i]);
+            }
+            REQUIRE(Kernels::norm(in(a), result));
+            REQUIRE(result == Approx(std::sqrt(expected)));
+
+            // The output can be one of the inputs
+            y = a;
+            REQUIRE(Kernels::add(in(y), in(b), out(y)));
+            for (size_t i = 0; i < length; ++i) {
+                REQUIRE(y[i] == static_cast<T>(a[i] + b[i]));
+            }
+        }
+    }
+
+    REQUIRE(Kernels::setInstructionSet(defaultInstructionSet));
+}
+
+TEST_CASE("Kernels with invalid arguments", "[Core][Kernels]")
+{
+    const std::vector<double> a(8, 1.0);
+    const std::vector<double> b(7, 1.0);
+    std::vector<double> y(8);
+    double result = 0;
+
+    REQUIRE_FALSE(Kernels::add(in(a), in(b), out(y)));
+    REQUIRE_FALSE(Kernels::subtract(in(b), in(a), out(y)));
+    REQUIRE_FALSE(Kernels::scale(in(b), 2.0, out(y)));
+    REQUIRE_FALSE(Kernels::axpy(2.0, in(b), out(y)));
+    REQUIRE_FALSE(Kernels::dot(in(a), in(b), result));
+    REQUIRE_FALSE(Kernels::clamp(in(a), 1.0, -1.0, out(y)));
+}
+
+TEST_CASE("Kernels on signals", "[Core][Kernels]")
+{
+    const size_t width = 10;
+    std::vector<int16_t> u1 = generate<int16_t>(width, 0);
+    std::vector<int16_t> u2 = generate<int16_t>(width, 5);
+    std::vector<int16_t> y(width);
+
+    Signal signal1(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::INT16);
+    Signal signal2(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::INT16);
+    Signal output(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::INT16);
+    REQUIRE(signal1.initializeBufferFromContiguousZeroCopy(u1.data(), width));
+    REQUIRE(signal2.initializeBufferFromContiguousZeroCopy(u2.data(), width));
+    REQUIRE(output.initializeBufferFromContiguousZeroCopy(y.data(), width));
+
+    REQUIRE(Kernels::add(signal1, signal2, output));
+    for (size_t i = 0; i < width; ++i) {
+        REQUIRE(y[i] == u1[i] + u2[i]);
+    }
+
+    REQUIRE(Kernels::scale(signal1, 2.0, output));
+    for (size_t i = 0; i < width; ++i) {
+        REQUIRE(y[i] == 2 * u1[i]);
+    }
+
+    REQUIRE(Kernels::clamp(signal1, 3.0, 5.0, output));
+    for (size_t i = 0; i < width; ++i) {
+        REQUIRE(y[i] >= 3);
+        REQUIRE(y[i] <= 5);
+    }
+
+    // Scale factors that the integer type cannot represent are rejected
+    REQUIRE_FALSE(Kernels::scale(signal1, 0.5, output));
+    REQUIRE_FALSE(Kernels::scale(signal1, 1e6, output));
+    REQUIRE_FALSE(Kernels::axpy(std::nan(""), signal1, output));
+    REQUIRE_FALSE(Kernels::axpy(-std::numeric_limits<double>::infinity(), signal1, output));
+    REQUIRE(Kernels::scale(signal1, -32768.0, output));
+
+    // The limits are rounded inside the interval and saturated to the range of the type
+    REQUIRE(Kernels::clamp(signal1, 2.5, 1e9, output));
+    for (size_t i = 0; i < width; ++i) {
+        REQUIRE(y[i] == std::max<int16_t>(u1[i], 3));
+    }
+    REQUIRE(Kernels::clamp(signal1, -std::numeric_limits<double>::infinity(), 4.9, output));
+    for (size_t i = 0; i < width; ++i) {
+        REQUIRE(y[i] == std::min<int16_t>(u1[i], 4));
+    }
+    REQUIRE_FALSE(Kernels::clamp(signal1, 2.2, 2.8, output));
+    REQUIRE_FALSE(Kernels::clamp(signal1, std::nan(""), 2.0, output));
+
+    double norm = 0;
+    REQUIRE(Kernels::norm(signal2, norm));
+    REQUIRE(norm > 0);
+
+    // The data types must match and be numeric
+    std::vector<double> doubles(width);
+    Signal doubleSignal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::DOUBLE);
+    REQUIRE(doubleSignal.initializeBufferFromContiguousZeroCopy(doubles.data(), width));
+    REQUIRE_FALSE(Kernels::add(signal1, signal2, doubleSignal));
+
+    bool booleanBuffer[width] = {};
+    Signal booleanSignal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::BOOLEAN);
+    REQUIRE(booleanSignal.initializeBufferFromContiguousZeroCopy(booleanBuffer, width));
+    REQUIRE_FALSE(Kernels::norm(booleanSignal, norm));
+
+    // Signals with different widths
+    Signal shortSignal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::INT16);
+    REQUIRE(shortSignal.initializeBufferFromContiguousZeroCopy(u1.data(), width - 1));
+    REQUIRE_FALSE(Kernels::add(signal1, shortSignal, output));
+
+    // Signals that are not initialized
+    Signal invalid(Signal::DataFormat::CONTIGUOUS_ZEROCOPY, Port::DataType::INT16);
+    REQUIRE_FALSE(Kernels::multiply(signal1, invalid, output));
+}
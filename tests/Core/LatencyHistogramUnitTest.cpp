@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/LatencyHistogram.h"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+using namespace blockfactory::core;
+
+TEST_CASE("Histogram buckets", "[Core][LatencyHistogram]")
+{
+    // Small values are stored exactly
+    for (uint64_t value = 0; value < LatencyHistogram::SubBuckets; ++value) {
+        REQUIRE(LatencyHistogram::getBucketIndex(value) == value);
+    }
+
+    // Buckets are contiguous and cover the whole range
+    for (size_t bucket = 0; bucket + 1 < LatencyHistogram::NumberOfBuckets; ++bucket) {
+        const uint64_t lower = LatencyHistogram::getBucketLowerBound(bucket);
+        const uint64_t upper = LatencyHistogram::getBucketUpperBound(bucket);
+        REQUIRE(lower <= upper);
+        REQUIRE(LatencyHistogram::getBucketLowerBound(bucket + 1) == upper + 1);
+        REQUIRE(LatencyHistogram::getBucketIndex(lower) == bucket);
+        REQUIRE(LatencyHistogram::getBucketIndex(upper) == bucket);
+    }
+
+    REQUIRE(LatencyHistogram::getBucketIndex(std::numeric_limits<uint64_t>::max())
+            == LatencyHistogram::NumberOfBuckets - 1);
+}
+
+TEST_CASE("Histogram statistics", "[Core][LatencyHistogram]")
+{
+    LatencyHistogram histogram;
+    REQUIRE(histogram.getCount() == 0);
+    REQUIRE(histogram.getPercentile(50) == 0);
+
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value * 1000);
+    }
+
+    REQUIRE(histogram.getCount() == 1000);
+    REQUIRE(histogram.getMin() == 1000);
+    REQUIRE(histogram.getMax() == 1000000);
+    REQUIRE(histogram.getMean() == Approx(500500));
+    REQUIRE(histogram.getPercentile(100) == 1000000);
+
+    // The relative error of the percentiles is bounded by the sub buckets
+    const double median = static_cast<double>(histogram.getPercentile(50));
+    REQUIRE(median >= 500000);
+    REQUIRE(median <= 500000 * (1 + 1.0 / LatencyHistogram::SubBuckets));
+
+    histogram.reset();
+    REQUIRE(histogram.getCount() == 0);
+    REQUIRE(histogram.getMax() == 0);
+}
+
+TEST_CASE("Histogram concurrent read", "[Core][LatencyHistogram]")
+{
+    LatencyHistogram histogram;
+    const uint64_t numberOfSamples = 100000;
+    std::atomic<bool> done{false};
+    bool consistent = true;
+
+    // Catch assertions are not thread safe, the result is checked after the join
+    std::thread reader([&]() {
+        uint64_t previous = 0;
+        while (!done) {
+            const uint64_t count = histogram.getCount();
+            consistent = consistent && count >= previous && histogram.getMax() < 1000;
+            previous = count;
+        }
+    });
+
+    for (uint64_t i = 0; i < numberOfSamples; ++i) {
+        histogram.record(i % 1000);
+    }
+    done = true;
+    reader.join();
+
+    REQUIRE(consistent);
+    REQUIRE(histogram.getCount() == numberOfSamples);
+}
+
+TEST_CASE("Histogram merge", "[Core][LatencyHistogram]")
+{
+    LatencyHistogram first;
+    LatencyHistogram second;
+    LatencyHistogram merged;
+
+    for (uint64_t value = 10; value <= 100; value += 10) {
+        first.record(value);
+        second.record(value * 100);
+    }
+
+    merged.merge(first);
+    merged.merge(second);
+    merged.merge(LatencyHistogram());
+
+    REQUIRE(merged.getCount() == 20);
+    REQUIRE(merged.getMin() == 10);
+    REQUIRE(merged.getMax() == 10000);
+    REQUIRE(merged.getMean() == Approx((first.getMean() + second.getMean()) / 2));
+    REQUIRE(merged.getPercentile(50)
+            == LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(100)));
+}
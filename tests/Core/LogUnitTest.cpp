@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Log.h"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace blockfactory::core;
+
+static size_t countOccurrences(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+TEST_CASE("Log messages", "[Core][Log]")
+{
+    Log log;
+
+    log.getLogStringStream(Log::Type::ERROR, __FILE__, __LINE__, __FUNCTION__)
+        << "error " << 1 << std::endl;
+    log.getLogStringStream(Log::Type::WARNING, __FILE__, __LINE__, __FUNCTION__)
+        << "warning " << 2.5;
+
+    REQUIRE(log.getErrors().find("error 1\n") != std::string::npos);
+    REQUIRE(log.getWarnings().find("warning 2.5") != std::string::npos);
+    REQUIRE(log.getErrors().find("warning") == std::string::npos);
+
+    log.clear();
+    REQUIRE(log.getErrors().empty());
+    REQUIRE(log.getWarnings().empty());
+}
+
+static std::vector<std::thread> startThreads(Log& log,
+                                             const size_t numberOfThreads,
+                                             const size_t numberOfMessages)
+{
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < numberOfThreads; ++t) {
+        threads.emplace_back([&log, t, numberOfMessages]() {
+            for (size_t i = 0; i < numberOfMessages; ++i) {
+                log.getLogStringStream(Log::Type::ERROR, __FILE__, __LINE__, __FUNCTION__)
+                    << "<thread " << t << " message " << i << ">";
+            }
+        });
+    }
+
+    return threads;
+}
+
+TEST_CASE("Log messages from concurrent threads", "[Core][Log]")
+{
+    constexpr size_t NumberOfThreads = 4;
+    constexpr size_t NumberOfMessages = 1000;
+
+    Log log;
+    auto threads = startThreads(log, NumberOfThreads, NumberOfMessages);
+
+    // Reading and clearing the log while the messages are written does not corrupt them
+    for (size_t i = 0; i < 100; ++i) {
+        const std::string errors = log.getErrors();
+        REQUIRE(countOccurrences(errors, "<thread ") == countOccurrences(errors, ">"));
+        if (i == 50) {
+            log.clearErrors();
+        }
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every message is stored whole
+    log.clearErrors();
+    threads = startThreads(log, NumberOfThreads, NumberOfMessages);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::string errors = log.getErrors();
+    REQUIRE(countOccurrences(errors, "<thread ") == NumberOfThreads * NumberOfMessages);
+    REQUIRE(countOccurrences(errors, ">") == NumberOfThreads * NumberOfMessages);
+    for (size_t t = 0; t < NumberOfThreads; ++t) {
+        REQUIRE(errors.find("<thread " + std::to_string(t) + " message "
+                            + std::to_string(NumberOfMessages - 1) + ">")
+                != std::string::npos);
+    }
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Kernels.h"
+#include "BlockFactory/Core/MatrixView.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+
+#if defined(BLOCKFACTORY_TEST_EIGEN)
+#include "BlockFactory/Core/EigenMatrixView.h"
+#endif
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace blockfactory::core;
+
+namespace {
+    // Matrix with small integer values, so that the products are exact
+    std::vector<double> generate(const size_t rows, const size_t cols, const size_t offset)
+    {
+        std::vector<double> values(rows * cols);
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<double>((i * 7 + offset) % 5) - 2.0;
+        }
+        return values;
+    }
+
+    // Reference product C = alpha * A * B + beta * C
+    void multiply(const double alpha,
+                  const MatrixView<const double>& a,
+                  const MatrixView<const double>& b,
+                  const double beta,
+                  const MatrixView<double>& c)
+    {
+        for (size_t row = 0; row < c.rows(); ++row) {
+            for (size_t col = 0; col < c.cols(); ++col) {
+                double product = 0;
+                for (size_t k = 0; k < a.cols(); ++k) {
+                    product += a(row, k) * b(k, col);
+                }
+                c(row, col) = alpha * product + beta * c(row, col);
+            }
+        }
+    }
+
+    void requireEqual(const MatrixView<const double>& actual,
+                      const MatrixView<const double>& expected)
+    {
+        REQUIRE(actual.rows() == expected.rows());
+        REQUIRE(actual.cols() == expected.cols());
+        for (size_t row = 0; row < actual.rows(); ++row) {
+            for (size_t col = 0; col < actual.cols(); ++col) {
+                REQUIRE(actual(row, col) == expected(row, col));
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("Matrix views", "[Core][MatrixView]")
+{
+    // 2x3 matrix [1 2 3; 4 5 6] stored column major, as in Simulink
+    double columnMajor[] = {1, 4, 2, 5, 3, 6};
+    const double rowMajor[] = {1, 2, 3, 4, 5, 6};
+
+    const MatrixView<double> a(columnMajor, 2, 3);
+    const MatrixView<const double> b(rowMajor, 2, 3, MatrixLayout::RowMajor);
+
+    REQUIRE(a.rows() == 2);
+    REQUIRE(a.cols() == 3);
+    REQUIRE(a.size() == 6);
+    REQUIRE(a.hasContiguousColumns());
+    REQUIRE_FALSE(a.hasContiguousRows());
+    REQUIRE(b.hasContiguousRows());
+    requireEqual(a, b);
+
+    // The views do not copy data
+    a(1, 2) = 60;
+    REQUIRE(columnMajor[5] == 60);
+    a(1, 2) = 6;
+
+    const auto transposed = a.transpose();
+    REQUIRE(transposed.rows() == 3);
+    REQUIRE(transposed.cols() == 2);
+    REQUIRE(transposed.hasContiguousRows());
+    REQUIRE(transposed(2, 1) == 6);
+    requireEqual(transposed.transpose(), a);
+
+    const auto block = a.block(0, 1, 2, 2);
+    REQUIRE(block(0, 0) == 2);
+    REQUIRE(block(1, 1) == 6);
+    REQUIRE(block.data() == &columnMajor[2]);
+
+    // Mutable views convert to read-only views
+    const MatrixView<const double> readOnly = a;
+    REQUIRE(readOnly.data() == a.data());
+}
+
+TEST_CASE("Matrix views of signals", "[Core][MatrixView]")
+{
+    std::vector<double> buffer = {1, 4, 2, 5, 3, 6};
+    Signal signal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    REQUIRE(signal.initializeBufferFromContiguousZeroCopy(buffer.data(), buffer.size()));
+
+    const auto view = MatrixView<double>::fromSignal(signal, {2, 3});
+    REQUIRE(view.data() == buffer.data());
+    REQUIRE(view(1, 0) == 4);
+
+    const Signal& constSignal = signal;
+    const auto rowMajor =
+        MatrixView<const double>::fromSignal(constSignal, {3, 2}, MatrixLayout::RowMajor);
+    REQUIRE(rowMajor(0, 1) == 4);
+
+    // The width of the signal must match the size
+    REQUIRE(MatrixView<double>::fromSignal(signal, {2, 2}).empty());
+}
+
+TEST_CASE("Matrix kernels", "[Core][MatrixView][Kernels]")
+{
+    // The sizes are larger than the blocks of the kernels
+    for (const size_t rows : {1u, 7u, 150u}) {
+        for (const size_t depth : {1u, 5u, 70u}) {
+            const size_t cols = 9;
+            INFO("Rows: " << rows << ", depth: " << depth);
+
+            const auto aBuffer = generate(rows, depth, 0);
+            const auto bBuffer = generate(depth, cols, 1);
+            const auto cBuffer = generate(rows, cols, 2);
+
+            for (const auto layout : {MatrixLayout::ColumnMajor, MatrixLayout::RowMajor}) {
+                const MatrixView<const double> a(aBuffer.data(), rows, depth, layout);
+                const MatrixView<const double> b(bBuffer.data(), depth, cols, layout);
+
+                auto expected = cBuffer;
+                auto actual = cBuffer;
+                const MatrixView<double> c(actual.data(), rows, cols, layout);
+                multiply(2.0, a, b, 3.0, {expected.data(), rows, cols, layout});
+
+                REQUIRE(Kernels::gemm(2.0, a, b, 3.0, c));
+                requireEqual(c, {expected.data(), rows, cols, layout});
+
+                // With beta = 0 the initial values of the output are not used
+                actual.assign(actual.size(), std::numeric_limits<double>::quiet_NaN());
+                multiply(1.0, a, b, 0.0, {expected.data(), rows, cols, layout});
+                REQUIRE(Kernels::gemm(1.0, a, b, 0.0, c));
+                requireEqual(c, {expected.data(), rows, cols, layout});
+
+                // Output with a different layout
+                std::vector<double> other(rows * cols, 0.0);
+                const auto otherLayout = layout == MatrixLayout::ColumnMajor
+                                             ? MatrixLayout::RowMajor
+                                             : MatrixLayout::ColumnMajor;
+                const MatrixView<double> d(other.data(), rows, cols, otherLayout);
+                REQUIRE(Kernels::gemm(1.0, a, b, 0.0, d));
+                requireEqual(d, c);
+
+                // Matrix-vector product
+                const std::vector<double> x(bBuffer.begin(), bBuffer.begin() + depth);
+                const MatrixView<const double> xView(x.data(), depth, 1);
+                std::vector<double> y(cBuffer.begin(), cBuffer.begin() + rows);
+                std::vector<double> yExpected = y;
+
+                multiply(2.0, a, xView, 3.0, {yExpected.data(), rows, 1});
+                REQUIRE(Kernels::gemv(2.0, a, {x.data(), x.size()}, 3.0, {y.data(), y.size()}));
+                REQUIRE(y == yExpected);
+            }
+        }
+    }
+
+    // Strided view over the even rows and columns of a matrix, which uses the scalar loops
+    const auto buffer = generate(4, 6, 3);
+    const MatrixView<const double> strided(buffer.data(), 2, 3, 2, 8);
+    const auto xBuffer = generate(3, 1, 4);
+    std::vector<double> y(2, 0.0);
+    std::vector<double> yExpected(2, 0.0);
+    multiply(1.0, strided, {xBuffer.data(), 3, 1}, 0.0, {yExpected.data(), 2, 1});
+    REQUIRE(Kernels::gemv(1.0, strided, {xBuffer.data(), 3}, 0.0, {y.data(), 2}));
+    REQUIRE(y == yExpected);
+
+    // Sizes that do not match
+    std::vector<double> c(2 * 2);
+    REQUIRE_FALSE(Kernels::gemm(1.0, strided, strided, 0.0, {c.data(), 2, 2}));
+    REQUIRE_FALSE(Kernels::gemv(1.0, strided, {xBuffer.data(), 2}, 0.0, {y.data(), 2}));
+
+    // Single precision
+    const std::vector<float> a = {1, 2, 3, 4};
+    std::vector<float> product(4);
+    REQUIRE(Kernels::gemm(1.0f,
+                          MatrixView<const float>(a.data(), 2, 2),
+                          MatrixView<const float>(a.data(), 2, 2),
+                          0.0f,
+                          MatrixView<float>(product.data(), 2, 2)));
+    REQUIRE(product == std::vector<float>{7, 10, 15, 22});
+}
+
+#if defined(BLOCKFACTORY_TEST_EIGEN)
+TEST_CASE("Eigen maps of matrix views", "[Core][MatrixView]")
+{
+    double buffer[] = {1, 4, 2, 5, 3, 6};
+    const MatrixView<double> view(buffer, 2, 3);
+
+    auto map = toEigen(view);
+    REQUIRE(map.rows() == 2);
+    REQUIRE(map.cols() == 3);
+    REQUIRE(map(1, 2) == 6);
+
+    // Transposed views map to the transposed matrix
+    const auto transposed = toEigen(MatrixView<const double>(view).transpose());
+    REQUIRE(transposed.isApprox(map.transpose()));
+
+    // The map writes in the buffer of the view
+    map(0, 0) = 10;
+    REQUIRE(buffer[0] == 10);
+}
+#endif
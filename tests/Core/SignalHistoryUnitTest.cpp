@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Kernels.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/Core/SignalHistory.h"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <vector>
+
+using namespace blockfactory::core;
+
+namespace {
+    // Sample with the elements {step, 10 * step, ...}
+    std::vector<double> generate(const size_t width, const size_t step)
+    {
+        std::vector<double> sample(width);
+        for (size_t i = 0; i < width; ++i) {
+            sample[i] = static_cast<double>(step) * (i == 0 ? 1.0 : 10.0 * static_cast<double>(i));
+        }
+        return sample;
+    }
+} // namespace
+
+TEST_CASE("Signal history", "[Core][SignalHistory]")
+{
+    const size_t width = 3;
+    SignalHistory history(width, 5);
+
+    REQUIRE(history.isValid());
+    REQUIRE(history.getCapacity() == 8);
+    REQUIRE(history.getMaxWindow() == 8);
+    REQUIRE(history.empty());
+    REQUIRE(history.window(1).empty());
+
+    // Push more samples than the capacity, so that the buffer wraps around
+    for (size_t step = 1; step <= 20; ++step) {
+        const auto sample = generate(width, step);
+        history.push(sample.data());
+
+        REQUIRE(history.size() == std::min<size_t>(step, 8));
+        REQUIRE(history.sample(0)[0] == static_cast<double>(step));
+        REQUIRE(history.sample(history.size() - 1)[0]
+                == static_cast<double>(step - history.size() + 1));
+
+        // Every window is contiguous and ordered from the oldest sample
+        for (size_t length = 1; length <= history.size(); ++length) {
+            const auto window = history.window(length);
+            REQUIRE(window.rows() == width);
+            REQUIRE(window.cols() == length);
+            REQUIRE(window.hasContiguousColumns());
+            REQUIRE(window.colStride() == width);
+            for (size_t col = 0; col < length; ++col) {
+                const auto expected = generate(width, step - length + 1 + col);
+                REQUIRE(window(0, col) == expected[0]);
+                REQUIRE(window(2, col) == expected[2]);
+            }
+        }
+    }
+
+    REQUIRE(history.window(9).empty());
+
+    history.clear();
+    REQUIRE(history.empty());
+}
+
+TEST_CASE("Signal history with limited windows", "[Core][SignalHistory]")
+{
+    SignalHistory history(2, 16, 4);
+    REQUIRE(history.getMaxWindow() == 4);
+
+    for (size_t step = 1; step <= 40; ++step) {
+        const auto sample = generate(2, step);
+        history.push(sample.data());
+
+        const size_t length = std::min<size_t>(step, 4);
+        const auto window = history.window(length);
+        REQUIRE(window.cols() == length);
+        for (size_t col = 0; col < length; ++col) {
+            REQUIRE(window(1, col) == 10.0 * static_cast<double>(step - length + 1 + col));
+        }
+    }
+
+    // Older samples are accessible one by one
+    REQUIRE(history.sample(15)[0] == 25);
+    REQUIRE(history.window(5).empty());
+}
+
+TEST_CASE("Signal history of signals", "[Core][SignalHistory]")
+{
+    std::vector<double> buffer = {1, 2, 3};
+    Signal signal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    REQUIRE(signal.initializeBufferFromContiguousZeroCopy(buffer.data(), buffer.size()));
+
+    SignalHistory history(3, 4);
+    REQUIRE(history.push(signal));
+    buffer = {4, 5, 6};
+    REQUIRE(history.push(signal));
+
+    // FIR filter with the coefficients of the last two samples
+    const std::vector<double> coefficients = {0.5, 2.0};
+    std::vector<double> output(3, 0.0);
+    REQUIRE(Kernels::gemv(1.0,
+                          history.window(2),
+                          {coefficients.data(), coefficients.size()},
+                          0.0,
+                          {output.data(), output.size()}));
+    REQUIRE(output == std::vector<double>{8.5, 11.0, 13.5});
+
+    // The width must match
+    SignalHistory other(2, 4);
+    REQUIRE_FALSE(other.push(signal));
+    REQUIRE(other.empty());
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/Core/TensorView.h"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <vector>
+
+using namespace blockfactory::core;
+
+namespace {
+    // 2x3x4 tensor whose elements store their indices as 100 * i + 10 * j + k
+    std::vector<double> generate(const MatrixLayout layout)
+    {
+        std::vector<double> values(2 * 3 * 4);
+        for (size_t i = 0; i < 2; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                for (size_t k = 0; k < 4; ++k) {
+                    const size_t index = layout == MatrixLayout::ColumnMajor
+                                             ? i + 2 * j + 6 * k
+                                             : 12 * i + 4 * j + k;
+                    values[index] = static_cast<double>(100 * i + 10 * j + k);
+                }
+            }
+        }
+        return values;
+    }
+} // namespace
+
+TEST_CASE("Tensor views", "[Core][TensorView]")
+{
+    for (const auto layout : {MatrixLayout::ColumnMajor, MatrixLayout::RowMajor}) {
+        auto buffer = generate(layout);
+        const TensorView<double> tensor(buffer.data(), {2, 3, 4}, layout);
+
+        REQUIRE(tensor.rank() == 3);
+        REQUIRE(tensor.size() == 24);
+        REQUIRE(tensor.dim(2) == 4);
+        REQUIRE(tensor(0, 0, 0) == 0);
+        REQUIRE(tensor(1, 2, 3) == 123);
+        REQUIRE(tensor(1, 0, 2) == 102);
+
+        // The view does not copy data
+        tensor(0, 1, 1) = -1;
+        REQUIRE(buffer[layout == MatrixLayout::ColumnMajor ? 8 : 5] == -1);
+        tensor(0, 1, 1) = 11;
+
+        // Slices drop a dimension
+        const auto slice = tensor.slice(2, 3);
+        REQUIRE(slice.rank() == 2);
+        REQUIRE(slice.dim(0) == 2);
+        REQUIRE(slice.dim(1) == 3);
+        REQUIRE(slice(1, 2) == 123);
+
+        const auto matrix = slice.matrix();
+        REQUIRE(matrix.rows() == 2);
+        REQUIRE(matrix(1, 1) == 113);
+
+        // Permutations reorder the dimensions
+        const auto permuted = tensor.permute({2, 0, 1});
+        REQUIRE(permuted.dim(0) == 4);
+        REQUIRE(permuted(3, 1, 2) == 123);
+        REQUIRE(permuted(1, 0, 2) == 21);
+        REQUIRE(tensor.permute({0, 0, 1}).empty());
+
+        // Mutable views convert to read-only views
+        const TensorView<const double> readOnly = tensor;
+        REQUIRE(readOnly(1, 1, 1) == 111);
+    }
+
+    // Explicit strides: every other element of the first dimension
+    std::vector<double> buffer = generate(MatrixLayout::ColumnMajor);
+    const TensorView<const double> strided(buffer.data(), {3, 4}, {2, 6});
+    REQUIRE(strided(2, 3) == 23);
+    REQUIRE(strided.matrix()(1, 2) == 12);
+
+    REQUIRE(TensorView<double>(buffer.data(), {1, 2, 3}, {1, 2}).empty());
+    REQUIRE(TensorView<double>(buffer.data(), {1, 1, 1, 1, 1, 1, 1, 1, 1}).empty());
+}
+
+TEST_CASE("Tensor views of signals", "[Core][TensorView]")
+{
+    auto buffer = generate(MatrixLayout::ColumnMajor);
+    Signal signal(Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+    REQUIRE(signal.initializeBufferFromContiguousZeroCopy(buffer.data(), buffer.size()));
+
+    const Port::Dimensions dims = {2, 3, 4};
+    const auto tensor = TensorView<double>::fromSignal(signal, dims);
+    REQUIRE(tensor.data() == buffer.data());
+    REQUIRE(tensor(1, 2, 3) == 123);
+
+    const Signal& constSignal = signal;
+    const auto readOnly = TensorView<const double>::fromSignal(constSignal, dims);
+    REQUIRE(readOnly(0, 2, 1) == 21);
+
+    // The dimensions must be concrete and match the width of the signal
+    REQUIRE(TensorView<double>::fromSignal(signal, {2, 3, 3}).empty());
+    REQUIRE(TensorView<double>::fromSignal(signal, {2, Port::DynamicSize, 4}).empty());
+}
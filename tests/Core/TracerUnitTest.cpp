@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Tracer.h"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace blockfactory::core;
+
+TEST_CASE("Trace names", "[Core][Tracer]")
+{
+    const uint32_t first = Tracer::registerName("Trace names/first");
+    const uint32_t second = Tracer::registerName("Trace names/second");
+
+    REQUIRE(first != second);
+    REQUIRE(Tracer::registerName("Trace names/first") == first);
+    REQUIRE(Tracer::getName(first) == "Trace names/first");
+    REQUIRE(Tracer::getName(second) == "Trace names/second");
+}
+
+TEST_CASE("Record trace events", "[Core][Tracer]")
+{
+    const uint32_t step = Tracer::registerName("model");
+    const uint32_t category = Tracer::registerName("step");
+
+    // Disabled tracer
+    REQUIRE_FALSE(Tracer::isEnabled());
+    {
+        const Tracer::Scope scope(step, category);
+    }
+
+    REQUIRE_FALSE(Tracer::start(0));
+    REQUIRE(Tracer::start(8));
+    REQUIRE_FALSE(Tracer::start(8));
+    REQUIRE(Tracer::getNumberOfEvents() == 0);
+
+    {
+        const Tracer::Scope scope(step, category);
+    }
+    std::thread other([&]() { const Tracer::Scope scope(step, category); });
+    other.join();
+
+    REQUIRE(Tracer::getNumberOfEvents() == 4);
+
+    Tracer::Event begin;
+    Tracer::Event end;
+    REQUIRE(Tracer::getEvent(0, begin));
+    REQUIRE(Tracer::getEvent(1, end));
+    REQUIRE(begin.phase == Tracer::Phase::Begin);
+    REQUIRE(end.phase == Tracer::Phase::End);
+    REQUIRE(begin.name == step);
+    REQUIRE(begin.category == category);
+    REQUIRE(begin.timestamp <= end.timestamp);
+    REQUIRE(begin.thread == end.thread);
+
+    Tracer::Event otherThread;
+    REQUIRE(Tracer::getEvent(2, otherThread));
+    REQUIRE(otherThread.thread != begin.thread);
+    REQUIRE_FALSE(Tracer::getEvent(4, otherThread));
+
+    // Fill the buffer
+    for (size_t i = 0; i < 3; ++i) {
+        const Tracer::Scope scope(step, category);
+    }
+    REQUIRE(Tracer::getNumberOfEvents() == 8);
+    REQUIRE(Tracer::getNumberOfDroppedEvents() == 2);
+
+    Tracer::stop();
+    REQUIRE_FALSE(Tracer::isEnabled());
+
+    std::ostringstream json;
+    Tracer::writeChromeTrace(json);
+    const std::string trace = json.str();
+
+    REQUIRE(trace.find("\"traceEvents\":[") != std::string::npos);
+    REQUIRE(trace.find("{\"name\":\"model\",\"cat\":\"step\",\"ph\":\"B\"") != std::string::npos);
+    REQUIRE(trace.find("\"ph\":\"E\"") != std::string::npos);
+    REQUIRE(trace.rfind("]}") != std::string::npos);
+
+    // A new start removes the events
+    REQUIRE(Tracer::start(8));
+    REQUIRE(Tracer::getNumberOfEvents() == 0);
+    REQUIRE(Tracer::getNumberOfDroppedEvents() == 0);
+    Tracer::stop();
+}
+
+TEST_CASE("Restart the tracer while threads record events", "[Core][Tracer]")
+{
+    const uint32_t name = Tracer::registerName("concurrent");
+    std::atomic<bool> running{true};
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            while (running) {
+                Tracer::record(name, name, Tracer::Phase::Begin);
+            }
+        });
+    }
+
+    // Buffers of different sizes are replaced while the threads are recording
+    for (size_t capacity = 1; capacity < 200; ++capacity) {
+        REQUIRE(Tracer::start(capacity * 16));
+        std::ostringstream trace;
+        Tracer::writeChromeTrace(trace);
+        Tracer::stop();
+
+        Tracer::Event event;
+        for (size_t i = 0; i < Tracer::getNumberOfEvents(); ++i) {
+            if (Tracer::getEvent(i, event)) {
+                REQUIRE(event.name == name);
+            }
+        }
+    }
+
+    running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
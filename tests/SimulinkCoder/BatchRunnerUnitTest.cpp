@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/BatchRunner.h"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+// y[e] = gain * u[e] + e
+class ScaleBlock : public core::Block
+{
+public:
+    static constexpr double Gain = 2.0;
+    size_t outputCalls = 0;
+
+    bool initialize(core::BlockInformation* /*blockInfo*/) override { return true; }
+
+    bool output(const core::BlockInformation* blockInfo) override
+    {
+        ++outputCalls;
+
+        const auto input = blockInfo->getInputPortSignal(0);
+        auto output = blockInfo->getOutputPortSignal(0);
+
+        for (size_t e = 0; e < input->getWidth(); ++e) {
+            output->set(e, Gain * input->get<double>(e) + static_cast<double>(e));
+        }
+        return true;
+    }
+};
+
+constexpr double ScaleBlock::Gain;
+
+class BatchedScaleBlock : public ScaleBlock
+{
+public:
+    size_t batchedCalls = 0;
+
+    bool supportsBatchedOutput() override { return true; }
+
+    bool outputBatched(const core::BlockInformation* blockInfo, const size_t batchSize) override
+    {
+        ++batchedCalls;
+
+        const double* u = blockInfo->getInputPortSignal(0)->getBuffer<double>();
+        double* y = blockInfo->getOutputPortSignal(0)->getBuffer<double>();
+        const size_t width = blockInfo->getInputPortSignal(0)->getWidth() / batchSize;
+
+        for (size_t e = 0; e < width; ++e) {
+            // Contiguous loop over the instances
+            for (size_t i = 0; i < batchSize; ++i) {
+                y[e * batchSize + i] = Gain * u[e * batchSize + i] + static_cast<double>(e);
+            }
+        }
+        return true;
+    }
+};
+
+static void runBatch(core::Block& block, BatchRunner& runner, const size_t batchSize)
+{
+    const size_t width = 3;
+    const core::InputPortsInfo inputs = {
+        {0, {static_cast<int>(width)}, core::Port::DataType::DOUBLE}};
+    const core::OutputPortsInfo outputs = {
+        {0, {static_cast<int>(width)}, core::Port::DataType::DOUBLE}};
+
+    REQUIRE(runner.configure(&block, inputs, outputs, batchSize));
+    REQUIRE(runner.getBatchSize() == batchSize);
+    REQUIRE(runner.initialize());
+
+    double* u = runner.getInputPortBuffer(0);
+    REQUIRE(u);
+    REQUIRE_FALSE(runner.getInputPortBuffer(1));
+
+    for (size_t i = 0; i < batchSize; ++i) {
+        for (size_t e = 0; e < width; ++e) {
+            u[runner.getIndex(i, e)] = static_cast<double>(100 * i + e);
+        }
+    }
+
+    REQUIRE(runner.output());
+
+    const double* y = runner.getOutputPortBuffer(0);
+    for (size_t i = 0; i < batchSize; ++i) {
+        for (size_t e = 0; e < width; ++e) {
+            const double expected =
+                ScaleBlock::Gain * static_cast<double>(100 * i + e) + static_cast<double>(e);
+            REQUIRE(y[runner.getIndex(i, e)] == expected);
+        }
+    }
+
+    REQUIRE(runner.terminate());
+}
+
+TEST_CASE("Batched output", "[SimulinkCoder][BatchRunner]")
+{
+    BatchedScaleBlock block;
+    BatchRunner runner;
+    runBatch(block, runner, 16);
+
+    REQUIRE(runner.isBatched());
+    REQUIRE(block.batchedCalls == 1);
+    REQUIRE(block.outputCalls == 0);
+}
+
+TEST_CASE("Batched output fallback", "[SimulinkCoder][BatchRunner]")
+{
+    ScaleBlock block;
+    BatchRunner runner;
+    runBatch(block, runner, 16);
+
+    REQUIRE_FALSE(runner.isBatched());
+    REQUIRE(block.outputCalls == 16);
+}
+
+// Discrete accumulator x[k+1] = x[k] + u, with y = x, and continuous state with dx = 2 * u
+class StatefulBlock : public core::Block
+{
+public:
+    static constexpr double InitialState = 10.0;
+
+    unsigned numberOfDiscreteStates() override { return 1; }
+    unsigned numberOfContinuousStates() override { return 1; }
+    bool initialize(core::BlockInformation* /*blockInfo*/) override { return true; }
+
+    bool initializeInitialConditions(const core::BlockInformation* blockInfo) override
+    {
+        return blockInfo->getDiscreteStateSignal()->set(0, InitialState)
+               && blockInfo->getContinuousStateSignal()->set(0, 0.0);
+    }
+
+    bool output(const core::BlockInformation* blockInfo) override
+    {
+        return blockInfo->getOutputPortSignal(0)->set(
+            0, blockInfo->getDiscreteStateSignal()->get<double>(0));
+    }
+
+    bool updateDiscreteState(const core::BlockInformation* blockInfo) override
+    {
+        auto state = blockInfo->getDiscreteStateSignal();
+        return state->set(
+            0, state->get<double>(0) + blockInfo->getInputPortSignal(0)->get<double>(0));
+    }
+
+    bool stateDerivative(const core::BlockInformation* blockInfo) override
+    {
+        return blockInfo->getContinuousStateDerivativeSignal()->set(
+            0, 2 * blockInfo->getInputPortSignal(0)->get<double>(0));
+    }
+};
+
+constexpr double StatefulBlock::InitialState;
+
+TEST_CASE("Batched blocks with states", "[SimulinkCoder][BatchRunner]")
+{
+    const size_t batchSize = 8;
+    const core::InputPortsInfo inputs = {{0, {1}, core::Port::DataType::DOUBLE}};
+    const core::OutputPortsInfo outputs = {{0, {1}, core::Port::DataType::DOUBLE}};
+
+    StatefulBlock block;
+    BatchRunner runner;
+    REQUIRE(runner.configure(&block, inputs, outputs, batchSize));
+    REQUIRE(runner.initialize());
+
+    double* u = runner.getInputPortBuffer(0);
+    double* x = runner.getDiscreteStateBuffer();
+    const double* y = runner.getOutputPortBuffer(0);
+    const double* dx = runner.getContinuousStateDerivativeBuffer();
+    REQUIRE(x);
+    REQUIRE(runner.getContinuousStateBuffer());
+    REQUIRE(dx);
+
+    // Every instance starts from the initial state
+    for (size_t i = 0; i < batchSize; ++i) {
+        REQUIRE(x[runner.getIndex(i, 0)] == StatefulBlock::InitialState);
+        u[runner.getIndex(i, 0)] = static_cast<double>(i);
+    }
+
+    // Every instance accumulates its own input
+    const size_t numSteps = 3;
+    for (size_t step = 0; step < numSteps; ++step) {
+        REQUIRE(runner.output());
+        REQUIRE(runner.stateDerivative());
+        REQUIRE(runner.updateDiscreteState());
+
+        const double steps = static_cast<double>(step);
+        for (size_t i = 0; i < batchSize; ++i) {
+            const double input = static_cast<double>(i);
+            REQUIRE(y[runner.getIndex(i, 0)] == StatefulBlock::InitialState + steps * input);
+            REQUIRE(dx[runner.getIndex(i, 0)] == 2 * input);
+            REQUIRE(x[runner.getIndex(i, 0)] == StatefulBlock::InitialState + (steps + 1) * input);
+        }
+    }
+
+    REQUIRE(runner.terminate());
+
+    // Blocks without states have no state buffers
+    ScaleBlock stateless;
+    REQUIRE(runner.configure(&stateless, inputs, outputs, batchSize));
+    REQUIRE_FALSE(runner.getDiscreteStateBuffer());
+    REQUIRE_FALSE(runner.getContinuousStateBuffer());
+    REQUIRE(runner.updateDiscreteState());
+}
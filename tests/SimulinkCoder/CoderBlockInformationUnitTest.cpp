@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/MatrixView.h"
+#include "BlockFactory/Core/Port.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/Core/TensorView.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+using namespace blockfactory;
+
+TEST_CASE("N-D ports", "[SimulinkCoder][CoderBlockInformation]")
+{
+    // A 4x3 RGB image, as emitted by the TLC for a 3-D signal
+    std::array<double, 4 * 3 * 3> image = {};
+    std::array<double, 5> vector = {};
+
+    const core::Port::Dimensions dims = {4, 3, 3};
+    const auto dataType = core::Port::DataType::DOUBLE;
+
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setInputPort({0, dims, dataType}, image.data()));
+    REQUIRE(blockInfo.setOutputPort({0, {1, 5}, dataType}, vector.data()));
+
+    REQUIRE(blockInfo.getInputPortInfo(0).dimension == dims);
+    REQUIRE(blockInfo.getInputPortWidth(0) == static_cast<int>(image.size()));
+    REQUIRE(blockInfo.getOutputPortWidth(0) == 5);
+
+    const auto signal = blockInfo.getInputPortSignal(0);
+    REQUIRE(signal);
+    REQUIRE(signal->getWidth() == image.size());
+
+    // Blocks access the signal through a view, without copies
+    image[2 + 4 * 1 + 12 * 2] = 7;
+    const auto view = core::TensorView<const double>::fromSignal(*signal, dims);
+    REQUIRE(view.rank() == 3);
+    REQUIRE(view(2, 1, 2) == 7);
+    REQUIRE(view.slice(2, 2).matrix()(2, 1) == 7);
+
+    // Ports without dimensions are not valid
+    REQUIRE_FALSE(blockInfo.setInputPort({1, {}, dataType}, vector.data()));
+}
+
+TEST_CASE("Frame ports", "[SimulinkCoder][CoderBlockInformation]")
+{
+    // A frame of 4 samples of a signal with 3 elements, as emitted by the TLC
+    std::array<double, 4 * 3> frame = {};
+    std::array<double, 4 * 3> output = {};
+
+    const auto dataType = core::Port::DataType::DOUBLE;
+
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setInputPort({0, {1, 3}, dataType, 4}, frame.data()));
+    REQUIRE(blockInfo.setOutputPort({0, {1, 3}, dataType, 4}, output.data()));
+
+    REQUIRE(blockInfo.getInputPortInfo(0).frameSize == 4);
+    REQUIRE(blockInfo.getInputPortWidth(0) == static_cast<int>(frame.size()));
+    REQUIRE(blockInfo.getOutputPortWidth(0) == static_cast<int>(output.size()));
+    REQUIRE(blockInfo.getInputPortMatrixSize(0).rows == 4);
+    REQUIRE(blockInfo.getInputPortMatrixSize(0).cols == 3);
+
+    // The signal contains the whole frame, and the samples of every element are contiguous
+    const auto signal = blockInfo.getInputPortSignal(0);
+    REQUIRE(signal->getWidth() == frame.size());
+    frame[1 + 2 * 4] = 5;
+    const auto view = core::MatrixView<const double>::fromSignal(
+        *signal, blockInfo.getInputPortMatrixSize(0));
+    REQUIRE(view(1, 2) == 5);
+
+    // Ports without frames have a frame size of one
+    REQUIRE(blockInfo.setInputPort({1, {1, 3}, dataType}, frame.data()));
+    REQUIRE(blockInfo.getInputPortInfo(1).frameSize == 1);
+    REQUIRE(blockInfo.getInputPortWidth(1) == 3);
+
+    // Frames are supported only by vectors
+    REQUIRE_FALSE(blockInfo.setInputPort({2, {2, 3}, dataType, 2}, frame.data()));
+    REQUIRE_FALSE(blockInfo.setInputPort({2, {1, 3}, dataType, 0}, frame.data()));
+}
+
+TEST_CASE("Relocate signals", "[SimulinkCoder][CoderBlockInformation]")
+{
+    // The root structure of a model with ports of different data types
+    struct Root
+    {
+        double u[2];
+        int32_t counter[3];
+        float y[4];
+    };
+
+    Root model = {};
+    Root application = {};
+
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setInputPort({0, {1, 2}, core::Port::DataType::DOUBLE}, model.u));
+    REQUIRE(blockInfo.setInputPort({1, {1, 3}, core::Port::DataType::INT32}, model.counter));
+    REQUIRE(blockInfo.setOutputPort({0, {1, 4}, core::Port::DataType::SINGLE}, model.y));
+
+    // Only the signals entirely contained in the region are relocated
+    REQUIRE(coder::CoderBlockInformation::relocateSignals(
+                model.counter, sizeof(model.counter), application.counter)
+            == 1);
+    REQUIRE(coder::CoderBlockInformation::relocateSignals(
+                model.counter, sizeof(model.counter) - 1, application.counter)
+            == 0);
+
+    const auto counter = blockInfo.getInputPortSignal(1);
+    REQUIRE(counter->getPortDataType() == core::Port::DataType::INT32);
+    REQUIRE(counter->getWidth() == 3);
+    REQUIRE(counter->getBuffer<int32_t>() == application.counter);
+    REQUIRE(blockInfo.getInputPortSignal(0)->getBuffer<double>() == model.u);
+
+    // Relocate the whole structure
+    REQUIRE(coder::CoderBlockInformation::relocateSignals(&model, sizeof(Root), &application)
+            == 2);
+    REQUIRE(blockInfo.getInputPortSignal(0)->getBuffer<double>() == application.u);
+    REQUIRE(blockInfo.getOutputPortSignal(0)->getBuffer<float>() == application.y);
+
+    REQUIRE(blockInfo.getOutputPortSignal(0)->set(3, 1.5));
+    REQUIRE(application.y[3] == 1.5f);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/ContinuousStateIntegrator.h"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+// dx = -rate * x, x(0) = 1
+class DecayBlock : public core::Block
+{
+public:
+    double rate = 1;
+
+    unsigned numberOfContinuousStates() override { return 2; }
+
+    bool initializeInitialConditions(const core::BlockInformation* blockInfo) override
+    {
+        auto state = blockInfo->getContinuousStateSignal();
+        return state && state->set(0, 1.0) && state->set(1, 2.0);
+    }
+
+    bool stateDerivative(const core::BlockInformation* blockInfo) override
+    {
+        const auto state = blockInfo->getContinuousStateSignal();
+        auto derivative = blockInfo->getContinuousStateDerivativeSignal();
+        for (size_t i = 0; i < state->getWidth(); ++i) {
+            derivative->set(i, -rate * state->get<double>(i));
+        }
+        return true;
+    }
+
+    bool output(const core::BlockInformation* /*blockInfo*/) override { return true; }
+};
+
+class StatelessBlock : public core::Block
+{
+public:
+    bool output(const core::BlockInformation* /*blockInfo*/) override { return true; }
+};
+
+TEST_CASE("Continuous states storage", "[SimulinkCoder][ContinuousStateIntegrator]")
+{
+    DecayBlock first;
+    StatelessBlock stateless;
+    DecayBlock second;
+    CoderBlockInformation firstInfo;
+    CoderBlockInformation statelessInfo;
+    CoderBlockInformation secondInfo;
+
+    ContinuousStateIntegrator integrator;
+    REQUIRE(integrator.addBlock(&first, &firstInfo));
+    REQUIRE(integrator.addBlock(&stateless, &statelessInfo));
+    REQUIRE(integrator.addBlock(&second, &secondInfo));
+    REQUIRE(integrator.getNumberOfStates() == 4);
+    REQUIRE(integrator.configure());
+
+    REQUIRE(first.initializeInitialConditions(&firstInfo));
+    REQUIRE(second.initializeInitialConditions(&secondInfo));
+
+    // The states of all the blocks are contiguous
+    const double* states = integrator.getStates();
+    REQUIRE(firstInfo.getContinuousStateSignal()->getBuffer<double>() == states);
+    REQUIRE(secondInfo.getContinuousStateSignal()->getBuffer<double>() == states + 2);
+    REQUIRE(states[0] == 1.0);
+    REQUIRE(states[3] == 2.0);
+
+    // Blocks without continuous states are not registered
+    REQUIRE_FALSE(statelessInfo.getContinuousStateSignal());
+}
+
+TEST_CASE("Continuous states integration", "[SimulinkCoder][ContinuousStateIntegrator]")
+{
+    const auto method = GENERATE(ContinuousStateIntegrator::Method::ForwardEuler,
+                                 ContinuousStateIntegrator::Method::RungeKutta4);
+
+    DecayBlock block;
+    CoderBlockInformation blockInfo;
+
+    ContinuousStateIntegrator integrator;
+    REQUIRE(integrator.addBlock(&block, &blockInfo));
+    REQUIRE(integrator.configure(method));
+    REQUIRE(block.initializeInitialConditions(&blockInfo));
+    REQUIRE_FALSE(integrator.integrate(0));
+
+    const double h = 0.1;
+    for (unsigned step = 0; step < 10; ++step) {
+        REQUIRE(integrator.integrate(h));
+    }
+
+    const double* x = integrator.getStates();
+
+    if (method == ContinuousStateIntegrator::Method::ForwardEuler) {
+        REQUIRE(x[0] == Approx(std::pow(1 - h, 10)));
+    }
+    else {
+        REQUIRE(x[0] == Approx(std::exp(-1.0)).epsilon(1e-6));
+        REQUIRE(x[1] == Approx(2 * std::exp(-1.0)).epsilon(1e-6));
+    }
+}
+
+TEST_CASE("Continuous states minor steps", "[SimulinkCoder][ContinuousStateIntegrator]")
+{
+    DecayBlock block;
+    CoderBlockInformation blockInfo;
+
+    ContinuousStateIntegrator integrator;
+    REQUIRE(integrator.addBlock(&block, &blockInfo));
+    REQUIRE(integrator.configure(ContinuousStateIntegrator::Method::RungeKutta4));
+
+    unsigned minorSteps = 0;
+    REQUIRE(integrator.integrate(0.1, [&]() { return ++minorSteps > 0; }));
+    REQUIRE(minorSteps == 3);
+
+    REQUIRE_FALSE(integrator.integrate(0.1, []() { return false; }));
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/DiscreteStateArena.h"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+// x[k+1] = x[k] + increment
+class CounterBlock : public core::Block
+{
+public:
+    unsigned numberOfStates = 3;
+    double increment = 1;
+
+    unsigned numberOfDiscreteStates() override { return numberOfStates; }
+
+    bool initializeInitialConditions(const core::BlockInformation* blockInfo) override
+    {
+        auto state = blockInfo->getDiscreteStateSignal();
+        for (size_t i = 0; i < state->getWidth(); ++i) {
+            state->set(i, static_cast<double>(i));
+        }
+        return true;
+    }
+
+    bool updateDiscreteState(const core::BlockInformation* blockInfo) override
+    {
+        auto state = blockInfo->getDiscreteStateSignal();
+        double* x = state->getBuffer<double>();
+        for (size_t i = 0; i < state->getWidth(); ++i) {
+            x[i] += increment;
+        }
+        return true;
+    }
+
+    bool output(const core::BlockInformation* /*blockInfo*/) override { return true; }
+};
+
+TEST_CASE("Discrete states storage", "[SimulinkCoder][DiscreteStateArena]")
+{
+    CounterBlock first;
+    CounterBlock second;
+    second.numberOfStates = 10;
+    second.increment = 10;
+    CoderBlockInformation firstInfo;
+    CoderBlockInformation secondInfo;
+
+    DiscreteStateArena arena;
+    REQUIRE(arena.addBlock(&first, &firstInfo));
+    REQUIRE(arena.addBlock(&second, &secondInfo));
+    REQUIRE(arena.configure());
+    REQUIRE(arena.getNumberOfStates() == 13);
+
+    // Slices are aligned and contiguous
+    const double* firstStates = firstInfo.getDiscreteStateSignal()->getBuffer<double>();
+    const double* secondStates = secondInfo.getDiscreteStateSignal()->getBuffer<double>();
+    REQUIRE(reinterpret_cast<uintptr_t>(firstStates) % DiscreteStateArena::Alignment == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(secondStates) % DiscreteStateArena::Alignment == 0);
+    REQUIRE(secondStates - firstStates == DiscreteStateArena::Alignment / sizeof(double));
+    REQUIRE(arena.getArenaSize() == 3 * DiscreteStateArena::Alignment);
+
+    REQUIRE(first.initializeInitialConditions(&firstInfo));
+    REQUIRE(second.initializeInitialConditions(&secondInfo));
+    REQUIRE(arena.update());
+    REQUIRE(firstStates[2] == 3);
+    REQUIRE(secondStates[9] == 19);
+}
+
+TEST_CASE("Discrete states snapshot", "[SimulinkCoder][DiscreteStateArena]")
+{
+    CounterBlock block;
+    CoderBlockInformation blockInfo;
+
+    DiscreteStateArena arena;
+    REQUIRE(arena.addBlock(&block, &blockInfo));
+    REQUIRE(arena.configure());
+    REQUIRE(block.initializeInitialConditions(&blockInfo));
+
+    std::vector<double> snapshot;
+    REQUIRE(arena.snapshot(snapshot));
+
+    for (unsigned i = 0; i < 5; ++i) {
+        REQUIRE(arena.update());
+    }
+    REQUIRE(blockInfo.getDiscreteStateSignal()->get<double>(0) == 5);
+
+    REQUIRE(arena.restore(snapshot));
+    REQUIRE(blockInfo.getDiscreteStateSignal()->get<double>(0) == 0);
+    REQUIRE(blockInfo.getDiscreteStateSignal()->get<double>(2) == 2);
+
+    REQUIRE_FALSE(arena.restore({1, 2, 3}));
+}
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/ElementwiseKernel.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/ElementwiseFusion.h"
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+#include "BlockFactory/SimulinkCoder/MultiRateScheduler.h"
+#include "BlockFactory/SimulinkCoder/ParallelScheduler.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <memory>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+using Operation = core::ElementwiseKernel::Operation;
+
+// Block that computes its output with an elementwise kernel
+class KernelBlock : public core::Block
+{
+public:
+    core::ElementwiseKernel kernel;
+    size_t calls = 0;
+
+    KernelBlock(const Operation operation, const double alpha = 1.0)
+    {
+        kernel.operation = operation;
+        kernel.alpha = alpha;
+    }
+
+    bool output(const core::BlockInformation* blockInfo) override
+    {
+        ++calls;
+        const auto u0 = blockInfo->getInputPortSignal(0);
+        const auto u1 = blockInfo->getInputPortSignal(1);
+        auto y = blockInfo->getOutputPortSignal(0);
+        return kernel.apply({u0->getBuffer<double>(), u0->getWidth()},
+                            {u1 ? u1->getBuffer<double>() : nullptr, u1 ? u1->getWidth() : 0},
+                            {y->getBuffer<double>(), y->getWidth()});
+    }
+
+    bool getElementwiseKernel(core::ElementwiseKernel& kernel) override
+    {
+        kernel = this->kernel;
+        return true;
+    }
+};
+
+// Block without kernel
+class CopyBlock : public core::Block
+{
+public:
+    bool output(const core::BlockInformation* blockInfo) override
+    {
+        const auto u = blockInfo->getInputPortSignal(0);
+        auto y = blockInfo->getOutputPortSignal(0);
+        return y->setBuffer(u->getBuffer<double>(), u->getWidth());
+    }
+};
+
+static core::Port::Info vectorPort(const core::Port::Index index, const int width)
+{
+    return {index, {width}, core::Port::DataType::DOUBLE};
+}
+
+TEST_CASE("Fuse chains of elementwise blocks", "[SimulinkCoder][ElementwiseFusion]")
+{
+    // Wider than a tile, so that the groups are computed in many tiles
+    const int width = 1000;
+    const auto in1 = vectorPort(0, width);
+    const auto in2 = {vectorPort(0, width), vectorPort(1, width)};
+    const auto out = vectorPort(0, width);
+
+    // B0 = a + b, B1 = 2 * B0, B2 = c - B1 | B3 = copy(B2) | B4 = B3 * B3, B5 = B4 + d, B6 = -B4
+    ModelGraph graph;
+    std::vector<std::unique_ptr<core::Block>> blocks;
+    graph.addBlock("B0", in2, {out});
+    blocks.emplace_back(new KernelBlock(Operation::ADDITION));
+    graph.addBlock("B1", {in1}, {out});
+    blocks.emplace_back(new KernelBlock(Operation::SCALE, 2.0));
+    graph.addBlock("B2", in2, {out});
+    blocks.emplace_back(new KernelBlock(Operation::SUBTRACTION));
+    graph.addBlock("B3", {in1}, {out});
+    blocks.emplace_back(new CopyBlock);
+    graph.addBlock("B4", in2, {out});
+    blocks.emplace_back(new KernelBlock(Operation::MULTIPLICATION));
+    graph.addBlock("B5", in2, {out});
+    blocks.emplace_back(new KernelBlock(Operation::ADDITION));
+    graph.addBlock("B6", {in1}, {out});
+    blocks.emplace_back(new KernelBlock(Operation::SCALE, -1.0));
+
+    REQUIRE(graph.connect({0, 0}, {1, 0}));
+    REQUIRE(graph.connect({1, 0}, {2, 1}));
+    REQUIRE(graph.connect({2, 0}, {3, 0}));
+    REQUIRE(graph.connect({3, 0}, {4, 0}));
+    REQUIRE(graph.connect({3, 0}, {4, 1}));
+    REQUIRE(graph.connect({4, 0}, {5, 0}));
+    REQUIRE(graph.connect({4, 0}, {6, 0}));
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    std::vector<core::Block*> blockPtrs;
+    std::vector<std::unique_ptr<CoderBlockInformation>> blockInfos;
+    std::vector<const core::BlockInformation*> blockInfoPtrs;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blockPtrs.push_back(blocks[i].get());
+        blockInfos.emplace_back(new CoderBlockInformation);
+        REQUIRE(planner.configureBlockInformation(i, *blockInfos.back()));
+        blockInfoPtrs.push_back(blockInfos.back().get());
+    }
+
+    // Only B0-B1-B2 are fused. B4 is consumed by two blocks and B3 has no kernel.
+    ElementwiseFusion fusion;
+    REQUIRE(fusion.configure(graph, blockPtrs));
+    REQUIRE(fusion.getNumberOfGroups() == 1);
+    REQUIRE(fusion.getRole(0) == ElementwiseFusion::Role::NONE);
+    REQUIRE(fusion.bind(blockInfoPtrs));
+    REQUIRE(fusion.getRole(0) == ElementwiseFusion::Role::INTERMEDIATE);
+    REQUIRE(fusion.getRole(1) == ElementwiseFusion::Role::INTERMEDIATE);
+    REQUIRE(fusion.getRole(2) == ElementwiseFusion::Role::LAST);
+    for (size_t i = 3; i < blocks.size(); ++i) {
+        REQUIRE(fusion.getRole(i) == ElementwiseFusion::Role::NONE);
+    }
+    REQUIRE_FALSE(fusion.output(1));
+
+    // Fill the external inputs
+    auto a = planner.getInputPortSignal({0, 0});
+    auto b = planner.getInputPortSignal({0, 1});
+    auto c = planner.getInputPortSignal({2, 0});
+    auto d = planner.getInputPortSignal({5, 1});
+    for (int i = 0; i < width; ++i) {
+        const_cast<double*>(a->getBuffer<double>())[i] = i;
+        const_cast<double*>(b->getBuffer<double>())[i] = 0.5;
+        const_cast<double*>(c->getBuffer<double>())[i] = 3 * i;
+        const_cast<double*>(d->getBuffer<double>())[i] = 1;
+    }
+
+    for (size_t block = 0; block < blocks.size(); ++block) {
+        switch (fusion.getRole(block)) {
+            case ElementwiseFusion::Role::NONE:
+                REQUIRE(blocks[block]->output(blockInfoPtrs[block]));
+                break;
+            case ElementwiseFusion::Role::INTERMEDIATE:
+                break;
+            case ElementwiseFusion::Role::LAST:
+                REQUIRE(fusion.output(block));
+                break;
+        }
+    }
+
+    // The fused blocks are not executed
+    REQUIRE(static_cast<KernelBlock*>(blockPtrs[0])->calls == 0);
+    REQUIRE(static_cast<KernelBlock*>(blockPtrs[2])->calls == 0);
+
+    // B2 = 3i - 2 * (i + 0.5) = i - 1
+    const auto b5 = planner.getOutputPortSignal({5, 0});
+    const auto b6 = planner.getOutputPortSignal({6, 0});
+    for (int i = 0; i < width; ++i) {
+        const double b2 = i - 1;
+        REQUIRE(b5->get<double>(i) == b2 * b2 + 1);
+        REQUIRE(b6->get<double>(i) == -b2 * b2);
+    }
+}
+
+TEST_CASE("Do not fuse overlapping signals", "[SimulinkCoder][ElementwiseFusion]")
+{
+    const auto dataType = core::Port::DataType::DOUBLE;
+    const int width = 4;
+
+    ModelGraph graph;
+    graph.addBlock("B0", {vectorPort(0, width)}, {vectorPort(0, width)});
+    graph.addBlock("B1", {vectorPort(0, width)}, {vectorPort(0, width)});
+    REQUIRE(graph.connect({0, 0}, {1, 0}));
+
+    KernelBlock b0(Operation::SCALE, 2.0);
+    KernelBlock b1(Operation::CLAMP);
+    b1.kernel.upper = 5;
+
+    ElementwiseFusion fusion;
+    REQUIRE(fusion.configure(graph, {&b0, &b1}));
+    REQUIRE(fusion.getNumberOfGroups() == 1);
+
+    // The output of the group is shifted by one element from its input
+    std::vector<double> buffer = {1, 2, 3, 4, 5};
+    std::vector<double> intermediate(width);
+    CoderBlockInformation info0;
+    CoderBlockInformation info1;
+    REQUIRE(info0.setInputPort({0, {1, width}, dataType}, buffer.data()));
+    REQUIRE(info0.setOutputPort({0, {1, width}, dataType}, intermediate.data()));
+    REQUIRE(info1.setInputPort({0, {1, width}, dataType}, intermediate.data()));
+    REQUIRE(info1.setOutputPort({0, {1, width}, dataType}, buffer.data() + 1));
+
+    REQUIRE(fusion.bind({&info0, &info1}));
+    REQUIRE(fusion.getRole(0) == ElementwiseFusion::Role::NONE);
+    REQUIRE(fusion.getRole(1) == ElementwiseFusion::Role::NONE);
+
+    // The same buffer for the input and the output can be fused
+    CoderBlockInformation inPlace;
+    REQUIRE(inPlace.setInputPort({0, {1, width}, dataType}, intermediate.data()));
+    REQUIRE(inPlace.setOutputPort({0, {1, width}, dataType}, buffer.data()));
+    REQUIRE(fusion.bind({&info0, &inPlace}));
+    REQUIRE(fusion.getRole(1) == ElementwiseFusion::Role::LAST);
+    REQUIRE(fusion.output(1));
+    REQUIRE(buffer == std::vector<double>{2, 4, 5, 5, 5});
+}
+
+TEST_CASE("Skip the fused blocks in the schedulers", "[SimulinkCoder][ElementwiseFusion]")
+{
+    const int width = 8;
+    const auto in1 = vectorPort(0, width);
+    const auto in2 = {vectorPort(0, width), vectorPort(1, width)};
+    const auto out = vectorPort(0, width);
+
+    // B0 = a + b, B1 = 2 * B0 | B2 = copy(B1)
+    ModelGraph graph;
+    std::vector<std::unique_ptr<KernelBlock>> kernelBlocks;
+    CopyBlock copyBlock;
+    graph.addBlock("B0", in2, {out});
+    kernelBlocks.emplace_back(new KernelBlock(Operation::ADDITION));
+    graph.addBlock("B1", {in1}, {out});
+    kernelBlocks.emplace_back(new KernelBlock(Operation::SCALE, 2.0));
+    graph.addBlock("B2", {in1}, {out});
+    REQUIRE(graph.connect({0, 0}, {1, 0}));
+    REQUIRE(graph.connect({1, 0}, {2, 0}));
+
+    SignalMemoryPlanner planner;
+    planner.setBufferReuse(false);
+    REQUIRE(planner.plan(graph));
+
+    std::vector<core::Block*> blocks = {kernelBlocks[0].get(), kernelBlocks[1].get(), &copyBlock};
+    std::vector<std::unique_ptr<CoderBlockInformation>> blockInfos;
+    std::vector<const core::BlockInformation*> blockInfoPtrs;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blockInfos.emplace_back(new CoderBlockInformation);
+        REQUIRE(planner.configureBlockInformation(i, *blockInfos.back()));
+        blockInfoPtrs.push_back(blockInfos.back().get());
+    }
+
+    ElementwiseFusion fusion;
+    REQUIRE(fusion.configure(graph, blocks));
+    REQUIRE(fusion.bind(blockInfoPtrs));
+    REQUIRE(fusion.getRole(1) == ElementwiseFusion::Role::LAST);
+
+    auto a = const_cast<double*>(planner.getInputPortSignal({0, 0})->getBuffer<double>());
+    auto b = const_cast<double*>(planner.getInputPortSignal({0, 1})->getBuffer<double>());
+    const auto y = planner.getOutputPortSignal({2, 0});
+
+    std::vector<std::atomic<size_t>> tasks(blocks.size());
+    for (auto& t : tasks) {
+        t = 0;
+    }
+    const auto task = [&](const ModelGraph::BlockIndex block) {
+        tasks[block]++;
+        return blocks[block]->output(blockInfoPtrs[block]);
+    };
+
+    const auto checkStep = [&](const double offset, const size_t steps) {
+        for (int i = 0; i < width; ++i) {
+            REQUIRE(y->get<double>(i) == 2 * (i + offset));
+        }
+        REQUIRE(tasks[0] == 0);
+        REQUIRE(tasks[1] == 0);
+        REQUIRE(tasks[2] == steps);
+        REQUIRE(kernelBlocks[0]->calls == 0);
+        REQUIRE(kernelBlocks[1]->calls == 0);
+    };
+
+    for (int i = 0; i < width; ++i) {
+        a[i] = i;
+        b[i] = 1;
+    }
+
+    SECTION("ParallelScheduler")
+    {
+        SignalMemoryPlanner reusePlanner;
+        REQUIRE(reusePlanner.plan(graph));
+
+        ParallelScheduler scheduler;
+        REQUIRE_FALSE(scheduler.configure(graph, &reusePlanner, &fusion));
+        REQUIRE(scheduler.configure(graph, &planner, &fusion));
+        REQUIRE(scheduler.start(2));
+        REQUIRE(scheduler.step(task));
+        checkStep(1, 1);
+
+        b[0] = 3;
+        REQUIRE(scheduler.step(task));
+        REQUIRE(y->get<double>(0) == 6);
+        scheduler.stop();
+    }
+
+    SECTION("MultiRateScheduler")
+    {
+        const std::vector<core::Block::SampleTime> sampleTimes = {
+            {0.001, 0}, {core::Block::InheritedSampleTime, 0}, {0.001, 0}};
+
+        MultiRateScheduler scheduler;
+        REQUIRE(scheduler.configure(graph, sampleTimes, planner, &fusion));
+        REQUIRE(scheduler.start(task, /*multiThreading=*/false));
+        REQUIRE(scheduler.tick());
+        checkStep(1, 1);
+        REQUIRE(scheduler.tick());
+        checkStep(1, 2);
+        scheduler.stop();
+
+        // The fused blocks must belong to the same rate
+        MultiRateScheduler mixedRates;
+        REQUIRE(mixedRates.configure(
+            graph, {{0.001, 0}, {0.002, 0}, {0.001, 0}}, planner, &fusion));
+        REQUIRE_FALSE(mixedRates.start(task, /*multiThreading=*/false));
+    }
+}
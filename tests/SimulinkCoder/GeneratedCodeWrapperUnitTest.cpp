@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#define MODEL FakeModel
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/GeneratedCodeWrapper.h"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <memory>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+// y = 2 * u
+class DoubleBlock : public core::Block
+{
+public:
+    bool output(const core::BlockInformation* blockInfo) override
+    {
+        const auto input = blockInfo->getInputPortSignal(0);
+        auto output = blockInfo->getOutputPortSignal(0);
+
+        for (size_t e = 0; e < input->getWidth(); ++e) {
+            output->set(e, 2 * input->get<double>(e));
+        }
+        return true;
+    }
+};
+
+// Mimics the class generated by Simulink Coder for a model with a single BlockFactory block
+// connected to the root input u and to the root output y. The root input offset is read directly
+// by the generated code, as it happens for native Simulink blocks.
+class FakeModelModelClass
+{
+public:
+    struct ExtU_FakeModel_T
+    {
+        double u[3];
+        double offset;
+    };
+
+    struct ExtY_FakeModel_T
+    {
+        double y[3];
+    };
+
+    struct RT_MODEL_FakeModel_T
+    {
+        const char* errorStatus = nullptr;
+    };
+
+    ExtU_FakeModel_T FakeModel_U;
+    ExtY_FakeModel_T FakeModel_Y;
+
+    FakeModelModelClass()
+        : FakeModel_U()
+        , FakeModel_Y()
+    {}
+
+    void initialize()
+    {
+        m_blockInfo = std::make_unique<CoderBlockInformation>();
+        const core::Port::Info port = {0, {1, 3}, core::Port::DataType::DOUBLE};
+
+        if (!m_blockInfo->setInputPort(port, FakeModel_U.u)
+            || !m_blockInfo->setOutputPort(port, FakeModel_Y.y)) {
+            m_rtm.errorStatus = "Failed to initialize the block";
+        }
+    }
+
+    void step()
+    {
+        if (!m_block.output(m_blockInfo.get())) {
+            m_rtm.errorStatus = "Failed to compute the output";
+        }
+    }
+
+    void terminate() { m_blockInfo.reset(); }
+
+    RT_MODEL_FakeModel_T* getRTM() { return &m_rtm; }
+
+private:
+    DoubleBlock m_block;
+    std::unique_ptr<CoderBlockInformation> m_blockInfo;
+    RT_MODEL_FakeModel_T m_rtm;
+};
+
+TEST_CASE("Access root inputs and outputs", "[SimulinkCoder][GeneratedCodeWrapper]")
+{
+    GeneratedCodeWrapper<FakeModelModelClass> model("FakeModel");
+
+    REQUIRE(BF_CODER_ADD_INPUT(model, u));
+    REQUIRE(BF_CODER_ADD_INPUT(model, offset));
+    REQUIRE(BF_CODER_ADD_OUTPUT(model, y));
+    REQUIRE_FALSE(BF_CODER_ADD_OUTPUT(model, y));
+    REQUIRE(model.getNumberOfInputs() == 2);
+    REQUIRE(model.getNumberOfOutputs() == 1);
+
+    // The model is not allocated yet
+    REQUIRE(model.getInput("u").empty());
+
+    REQUIRE(model.initialize());
+
+    auto input = model.getInput<double>("u");
+    REQUIRE(input.size() == 3);
+    REQUIRE(model.getInput<double>(1).size() == 1);
+    REQUIRE(model.getOutput<double>(0).size() == 3);
+
+    // Wrong type, index, or name
+    REQUIRE(model.getInput<float>("u").empty());
+    REQUIRE(model.getInput<double>(2).empty());
+    REQUIRE(model.getOutput<double>("u").empty());
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<double>(i);
+    }
+    REQUIRE(model.step());
+
+    const auto output = model.getOutput<double>("y");
+    for (size_t i = 0; i < output.size(); ++i) {
+        REQUIRE(output[i] == 2.0 * static_cast<double>(i));
+    }
+
+    REQUIRE(model.terminate());
+}
+
+TEST_CASE("Bind external buffers", "[SimulinkCoder][GeneratedCodeWrapper]")
+{
+    GeneratedCodeWrapper<FakeModelModelClass> model("FakeModel");
+    REQUIRE(BF_CODER_ADD_INPUT(model, u));
+    REQUIRE(BF_CODER_ADD_INPUT(model, offset));
+    REQUIRE(BF_CODER_ADD_OUTPUT(model, y));
+
+    double u[3] = {1, 2, 3};
+    double y[3] = {0, 0, 0};
+
+    // Bindings set before the initialization are applied by initialize()
+    REQUIRE(model.bindInput("u", u));
+    REQUIRE(model.initialize());
+    REQUIRE(model.bindOutput("y", y));
+
+    REQUIRE(model.getInput("u").data() == u);
+    REQUIRE(model.getOutput("y").data() == y);
+
+    REQUIRE(model.step());
+    REQUIRE(y[0] == 2);
+    REQUIRE(y[1] == 4);
+    REQUIRE(y[2] == 6);
+
+    // The application writes its own buffer
+    u[1] = 10;
+    REQUIRE(model.step());
+    REQUIRE(y[1] == 20);
+
+    // The offset is not connected to a BlockFactory block
+    double offset = 0;
+    REQUIRE_FALSE(model.bindInput("offset", &offset));
+
+    // Wrong type and name
+    float wrong[3];
+    REQUIRE_FALSE(model.bindInput("u", wrong));
+    REQUIRE_FALSE(model.bindOutput("u", y));
+
+    // Unbind the output, the model writes again its own structure
+    REQUIRE(model.bindOutput<double>("y", nullptr));
+    REQUIRE(model.getOutput("y").data() != y);
+    y[1] = 0;
+    REQUIRE(model.step());
+    REQUIRE(y[1] == 0);
+    REQUIRE(model.getOutput("y")[1] == 20);
+
+    // A new initialization keeps the input binding
+    REQUIRE(model.initialize());
+    REQUIRE(model.step());
+    REQUIRE(model.getOutput("y")[1] == 20);
+
+    REQUIRE(model.terminate());
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+#include "BlockFactory/SimulinkCoder/MultiRateScheduler.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+static core::Port::Info scalarPort(const core::Port::Index index)
+{
+    return {index, {1}, core::Port::DataType::DOUBLE};
+}
+
+// Counter (1 ms) -> Planner (10 ms) -> Controller (inherited, reads also Counter)
+static std::vector<std::vector<double>>
+runModel(const bool multiThreading, const size_t numTicks, const bool reconfigure = false)
+{
+    ModelGraph graph;
+    const auto counter = graph.addBlock("Counter", {}, {scalarPort(0)});
+    const auto planner = graph.addBlock("Planner", {scalarPort(0)}, {scalarPort(0)});
+    const auto controller = graph.addBlock("Controller", {scalarPort(0), scalarPort(1)}, {});
+    REQUIRE(graph.connect({counter, 0}, {planner, 0}));
+    REQUIRE(graph.connect({planner, 0}, {controller, 0}));
+    REQUIRE(graph.connect({counter, 0}, {controller, 1}));
+
+    const std::vector<core::Block::SampleTime> sampleTimes = {
+        {0.001, 0}, {0.01, 0}, {core::Block::InheritedSampleTime, 0}};
+
+    SignalMemoryPlanner memoryPlanner;
+    memoryPlanner.setBufferReuse(false);
+    REQUIRE(memoryPlanner.plan(graph));
+
+    MultiRateScheduler scheduler;
+    REQUIRE(scheduler.configure(graph, sampleTimes, memoryPlanner));
+    if (reconfigure) {
+        // The transition buffers of the first configuration are freed
+        const void* oldBuffer = memoryPlanner.getInputPortAddress({planner, 0});
+        REQUIRE(scheduler.configure(graph, sampleTimes, memoryPlanner));
+        REQUIRE(memoryPlanner.getInputPortAddress({planner, 0}) != oldBuffer);
+    }
+    REQUIRE(scheduler.getNumberOfRates() == 2);
+    REQUIRE(scheduler.getBasePeriod() == 0.001);
+    REQUIRE(scheduler.getRate(counter) == 0);
+    REQUIRE(scheduler.getRate(planner) == 1);
+    REQUIRE(scheduler.getRate(controller) == 0);
+    REQUIRE(scheduler.getNumberOfRateTransitions() == 2);
+
+    auto* counterOut = static_cast<double*>(memoryPlanner.getOutputPortAddress({counter, 0}));
+    auto* plannerIn = static_cast<double*>(memoryPlanner.getInputPortAddress({planner, 0}));
+    auto* plannerOut = static_cast<double*>(memoryPlanner.getOutputPortAddress({planner, 0}));
+    auto* controllerIn0 = static_cast<double*>(memoryPlanner.getInputPortAddress({controller, 0}));
+    auto* controllerIn1 = static_cast<double*>(memoryPlanner.getInputPortAddress({controller, 1}));
+
+    // Blocks of different rates read from the transition buffers
+    REQUIRE(plannerIn != counterOut);
+    REQUIRE(controllerIn0 != plannerOut);
+    REQUIRE(controllerIn1 == counterOut);
+
+    std::vector<std::vector<double>> log;
+    size_t plannerExecutions = 0;
+
+    REQUIRE(scheduler.start(
+        [&](const ModelGraph::BlockIndex block) {
+            if (block == counter) {
+                counterOut[0] += 1;
+            }
+            else if (block == planner) {
+                plannerOut[0] = plannerIn[0];
+                plannerExecutions++;
+            }
+            else {
+                log.push_back({controllerIn0[0], controllerIn1[0]});
+            }
+            return true;
+        },
+        multiThreading));
+
+    for (size_t i = 0; i < numTicks; ++i) {
+        REQUIRE(scheduler.tick());
+    }
+    scheduler.stop();
+
+    // The planner is executed every 10 ticks
+    REQUIRE(plannerExecutions == (numTicks + 9) / 10);
+
+    return log;
+}
+
+TEST_CASE("Multi-rate execution", "[SimulinkCoder][MultiRateScheduler]")
+{
+    const size_t numTicks = 100;
+    const auto log = runModel(/*multiThreading=*/false, numTicks);
+
+    REQUIRE(log.size() == numTicks);
+
+    for (size_t tick = 0; tick < numTicks; ++tick) {
+        // The controller reads the counter of the same rate without delay
+        REQUIRE(log[tick][1] == tick + 1);
+
+        // The planner output is available after one slow period, and it is held until the next
+        // planner tick
+        const double expected = (tick < 10) ? 0.0 : static_cast<double>(tick / 10 * 10 - 9);
+        REQUIRE(log[tick][0] == expected);
+    }
+
+    // Executing the slow rate in a dedicated thread produces the same result
+    REQUIRE(runModel(/*multiThreading=*/true, numTicks) == log);
+
+    // Configuring the scheduler again replaces the previous transition buffers
+    REQUIRE(runModel(/*multiThreading=*/false, numTicks, /*reconfigure=*/true) == log);
+}
+
+// Counter (1 ms) -> Middle (2 ms) -> Slow (4 ms)
+static std::vector<double> runThreeRates(const bool multiThreading, const size_t numTicks)
+{
+    ModelGraph graph;
+    const auto counter = graph.addBlock("Counter", {}, {scalarPort(0)});
+    const auto middle = graph.addBlock("Middle", {scalarPort(0)}, {scalarPort(0)});
+    const auto slow = graph.addBlock("Slow", {scalarPort(0)}, {});
+    REQUIRE(graph.connect({counter, 0}, {middle, 0}));
+    REQUIRE(graph.connect({middle, 0}, {slow, 0}));
+
+    SignalMemoryPlanner memoryPlanner;
+    memoryPlanner.setBufferReuse(false);
+    REQUIRE(memoryPlanner.plan(graph));
+
+    MultiRateScheduler scheduler;
+    REQUIRE(scheduler.configure(graph, {{0.001, 0}, {0.002, 0}, {0.004, 0}}, memoryPlanner));
+    REQUIRE(scheduler.getNumberOfRates() == 3);
+
+    auto* counterOut = static_cast<double*>(memoryPlanner.getOutputPortAddress({counter, 0}));
+    auto* middleIn = static_cast<double*>(memoryPlanner.getInputPortAddress({middle, 0}));
+    auto* middleOut = static_cast<double*>(memoryPlanner.getOutputPortAddress({middle, 0}));
+    auto* slowIn = static_cast<double*>(memoryPlanner.getInputPortAddress({slow, 0}));
+
+    std::vector<double> log;
+
+    REQUIRE(scheduler.start(
+        [&](const ModelGraph::BlockIndex block) {
+            if (block == counter) {
+                counterOut[0] += 1;
+            }
+            else if (block == middle) {
+                // Give the slow rate the time to read a stale value
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                middleOut[0] = middleIn[0];
+            }
+            else {
+                log.push_back(slowIn[0]);
+            }
+            return true;
+        },
+        multiThreading));
+
+    for (size_t i = 0; i < numTicks; ++i) {
+        REQUIRE(scheduler.tick());
+    }
+    scheduler.stop();
+
+    return log;
+}
+
+TEST_CASE("Multi-rate chain of three rates", "[SimulinkCoder][MultiRateScheduler]")
+{
+    const size_t numTicks = 40;
+    const auto log = runThreeRates(/*multiThreading=*/false, numTicks);
+
+    // The slow rate reads the value computed by the middle rate in the tick that released it,
+    // i.e. the counter of that tick
+    REQUIRE(log.size() == numTicks / 4);
+    for (size_t i = 0; i < log.size(); ++i) {
+        REQUIRE(log[i] == static_cast<double>(4 * i + 1));
+    }
+
+    REQUIRE(runThreeRates(/*multiThreading=*/true, numTicks) == log);
+}
+
+TEST_CASE("Multi-rate configuration errors", "[SimulinkCoder][MultiRateScheduler]")
+{
+    ModelGraph graph;
+    graph.addBlock("A", {}, {scalarPort(0)});
+    graph.addBlock("B", {scalarPort(0)}, {});
+    REQUIRE(graph.connect({0, 0}, {1, 0}));
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    MultiRateScheduler scheduler;
+
+    // Buffer reuse is not allowed
+    REQUIRE_FALSE(scheduler.configure(graph, {{0.001, 0}, {0.01, 0}}, planner));
+
+    planner.setBufferReuse(false);
+    REQUIRE(planner.plan(graph));
+
+    // Not harmonic rates
+    REQUIRE_FALSE(scheduler.configure(graph, {{0.002, 0}, {0.003, 0}}, planner));
+
+    // Offsets
+    REQUIRE_FALSE(scheduler.configure(graph, {{0.001, 0.0005}, {0.01, 0}}, planner));
+
+    REQUIRE(scheduler.configure(graph, {{0.001, 0}, {0.01, 0}}, planner));
+
+    // The redirected input port can be connected back to the planned signal
+    REQUIRE(planner.getInputPortAddress({1, 0}) != planner.getOutputPortAddress({0, 0}));
+    REQUIRE(planner.restoreInputPort({1, 0}));
+    REQUIRE(planner.getInputPortAddress({1, 0}) == planner.getOutputPortAddress({0, 0}));
+    REQUIRE_FALSE(planner.restoreInputPort({1, 1}));
+}
+
+TEST_CASE("Multi-rate priorities", "[SimulinkCoder][MultiRateScheduler]")
+{
+    ModelGraph graph;
+    graph.addBlock("A", {}, {scalarPort(0)});
+    graph.addBlock("B", {}, {scalarPort(0)});
+    graph.addBlock("C", {}, {scalarPort(0)});
+
+    SignalMemoryPlanner planner;
+    planner.setBufferReuse(false);
+    REQUIRE(planner.plan(graph));
+
+    MultiRateScheduler scheduler;
+    REQUIRE(scheduler.configure(graph, {{0.001, 0}, {0.01, 0}, {0.1, 0}}, planner));
+    REQUIRE_FALSE(scheduler.setBasePriority(-1));
+
+    // By default, the threads use the default policy
+    REQUIRE(scheduler.getPriority(1) == 0);
+
+#if defined(__linux__)
+    // Faster rates have higher priorities
+    REQUIRE(scheduler.setBasePriority(50));
+    REQUIRE(scheduler.getPriority(0) == 50);
+    REQUIRE(scheduler.getPriority(1) == 49);
+    REQUIRE(scheduler.getPriority(2) == 48);
+    REQUIRE(scheduler.getPriority(3) == 0);
+
+    // Priorities are limited to the minimum of SCHED_FIFO
+    REQUIRE(scheduler.setBasePriority(1));
+    REQUIRE(scheduler.getPriority(2) == 1);
+
+    // The priority cannot be changed while running
+    REQUIRE(scheduler.setBasePriority(0));
+    REQUIRE(scheduler.start([](const ModelGraph::BlockIndex) { return true; }));
+    REQUIRE_FALSE(scheduler.setBasePriority(50));
+    scheduler.stop();
+#endif
+}
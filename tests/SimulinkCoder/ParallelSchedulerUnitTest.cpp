@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+#include "BlockFactory/SimulinkCoder/ParallelScheduler.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <vector>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+static core::Port::Info vectorPort(const core::Port::Index index, const int width)
+{
+    return {index, {width}, core::Port::DataType::DOUBLE};
+}
+
+// Source -> numBranches chains of branchLength blocks -> Sink
+static void createBranches(ModelGraph& graph, const size_t numBranches, const size_t branchLength)
+{
+    core::OutputPortsInfo sourceOutputs;
+    core::InputPortsInfo sinkInputs;
+    for (size_t i = 0; i < numBranches; ++i) {
+        sourceOutputs.push_back(vectorPort(i, 4));
+        sinkInputs.push_back(vectorPort(i, 4));
+    }
+
+    const auto source = graph.addBlock("Source", {}, sourceOutputs);
+
+    std::vector<ModelGraph::BlockIndex> lastOfBranch;
+    for (size_t branch = 0; branch < numBranches; ++branch) {
+        ModelGraph::PortRef previous = {source, branch};
+        for (size_t i = 0; i < branchLength; ++i) {
+            const auto block = graph.addBlock("Branch", {vectorPort(0, 4)}, {vectorPort(0, 4)});
+            REQUIRE(graph.connect(previous, {block, 0}));
+            previous = {block, 0};
+        }
+        lastOfBranch.push_back(previous.block);
+    }
+
+    const auto sink = graph.addBlock("Sink", sinkInputs, {});
+    for (size_t branch = 0; branch < numBranches; ++branch) {
+        REQUIRE(graph.connect({lastOfBranch[branch], 0}, {sink, branch}));
+    }
+}
+
+TEST_CASE("Scheduler levels", "[SimulinkCoder][ParallelScheduler]")
+{
+    ModelGraph graph;
+    createBranches(graph, 4, 3);
+
+    ParallelScheduler scheduler;
+    REQUIRE(scheduler.configure(graph));
+
+    // Source, three levels of branches, sink
+    const auto& levels = scheduler.getLevels();
+    REQUIRE(levels.size() == 5);
+    REQUIRE(levels[0].size() == 1);
+    REQUIRE(levels[1].size() == 4);
+    REQUIRE(levels[4].size() == 1);
+}
+
+TEST_CASE("Scheduler respects dependencies", "[SimulinkCoder][ParallelScheduler]")
+{
+    ModelGraph graph;
+    createBranches(graph, 8, 5);
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    ParallelScheduler scheduler;
+    REQUIRE(scheduler.configure(graph, &planner));
+    REQUIRE(scheduler.start(4));
+    REQUIRE(scheduler.getNumberOfThreads() == 4);
+
+    const size_t numBlocks = graph.getNumberOfBlocks();
+    std::vector<std::atomic<size_t>> startedAt(numBlocks);
+    std::vector<std::atomic<size_t>> completedAt(numBlocks);
+    std::vector<std::atomic<size_t>> executions(numBlocks);
+    std::atomic<size_t> clock{0};
+
+    for (auto& e : executions) {
+        e = 0;
+    }
+
+    const size_t numSteps = 100;
+    for (size_t step = 0; step < numSteps; ++step) {
+        REQUIRE(scheduler.step([&](const ModelGraph::BlockIndex block) {
+            startedAt[block] = ++clock;
+            executions[block]++;
+            completedAt[block] = ++clock;
+            return true;
+        }));
+
+        for (size_t block = 0; block < numBlocks; ++block) {
+            for (const auto dependency : scheduler.getDependencies(block)) {
+                REQUIRE(completedAt[dependency] < startedAt[block]);
+            }
+        }
+    }
+
+    for (size_t block = 0; block < numBlocks; ++block) {
+        REQUIRE(executions[block] == numSteps);
+    }
+
+    // A failing task makes the step fail
+    REQUIRE_FALSE(scheduler.step([](const ModelGraph::BlockIndex block) { return block != 3; }));
+    REQUIRE(scheduler.step([](const ModelGraph::BlockIndex) { return true; }));
+
+    scheduler.stop();
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/PeriodicExecutor.h"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+TEST_CASE("Periodic execution", "[SimulinkCoder][PeriodicExecutor]")
+{
+    PeriodicExecutor executor;
+    REQUIRE_FALSE(executor.setPeriod(0));
+    REQUIRE(executor.setPeriod(0.002));
+    REQUIRE(executor.getPeriod() == Approx(0.002));
+
+    const size_t numberOfSteps = 50;
+    size_t counter = 0;
+
+    const auto begin = std::chrono::steady_clock::now();
+    REQUIRE(executor.run([&]() { return ++counter > 0; }, numberOfSteps));
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    // The first step is executed immediately
+    REQUIRE(counter == numberOfSteps);
+    REQUIRE(elapsed >= std::chrono::milliseconds(2 * (numberOfSteps - 1)));
+    REQUIRE_FALSE(executor.isRunning());
+
+    REQUIRE(executor.getNumberOfSteps() == numberOfSteps);
+    REQUIRE(executor.getExecutionTimeHistogram().getCount() == numberOfSteps);
+    REQUIRE(executor.getJitterHistogram().getCount() == numberOfSteps);
+
+    executor.resetStatistics();
+    REQUIRE(executor.getNumberOfSteps() == 0);
+    REQUIRE(executor.getJitterHistogram().getCount() == 0);
+}
+
+TEST_CASE("Periodic execution overruns", "[SimulinkCoder][PeriodicExecutor]")
+{
+    PeriodicExecutor executor;
+    REQUIRE(executor.setPeriod(0.001));
+
+    size_t counter = 0;
+    REQUIRE(executor.run(
+        [&]() {
+            // Every other step lasts more than a period
+            if (counter++ % 2 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(3));
+            }
+            return true;
+        },
+        10));
+
+    REQUIRE(executor.getNumberOfOverruns() >= 5);
+    REQUIRE(executor.getExecutionTimeHistogram().getMax() >= 3000000);
+
+    // A failing step stops the execution
+    REQUIRE_FALSE(executor.run([&]() { return false; }, 10));
+    REQUIRE(executor.getNumberOfSteps() == 11);
+}
+
+TEST_CASE("Periodic execution stop", "[SimulinkCoder][PeriodicExecutor]")
+{
+    PeriodicExecutor executor;
+    REQUIRE(executor.setPeriod(0.001));
+    REQUIRE_FALSE(executor.setPriority(-1));
+
+#if defined(__linux__)
+    REQUIRE(executor.setCpuAffinity({0}));
+#endif
+
+    bool result = false;
+    std::thread runner([&]() { result = executor.run([]() { return true; }); });
+
+    // Statistics can be read while the executor runs
+    while (executor.getExecutionTimeHistogram().getCount() < 10) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(executor.isRunning());
+    REQUIRE_FALSE(executor.setPeriod(0.002));
+
+    executor.requestStop();
+    runner.join();
+
+    REQUIRE(result);
+    REQUIRE_FALSE(executor.isRunning());
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Block.h"
+#include "BlockFactory/Core/BlockInformation.h"
+#include "BlockFactory/Core/LatencyHistogram.h"
+#include "BlockFactory/Core/Profiler.h"
+#include "BlockFactory/Core/Tracer.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace blockfactory;
+using core::Profiler;
+
+class SleepBlock : public core::Block
+{
+public:
+    bool initialize(core::BlockInformation* /*blockInfo*/) override { return true; }
+
+    bool output(const core::BlockInformation* /*blockInfo*/) override
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        return true;
+    }
+};
+
+static bool callOutput(SleepBlock& block, coder::CoderBlockInformation& blockInfo)
+{
+    return Profiler::call(&block, &blockInfo, Profiler::Callback::Output, &core::Block::output);
+}
+
+TEST_CASE("Profile the callbacks of a block", "[Core][Profiler]")
+{
+    SleepBlock block;
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setUniqueBlockName("model/Sleep"));
+
+    // Disabled profiler
+    Profiler::setEnabled(false);
+    REQUIRE(callOutput(block, blockInfo));
+    REQUIRE(Profiler::getCallCount("model/Sleep", Profiler::Callback::Output) == 0);
+
+    Profiler::setEnabled(true);
+    REQUIRE(Profiler::isEnabled());
+
+    for (size_t i = 0; i < 10; ++i) {
+        REQUIRE(callOutput(block, blockInfo));
+    }
+    REQUIRE(Profiler::call(
+        &block, &blockInfo, Profiler::Callback::Initialize, &core::Block::initialize));
+
+    REQUIRE(Profiler::getCallCount("model/Sleep", Profiler::Callback::Output) == 10);
+    REQUIRE(Profiler::getCallCount("model/Sleep", Profiler::Callback::Initialize) == 1);
+    REQUIRE(Profiler::getCallCount("model/Sleep", Profiler::Callback::Terminate) == 0);
+
+    core::LatencyHistogram histogram;
+    REQUIRE(Profiler::getExecutionTimes("model/Sleep", Profiler::Callback::Output, histogram));
+    REQUIRE(histogram.getMin() >= 200000);
+    REQUIRE_FALSE(
+        Profiler::getExecutionTimes("model/Missing", Profiler::Callback::Output, histogram));
+
+    std::ostringstream report;
+    Profiler::report(report);
+    REQUIRE(report.str().find("model/Sleep") != std::string::npos);
+    REQUIRE(report.str().find("output") != std::string::npos);
+
+    Profiler::reset();
+    REQUIRE(Profiler::getCallCount("model/Sleep", Profiler::Callback::Output) == 0);
+
+    Profiler::setEnabled(false);
+}
+
+TEST_CASE("Profile blocks executed by many threads", "[Core][Profiler]")
+{
+    SleepBlock block;
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setUniqueBlockName("model/Threads"));
+
+    Profiler::setEnabled(true);
+
+    bool ok = true;
+    std::thread other([&]() {
+        for (size_t i = 0; i < 5; ++i) {
+            ok = callOutput(block, blockInfo) && ok;
+        }
+    });
+    for (size_t i = 0; i < 3; ++i) {
+        REQUIRE(callOutput(block, blockInfo));
+    }
+    other.join();
+    REQUIRE(ok);
+
+    // The records of the two threads are merged
+    REQUIRE(Profiler::getCallCount("model/Threads", Profiler::Callback::Output) == 8);
+
+    // After the termination, a new block with the same address gets a new record
+    REQUIRE(Profiler::call(
+        &block, &blockInfo, Profiler::Callback::Terminate, &core::Block::terminate));
+
+    coder::CoderBlockInformation otherInfo;
+    REQUIRE(otherInfo.setUniqueBlockName("model/Reused"));
+    Profiler::call(&block, &otherInfo, Profiler::Callback::Output, &core::Block::output);
+    REQUIRE(Profiler::getCallCount("model/Reused", Profiler::Callback::Output) == 1);
+    REQUIRE(Profiler::getCallCount("model/Threads", Profiler::Callback::Output) == 8);
+
+    Profiler::setEnabled(false);
+}
+
+TEST_CASE("Release the blocks executed by worker threads", "[Core][Profiler]")
+{
+    // The two blocks are created in the same storage, so that they have the same address
+    alignas(SleepBlock) unsigned char storage[sizeof(SleepBlock)];
+    auto* block = new (storage) SleepBlock;
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setUniqueBlockName("model/Worker"));
+
+    Profiler::setEnabled(true);
+
+    // A worker thread that outlives the block, as the threads of the schedulers
+    std::mutex mutex;
+    std::condition_variable condition;
+    SleepBlock* task = nullptr;
+    coder::CoderBlockInformation* taskInfo = nullptr;
+    bool stop = false;
+    size_t done = 0;
+
+    std::thread worker([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock, [&]() { return task || stop; });
+            if (stop) {
+                return;
+            }
+            callOutput(*task, *taskInfo);
+            task = nullptr;
+            done++;
+            condition.notify_all();
+        }
+    });
+
+    const auto runInWorker = [&](SleepBlock* b, coder::CoderBlockInformation* info) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const size_t expected = done + 1;
+        task = b;
+        taskInfo = info;
+        condition.notify_all();
+        condition.wait(lock, [&]() { return done == expected; });
+    };
+
+    runInWorker(block, &blockInfo);
+    REQUIRE(
+        Profiler::call(block, &blockInfo, Profiler::Callback::Terminate, &core::Block::terminate));
+    block->~SleepBlock();
+
+    // The new block must not reuse the record cached by the worker
+    auto* newBlock = new (storage) SleepBlock;
+    coder::CoderBlockInformation newInfo;
+    REQUIRE(newInfo.setUniqueBlockName("model/NewWorker"));
+    runInWorker(newBlock, &newInfo);
+
+    REQUIRE(Profiler::getCallCount("model/NewWorker", Profiler::Callback::Output) == 1);
+    REQUIRE(Profiler::getCallCount("model/Worker", Profiler::Callback::Output) == 1);
+    REQUIRE(Profiler::getCallCount("model/Worker", Profiler::Callback::Terminate) == 1);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    condition.notify_all();
+    worker.join();
+    newBlock->~SleepBlock();
+
+    Profiler::setEnabled(false);
+}
+
+TEST_CASE("Trace the callbacks of a block", "[Core][Profiler]")
+{
+    SleepBlock block;
+    coder::CoderBlockInformation blockInfo;
+    REQUIRE(blockInfo.setUniqueBlockName("model/Traced"));
+
+    // The tracer works also when the profiler is disabled
+    REQUIRE_FALSE(Profiler::isEnabled());
+    REQUIRE(core::Tracer::start(16));
+    REQUIRE(callOutput(block, blockInfo));
+    core::Tracer::stop();
+
+    REQUIRE(core::Tracer::getNumberOfEvents() == 2);
+    REQUIRE(Profiler::getCallCount("model/Traced", Profiler::Callback::Output) == 0);
+
+    core::Tracer::Event begin;
+    core::Tracer::Event end;
+    REQUIRE(core::Tracer::getEvent(0, begin));
+    REQUIRE(core::Tracer::getEvent(1, end));
+    REQUIRE(core::Tracer::getName(begin.name) == "model/Traced");
+    REQUIRE(core::Tracer::getName(begin.category) == "output");
+    REQUIRE(end.timestamp - begin.timestamp >= 200000);
+}
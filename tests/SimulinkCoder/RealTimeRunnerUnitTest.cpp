@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/SimulinkCoder/RealTimeRunner.h"
+#include "BlockFactory/SimulinkCoder/SpscRingBuffer.h"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace blockfactory::coder;
+
+TEST_CASE("Ring buffer capacity", "[SimulinkCoder][RealTimeRunner]")
+{
+    SpscRingBuffer<int> buffer(5);
+    REQUIRE(buffer.capacity() == 8);
+    REQUIRE(buffer.empty());
+
+    int value = 0;
+    REQUIRE_FALSE(buffer.pop(value));
+
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(buffer.push(i));
+    }
+    REQUIRE_FALSE(buffer.push(8));
+    REQUIRE(buffer.size() == 8);
+
+    // Wrap around
+    for (int i = 0; i < 20; ++i) {
+        REQUIRE(buffer.pop(value));
+        REQUIRE(value == i);
+        REQUIRE(buffer.push(i + 8));
+    }
+    REQUIRE(buffer.size() == 8);
+}
+
+TEST_CASE("Ring buffer between two threads", "[SimulinkCoder][RealTimeRunner]")
+{
+    const uint64_t numberOfElements = 100000;
+    SpscRingBuffer<uint64_t> buffer(16);
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < numberOfElements;) {
+            if (buffer.push(i)) {
+                ++i;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // The elements arrive all and in order
+    bool ordered = true;
+    uint64_t expected = 0;
+    while (expected < numberOfElements) {
+        uint64_t value;
+        if (buffer.pop(value)) {
+            ordered = ordered && value == expected;
+            ++expected;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(buffer.empty());
+}
+
+// y[k] = y[k-1] + u
+struct AccumulatorModel
+{
+    double input = 0;
+    double accumulated = 0;
+    uint64_t steps = 0;
+    bool fail = false;
+
+    bool step()
+    {
+        accumulated += input;
+        ++steps;
+        return !fail;
+    }
+};
+
+using Message = std::array<double, 2>;
+using Runner = RealTimeRunner<AccumulatorModel, Message, Message>;
+
+static void setHandlers(Runner& runner)
+{
+    REQUIRE(runner.setInputHandler([](AccumulatorModel& model, const Message& input) {
+        model.input = input[0];
+        return true;
+    }));
+    REQUIRE(runner.setOutputHandler([](AccumulatorModel& model, Message& output) {
+        output = {static_cast<double>(model.steps), model.accumulated};
+        return true;
+    }));
+}
+
+TEST_CASE("Run a model in a real-time thread", "[SimulinkCoder][RealTimeRunner]")
+{
+    const uint64_t numberOfSteps = 200;
+
+    AccumulatorModel model;
+    Runner runner(model, 256);
+    setHandlers(runner);
+    REQUIRE(runner.getExecutor().setPeriod(0.0002));
+
+    REQUIRE(runner.pushInput({1, 0}));
+    REQUIRE(runner.start(numberOfSteps));
+    REQUIRE_FALSE(runner.start());
+    REQUIRE_FALSE(runner.setOutputHandler({}));
+
+    // Read the outputs while the model is running
+    std::vector<Message> outputs;
+    while (runner.isRunning() || outputs.size() < numberOfSteps) {
+        Message output;
+        if (runner.popOutput(output)) {
+            outputs.push_back(output);
+        }
+        else if (!runner.isRunning()) {
+            break;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    REQUIRE(runner.stop());
+    REQUIRE(model.steps == numberOfSteps);
+    REQUIRE(runner.getExecutor().getNumberOfSteps() == numberOfSteps);
+    REQUIRE(runner.getNumberOfDroppedOutputs() == 0);
+
+    // The input was applied before the first step
+    REQUIRE(outputs.size() == numberOfSteps);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        REQUIRE(outputs[i][0] == static_cast<double>(i + 1));
+        REQUIRE(outputs[i][1] == static_cast<double>(i + 1));
+    }
+}
+
+TEST_CASE("Stop and failures of the real-time thread", "[SimulinkCoder][RealTimeRunner]")
+{
+    AccumulatorModel model;
+    Runner runner(model, 4);
+    setHandlers(runner);
+    REQUIRE(runner.getExecutor().setPeriod(0.0001));
+
+    // Stop a runner without a limit of steps
+    REQUIRE(runner.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    REQUIRE(runner.stop());
+    REQUIRE_FALSE(runner.isRunning());
+
+    // Nobody reads the outputs
+    REQUIRE(model.steps > 4);
+    REQUIRE(runner.getNumberOfDroppedOutputs() == model.steps - 4);
+
+    // A stop received before the first step is not lost
+    REQUIRE(runner.start());
+    REQUIRE(runner.stop());
+
+    // Failing model
+    model.fail = true;
+    REQUIRE(runner.start());
+    while (runner.isRunning()) {
+        std::this_thread::yield();
+    }
+    REQUIRE_FALSE(runner.stop());
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2019 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "BlockFactory/Core/Signal.h"
+#include "BlockFactory/SimulinkCoder/CoderBlockInformation.h"
+#include "BlockFactory/SimulinkCoder/ModelGraph.h"
+#include "BlockFactory/SimulinkCoder/SignalMemoryPlanner.h"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+using namespace blockfactory;
+using namespace blockfactory::coder;
+
+static core::Port::Info vectorPort(const core::Port::Index index, const int width)
+{
+    return {index, {width}, core::Port::DataType::DOUBLE};
+}
+
+static bool isAligned(const void* address)
+{
+    return reinterpret_cast<uintptr_t>(address) % SignalMemoryPlanner::Alignment == 0;
+}
+
+// Create a chain of blocks: in -> B0 -> B1 -> ... -> Bn-1 -> out
+static void createChain(ModelGraph& graph, const size_t numBlocks, const int width)
+{
+    for (size_t i = 0; i < numBlocks; ++i) {
+        graph.addBlock("Block" + std::to_string(i), {vectorPort(0, width)}, {vectorPort(0, width)});
+        if (i > 0) {
+            REQUIRE(graph.connect({i - 1, 0}, {i, 0}));
+        }
+    }
+}
+
+TEST_CASE("Model graph connections", "[SimulinkCoder][ModelGraph]")
+{
+    ModelGraph graph;
+    const auto b0 = graph.addBlock("Source", {}, {vectorPort(0, 4), vectorPort(1, 3)});
+    const auto b1 = graph.addBlock("Sink", {vectorPort(0, 4)}, {});
+
+    REQUIRE(graph.getNumberOfBlocks() == 2);
+    REQUIRE(graph.getBlockName(b0) == "Source");
+
+    // Not existing ports
+    REQUIRE_FALSE(graph.connect({b0, 2}, {b1, 0}));
+    REQUIRE_FALSE(graph.connect({b0, 0}, {b1, 1}));
+
+    // Size mismatch
+    REQUIRE_FALSE(graph.connect({b0, 1}, {b1, 0}));
+
+    REQUIRE(graph.connect({b0, 0}, {b1, 0}));
+    REQUIRE(graph.getConnections().size() == 1);
+
+    // An input port can have only one source
+    REQUIRE_FALSE(graph.connect({b0, 0}, {b1, 0}));
+
+    ModelGraph::PortRef source;
+    REQUIRE(graph.getSource({b1, 0}, source));
+    REQUIRE(source.block == b0);
+    REQUIRE(source.port == 0);
+
+    // Frames have all their samples in the signal, and must match the frame of the destination
+    core::Port::Info framePort = vectorPort(0, 2);
+    framePort.frameSize = 4;
+    REQUIRE(ModelGraph::getNumberOfElements(framePort) == 8);
+    const auto b2 = graph.addBlock("FrameSource", {}, {framePort});
+    const auto b3 = graph.addBlock("SampleSink", {vectorPort(0, 8)}, {});
+    const auto b4 = graph.addBlock("FrameSink", {framePort}, {});
+    REQUIRE_FALSE(graph.connect({b2, 0}, {b3, 0}));
+    REQUIRE(graph.connect({b2, 0}, {b4, 0}));
+}
+
+TEST_CASE("Planner reuses buffers of dead signals", "[SimulinkCoder][SignalMemoryPlanner]")
+{
+    const size_t numBlocks = 10;
+    const int width = 100;
+
+    ModelGraph graph;
+    createChain(graph, numBlocks, width);
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    // One external input and one signal for every block output
+    REQUIRE(planner.getNumberOfSignals() == numBlocks + 1);
+    REQUIRE(planner.getArenaSize() < planner.getRequiredMemoryWithoutReuse());
+
+    for (size_t i = 0; i < numBlocks; ++i) {
+        auto input = planner.getInputPortSignal({i, 0});
+        auto output = planner.getOutputPortSignal({i, 0});
+
+        REQUIRE(input);
+        REQUIRE(output);
+        REQUIRE(input->isValid());
+        REQUIRE(output->getDataFormat() == core::Signal::DataFormat::CONTIGUOUS_ZEROCOPY);
+        REQUIRE(output->getWidth() == width);
+        REQUIRE(isAligned(output->getBuffer<double>()));
+
+        // The input of a block cannot share memory with its output
+        REQUIRE(input->getBuffer<double>() != output->getBuffer<double>());
+
+        // Consecutive blocks share the same signal
+        if (i > 0) {
+            REQUIRE(planner.getInputPortAddress({i, 0})
+                    == planner.getOutputPortAddress({i - 1, 0}));
+        }
+    }
+
+    // The external input and output are persistent and do not overlap with any other signal
+    const auto* in = static_cast<const uint8_t*>(planner.getInputPortAddress({0, 0}));
+    const auto* out = static_cast<const uint8_t*>(planner.getOutputPortAddress({numBlocks - 1, 0}));
+    const size_t bytes = width * sizeof(double);
+
+    for (size_t i = 0; i < numBlocks - 1; ++i) {
+        const auto* other = static_cast<const uint8_t*>(planner.getOutputPortAddress({i, 0}));
+        REQUIRE((other + bytes <= in || in + bytes <= other));
+        REQUIRE((other + bytes <= out || out + bytes <= other));
+    }
+}
+
+TEST_CASE("Planner without buffer reuse", "[SimulinkCoder][SignalMemoryPlanner]")
+{
+    ModelGraph graph;
+    createChain(graph, 5, 10);
+
+    SignalMemoryPlanner planner;
+    planner.setBufferReuse(false);
+    REQUIRE(planner.plan(graph));
+    REQUIRE(planner.getArenaSize() == planner.getRequiredMemoryWithoutReuse());
+}
+
+TEST_CASE("Planner keeps feedback signals alive", "[SimulinkCoder][SignalMemoryPlanner]")
+{
+    // B0 reads the output of B2 computed in the previous step
+    ModelGraph graph;
+    graph.addBlock("B0", {vectorPort(0, 8)}, {vectorPort(0, 8)});
+    graph.addBlock("B1", {vectorPort(0, 8)}, {vectorPort(0, 8)});
+    graph.addBlock("B2", {vectorPort(0, 8)}, {vectorPort(0, 8), vectorPort(1, 8)});
+    graph.addBlock("B3", {vectorPort(0, 8)}, {});
+    REQUIRE(graph.connect({0, 0}, {1, 0}));
+    REQUIRE(graph.connect({1, 0}, {2, 0}));
+    REQUIRE(graph.connect({2, 0}, {0, 0}));
+    REQUIRE(graph.connect({2, 1}, {3, 0}));
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    const auto* feedback = static_cast<const uint8_t*>(planner.getOutputPortAddress({2, 0}));
+    const size_t bytes = 8 * sizeof(double);
+
+    for (const ModelGraph::PortRef ref :
+         {ModelGraph::PortRef{0, 0}, ModelGraph::PortRef{1, 0}, ModelGraph::PortRef{2, 1}}) {
+        const auto* other = static_cast<const uint8_t*>(planner.getOutputPortAddress(ref));
+        REQUIRE((other + bytes <= feedback || feedback + bytes <= other));
+    }
+}
+
+TEST_CASE("Planner configures CoderBlockInformation", "[SimulinkCoder][SignalMemoryPlanner]")
+{
+    ModelGraph graph;
+    createChain(graph, 2, 3);
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    CoderBlockInformation blockInfo;
+    REQUIRE(planner.configureBlockInformation(1, blockInfo));
+    REQUIRE(blockInfo.getInputPortWidth(0) == 3);
+    REQUIRE(blockInfo.getOutputPortWidth(0) == 3);
+
+    // Writing the output of the first block is visible from the input of the second block
+    auto output = planner.getOutputPortSignal({0, 0});
+    REQUIRE(output->set(2, 42.0));
+    REQUIRE(blockInfo.getInputPortSignal(0)->get<double>(2) == 42.0);
+}
+
+TEST_CASE("Planner shares the buffers of outputs computed in place",
+          "[SimulinkCoder][SignalMemoryPlanner]")
+{
+    core::Port::Info inPlacePort = vectorPort(0, 8);
+    inPlacePort.inPlaceInput = 0;
+
+    // in -> B0 -> B1 -> B2 -> B3 -> out, with B0, B1 and B2 computed in place
+    ModelGraph graph;
+    graph.addBlock("B0", {vectorPort(0, 8)}, {inPlacePort});
+    graph.addBlock("B1", {vectorPort(0, 8)}, {inPlacePort});
+    graph.addBlock("B2", {vectorPort(0, 8)}, {inPlacePort});
+    graph.addBlock("B3", {vectorPort(0, 8)}, {vectorPort(0, 8)});
+    for (ModelGraph::BlockIndex block = 1; block < 4; ++block) {
+        REQUIRE(graph.connect({block - 1, 0}, {block, 0}));
+    }
+
+    SignalMemoryPlanner planner;
+    REQUIRE(planner.plan(graph));
+
+    // The external input is persistent, hence B0 has a dedicated buffer
+    REQUIRE(planner.getInputPortAddress({0, 0}) != planner.getOutputPortAddress({0, 0}));
+    REQUIRE(planner.getOutputPortAddress({1, 0}) == planner.getOutputPortAddress({0, 0}));
+    REQUIRE(planner.getOutputPortAddress({2, 0}) == planner.getOutputPortAddress({0, 0}));
+    REQUIRE(planner.getOutputPortAddress({3, 0}) != planner.getOutputPortAddress({2, 0}));
+
+    // The signals computed in place are alive until their last consumer
+    for (const auto& dependency : planner.getReuseDependencies()) {
+        REQUIRE(dependency.first < dependency.second);
+    }
+
+    // Signals read by other blocks are not overwritten
+    graph.addBlock("B4", {vectorPort(0, 8)}, {});
+    REQUIRE(graph.connect({1, 0}, {4, 0}));
+    REQUIRE(planner.plan(graph));
+    REQUIRE(planner.getOutputPortAddress({1, 0}) == planner.getOutputPortAddress({0, 0}));
+    REQUIRE(planner.getOutputPortAddress({2, 0}) != planner.getOutputPortAddress({1, 0}));
+
+    planner.setBufferReuse(false);
+    REQUIRE(planner.plan(graph));
+    REQUIRE(planner.getOutputPortAddress({1, 0}) != planner.getOutputPortAddress({0, 0}));
+
+    // Blocks with states read their inputs after the outputs are computed
+    ModelGraph statefulGraph;
+    statefulGraph.addBlock("B0", {vectorPort(0, 8)}, {vectorPort(0, 8)});
+    statefulGraph.addBlock("B1", {vectorPort(0, 8)}, {inPlacePort}, /*hasStates=*/true);
+    statefulGraph.addBlock("B2", {vectorPort(0, 8)}, {inPlacePort});
+    statefulGraph.addBlock("B3", {vectorPort(0, 8)}, {});
+    for (ModelGraph::BlockIndex block = 1; block < 4; ++block) {
+        REQUIRE(statefulGraph.connect({block - 1, 0}, {block, 0}));
+    }
+    REQUIRE(statefulGraph.hasStates(1));
+    REQUIRE_FALSE(statefulGraph.hasStates(2));
+    planner.setBufferReuse(true);
+    REQUIRE(planner.plan(statefulGraph));
+    REQUIRE(planner.getOutputPortAddress({1, 0}) != planner.getOutputPortAddress({0, 0}));
+    REQUIRE(planner.getOutputPortAddress({2, 0}) == planner.getOutputPortAddress({1, 0}));
+
+    // Invalid input ports are ignored
+    core::Port::Info invalidPort = vectorPort(0, 8);
+    invalidPort.inPlaceInput = -2;
+    ModelGraph invalidGraph;
+    invalidGraph.addBlock("B0", {vectorPort(0, 8)}, {vectorPort(0, 8)});
+    invalidGraph.addBlock("B1", {vectorPort(0, 8)}, {invalidPort});
+    REQUIRE(invalidGraph.connect({0, 0}, {1, 0}));
+    planner.setBufferReuse(true);
+    REQUIRE(planner.plan(invalidGraph));
+    REQUIRE(planner.getOutputPortAddress({1, 0}) != planner.getOutputPortAddress({0, 0}));
+}